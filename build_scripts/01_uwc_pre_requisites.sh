@@ -54,6 +54,14 @@ create_docker_volume_dir()
                 echo "${RED}Failed to create docker volume directory${NC}"
                 exit 1;
         fi
+        # spool of mqtt-bridge is kept across re-installation, it may hold unpublished messages
+        mkdir -p /opt/intel/eii/uwc_data/mqtt-bridge/spool && chown -R 1999:1999 /opt/intel/eii/uwc_data/mqtt-bridge
+        if [ "$?" -eq "0" ]; then
+                echo "${GREEN}/opt/intel/eii/uwc_data/mqtt-bridge/spool is sucessfully created. ${NC}"
+        else
+                echo "${RED}Failed to create docker volume directory${NC}"
+                exit 1;
+        fi
 
 	echo "${GREEN}Deleting old /opt/intel/eii/container_logs directory.${NC}"
 	rm -rf  /opt/intel/eii/container_logs
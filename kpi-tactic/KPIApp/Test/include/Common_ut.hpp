@@ -28,6 +28,7 @@
 #include "gtest/gtest.h"
 #include "Common.hpp"
 #include "QueueHandler.hpp"
+#include "PolledUpdate.hpp"
 
 
 class Common_ut : public ::testing::Test{
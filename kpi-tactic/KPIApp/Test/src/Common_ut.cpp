@@ -76,6 +76,25 @@ TEST_F(Common_ut, getKeyValue_FromJson_withMsg)
 
 }
 
+/**
+ * Test case to check if getValueofKeyFromJSONMsg() function extracts the value of a key from binary polled update
+ * @param :[in] None
+ * @param :[out] None
+ * @return None
+ */
+TEST_F(Common_ut, getKeyValue_FromBinaryUpdate)
+{
+	stPolledUpdate stUpdate;
+	stUpdate.m_sDataTopic = "/flowmeter/PL0/D1/update";
+	stUpdate.m_u64DriverSeq = 1234;
+	stUpdate.m_eStatus = enPOLLED_STATUS_BAD;
+	std::string sMsg;
+	CPolledUpdateCodec::encode(stUpdate, sMsg);
+	EXPECT_EQ("1234", commonUtilKPI::getValueofKeyFromJSONMsg(sMsg, "driver_seq"));
+	EXPECT_EQ("Bad", commonUtilKPI::getValueofKeyFromJSONMsg(sMsg, "status"));
+	EXPECT_EQ("", commonUtilKPI::getValueofKeyFromJSONMsg(sMsg, "app_seq"));
+}
+
 
 /**
  * Test case to check if addFieldToMsg() function adds field to JSON payload successfully
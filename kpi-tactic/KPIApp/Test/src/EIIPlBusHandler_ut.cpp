@@ -22,7 +22,7 @@
 
 #include "../include/EIIPlBusHandler_ut.hpp"
 
-extern bool publishEMBMsg(std::string a_sEiiMsg, std::string &a_sEiiTopic);
+extern bool publishEMBMsg(std::string a_sEiiMsg, zmq_handler::stZmqPubHandle *a_pPubHandle);
 
 extern std::vector<std::thread> g_vThreads;
 
@@ -123,7 +123,7 @@ TEST_F(EIIPlBusHandler_ut, EIIMsg_ctx_Map_Empty)
 	try
 	{
 		std::string sMsg{""};
-	    bool RetVal = CEIIPlBusHandler_obj.publishEMBMsg(strMsg, eiiTopic);
+	    bool RetVal = CEIIPlBusHandler_obj.publishEMBMsg(strMsg, zmq_handler::getPubHandle(eiiTopic));
 		EXPECT_EQ(false, RetVal);
 
 	}
@@ -54,15 +54,15 @@ TEST_F(MqttHandler_ut, isConnected_false)
 }
 
 /**
- * Test case to check if publishMsg() function publishes the msg successfully when topic is given and returns true on success
+ * Test case to check if publishMsg() function returns false when topic is given but client is not connected
  * @param :[in] None
  * @param :[out] None
  * @return None
  */
-TEST_F(MqttHandler_ut, publishMsg_true)
+TEST_F(MqttHandler_ut, publishMsg_NotConnected)
 {
 	bool RetVal = CMqttHandler::instance().publishMsg(strMsg, topic);
-	EXPECT_EQ(true, RetVal);
+	EXPECT_EQ(false, RetVal);
 }
 
 /**
@@ -95,15 +95,15 @@ TEST_F(QueueMgr_ut, platfomBusHandler_true)
 }
 
 /**
- * Test case to check if publishWriteReqOnMQTT()function Forms and publishes write request on MQTT and returns true on success
+ * Test case to check if publishWriteReqOnMQTT()function returns false when MQTT client is not connected
  * @param :[in] None
  * @param :[out] None
  * @return None
  */
-TEST_F(QueueMgr_ut, WriteRqOnMqtt_true)
+TEST_F(QueueMgr_ut, WriteRqOnMqtt_NotConnected)
 {
 	bool Result = publishWriteReqOnMQTT(subTopic, strMsg);
-	EXPECT_EQ(true, Result);
+	EXPECT_EQ(false, Result);
 }
 
 /**
@@ -33,6 +33,11 @@
 #include "QueueHandler.hpp"
 #include "Logger.hpp"
 
+namespace zmq_handler
+{
+	struct stZmqPubHandle;
+}
+
 /** class for control loop operations*/
 class CControlLoopOp
 {
@@ -47,6 +52,7 @@ private:
 	std::string m_sVal; /** site value*/
 	CQueueHandler m_q; /** object of class CQueueHandler*/
 	std::thread m_thread; /** thread id for this control loop handling */
+	zmq_handler::stZmqPubHandle *m_pEMBPubHandle; /** EMB publisher handle for write requests */
 
 	void threadPollMonitoring();
 
@@ -56,7 +62,7 @@ public:
 		uint32_t a_uiDelayMs, const std::string &a_sVal)
 	: m_sId{std::to_string(a_uiId)}, m_sPolledTopic{a_sPolledTopic}, m_sWritePointFullPath{a_sWritePoint}, 
 	m_sWriteDevName{a_sWriteDevName}, m_sWriteWellheadName{a_sWriteWellheadName}, m_sWritePointName{a_sWritePointName},
-	m_uiDelayMs{a_uiDelayMs}, m_sVal{a_sVal}, m_q{}
+	m_uiDelayMs{a_uiDelayMs}, m_sVal{a_sVal}, m_q{}, m_pEMBPubHandle{NULL}
 	{}
 
 	CControlLoopOp& operator=(const CControlLoopOp& a_obj)
@@ -69,6 +75,7 @@ public:
 		m_sWritePointName = a_obj.m_sWritePointName;
 		m_uiDelayMs = a_obj.m_uiDelayMs;
 		m_sVal = a_obj.m_sVal;
+		m_pEMBPubHandle = a_obj.m_pEMBPubHandle;
 
 		return *this;
 	}
@@ -77,7 +84,7 @@ public:
 	: m_sId{a_obj.m_sId}, m_sPolledTopic{a_obj.m_sPolledTopic}, m_sWritePointFullPath{a_obj.m_sWritePointFullPath}, 
 		m_sWriteDevName{a_obj.m_sWriteDevName}, m_sWriteWellheadName{a_obj.m_sWriteWellheadName}, 
 		m_sWritePointName{a_obj.m_sWritePointName},
-		m_uiDelayMs{a_obj.m_uiDelayMs}, m_sVal{a_obj.m_sVal}, m_q{}
+		m_uiDelayMs{a_obj.m_uiDelayMs}, m_sVal{a_obj.m_sVal}, m_q{}, m_pEMBPubHandle{a_obj.m_pEMBPubHandle}
 	{} 
 	
 	bool startThread();
@@ -90,6 +97,8 @@ public:
 	std::string getWellHeadNameForWrReq() const {return m_sWriteWellheadName;}
 	std::string getPointNameForWrReq() const {return m_sWritePointName;}
 	uint32_t getDelay() const {return m_uiDelayMs;}
+	zmq_handler::stZmqPubHandle* getEMBPubHandle() const {return m_pEMBPubHandle;}
+	void setEMBPubHandle(zmq_handler::stZmqPubHandle *a_pPubHandle) {m_pEMBPubHandle = a_pPubHandle;}
 	
 	CQueueHandler& getQueue() {return m_q;}
 
@@ -216,6 +225,7 @@ public:
 	bool triggerControlLoops(std::string& a_sPolledPoint, CMessageObject &a_oMsg);
 	bool configControlLoopOps(bool a_bIsRTWrite);
 	bool stopControlLoopOps();
+	bool resolveEMBPubHandles(bool a_bIsRTWrite);
 	bool destroySubCtx();
 	bool isControlLoopPollPoint(const std::string &a_sPollTopic);
 	bool isControlLoopWrRspPoint(const std::string &a_sWrRspTopic);
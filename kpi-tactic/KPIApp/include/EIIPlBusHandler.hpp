@@ -47,7 +47,7 @@ public:
     bool initEIIContext();
     void configEIIListerners(bool a_bIsPollingRT, bool a_bIsWrOpRT);
     void stopEIIListeners();
-    bool publishEMBMsg(std::string a_sEiiMsg, std::string &a_sEiiTopic);
+    bool publishEMBMsg(std::string a_sEiiMsg, zmq_handler::stZmqPubHandle *a_pPubHandle);
 };
 
 #endif
@@ -40,6 +40,8 @@ namespace QMgr
 	CQueueHandler& WriteRespMsgQ();
 }
 
+std::string mapMqttToEMBRespTopic(std::string mqttTopic,std::string isRealTime);
+
 /** nmaespace for Bus manager*/
 namespace PlBusMgr
 {
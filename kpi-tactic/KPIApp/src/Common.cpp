@@ -23,6 +23,7 @@
 #include "Common.hpp"
 #include <cjson/cJSON.h>
 #include "CommonDataShare.hpp"
+#include "PolledUpdate.hpp"
 
 /**
  * Get current time in micro seconds
@@ -68,7 +69,8 @@ void commonUtilKPI::logAnalysisMsg(struct stPollWrData &a_stPollWrData, CMessage
 
 /**
  * This function extracts the value of a key from given JSON payload 
- * @param a_sMsg 	:[in] JSON payload in string form
+ * or from binary polled update
+ * @param a_sMsg 	:[in] JSON payload in string form or binary polled update
  * @param a_sKey 	:[in] Key name for which value is needed
  * @return string: extracted value
  */
@@ -79,6 +81,16 @@ std::string commonUtilKPI::getValueofKeyFromJSONMsg(const std::string &a_sMsg, c
 	std::string sValue{""};
 	try
 	{
+		if(true == CPolledUpdateCodec::isPolledUpdate(a_sMsg.data(), a_sMsg.size()))
+		{
+			thread_local stPolledUpdate stUpdate;
+			if(true == CPolledUpdateCodec::decode(a_sMsg.data(), a_sMsg.size(), stUpdate))
+			{
+				CPolledUpdateCodec::getField(stUpdate, a_sKey, sValue);
+				DO_LOG_DEBUG("Key: " + a_sKey + ", extracted value: " + sValue);
+			}
+			return sValue;
+		}
 		do
 		{
 			// Format in JSON is:
@@ -227,31 +239,68 @@ std::string commonUtilKPI::createAnalysisMsg(struct stPollWrData &a_stPollWrData
 
 	try
 	{
-		cJSON *pRootPollMsg = cJSON_Parse(a_stPollWrData.m_oPollData.getStrMsg().c_str());
-		if (NULL == pRootPollMsg)
+		const std::string &sPollMsg = a_stPollWrData.m_oPollData.getStrMsg();
+		cJSON *pRootPollMsg = NULL;
+		stPolledUpdate stUpdate;
+		bool bIsBinary = CPolledUpdateCodec::isPolledUpdate(sPollMsg.data(), sPollMsg.size());
+		if(true == bIsBinary)
 		{
-			DO_LOG_ERROR(a_stPollWrData.m_oPollData.getStrMsg() + ": Message could not be parsed in json format");
-			return "";
+			if(false == CPolledUpdateCodec::decode(sPollMsg.data(), sPollMsg.size(), stUpdate))
+			{
+				DO_LOG_ERROR("Binary poll message could not be decoded");
+				return "";
+			}
+		}
+		else
+		{
+			pRootPollMsg = cJSON_Parse(sPollMsg.c_str());
+			if (NULL == pRootPollMsg)
+			{
+				DO_LOG_ERROR(sPollMsg + ": Message could not be parsed in json format");
+				return "";
+			}
 		}
 
+		// binary poll message has no JSON tree, its fields are read from decoded update
+		auto answerPoll = [&](const std::string &a_sSrcKey, std::string a_sFinalKey)
+		{
+			if(true == bIsBinary)
+			{
+				std::string sData;
+				if(true == CPolledUpdateCodec::getField(stUpdate, a_sSrcKey, sData))
+				{
+					addFieldToMsg(sMsg, a_sFinalKey, sData, false);
+				}
+				else
+				{
+					DO_LOG_DEBUG(a_sSrcKey + ": Key not found in message");
+				}
+				return;
+			}
+			answer(sMsg, pRootPollMsg, a_sSrcKey, a_sFinalKey, false);
+		};
+
 		// Process poll message
-		answer(sMsg, pRootPollMsg,	"driver_seq",	"pollSeq",	 	false);
-		answer(sMsg, pRootPollMsg,	"data_topic",	"pollTopic", 	false);
-		answer(sMsg, pRootPollMsg,	"realtime",		"pollRT", 	false);
-		answer(sMsg, pRootPollMsg, 	"status", 		"pollStatus", 	false);
-		answer(sMsg, pRootPollMsg, 	"value", 		"pollValue", 	false);
-		answer(sMsg, pRootPollMsg, 	"error_code",	"pollError", 	false);
-		answer(sMsg, pRootPollMsg, 	"tsPollingTime", 		"tsPollingTime", 		false);
-		answer(sMsg, pRootPollMsg, 	"reqRcvdInStack", 		"pollReqRcvdInStack", 	false);
-		answer(sMsg, pRootPollMsg, 	"reqSentByStack", 		"pollReqSentByStack", 	false);
-		answer(sMsg, pRootPollMsg, 	"respRcvdByStack", 		"pollRespRcvdByStack", 	false);
-		answer(sMsg, pRootPollMsg, 	"respPostedByStack", 	"pollRespPostedByStack",false);
-		answer(sMsg, pRootPollMsg, 	"usec",				 	"pollRespPostedToEII",false);
-		answer(sMsg, pRootPollMsg, 	"tsMsgRcvdForProcessing","pollDataRcvdInExport",false);
-		answer(sMsg, pRootPollMsg, 	"tsMsgReadyForPublish",	"pollDataPostedToMQTT",	false);
+		answerPoll("driver_seq",	"pollSeq");
+		answerPoll("data_topic",	"pollTopic");
+		answerPoll("realtime",		"pollRT");
+		answerPoll("status", 		"pollStatus");
+		answerPoll("value", 		"pollValue");
+		answerPoll("error_code",	"pollError");
+		answerPoll("tsPollingTime", 		"tsPollingTime");
+		answerPoll("reqRcvdInStack", 		"pollReqRcvdInStack");
+		answerPoll("reqSentByStack", 		"pollReqSentByStack");
+		answerPoll("respRcvdByStack", 		"pollRespRcvdByStack");
+		answerPoll("respPostedByStack", 	"pollRespPostedByStack");
+		answerPoll("usec",				 	"pollRespPostedToEII");
+		answerPoll("tsMsgRcvdForProcessing","pollDataRcvdInExport");
+		answerPoll("tsMsgReadyForPublish",	"pollDataPostedToMQTT");
 
-		cJSON_Delete(pRootPollMsg);
-		pRootPollMsg = NULL;
+		if(NULL != pRootPollMsg)
+		{
+			cJSON_Delete(pRootPollMsg);
+			pRootPollMsg = NULL;
+		}
 		
 		addFieldToMsg(sMsg, "pollDataRcvdInApp", (std::to_string(commonUtilKPI::get_micros(a_stPollWrData.m_oPollData.getTimestamp()))).c_str(), false);
 		addFieldToMsg(sMsg, "wrReqCreation", (std::to_string(commonUtilKPI::get_micros(a_stPollWrData.m_tsStartWrReqCreate))).c_str(), false);
@@ -605,6 +605,33 @@ bool CControlLoopMapper::destroySubCtx()
 	return retVal;
 }
 
+/**
+ * Resolves EMB publisher handle of write topic for every control loop.
+ * Needs to be called once EII contexts are prepared.
+ * @param a_bIsRTWrite	[in]: It indicates whether write op is RT
+ * @return true/false based on success/failure
+ */
+bool CControlLoopMapper::resolveEMBPubHandles(bool a_bIsRTWrite)
+{
+	bool bRet = true;
+	std::string sWrRT{a_bIsRTWrite ? "1" : "0"};
+	for (auto& itr : m_oControlLoopMap) 
+	{
+		for (auto& rCtrlLoop : itr.second) 
+		{
+			std::string sEMBTopic = mapMqttToEMBRespTopic(rCtrlLoop.getWritePoint() + "/write", sWrRT);
+			zmq_handler::stZmqPubHandle *pPubHandle = zmq_handler::getPubHandle(sEMBTopic);
+			if(NULL == pPubHandle)
+			{
+				DO_LOG_ERROR(sEMBTopic + ": Publisher could not be resolved for control loop " + rCtrlLoop.getMyID());
+				bRet = false;
+			}
+			rCtrlLoop.setEMBPubHandle(pPubHandle);
+		}
+	}
+	return bRet;
+}
+
 /**
  * Stops control loop threads
  * @return true/false based on success/failure
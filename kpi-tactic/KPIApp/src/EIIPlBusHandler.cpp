@@ -27,6 +27,9 @@
 #include "Logger.hpp"
 #include "Common.hpp"
 #include "ZmqHandler.hpp"
+#include "JsonEnvelope.hpp"
+#include "EmbBatch.hpp"
+#include "PolledUpdate.hpp"
 
 extern std::atomic<bool> g_stopThread;
 
@@ -106,6 +109,38 @@ bool CEIIPlBusHandler::processMsg(msg_envelope_t *msg, CQueueHandler &a_rQ,
 			return false;
 		}
 
+		CEmbBatchReader oReader;
+		if(true == oReader.open(msg))
+		{
+			// each entry of batch is a serialized message along with its data topic
+			stEmbBatchEntry stEntry;
+			while(true == oReader.next(stEntry))
+			{
+				CMessageObject oMsg{std::string(stEntry.m_pTopic, stEntry.m_u16TopicLen),
+					std::string(stEntry.m_pMsg, stEntry.m_u32MsgLen)};
+				a_rQ.pushMsg(oMsg);
+				bRetVal = true;
+			}
+			return bRetVal;
+		}
+
+		// binary polled update is queued as it is, along with its data topic
+		if(true == CPolledUpdateCodec::isPolledUpdate(msg))
+		{
+			msg_envelope_elem_body_t *pBlob = NULL;
+			thread_local stPolledUpdate stUpdate;
+			if((MSG_SUCCESS != msgbus_msg_envelope_get(msg, NULL, &pBlob)) || (NULL == pBlob)
+					|| (false == CPolledUpdateCodec::decode(msg, stUpdate)))
+			{
+				DO_LOG_ERROR("Binary update could not be decoded");
+				return false;
+			}
+			CMessageObject oMsg{stUpdate.m_sDataTopic,
+				std::string(pBlob->body.blob->data, pBlob->body.blob->len)};
+			a_rQ.pushMsg(oMsg);
+			return true;
+		}
+
 		msg_envelope_elem_body_t* data;
 		msgbus_ret_t msgRet = msgbus_msg_envelope_get(msg, "data_topic", &data);
 		if(msgRet != MSG_SUCCESS)
@@ -230,64 +265,34 @@ void CEIIPlBusHandler::listenOnEII(std::string sTopic, zmq_handler::stZmqContext
 /**
  * publish message to EMB
  * @param a_sEMBMsg :[in] message to publish on EMB
- * @param a_sEMBTopic :[in] emb topic
+ * @param a_pPubHandle :[in] publisher handle of emb topic
  * @return true/false based on success/failure
  */
-bool CEIIPlBusHandler::publishEMBMsg(std::string a_sEMBMsg, std::string &a_sEMBTopic)
+bool CEIIPlBusHandler::publishEMBMsg(std::string a_sEMBMsg, zmq_handler::stZmqPubHandle *a_pPubHandle)
 {
+	// converter reuses its buffers, hence one converter per thread
+	static thread_local CJsonToEnvelope oConverter;
+
 	// Creating message to be published
 	msg_envelope_t *msg = NULL;
-	cJSON *root = NULL;
 
 	try
 	{
-		msg = msgbus_msg_envelope_new(CT_JSON);
-		if(msg == NULL)
+		if(NULL == a_pPubHandle)
 		{
+			DO_LOG_ERROR("Publisher is not available for write msg: " + a_sEMBMsg);
 			return false;
 		}
-		//Get the context for this EMB PUB topic
-		zmq_handler::prepareContext(true, (zmq_handler::getPubCtxCfg()).m_pub_msgbus_ctx, a_sEMBTopic, (zmq_handler::getPubCtxCfg()).m_pub_config);		
-		//parse from root element
-		root = cJSON_Parse(a_sEMBMsg.c_str());
-		if (NULL == root)
+		msg = oConverter.convert(a_sEMBMsg);
+		if(msg == NULL)
 		{
-			if(msg != NULL)
-			{
-				msgbus_msg_envelope_destroy(msg);
-			}
 			return false;
 		}
 
-		cJSON *device = root->child;
-		while (device)
-		{
-			if(cJSON_IsString(device))
-			{
-				msg_envelope_elem_body_t *value = msgbus_msg_envelope_new_string(
-						device->valuestring);
-				if(value != NULL)
-				{
-					msgbus_msg_envelope_put(msg, device->string, value);
-				}
-			}
-			else
-			{
-				throw std::string("Invalid JSON");
-			}
-			device = device->next;
-		}
-
-		if (root)
-		{
-			cJSON_Delete(root);
-			root = NULL;
-		}
-
 		//add time stamp before publishing msg on EII
 		std::string strTsReceived{""};
 		bool bRet = true;
-		if(true == zmq_handler::publishJson(strTsReceived, msg, a_sEMBTopic, "tsMsgPublishOnEII"))
+		if(true == zmq_handler::publishJson(strTsReceived, msg, a_pPubHandle, "tsMsgPublishOnEII"))
 		{
 			bRet = true;
 		}
@@ -303,10 +308,6 @@ bool CEIIPlBusHandler::publishEMBMsg(std::string a_sEMBMsg, std::string &a_sEMBT
 
 		return bRet;
 	}
-	catch(std::string& strException)
-	{
-		DO_LOG_ERROR("publishEMBMsg error1::" + strException);
-	}
 	catch(std::exception &ex)
 	{
 		DO_LOG_ERROR("publishEMBMsg error2::" + std::string(ex.what()));
@@ -316,10 +317,6 @@ bool CEIIPlBusHandler::publishEMBMsg(std::string a_sEMBMsg, std::string &a_sEMBT
 	{
 		msgbus_msg_envelope_destroy(msg);
 	}
-	if (root)
-	{
-		cJSON_Delete(root);
-	}
 
 	return false;
 }
@@ -77,6 +77,10 @@ void PlBusMgr::initPlatformBusHandler(bool a_bIsMQTTMode)
 			// It is ZMQ mode. Prepare contexts and create threads
 			getEIIPlBusHandler().initEIIContext();
 
+			// publisher handles are resolved once, write requests use them as is
+			CKPIAppConfig::getInstance().getControlLoopMapper().resolveEMBPubHandles(
+				CKPIAppConfig::getInstance().isRTModeForWriteOp());
+
 			getEIIPlBusHandler().configEIIListerners(CKPIAppConfig::getInstance().isRTModeForPolledPoints(),
 				CKPIAppConfig::getInstance().isRTModeForWriteOp());
 		}
@@ -157,8 +161,7 @@ bool PlBusMgr::publishWriteReq(const CControlLoopOp& a_rCtrlLoop,
 		}
 		else
 		{
-			sPubTopic = mapMqttToEMBRespTopic(sPubTopic,sWrRT);
-			return getEIIPlBusHandler().publishEMBMsg(sMsg,sPubTopic);
+			return getEIIPlBusHandler().publishEMBMsg(sMsg, a_rCtrlLoop.getEMBPubHandle());
 		}
 	}
 	catch(const std::exception& e)
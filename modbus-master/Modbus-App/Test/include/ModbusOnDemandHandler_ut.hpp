@@ -66,6 +66,7 @@ public:
 	std::string strTopic = "";
 
 	MbusAPI_t stMbusApiPram;
+	stOnDemandReqView stReqView;
 
 	eMbusAppErrorCode eFunRetType = APP_SUCCESS;
 
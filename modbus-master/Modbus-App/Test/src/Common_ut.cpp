@@ -21,6 +21,12 @@
 *********************************************************************************/
 
 #include "../include/Common_ut.hpp"
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <iostream>
+#include <functional>
+#include <atomic>
 
 
 void Common_ut::SetUp()
@@ -199,6 +205,199 @@ TEST_F(Common_ut, HextoUnsignedInt_empty)
 	EXPECT_EQ(0, convertedValue);
 }
 
+/**
+ * Test case to check that bytesToRawValue() orders bytes in same way as swapConversion()
+ * @param :[in] None
+ * @param :[out] None
+ * @return None
+ */
+TEST_F(Common_ut, bytesToRawValue_SameAsSwapConversion)
+{
+	Vec = {0x01, 0x02, 0x03, 0x04};
+
+	EXPECT_EQ(common_Handler::hexBytesToUnsignedLongLongInt(common_Handler::swapConversion(Vec, false, false)),
+			common_Handler::bytesToRawValue(Vec, false, false));
+	EXPECT_EQ(common_Handler::hexBytesToUnsignedLongLongInt(common_Handler::swapConversion(Vec, true, false)),
+			common_Handler::bytesToRawValue(Vec, true, false));
+	EXPECT_EQ(common_Handler::hexBytesToUnsignedLongLongInt(common_Handler::swapConversion(Vec, false, true)),
+			common_Handler::bytesToRawValue(Vec, false, true));
+	EXPECT_EQ(common_Handler::hexBytesToUnsignedLongLongInt(common_Handler::swapConversion(Vec, true, true)),
+			common_Handler::bytesToRawValue(Vec, true, true));
+}
+
+/**
+ * Test case to check bytesToRawValue() when value does not fit in 8 bytes
+ * @param :[in] None
+ * @param :[out] None
+ * @return None
+ */
+TEST_F(Common_ut, bytesToRawValue_TooLong)
+{
+	Vec.assign(10, 0xFF);
+	EXPECT_EQ(0, common_Handler::bytesToRawValue(Vec, false, false));
+	EXPECT_EQ(0, common_Handler::bytesToRawValue(EmptyVec, false, false));
+}
 
+/**
+ * Test case to check decoder selection as per datatype and width
+ * @param :[in] None
+ * @param :[out] None
+ * @return None
+ */
+TEST_F(Common_ut, getValueDecoder_DataTypeAndWidth)
+{
+	EXPECT_EQ(enDECODE_INT16, common_Handler::getValueDecoder("INT", 1, false, false, 1.0).m_eDecodeType);
+	EXPECT_EQ(enDECODE_UINT32, common_Handler::getValueDecoder("uint", 2, false, false, 1.0).m_eDecodeType);
+	EXPECT_EQ(enDECODE_DOUBLE, common_Handler::getValueDecoder("double", 4, false, false, 1.0).m_eDecodeType);
+	EXPECT_EQ(enDECODE_STRING, common_Handler::getValueDecoder("string", 3, false, false, 1.0).m_eDecodeType);
+	EXPECT_EQ(enDECODE_INVALID, common_Handler::getValueDecoder("float", 1, false, false, 1.0).m_eDecodeType);
+}
 
 
+/**
+ * Benchmark of on-demand request table with concurrent request streams.
+ * Each stream inserts, reads and removes its own requests as listener and
+ * response threads do. Time taken is compared with a single map guarded by
+ * one mutex where request with owning string fields is copied in and out,
+ * which was used earlier. Times are recorded as test properties.
+ * It is disabled by default, run it with --gtest_also_run_disabled_tests.
+ * @param :[in] None
+ * @param :[out] None
+ * @return None
+ */
+TEST_F(Common_ut, DISABLED_reqDataTable_ConcurrentStreams)
+{
+	const int iStreamCount = 8;
+	const int iReqPerStream = 20000;
+	const size_t uiInitialCount = common_Handler::getReqDataCount();
+
+	MbusAPI_t stTemplate;
+	common_Handler::copyEchoField(stTemplate.m_stOnDemandReqData.m_szAppSeq, "1234567890");
+	stTemplate.m_stOnDemandReqData.m_svTopic = "/flowmeter/PL0/D1";
+	stTemplate.m_stOnDemandReqData.m_svWellhead = "PL0";
+	stTemplate.m_stOnDemandReqData.m_svMetric = "D1";
+	common_Handler::copyEchoField(stTemplate.m_stOnDemandReqData.m_szMqttTime, "1581488055204186");
+	common_Handler::copyEchoField(stTemplate.m_stOnDemandReqData.m_szEiiTime, "1581488055204186");
+
+	// earlier request: echo fields are owning strings
+	struct stBaselineReq
+	{
+		unsigned short m_u16TxId;
+		unsigned char m_pu8Data[260];
+		std::string m_strAppSeq;
+		std::string m_strWellhead;
+		std::string m_strMetric;
+		std::string m_strTopic;
+		std::string m_strMqttTime;
+		std::string m_strEiiTime;
+	};
+	stBaselineReq stBaselineTemplate{0, {0}, "1234567890", "PL0", "D1", "/flowmeter/PL0/D1",
+		"1581488055204186", "1581488055204186"};
+
+	// earlier implementation: one map and one mutex, request copied in and out
+	std::map<unsigned short, stBaselineReq> mapBaseline;
+	std::mutex mutexBaseline;
+	auto fnBaseline = [&](int a_iStream)
+	{
+		for(int iIndex = 0; iIndex < iReqPerStream; iIndex++)
+		{
+			unsigned short u16TxID = (unsigned short)(a_iStream + iIndex * iStreamCount);
+			stBaselineReq stReq = stBaselineTemplate;
+			stReq.m_u16TxId = u16TxID;
+			{
+				std::unique_lock<std::mutex> lck(mutexBaseline);
+				mapBaseline.insert(std::pair<unsigned short, stBaselineReq>(u16TxID, stReq));
+			}
+			stBaselineReq stResp;
+			{
+				std::unique_lock<std::mutex> lck(mutexBaseline);
+				stResp = mapBaseline.at(u16TxID);
+			}
+			std::unique_lock<std::mutex> lck(mutexBaseline);
+			mapBaseline.erase(u16TxID);
+		}
+	};
+
+	std::atomic<int> iMismatch{0};
+	auto fnSharded = [&](int a_iStream)
+	{
+		for(int iIndex = 0; iIndex < iReqPerStream; iIndex++)
+		{
+			unsigned short u16TxID = (unsigned short)(a_iStream + iIndex * iStreamCount);
+			MbusAPI_t stReq = stTemplate;
+			stReq.m_u16TxId = u16TxID;
+			common_Handler::insertReqData(u16TxID, std::move(stReq));
+
+			common_Handler::reqDataHandle_t pReq = common_Handler::getReqData(u16TxID);
+			if(NULL == pReq || u16TxID != pReq->m_u16TxId)
+			{
+				iMismatch++;
+			}
+			common_Handler::removeReqData(u16TxID);
+		}
+	};
+
+	auto fnRun = [&](std::function<void(int)> a_fnStream)
+	{
+		std::vector<std::thread> vThreads;
+		auto tpStart = std::chrono::steady_clock::now();
+		for(int iStream = 0; iStream < iStreamCount; iStream++)
+		{
+			vThreads.emplace_back(a_fnStream, iStream);
+		}
+		for(auto &th : vThreads)
+		{
+			th.join();
+		}
+		return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - tpStart).count();
+	};
+
+	RecordProperty("single_mutex_map_us", std::to_string(fnRun(fnBaseline)));
+	RecordProperty("sharded_table_us", std::to_string(fnRun(fnSharded)));
+
+	EXPECT_EQ(0, iMismatch.load());
+	EXPECT_EQ(true, mapBaseline.empty());
+	EXPECT_EQ(uiInitialCount, common_Handler::getReqDataCount());
+}
+
+/**
+ * Test case to check handle of on-demand request remains valid after request is removed
+ * @param :[in] None
+ * @param :[out] None
+ * @return None
+ */
+TEST_F(Common_ut, reqDataTable_HandleOutlivesRemove)
+{
+	MbusAPI_t stReq;
+	stReq.m_u16TxId = 65000;
+	common_Handler::copyEchoField(stReq.m_stOnDemandReqData.m_szAppSeq, "42");
+	EXPECT_EQ(true, common_Handler::insertReqData(65000, std::move(stReq)));
+
+	common_Handler::reqDataHandle_t pReq = common_Handler::getReqData(65000);
+	ASSERT_NE((MbusAPI_t*)NULL, pReq.get());
+
+	common_Handler::reqDataHandle_t pRemoved = common_Handler::removeReqData(65000);
+	EXPECT_EQ(pReq.get(), pRemoved.get());
+	EXPECT_EQ((MbusAPI_t*)NULL, common_Handler::getReqData(65000).get());
+	EXPECT_EQ((MbusAPI_t*)NULL, common_Handler::removeReqData(65000).get());
+	EXPECT_STREQ("42", pReq->m_stOnDemandReqData.m_szAppSeq);
+}
+
+/**
+ * Test case to check echoed request field is copied to fixed size buffer and truncated if longer
+ * @param :[in] None
+ * @param :[out] None
+ * @return None
+ */
+TEST_F(Common_ut, copyEchoField_Truncate)
+{
+	stOnDemandRequest stReqData{};
+	EXPECT_EQ(true, common_Handler::copyEchoField(stReqData.m_szAppSeq, "1234"));
+	EXPECT_STREQ("1234", stReqData.m_szAppSeq);
+
+	std::string strLong(ONDEMAND_ECHO_FIELD_LEN + 10, 'a');
+	EXPECT_EQ(false, common_Handler::copyEchoField(stReqData.m_szAppSeq, strLong));
+	EXPECT_EQ((size_t)(ONDEMAND_ECHO_FIELD_LEN - 1), strlen(stReqData.m_szAppSeq));
+
+	EXPECT_EQ(false, common_Handler::copyEchoField(NULL, "1234"));
+}
@@ -56,22 +56,23 @@ TEST_F(ModbusOnDemandHandler_ut, jsonParserForOnDemandRequest_InvServiceReq)
 	stMbusApiPram.m_stOnDemandReqData.m_isWordSwap				= false;
 	 stMbusApiPram.m_stOnDemandReqData.m_obtReqRcvdTS.tv_nsec	= 21132323;
 	stMbusApiPram.m_stOnDemandReqData.m_obtReqRcvdTS.tv_sec		= 1;
-	stMbusApiPram.m_stOnDemandReqData.m_strAppSeq				= "455";
-	stMbusApiPram.m_stOnDemandReqData.m_strEiiTime				= "2020-03-31 12:34:56";
-	stMbusApiPram.m_stOnDemandReqData.m_strMetric				= "Flow";
-	stMbusApiPram.m_stOnDemandReqData.m_strMqttTime				= "2020-03-13 12:34:56";
-	stMbusApiPram.m_stOnDemandReqData.m_strTopic				= "RT/read/flowmeter/PL0/Flow";
-	stMbusApiPram.m_stOnDemandReqData.m_strVersion				= "2.1";
-	stMbusApiPram.m_stOnDemandReqData.m_strWellhead				= "PL0";
-	stMbusApiPram.m_stOnDemandReqData.m_sUsec					= "0";
-	stMbusApiPram.m_stOnDemandReqData.m_sTimestamp				= "0:0:0";
+	stReqView.m_svAppSeq			= "455";
+	stReqView.m_svEiiTime			= "2020-03-31 12:34:56";
+	stReqView.m_svMetric			= "Flow";
+	stReqView.m_svMqttTime			= "2020-03-13 12:34:56";
+	stReqView.m_svTopic				= "RT/read/flowmeter/PL0/Flow";
+	stReqView.m_svVersion			= "2.1";
+	stReqView.m_svWellhead			= "PL0";
+	stReqView.m_svUsec				= "0";
+	stReqView.m_svTimestamp			= "0:0:0";
 	fprintf(stderr, "\n Green 2 \n");
 	bool isWrite = false;
 
 	try
 	{
 		fprintf(stderr, "\n Green 3 \n");
-		eFunRetType = onDemandHandler::Instance().jsonParserForOnDemandRequest(stMbusApiPram,
+		eFunRetType = onDemandHandler::Instance().jsonParserForOnDemandRequest(stReqView,
+				stMbusApiPram,
 				m_u8FunCode,
 				stMbusApiPram.m_u16TxId,
 				isWrite);
@@ -94,23 +95,24 @@ TEST_F(ModbusOnDemandHandler_ut, jsonParserForOnDemandRequest_InvalidTopicMsg)
 {
 
 	stMbusApiPram.m_u16TxId = PublishJsonHandler::instance().getTxId();
-	stMbusApiPram.m_stOnDemandReqData.m_strAppSeq = "1234";
-	stMbusApiPram.m_stOnDemandReqData.m_strMetric =  "D1";
-	stMbusApiPram.m_stOnDemandReqData.m_sValue = "0X00";
-	stMbusApiPram.m_stOnDemandReqData.m_strWellhead = "PL0";
-	stMbusApiPram.m_stOnDemandReqData.m_strVersion = "version";
-	stMbusApiPram.m_stOnDemandReqData.m_strTopic = "Invalid";
-	stMbusApiPram.m_stOnDemandReqData.m_sTimestamp = "2020-02-12 06:14:15";
-	stMbusApiPram.m_stOnDemandReqData.m_sUsec = "1581488055204186";
-	stMbusApiPram.m_stOnDemandReqData.m_strMqttTime = "2020-03-13 12:34:56";
-	stMbusApiPram.m_stOnDemandReqData.m_strEiiTime = "2020-03-31 12:34:56";
+	stReqView.m_svAppSeq = "1234";
+	stReqView.m_svMetric =  "D1";
+	stReqView.m_svValue = "0X00";
+	stReqView.m_svWellhead = "PL0";
+	stReqView.m_svVersion = "version";
+	stReqView.m_svTopic = "Invalid";
+	stReqView.m_svTimestamp = "2020-02-12 06:14:15";
+	stReqView.m_svUsec = "1581488055204186";
+	stReqView.m_svMqttTime = "2020-03-13 12:34:56";
+	stReqView.m_svEiiTime = "2020-03-31 12:34:56";
 	stMbusApiPram.m_stOnDemandReqData.m_isRT = true;
 	stMbusApiPram.m_nRetry = 1;
 	stMbusApiPram.m_lPriority = 1;
 
 	try
 	{
-		eFunRetType = onDemandHandler::Instance().jsonParserForOnDemandRequest(stMbusApiPram,
+		eFunRetType = onDemandHandler::Instance().jsonParserForOnDemandRequest(stReqView,
+				stMbusApiPram,
 				m_u8FunCode,
 				16,
 				true);
@@ -135,21 +137,21 @@ TEST_F(ModbusOnDemandHandler_ut, jsonParserForOnDemandRequest_ValidIpJason)
 {
 
 	stMbusApiPram.m_u16TxId = PublishJsonHandler::instance().getTxId();
-	stMbusApiPram.m_stOnDemandReqData.m_strAppSeq = "1234";
-	stMbusApiPram.m_stOnDemandReqData.m_strMetric =  "D1";
-	stMbusApiPram.m_stOnDemandReqData.m_sValue = "0X00";
-	stMbusApiPram.m_stOnDemandReqData.m_strWellhead = "PL0";
-	stMbusApiPram.m_stOnDemandReqData.m_strVersion = "version";
+	stReqView.m_svAppSeq = "1234";
+	stReqView.m_svMetric =  "D1";
+	stReqView.m_svValue = "0X00";
+	stReqView.m_svWellhead = "PL0";
+	stReqView.m_svVersion = "version";
 #ifdef MODBUS_STACK_TCPIP_ENABLED
-	stMbusApiPram.m_stOnDemandReqData.m_strTopic = "/flowmeter/PL0/D1/read";
+	stReqView.m_svTopic = "/flowmeter/PL0/D1/read";
 #else
-	stMbusApiPram.m_stOnDemandReqData.m_strTopic = "/iou/PL0/D1/read";
+	stReqView.m_svTopic = "/iou/PL0/D1/read";
 #endif
-	stMbusApiPram.m_stOnDemandReqData.m_sTimestamp = "2020-02-12 06:14:15";
-	stMbusApiPram.m_stOnDemandReqData.m_sUsec = "1581488055204186";
-	stMbusApiPram.m_stOnDemandReqData.m_strMqttTime = "2020-03-13 12:34:56";
-	stMbusApiPram.m_stOnDemandReqData.m_strEiiTime = "2020-03-31 12:34:56";
-	stMbusApiPram.m_stOnDemandReqData.m_strAppSeq = "1";
+	stReqView.m_svTimestamp = "2020-02-12 06:14:15";
+	stReqView.m_svUsec = "1581488055204186";
+	stReqView.m_svMqttTime = "2020-03-13 12:34:56";
+	stReqView.m_svEiiTime = "2020-03-31 12:34:56";
+	stReqView.m_svAppSeq = "1";
 	stMbusApiPram.m_stOnDemandReqData.m_isRT = true;
 	stMbusApiPram.m_nRetry = 1;
 	stMbusApiPram.m_lPriority = 1;
@@ -157,7 +159,8 @@ TEST_F(ModbusOnDemandHandler_ut, jsonParserForOnDemandRequest_ValidIpJason)
 
 	try
 	{
-		eFunRetType = onDemandHandler::Instance().jsonParserForOnDemandRequest(stMbusApiPram,
+		eFunRetType = onDemandHandler::Instance().jsonParserForOnDemandRequest(stReqView,
+				stMbusApiPram,
 				m_u8FunCode,
 				16,
 				true);
@@ -324,55 +327,6 @@ TEST_F(ModbusOnDemandHandler_ut, hex2bin_InvalidInputString)
 }
 
 
-/**
- * checks the behaviour of the validateInputJson() with a valid jason string
- * @param :[in] None
- * @param :[out] None
- * @return None
- */
-TEST_F(ModbusOnDemandHandler_ut, validateInputJson_ValidJason)
-{
-
-	try
-	{
-		bool Value = onDemandHandler::Instance().validateInputJson("/flowmeter/PL0/D1/read",
-				"PL0",
-				"D1");
-
-		EXPECT_EQ(true, Value);
-	}
-	catch(std::exception &e)
-	{
-		EXPECT_EQ(" ", (string)e.what());
-
-	}
-
-}
-
-/**
- * checks the behaviour of the validateInputJson() with a invalid jason string
- * @param :[in] None
- * @param :[out] None
- * @return None
- */
-TEST_F(ModbusOnDemandHandler_ut, validateInputJson_InValidJason)
-{
-
-	try
-	{
-		bool Value = onDemandHandler::Instance().validateInputJson("/flowmeter/PL0/D1/read",
-				"Invalid",
-				"D1");
-
-		EXPECT_EQ(false, Value);
-	}
-	catch(std::exception &e)
-	{
-		EXPECT_EQ(" ", (string)e.what());
-
-	}
-
-}
 /**
  * checks the behaviour of the createErrorResponse() with non RT response
  * @param :[in] None
@@ -387,11 +341,10 @@ TEST_F(ModbusOnDemandHandler_ut, createErrorResponseNonRT)
 	reqData.m_isWordSwap = false;
 	reqData.m_obtReqRcvdTS.tv_nsec = 21132323;
 	reqData.m_obtReqRcvdTS.tv_sec = 1;
-	reqData.m_strAppSeq = "455";
-	reqData.m_strMetric = "Test";
-	reqData.m_strTopic = "kzdjfhdszh";
-	reqData.m_strVersion = "2.1";
-	reqData.m_strWellhead = "test";
+	common_Handler::copyEchoField(reqData.m_szAppSeq, "455");
+	reqData.m_svMetric = "Test";
+	reqData.m_svTopic = "kzdjfhdszh";
+	reqData.m_svWellhead = "test";
 
 	try
 	{
@@ -419,11 +372,10 @@ TEST_F(ModbusOnDemandHandler_ut, createErrorResponseRt)
 	reqData.m_isWordSwap = false;
 	reqData.m_obtReqRcvdTS.tv_nsec = 21132323;
 	reqData.m_obtReqRcvdTS.tv_sec = 1;
-	reqData.m_strAppSeq = "455";
-	reqData.m_strMetric = "Test";
-	reqData.m_strTopic = "kzdjfhdszh";
-	reqData.m_strVersion = "2.1";
-	reqData.m_strWellhead = "test";
+	common_Handler::copyEchoField(reqData.m_szAppSeq, "455");
+	reqData.m_svMetric = "Test";
+	reqData.m_svTopic = "kzdjfhdszh";
+	reqData.m_svWellhead = "test";
 
 	try
 	{
@@ -448,6 +400,7 @@ TEST_F(ModbusOnDemandHandler_ut, OnDemandInfoHandler_MbusAPI_tNULL)
 
 
 	eMbusAppErrorCode_variable = onDemandHandler::Instance().onDemandInfoHandler(NULL,
+			stReqView,
 			"Topic",
 			(void *)0x01,
 			false);
@@ -469,6 +422,7 @@ TEST_F(ModbusOnDemandHandler_ut, OnDemandInfoHandler_CallbackNULL)
 
 
 	eMbusAppErrorCode_variable = onDemandHandler::Instance().onDemandInfoHandler(&MbusAPI_t_obj,
+			stReqView,
 			"Topic",
 			NULL,
 			false);
@@ -549,3 +503,329 @@ TEST_F(ModbusOnDemandHandler_ut, ScaledValuToHex_uint)
 
 
 
+
+/**
+ * Test case to check contiguous register writes are coalesced in one write multiple registers request
+ * and write to same address is kept in separate request
+ * @param :[in] None
+ * @param :[out] None
+ * @return None
+ */
+TEST_F(ModbusOnDemandHandler_ut, coalesceWrites_ContiguousRegisters)
+{
+	std::vector<stCoalescedWrite> vWrites;
+	stCoalescedWrite stWrite{};
+	stWrite.m_u8FunCode = WRITE_SINGLE_REG;
+	stWrite.m_stMbusApiPram.m_u16Quantity = 1;
+
+	// arrival order: 11, 10, 12 (2 registers), 10
+	uint16_t au16Addr[] = {11, 10, 12, 10};
+	for(uint16_t u16Index = 0; u16Index < 4; u16Index++)
+	{
+		stWrite.m_stMbusApiPram.m_u16TxId = u16Index + 1;
+		stWrite.m_stMbusApiPram.m_u16StartAddr = au16Addr[u16Index];
+		stWrite.m_stMbusApiPram.m_pu8Data[0] = (unsigned char)(u16Index + 1);
+		vWrites.push_back(stWrite);
+	}
+	vWrites[2].m_u8FunCode = WRITE_MULTIPLE_REG;
+	vWrites[2].m_stMbusApiPram.m_u16Quantity = 2;
+
+	std::vector<std::vector<stCoalescedWrite>> vRuns;
+	onDemandHandler::Instance().groupContiguousWrites(vWrites, vRuns);
+
+	// {10, 11, 12-13} and second write of 10
+	ASSERT_EQ(2, vRuns.size());
+	ASSERT_EQ(3, vRuns[0].size());
+	EXPECT_EQ(2, vRuns[0][0].m_stMbusApiPram.m_u16TxId);
+	EXPECT_EQ(1, vRuns[0][1].m_stMbusApiPram.m_u16TxId);
+	EXPECT_EQ(3, vRuns[0][2].m_stMbusApiPram.m_u16TxId);
+	ASSERT_EQ(1, vRuns[1].size());
+	EXPECT_EQ(4, vRuns[1][0].m_stMbusApiPram.m_u16TxId);
+
+	MbusAPI_t stMbusApi;
+	unsigned char u8FunCode = 0;
+	EXPECT_EQ(true, onDemandHandler::Instance().buildCoalescedRequest(vRuns[0], stMbusApi, u8FunCode));
+	EXPECT_EQ(WRITE_MULTIPLE_REG, u8FunCode);
+	EXPECT_EQ(10, stMbusApi.m_u16StartAddr);
+	EXPECT_EQ(4, stMbusApi.m_u16Quantity);
+	EXPECT_EQ(8, stMbusApi.m_u16ByteCount);
+	EXPECT_EQ(2, stMbusApi.m_pu8Data[0]);
+	EXPECT_EQ(1, stMbusApi.m_pu8Data[2]);
+	EXPECT_EQ(3, stMbusApi.m_pu8Data[4]);
+}
+
+/**
+ * Test case to check that write which overlaps an earlier write is sent after it,
+ * even when it starts at lower address
+ * @param :[in] None
+ * @param :[out] None
+ * @return None
+ */
+TEST_F(ModbusOnDemandHandler_ut, coalesceWrites_OverlapKeepsArrivalOrder)
+{
+	std::vector<stCoalescedWrite> vWrites;
+	stCoalescedWrite stWrite{};
+	stWrite.m_u8FunCode = WRITE_SINGLE_REG;
+	stWrite.m_stMbusApiPram.m_u16TxId = 1;
+	stWrite.m_stMbusApiPram.m_u16StartAddr = 5;
+	stWrite.m_stMbusApiPram.m_u16Quantity = 1;
+	vWrites.push_back(stWrite);
+
+	stWrite.m_u8FunCode = WRITE_MULTIPLE_REG;
+	stWrite.m_stMbusApiPram.m_u16TxId = 2;
+	stWrite.m_stMbusApiPram.m_u16StartAddr = 4;
+	stWrite.m_stMbusApiPram.m_u16Quantity = 2;
+	vWrites.push_back(stWrite);
+
+	std::vector<std::vector<stCoalescedWrite>> vRuns;
+	onDemandHandler::Instance().groupContiguousWrites(vWrites, vRuns);
+
+	ASSERT_EQ(2, vRuns.size());
+	ASSERT_EQ(1, vRuns[0].size());
+	EXPECT_EQ(1, vRuns[0][0].m_stMbusApiPram.m_u16TxId);
+	ASSERT_EQ(1, vRuns[1].size());
+	EXPECT_EQ(2, vRuns[1][0].m_stMbusApiPram.m_u16TxId);
+}
+
+/**
+ * Test case to check contiguous coil writes are packed in one write multiple coils request
+ * @param :[in] None
+ * @param :[out] None
+ * @return None
+ */
+TEST_F(ModbusOnDemandHandler_ut, coalesceWrites_Coils)
+{
+	std::vector<stCoalescedWrite> vRun;
+	stCoalescedWrite stWrite{};
+	stWrite.m_u8FunCode = WRITE_SINGLE_COIL;
+	stWrite.m_stMbusApiPram.m_u16Quantity = 1;
+
+	// coils 5 to 13, odd ones are ON
+	for(uint16_t u16Index = 0; u16Index < 9; u16Index++)
+	{
+		stWrite.m_stMbusApiPram.m_u16StartAddr = 5 + u16Index;
+		stWrite.m_stMbusApiPram.m_pu8Data[0] = (0 != (u16Index % 2)) ? 0xFF : 0x00;
+		stWrite.m_stMbusApiPram.m_pu8Data[1] = 0x00;
+		vRun.push_back(stWrite);
+	}
+
+	MbusAPI_t stMbusApi;
+	unsigned char u8FunCode = 0;
+	EXPECT_EQ(true, onDemandHandler::Instance().buildCoalescedRequest(vRun, stMbusApi, u8FunCode));
+	EXPECT_EQ(WRITE_MULTIPLE_COILS, u8FunCode);
+	EXPECT_EQ(5, stMbusApi.m_u16StartAddr);
+	EXPECT_EQ(9, stMbusApi.m_u16Quantity);
+	EXPECT_EQ(2, stMbusApi.m_u16ByteCount);
+	EXPECT_EQ(0xAA, stMbusApi.m_pu8Data[0]);
+	EXPECT_EQ(0x00, stMbusApi.m_pu8Data[1]);
+}
+
+/**
+ * Test case to check routing index resolves sourcetopic to request descriptor of the point
+ * @param :[in] None
+ * @param :[out] None
+ * @return None
+ */
+TEST_F(ModbusOnDemandHandler_ut, getRoute_SourceTopic)
+{
+	EXPECT_EQ(NULL, onDemandHandler::Instance().getRoute("Invalid"));
+	EXPECT_EQ(NULL, onDemandHandler::Instance().getRoute("/read"));
+	EXPECT_EQ(NULL, onDemandHandler::Instance().getRoute("/unknown/PL0/D1/read"));
+
+	const std::map<std::string, network_info::CUniqueDataPoint>& mapUniquePoint = network_info::getUniquePointList();
+	EXPECT_EQ(mapUniquePoint.size(), onDemandHandler::Instance().buildRoutingIndex());
+	for(const auto &pt : mapUniquePoint)
+	{
+		const stOnDemandRoute *pRoute = onDemandHandler::Instance().getRoute(pt.first + "/read");
+		ASSERT_NE((const stOnDemandRoute*)NULL, pRoute);
+		EXPECT_EQ((uint16_t)pt.second.getDataPoint().getAddress().m_iAddress, pRoute->m_u16StartAddr);
+		EXPECT_EQ((uint16_t)pt.second.getDataPoint().getAddress().m_iWidth, pRoute->m_u16Quantity);
+		EXPECT_EQ(pt.second.getWellSiteDev().getCtxInfo(), pRoute->m_i32Ctx);
+		EXPECT_EQ(pt.second.getWellSite().getID(), pRoute->m_sWellhead);
+		EXPECT_EQ(pt.second.getDataPoint().getID(), pRoute->m_sMetric);
+	}
+}
+
+/**
+ * Test case to check request with app_seq longer than echo field is rejected
+ * @param :[in] None
+ * @param :[out] None
+ * @return None
+ */
+TEST_F(ModbusOnDemandHandler_ut, jsonParserForOnDemandRequest_LongAppSeq)
+{
+	const std::map<std::string, network_info::CUniqueDataPoint>& mapUniquePoint = network_info::getUniquePointList();
+	onDemandHandler::Instance().buildRoutingIndex();
+	if(true == mapUniquePoint.empty())
+	{
+		return;
+	}
+	const network_info::CUniqueDataPoint &objPoint = mapUniquePoint.begin()->second;
+	std::string sTopic = mapUniquePoint.begin()->first + "/read";
+	std::string sAppSeq(ONDEMAND_ECHO_FIELD_LEN - 1, '1');
+
+	stReqView.m_svMetric = objPoint.getDataPoint().getID();
+	stReqView.m_svWellhead = objPoint.getWellSite().getID();
+	stReqView.m_svVersion = "version";
+	stReqView.m_svTopic = sTopic;
+	stReqView.m_svTimestamp = "2020-02-12 06:14:15";
+	stReqView.m_svUsec = "1581488055204186";
+	stReqView.m_svMqttTime = "2020-03-13 12:34:56";
+	stReqView.m_svEiiTime = "2020-03-31 12:34:56";
+	stReqView.m_svAppSeq = sAppSeq;
+
+	MbusAPI_t stReq{};
+	EXPECT_NE(APP_ERROR_INVALID_INPUT_JSON, onDemandHandler::Instance().jsonParserForOnDemandRequest(stReqView,
+			stReq, m_u8FunCode, 16, false));
+	EXPECT_EQ(sAppSeq, stReq.m_stOnDemandReqData.m_szAppSeq);
+
+	sAppSeq.push_back('2');
+	stReqView.m_svAppSeq = sAppSeq;
+	MbusAPI_t stLongReq{};
+	EXPECT_EQ(APP_ERROR_INVALID_INPUT_JSON, onDemandHandler::Instance().jsonParserForOnDemandRequest(stReqView,
+			stLongReq, m_u8FunCode, 16, false));
+}
+
+/**
+ * Test case to check RT and non-RT work queues are separate and keep writes of a topic in order
+ * @param :[in] None
+ * @param :[out] None
+ * @return None
+ */
+TEST_F(ModbusOnDemandHandler_ut, workQueue_TopicOrder)
+{
+	stOnDemandTopic *pWriteTopic = onDemandHandler::Instance().registerTopic("TCP_write", false, NULL, 0, 1, true);
+	stOnDemandTopic *pReadTopic = onDemandHandler::Instance().registerTopic("TCP_read", false, NULL, 0, 1, false);
+	stOnDemandTopic *pRTReadTopic = onDemandHandler::Instance().registerTopic("TCP_RT_read", true, NULL, 0, 1, false);
+	ASSERT_NE((stOnDemandTopic*)NULL, pWriteTopic);
+	ASSERT_NE((stOnDemandTopic*)NULL, pReadTopic);
+	ASSERT_NE((stOnDemandTopic*)NULL, pRTReadTopic);
+
+	EXPECT_EQ(true, onDemandHandler::Instance().enqueueWork(NULL, pWriteTopic));
+	EXPECT_EQ(true, onDemandHandler::Instance().enqueueWork(NULL, pWriteTopic));
+	EXPECT_EQ(true, onDemandHandler::Instance().enqueueWork(NULL, pReadTopic));
+	EXPECT_EQ(true, onDemandHandler::Instance().enqueueWork(NULL, pRTReadTopic));
+	EXPECT_EQ(true, onDemandHandler::Instance().enqueueWork(NULL, pRTReadTopic));
+
+	// RT worker takes only RT requests
+	stOnDemandWork stRTFirst{}, stRTSecond{};
+	EXPECT_EQ(true, onDemandHandler::Instance().dequeueWork(stRTFirst, true));
+	EXPECT_EQ(pRTReadTopic, stRTFirst.m_pTopic);
+	EXPECT_EQ(true, onDemandHandler::Instance().dequeueWork(stRTSecond, true));
+	EXPECT_EQ(pRTReadTopic, stRTSecond.m_pTopic);
+	EXPECT_EQ(false, onDemandHandler::Instance().dequeueWork(stRTSecond, true));
+	onDemandHandler::Instance().completeWork(stRTFirst);
+	onDemandHandler::Instance().completeWork(stRTSecond);
+
+	// request of other topic is taken while write of the topic waits
+	stOnDemandWork stFirst{}, stSecond{}, stThird{};
+	EXPECT_EQ(true, onDemandHandler::Instance().dequeueWork(stFirst, false));
+	EXPECT_EQ(pWriteTopic, stFirst.m_pTopic);
+	EXPECT_EQ(true, onDemandHandler::Instance().dequeueWork(stSecond, false));
+	EXPECT_EQ(pReadTopic, stSecond.m_pTopic);
+	EXPECT_EQ(false, onDemandHandler::Instance().dequeueWork(stThird, false));
+	onDemandHandler::Instance().completeWork(stFirst);
+	EXPECT_EQ(true, onDemandHandler::Instance().dequeueWork(stThird, false));
+	EXPECT_EQ(pWriteTopic, stThird.m_pTopic);
+
+	onDemandHandler::Instance().completeWork(stSecond);
+	onDemandHandler::Instance().completeWork(stThird);
+	EXPECT_EQ(false, onDemandHandler::Instance().dequeueWork(stThird, false));
+	EXPECT_EQ(false, onDemandHandler::Instance().dequeueWork(stThird, true));
+}
+
+/**
+ * Test case to check reads of a topic are processed by parallel workers
+ * @param :[in] None
+ * @param :[out] None
+ * @return None
+ */
+TEST_F(ModbusOnDemandHandler_ut, workQueue_ReadsOverlap)
+{
+	stOnDemandTopic *pReadTopic = onDemandHandler::Instance().registerTopic("TCP_parallel_read", false, NULL, 0, 1, false);
+	ASSERT_NE((stOnDemandTopic*)NULL, pReadTopic);
+
+	EXPECT_EQ(true, onDemandHandler::Instance().enqueueWork(NULL, pReadTopic));
+	EXPECT_EQ(true, onDemandHandler::Instance().enqueueWork(NULL, pReadTopic));
+
+	// second read is taken while first one is still being processed
+	stOnDemandWork stFirst{}, stSecond{}, stThird{};
+	EXPECT_EQ(true, onDemandHandler::Instance().dequeueWork(stFirst, false));
+	EXPECT_EQ(pReadTopic, stFirst.m_pTopic);
+	EXPECT_EQ(true, onDemandHandler::Instance().dequeueWork(stSecond, false));
+	EXPECT_EQ(pReadTopic, stSecond.m_pTopic);
+	EXPECT_EQ(false, onDemandHandler::Instance().dequeueWork(stThird, false));
+
+	onDemandHandler::Instance().completeWork(stSecond);
+	onDemandHandler::Instance().completeWork(stFirst);
+	EXPECT_EQ(false, onDemandHandler::Instance().dequeueWork(stThird, false));
+}
+
+/**
+ * Test case to check work queue rejects request once it is full
+ * @param :[in] None
+ * @param :[out] None
+ * @return None
+ */
+TEST_F(ModbusOnDemandHandler_ut, workQueue_Full)
+{
+	stOnDemandTopic *pTopic = onDemandHandler::Instance().registerTopic("TCP_RT_write", true, NULL, 0, 1, true);
+	ASSERT_NE((stOnDemandTopic*)NULL, pTopic);
+
+	for(uint32_t u32Index = 0; u32Index < MAX_ONDEMAND_WORK_QUEUE_LEN; u32Index++)
+	{
+		EXPECT_EQ(true, onDemandHandler::Instance().enqueueWork(NULL, pTopic));
+	}
+	EXPECT_EQ(false, onDemandHandler::Instance().enqueueWork(NULL, pTopic));
+
+	// queue accepts request again once worker takes one
+	stOnDemandWork stWork{};
+	EXPECT_EQ(true, onDemandHandler::Instance().dequeueWork(stWork, true));
+	EXPECT_EQ(true, onDemandHandler::Instance().enqueueWork(NULL, pTopic));
+
+	uint32_t u32Count = 0;
+	do
+	{
+		onDemandHandler::Instance().completeWork(stWork);
+		u32Count++;
+	} while(true == onDemandHandler::Instance().dequeueWork(stWork, true));
+	EXPECT_EQ((uint32_t)(MAX_ONDEMAND_WORK_QUEUE_LEN + 1), u32Count);
+}
+
+/**
+ * Test case to check request view refers to fields of received message without copying them
+ * @param :[in] None
+ * @param :[out] None
+ * @return None
+ */
+TEST_F(ModbusOnDemandHandler_ut, fillRequestView_BorrowsFields)
+{
+	EXPECT_EQ(true, onDemandHandler::Instance().getMsgElementView(NULL, "app_seq").empty());
+
+	msg_envelope_t *pMsg = msgbus_msg_envelope_new(CT_JSON);
+	ASSERT_NE((msg_envelope_t*)NULL, pMsg);
+	msgbus_msg_envelope_put(pMsg, "app_seq", msgbus_msg_envelope_new_string("1234"));
+	msgbus_msg_envelope_put(pMsg, "command", msgbus_msg_envelope_new_string("D1"));
+	msgbus_msg_envelope_put(pMsg, "sourcetopic", msgbus_msg_envelope_new_string("/flowmeter/PL0/D1/read"));
+	msgbus_msg_envelope_put(pMsg, "tsMsgRcvdFromExtMQTTToSP", msgbus_msg_envelope_new_string("1581488055204186"));
+	msgbus_msg_envelope_put(pMsg, "usec", msgbus_msg_envelope_new_integer(10));
+
+	EXPECT_EQ(true, onDemandHandler::Instance().fillRequestView(pMsg, false, stReqView));
+	EXPECT_EQ("1234", stReqView.m_svAppSeq);
+	EXPECT_EQ("D1", stReqView.m_svMetric);
+	EXPECT_EQ("/flowmeter/PL0/D1/read", stReqView.m_svTopic);
+	EXPECT_EQ("1581488055204186", stReqView.m_svMqttTime);
+	EXPECT_EQ(true, stReqView.m_svWellhead.empty());
+	// non-string field is not taken
+	EXPECT_EQ(true, stReqView.m_svUsec.empty());
+
+	msg_envelope_elem_body_t *pData = NULL;
+	ASSERT_EQ(MSG_SUCCESS, msgbus_msg_envelope_get(pMsg, "app_seq", &pData));
+	EXPECT_EQ((const char*)pData->body.string, stReqView.m_svAppSeq.data());
+
+	// write request without value and scaledValue is not valid
+	stOnDemandReqView stWriteView;
+	EXPECT_EQ(false, onDemandHandler::Instance().fillRequestView(pMsg, true, stWriteView));
+
+	msgbus_msg_envelope_destroy(pMsg);
+}
@@ -24,6 +24,9 @@
 #include "ConfigManager.hpp"
 
 #include <typeinfo>
+#include <set>
+#include <thread>
+#include <chrono>
 
 extern void getTimeBasedParams(const CRefDataForPolling& a_objReqData, std::string &a_sTimeStamp, std::string &a_sUsec, std::string &a_sTxID);
 
@@ -142,7 +145,7 @@ TEST_F(PeriodicRead_ut, readPeriodicCallBack_NULLArg1)
 
 /**
  * Test case to check the behaviour of isTxIDPresent() with non RT and
- * input token ID is not found in "m_mapTxIDReqData" map
+ * input token ID is not in flight
  * @param :[in] None
  * @param :[out] None
  * @return None
@@ -152,16 +155,6 @@ TEST_F(PeriodicRead_ut, isTxIDPresent_return)
 
 	try
 	{
-		struct StPollingInstance stPollRef;
-		std::vector<StPollingTracker> listPollTracker;
-		CTimeMapper::instance().getPollingTrackerList(2, listPollTracker);
-
-		for(auto &pollInterval: listPollTracker)
-		{
-			CTimeRecord &a = pollInterval.m_objTimeRecord.get();
-			CRequestInitiator::instance().initiateMessages(stPollRef, a, true);
-		}
-
 		PeriodicTimer::timer_start(1000);
 		EXPECT_EQ( false, CRequestInitiator::instance().isTxIDPresent(3, false) );
 
@@ -286,9 +279,10 @@ TEST_F(PeriodicRead_ut, checkTimer_NotPolling)
 
 	CTimeRecord CTimeRecord_obj{600, CRefDataForPolling_obj};
 
-	CTimeMapper::instance().addToPollingTracker(600, CTimeRecord_obj, false);
-	CTimeMapper::instance().checkTimer(600, 600, tsPoll);
-
+	CTimeMapper::instance().clearPollingTracker();
+	CTimeMapper::instance().addToPollingTracker(CTimeRecord_obj, false, 0);
+	CTimeMapper::instance().checkTimer(tsPoll);
+	CTimeMapper::instance().clearPollingTracker();
 }
 
 /**
@@ -305,8 +299,72 @@ TEST_F(PeriodicRead_ut, checkTimer_IsPolling)
 	CRefDataForPolling CRefDataForPolling_obj{CUniqueDataPoint_obj, 100};
 	CTimeRecord CTimeRecord_obj{600, CRefDataForPolling_obj};
 
-	CTimeMapper::instance().addToPollingTracker(600, CTimeRecord_obj, true);
-	CTimeMapper::instance().checkTimer(600, 600, tsPoll);
+	CTimeMapper::instance().clearPollingTracker();
+	CTimeMapper::instance().addToPollingTracker(CTimeRecord_obj, true, 0);
+	CTimeMapper::instance().checkTimer(tsPoll);
+	CTimeMapper::instance().clearPollingTracker();
+}
+
+/**
+ * Test case to check that timer wheel fires entries periodically, including entries
+ * whose period is longer than the wheel and intervals which do not divide each other
+ * @param :[in] None
+ * @param :[out] None
+ * @return None
+ */
+TEST_F(PeriodicRead_ut, timerWheel_PeriodicFiring)
+{
+	CRefDataForPolling CRefDataForPolling_obj{CUniqueDataPoint_obj, 100};
+	CTimeRecord CTimeRecord_obj{600, CRefDataForPolling_obj};
+
+	CTimerWheel oWheel{8};
+	StPollingTracker stEntry1{3, CTimeRecord_obj, true};
+	StPollingTracker stEntry2{20, CTimeRecord_obj, true};
+	stEntry1.m_u32PeriodTicks = 3;
+	stEntry2.m_u32PeriodTicks = 20;
+	oWheel.schedule(stEntry1, 3);
+	oWheel.schedule(stEntry2, 20);
+
+	std::vector<uint64_t> vFired1, vFired2;
+	for(uint32_t u32Tick = 1; u32Tick <= 60; ++u32Tick)
+	{
+		StPollingTracker *pFired = oWheel.advance();
+		while(NULL != pFired)
+		{
+			StPollingTracker *pNext = pFired->m_pNext;
+			(pFired == &stEntry1) ? vFired1.push_back(oWheel.getCurrentTick()) : vFired2.push_back(oWheel.getCurrentTick());
+			oWheel.schedule(*pFired, pFired->m_u64ExpiryTick + pFired->m_u32PeriodTicks);
+			pFired = pNext;
+		}
+	}
+	EXPECT_EQ(20, vFired1.size());
+	EXPECT_EQ(60, vFired1.back());
+	EXPECT_EQ((std::vector<uint64_t>{20, 40, 60}), vFired2);
+}
+
+/**
+ * Test case to check that timer wheel fires entries of same tick in order of polling interval
+ * @param :[in] None
+ * @param :[out] None
+ * @return None
+ */
+TEST_F(PeriodicRead_ut, timerWheel_OrderByInterval)
+{
+	CRefDataForPolling CRefDataForPolling_obj{CUniqueDataPoint_obj, 100};
+	CTimeRecord CTimeRecord_obj{600, CRefDataForPolling_obj};
+
+	CTimerWheel oWheel{4};
+	StPollingTracker stEntry1{500, CTimeRecord_obj, true};
+	StPollingTracker stEntry2{100, CTimeRecord_obj, false};
+	oWheel.schedule(stEntry1, 2);
+	oWheel.schedule(stEntry2, 2);
+
+	EXPECT_EQ(nullptr, oWheel.advance());
+	StPollingTracker *pFired = oWheel.advance();
+	ASSERT_NE(nullptr, pFired);
+	EXPECT_EQ(&stEntry2, pFired);
+	EXPECT_EQ(&stEntry1, pFired->m_pNext);
+	EXPECT_EQ(nullptr, pFired->m_pNext->m_pNext);
 }
 
 /**
@@ -346,6 +404,568 @@ TEST_F(PeriodicRead_ut, ScaleValueInt_1)
         EXPECT_EQ(720, ptScaleValue->body.integer);
 }
 
+/**
+ * Test case to check that adjacent holding registers of same device are grouped
+ * in one polling block and each point gets its own value from block response
+ * @param :[in] None
+ * @param :[out] None
+ * @return None
+ */
+TEST_F(PeriodicRead_ut, pollingBlock_AdjacentRegisters)
+{
+	network_info::CDataPoint oDataPoint1, oDataPoint2;
+	network_info::CDataPoint::build(YAML::Load("{id: P1, attributes: {type: HOLDING_REGISTER, addr: 10, width: 2}}"), oDataPoint1, false);
+	network_info::CDataPoint::build(YAML::Load("{id: P2, attributes: {type: HOLDING_REGISTER, addr: 13, width: 1}}"), oDataPoint2, false);
+	network_info::CUniqueDataPoint oUniquePoint1{"P1", CWellSiteInfo_obj, CWellSiteDevInfo_obj, oDataPoint1};
+	network_info::CUniqueDataPoint oUniquePoint2{"P2", CWellSiteInfo_obj, CWellSiteDevInfo_obj, oDataPoint2};
+	// points of a block are in the same polled point list
+	std::vector<CRefDataForPolling> vPoints;
+	vPoints.emplace_back(oUniquePoint1, READ_HOLDING_REG);
+	vPoints.emplace_back(oUniquePoint2, READ_HOLDING_REG);
+	CRefDataForPolling &oRefPoint1 = vPoints[0];
+	CRefDataForPolling &oRefPoint2 = vPoints[1];
+
+	// Gap of one register is not allowed for contiguous blocks
+	EXPECT_EQ(false, oRefPoint1.canAddToBlock(oRefPoint2, 0));
+	EXPECT_EQ(true, oRefPoint1.canAddToBlock(oRefPoint2, 1));
+
+	oRefPoint1.addToBlock(oRefPoint2);
+	EXPECT_EQ(true, oRefPoint1.isBlockLeader());
+	EXPECT_EQ(true, oRefPoint2.isBlockMember());
+	ASSERT_EQ(1U, oRefPoint1.getBlockPoints().size());
+	EXPECT_EQ(&oRefPoint2, &(oRefPoint1.getBlockPoints()[0].get()));
+	ASSERT_EQ(2U, oRefPoint1.getRequestPoints().size());
+	EXPECT_EQ(&oRefPoint1, &(oRefPoint1.getRequestPoints()[0].get()));
+	EXPECT_EQ(10, oRefPoint1.getMBusReq().m_u16StartAddr);
+	EXPECT_EQ(4, oRefPoint1.getMBusReq().m_u16Quantity);
+	EXPECT_EQ(8, oRefPoint1.getMBusReq().m_u16ByteCount);
+
+	std::vector<uint8_t> vBlockValue{0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08};
+	std::vector<uint8_t> vPointValue;
+	EXPECT_EQ(true, oRefPoint1.getValueFromBlock(10, vBlockValue, vPointValue));
+	EXPECT_EQ((std::vector<uint8_t>{0x01, 0x02, 0x03, 0x04}), vPointValue);
+	EXPECT_EQ(true, oRefPoint2.getValueFromBlock(10, vBlockValue, vPointValue));
+	EXPECT_EQ((std::vector<uint8_t>{0x07, 0x08}), vPointValue);
+
+	// Short response does not cover second point
+	vBlockValue.resize(6);
+	EXPECT_EQ(false, oRefPoint2.getValueFromBlock(10, vBlockValue, vPointValue));
+}
+
+/**
+ * Test case to check that block membership is kept when polled point list
+ * is copied or reallocated
+ * @param :[in] None
+ * @param :[out] None
+ * @return None
+ */
+TEST_F(PeriodicRead_ut, pollingBlock_CopiedList)
+{
+	network_info::CDataPoint oDataPoint1, oDataPoint2;
+	network_info::CDataPoint::build(YAML::Load("{id: P1, attributes: {type: HOLDING_REGISTER, addr: 20, width: 1}}"), oDataPoint1, false);
+	network_info::CDataPoint::build(YAML::Load("{id: P2, attributes: {type: HOLDING_REGISTER, addr: 21, width: 1}}"), oDataPoint2, false);
+	network_info::CUniqueDataPoint oUniquePoint1{"P1", CWellSiteInfo_obj, CWellSiteDevInfo_obj, oDataPoint1};
+	network_info::CUniqueDataPoint oUniquePoint2{"P2", CWellSiteInfo_obj, CWellSiteDevInfo_obj, oDataPoint2};
+
+	// member is placed before leader in the list
+	std::vector<CRefDataForPolling> vPoints;
+	vPoints.emplace_back(oUniquePoint2, READ_HOLDING_REG);
+	vPoints.emplace_back(oUniquePoint1, READ_HOLDING_REG);
+	EXPECT_EQ(true, vPoints[1].addToBlock(vPoints[0]));
+
+	std::vector<CRefDataForPolling> vCopy(vPoints);
+	EXPECT_EQ(true, vCopy[1].isBlockLeader());
+	EXPECT_EQ(true, vCopy[0].isBlockMember());
+	EXPECT_EQ(2, vCopy[1].getMBusReq().m_u16Quantity);
+
+	// list is reallocated
+	for(uint32_t u32Index = 0; u32Index < 16; ++u32Index)
+	{
+		vCopy.emplace_back(oUniquePoint1, READ_HOLDING_REG);
+	}
+	ASSERT_EQ(1U, vCopy[1].getBlockPoints().size());
+	EXPECT_EQ(&vCopy[0], &(vCopy[1].getBlockPoints()[0].get()));
+	ASSERT_EQ(1U, vPoints[1].getBlockPoints().size());
+	EXPECT_EQ(&vPoints[0], &(vPoints[1].getBlockPoints()[0].get()));
+}
+
+/**
+ * Test case to check that coil values are extracted from bit-packed block response
+ * @param :[in] None
+ * @param :[out] None
+ * @return None
+ */
+TEST_F(PeriodicRead_ut, pollingBlock_CoilValue)
+{
+	network_info::CDataPoint oDataPoint;
+	network_info::CDataPoint::build(YAML::Load("{id: C1, attributes: {type: COIL, addr: 9, width: 1}}"), oDataPoint, false);
+	network_info::CUniqueDataPoint oUniquePoint{"C1", CWellSiteInfo_obj, CWellSiteDevInfo_obj, oDataPoint};
+	CRefDataForPolling oRefPoint{oUniquePoint, READ_COIL_STATUS};
+
+	// Block starts at coil 0; coil 9 is 2nd bit of 2nd byte
+	std::vector<uint8_t> vBlockValue{0x00, 0x02};
+	std::vector<uint8_t> vPointValue;
+	EXPECT_EQ(true, oRefPoint.getValueFromBlock(0, vBlockValue, vPointValue));
+	EXPECT_EQ((std::vector<uint8_t>{0x01}), vPointValue);
+
+	vBlockValue[1] = 0xFD;
+	EXPECT_EQ(true, oRefPoint.getValueFromBlock(0, vBlockValue, vPointValue));
+	EXPECT_EQ((std::vector<uint8_t>{0x00}), vPointValue);
+}
 
+/**
+ * Test case to check that setScaledValue() gives same value using response bytes and hex string
+ * @param :[in] None
+ * @param :[out] None
+ * @return None
+ */
+TEST_F(PeriodicRead_ut, ScaleValue_FromBytes)
+{
+	std::vector<uint8_t> vValue{0x24, 0x00};
+	stValueDecoder stDecoder = common_Handler::getValueDecoder("int", WIDTH_ONE, false, false, 20);
+
+	msg_envelope_elem_body_t* ptScaleValue = CPeriodicReponseProcessor::Instance().setScaledValue(vValue, stDecoder);
+	EXPECT_EQ(720, ptScaleValue->body.integer);
+	msgbus_msg_envelope_elem_destroy(ptScaleValue);
+
+	ptScaleValue = CPeriodicReponseProcessor::Instance().setScaledValue(common_Handler::swapConversion(vValue), "int", 20, WIDTH_ONE);
+	EXPECT_EQ(720, ptScaleValue->body.integer);
+	msgbus_msg_envelope_elem_destroy(ptScaleValue);
+}
 
+/**
+ * Test case to check that publish template of polled point has invariant fields
+ * and is shared with copy of the point
+ * @param :[in] None
+ * @param :[out] None
+ * @return None
+ */
+TEST_F(PeriodicRead_ut, publishTemplate_InvariantFields)
+{
+	network_info::CDataPoint oDataPoint;
+	network_info::CDataPoint::build(YAML::Load("{id: P1, attributes: {type: HOLDING_REGISTER, addr: 10, width: 2, datatype: INT}}"), oDataPoint, false);
+	network_info::CUniqueDataPoint oUniquePoint{"P1", CWellSiteInfo_obj, CWellSiteDevInfo_obj, oDataPoint};
+	CRefDataForPolling oRefPoint{oUniquePoint, READ_HOLDING_REG};
+	CRefDataForPolling oCopyPoint{oRefPoint};
+
+	std::shared_ptr<stPublishTemplate> pTemplate = oRefPoint.getPublishTemplate();
+	ASSERT_NE(nullptr, pTemplate);
+	EXPECT_EQ(pTemplate, oCopyPoint.getPublishTemplate());
+	EXPECT_EQ(oUniquePoint.getID() + SEPARATOR_CHAR + PERIODIC_GENERIC_TOPIC, pTemplate->m_sDataTopic);
+
+	msg_envelope_elem_body_t* ptField = NULL;
+	EXPECT_EQ(MSG_SUCCESS, msgbus_msg_envelope_get(pTemplate->m_pMsg, "version", &ptField));
+	EXPECT_EQ(MSG_SUCCESS, msgbus_msg_envelope_get(pTemplate->m_pMsg, "datatype", &ptField));
+	EXPECT_EQ(std::string("int"), std::string(ptField->body.string));
+	EXPECT_NE(MSG_SUCCESS, msgbus_msg_envelope_get(pTemplate->m_pMsg, "scaledValue", &ptField));
+}
 
+/**
+ * Test case to check that response ring keeps order of responses and rejects push when full
+ * @param :[in] None
+ * @param :[out] None
+ * @return None
+ */
+TEST_F(PeriodicRead_ut, responseRing_FullAndOrder)
+{
+	CMpscRing<uint32_t, 4> oRing;
+	for(uint32_t u32Val = 0; u32Val < 4; ++u32Val)
+	{
+		EXPECT_EQ(true, oRing.push([u32Val](uint32_t &a_u32Slot){ a_u32Slot = u32Val; }));
+	}
+	EXPECT_EQ(false, oRing.push([](uint32_t &a_u32Slot){ a_u32Slot = 10; }));
+	EXPECT_EQ(1, oRing.getDropCount());
+	EXPECT_EQ(4, oRing.size());
+
+	for(uint32_t u32Val = 0; u32Val < 4; ++u32Val)
+	{
+		uint32_t u32Popped = 0xFF;
+		EXPECT_EQ(true, oRing.pop([&u32Popped](uint32_t &a_u32Slot){ u32Popped = a_u32Slot; }));
+		EXPECT_EQ(u32Val, u32Popped);
+	}
+	EXPECT_EQ(false, oRing.pop([](uint32_t &){}));
+}
+
+/**
+ * Test case to check that no response is lost when multiple threads push to response ring
+ * @param :[in] None
+ * @param :[out] None
+ * @return None
+ */
+TEST_F(PeriodicRead_ut, responseRing_MultipleProducers)
+{
+	static CMpscRing<uint32_t, 1024> oRing;
+	const uint32_t u32PerThread = 10000;
+	std::atomic<uint32_t> u32Pushed{0};
+	std::vector<std::thread> vThreads;
+	for(uint32_t u32Thread = 0; u32Thread < 4; ++u32Thread)
+	{
+		vThreads.emplace_back([&u32Pushed, u32PerThread]()
+		{
+			for(uint32_t u32Val = 0; u32Val < u32PerThread; ++u32Val)
+			{
+				while(false == oRing.push([u32Val](uint32_t &a_u32Slot){ a_u32Slot = u32Val; }))
+				{
+					std::this_thread::yield();
+				}
+				++u32Pushed;
+			}
+		});
+	}
+
+	uint64_t u64Sum = 0;
+	uint32_t u32Popped = 0;
+	while(u32Popped < 4 * u32PerThread)
+	{
+		if(false == oRing.pop([&u64Sum](uint32_t &a_u32Slot){ u64Sum += a_u32Slot; }))
+		{
+			std::this_thread::yield();
+			continue;
+		}
+		++u32Popped;
+	}
+	for(auto &oThread : vThreads)
+	{
+		oThread.join();
+	}
+	EXPECT_EQ(4 * u32PerThread, u32Pushed.load());
+	EXPECT_EQ(4 * ((uint64_t)u32PerThread * (u32PerThread - 1) / 2), u64Sum);
+}
+
+/**
+ * Test case to check that same topic is interned only once
+ * @param :[in] None
+ * @param :[out] None
+ * @return None
+ */
+TEST_F(PeriodicRead_ut, internTopic_SameTopic)
+{
+	uint16_t u16TopicID = CPeriodicReponseProcessor::Instance().internTopic("TCP_PolledData_UT");
+	EXPECT_NE(INVALID_TOPIC_ID, u16TopicID);
+	EXPECT_EQ(u16TopicID, CPeriodicReponseProcessor::Instance().internTopic("TCP_PolledData_UT"));
+	EXPECT_EQ("TCP_PolledData_UT", CPeriodicReponseProcessor::Instance().getInternedTopic(u16TopicID));
+	EXPECT_EQ("", CPeriodicReponseProcessor::Instance().getInternedTopic(INVALID_TOPIC_ID));
+}
+
+/**
+ * Test case to check that points of a device are spread evenly across polling interval
+ * @param :[in] None
+ * @param :[out] None
+ * @return None
+ */
+TEST_F(PeriodicRead_ut, pollingPhases_SpreadAcrossInterval)
+{
+	std::vector<network_info::CDataPoint> vDataPoints(4);
+	std::vector<network_info::CUniqueDataPoint> vUniquePoints;
+	vUniquePoints.reserve(4);
+	for(uint32_t u32Index = 0; u32Index < 4; ++u32Index)
+	{
+		std::string sID = "P" + std::to_string(u32Index);
+		network_info::CDataPoint::build(YAML::Load("{id: " + sID + ", attributes: {type: HOLDING_REGISTER, addr: "
+				+ std::to_string(10 * u32Index) + ", width: 1}}"), vDataPoints[u32Index], false);
+		vUniquePoints.emplace_back(sID, CWellSiteInfo_obj, CWellSiteDevInfo_obj, vDataPoints[u32Index]);
+	}
+
+	CRefDataForPolling oRefPoint0{vUniquePoints[0], READ_HOLDING_REG};
+	CTimeRecord oTimeRecord{1000, oRefPoint0};
+	for(uint32_t u32Index = 1; u32Index < 4; ++u32Index)
+	{
+		CRefDataForPolling oRefPoint{vUniquePoints[u32Index], READ_HOLDING_REG};
+		oTimeRecord.add(oRefPoint);
+	}
+
+	// Staggering disabled
+	EXPECT_EQ(1, oTimeRecord.buildPollingPhases(0));
+	EXPECT_EQ((std::vector<uint32_t>{0}), oTimeRecord.getPhaseOffsets());
+
+	// Each of 4 points gets its own phase of 250 ms
+	EXPECT_EQ(4, oTimeRecord.buildPollingPhases(250));
+	EXPECT_EQ((std::vector<uint32_t>{0, 250, 500, 750}), oTimeRecord.getPhaseOffsets());
+	std::set<uint32_t> setOffsets;
+	for(auto &objPoint : oTimeRecord.getPolledPointList())
+	{
+		setOffsets.insert(objPoint.getPhaseOffset());
+	}
+	for(auto &objPoint : oTimeRecord.getPolledPointListRT())
+	{
+		setOffsets.insert(objPoint.getPhaseOffset());
+	}
+	EXPECT_EQ(4, setOffsets.size());
+
+	// Each phase visits only points having its offset
+	uint32_t u32Bucketed = 0;
+	EXPECT_EQ(4, oTimeRecord.buildPhasePoints());
+	for(uint32_t u32PhaseOffset : oTimeRecord.getPhaseOffsets())
+	{
+		for(bool bIsRT : {false, true})
+		{
+			auto &vPoints = bIsRT ? oTimeRecord.getPolledPointListRT() : oTimeRecord.getPolledPointList();
+			for(uint32_t u32Index : oTimeRecord.getPhasePoints(u32PhaseOffset, bIsRT))
+			{
+				EXPECT_EQ(u32PhaseOffset, vPoints[u32Index].getPhaseOffset());
+				++u32Bucketed;
+			}
+		}
+	}
+	EXPECT_EQ(4, u32Bucketed);
+	EXPECT_TRUE(oTimeRecord.getPhasePoints(100, false).empty());
+}
+
+
+/**
+ * Test case to check that TxIDs are given out independently of point identity:
+ * same point gets a new non-zero TxID for each request and TxID is free again
+ * once it is released
+ * @param :[in] None
+ * @param :[out] None
+ * @return None
+ */
+TEST_F(PeriodicRead_ut, inFlightTable_TxIDNotTiedToPoint)
+{
+	network_info::CDataPoint oDataPoint;
+	network_info::CDataPoint::build(YAML::Load("{id: P1, attributes: {type: HOLDING_REGISTER, addr: 10, width: 1}}"), oDataPoint, false);
+	network_info::CUniqueDataPoint oUniquePoint{"P1", CWellSiteInfo_obj, CWellSiteDevInfo_obj, oDataPoint};
+	CRefDataForPolling oRefPoint{oUniquePoint, READ_HOLDING_REG};
+
+	uint32_t u32InFlight = CRequestInitiator::instance().getInFlightCount(false);
+	uint16_t u16TxID1 = 0, u16TxID2 = 0;
+	EXPECT_EQ(true, CRequestInitiator::instance().allocateTxID(oRefPoint, false, u16TxID1));
+	EXPECT_EQ(true, CRequestInitiator::instance().allocateTxID(oRefPoint, false, u16TxID2));
+	EXPECT_NE(0, u16TxID1);
+	EXPECT_NE(u16TxID1, u16TxID2);
+	EXPECT_EQ(u32InFlight + 2, CRequestInitiator::instance().getInFlightCount(false));
+	EXPECT_EQ(&oRefPoint, &CRequestInitiator::instance().getTxIDReqData(u16TxID1, false));
+	EXPECT_EQ(false, CRequestInitiator::instance().isTxIDPresent(u16TxID1, true));
+	EXPECT_EQ(true, CRequestInitiator::instance().isTxIDOwnedBy(u16TxID1, oRefPoint, false));
+
+	// TxID released by one point may be in flight for another point
+	CRefDataForPolling oOtherPoint{oUniquePoint, READ_HOLDING_REG};
+	EXPECT_EQ(false, CRequestInitiator::instance().isTxIDOwnedBy(u16TxID1, oOtherPoint, false));
+
+	CRequestInitiator::instance().removeTxIDReqData(u16TxID1, false);
+	CRequestInitiator::instance().removeTxIDReqData(u16TxID2, false);
+	EXPECT_EQ(false, CRequestInitiator::instance().isTxIDPresent(u16TxID1, false));
+	EXPECT_EQ(u32InFlight, CRequestInitiator::instance().getInFlightCount(false));
+	EXPECT_THROW(CRequestInitiator::instance().getTxIDReqData(u16TxID1, false), std::out_of_range);
+}
+
+/**
+ * Test case to check that in-flight table rejects requests once all TxIDs
+ * are in flight
+ * @param :[in] None
+ * @param :[out] None
+ * @return None
+ */
+TEST_F(PeriodicRead_ut, inFlightTable_Full)
+{
+	std::unique_ptr<CInFlightTable<int>> pTable{new CInFlightTable<int>()};
+	int iOwner = 0;
+	uint16_t u16TxID = 0;
+	for(uint32_t u32Index = 1; u32Index < TXID_TABLE_SIZE; ++u32Index)
+	{
+		ASSERT_EQ(true, pTable->acquire(&iOwner, u16TxID));
+	}
+	EXPECT_EQ(TXID_TABLE_SIZE - 1, pTable->size());
+	EXPECT_EQ(false, pTable->acquire(&iOwner, u16TxID));
+
+	EXPECT_EQ(&iOwner, pTable->release(7));
+	EXPECT_EQ(true, pTable->acquire(&iOwner, u16TxID));
+	EXPECT_EQ(7, u16TxID);
+}
+
+/**
+ * Test case to check that device request queue limits requests in flight
+ * and sends pending RT requests before Non-RT requests
+ * @param :[in] None
+ * @param :[out] None
+ * @return None
+ */
+TEST_F(PeriodicRead_ut, deviceRequestQueue_InFlightLimit)
+{
+	network_info::CDataPoint oDataPoint;
+	network_info::CDataPoint::build(YAML::Load("{id: P1, attributes: {type: HOLDING_REGISTER, addr: 10, width: 1}}"), oDataPoint, false);
+	network_info::CUniqueDataPoint oUniquePoint{"P1", CWellSiteInfo_obj, CWellSiteDevInfo_obj, oDataPoint};
+	CRefDataForPolling oRefPoint{oUniquePoint, READ_HOLDING_REG};
+
+	CDeviceRequestQueue oDeviceQueue{"site1_dev1"};
+	stPendingRequest stNonRTReq{&oRefPoint, {0}, false, 0, 0, NULL};
+	stPendingRequest stRTReq{&oRefPoint, {0}, true, 0, 0, NULL};
+	oDeviceQueue.push(stNonRTReq);
+	oDeviceQueue.push(stNonRTReq);
+	oDeviceQueue.push(stRTReq);
+	EXPECT_EQ(3, oDeviceQueue.getPendingCount());
+
+	// RT request goes first, then one Non-RT request reaches the limit of 2
+	stPendingRequest stReq;
+	EXPECT_EQ(true, oDeviceQueue.pop(2, stReq));
+	EXPECT_EQ(true, stReq.m_bIsRT);
+	EXPECT_EQ(true, oDeviceQueue.pop(2, stReq));
+	EXPECT_EQ(false, stReq.m_bIsRT);
+	EXPECT_EQ(false, oDeviceQueue.pop(2, stReq));
+	EXPECT_EQ(2, oDeviceQueue.getInFlightCount());
+
+	// Response frees a slot for the last pending request
+	oDeviceQueue.complete();
+	EXPECT_EQ(true, oDeviceQueue.pop(2, stReq));
+	EXPECT_EQ(0, oDeviceQueue.getPendingCount());
+	EXPECT_EQ(false, oDeviceQueue.pop(0, stReq));
+}
+
+/**
+ * Test case to check that device is treated as down after given number of
+ * consecutive timeouts, is probed with exponential backoff and is up again
+ * on first response
+ * @param :[in] None
+ * @param :[out] None
+ * @return None
+ */
+TEST_F(PeriodicRead_ut, deviceRequestQueue_CircuitBreaker)
+{
+	network_info::CDataPoint oDataPoint;
+	network_info::CDataPoint::build(YAML::Load("{id: P1, attributes: {type: HOLDING_REGISTER, addr: 10, width: 1}}"), oDataPoint, false);
+	network_info::CUniqueDataPoint oUniquePoint{"P1", CWellSiteInfo_obj, CWellSiteDevInfo_obj, oDataPoint};
+	CRefDataForPolling oRefPoint{oUniquePoint, READ_HOLDING_REG};
+
+	CDeviceRequestQueue oDeviceQueue{"site1_dev1"};
+	oDeviceQueue.push(stPendingRequest{&oRefPoint, {0}, false, 0, 0, NULL});
+	std::vector<stPendingRequest> vDropped;
+	struct timespec tsNow = {100, 0};
+
+	EXPECT_EQ(false, oDeviceQueue.recordTimeout(2, 4000, tsNow, vDropped));
+	EXPECT_EQ(false, oDeviceQueue.isDown());
+	EXPECT_EQ(true, oDeviceQueue.recordTimeout(2, 4000, tsNow, vDropped));
+	EXPECT_EQ(true, oDeviceQueue.isDown());
+	EXPECT_EQ(1, vDropped.size());
+	EXPECT_EQ(0, oDeviceQueue.getPendingCount());
+
+	// First probe after 1 second
+	EXPECT_EQ(false, oDeviceQueue.isPollAllowed(tsNow));
+	struct timespec tsProbe = {101, 0};
+	EXPECT_EQ(true, oDeviceQueue.isPollAllowed(tsProbe));
+	EXPECT_EQ(false, oDeviceQueue.isPollAllowed(tsProbe));
+
+	// Failed probe doubles backoff
+	EXPECT_EQ(false, oDeviceQueue.recordTimeout(2, 4000, tsProbe, vDropped));
+	EXPECT_EQ(false, oDeviceQueue.isPollAllowed(timespec{102, 500000000}));
+	EXPECT_EQ(true, oDeviceQueue.isPollAllowed(timespec{103, 0}));
+
+	// Response of device resumes normal polling
+	EXPECT_EQ(true, oDeviceQueue.recordSuccess());
+	EXPECT_EQ(false, oDeviceQueue.isDown());
+	EXPECT_EQ(true, oDeviceQueue.isPollAllowed(tsNow));
+	EXPECT_EQ(false, oDeviceQueue.recordSuccess());
+}
+
+/**
+ * Test case to check report-by-exception of a point having deadband: value is
+ * reported on first response, on change beyond deadband and after bad response
+ * @param :[in] None
+ * @param :[out] None
+ * @return None
+ */
+TEST_F(PeriodicRead_ut, reportByException_Deadband)
+{
+	network_info::CDataPoint oDataPoint;
+	network_info::CDataPoint::build(YAML::Load("{id: P1, attributes: {type: HOLDING_REGISTER, addr: 10, width: 1, datatype: INT16, deadband: 5, heartbeat: 600000}}"), oDataPoint, false);
+	EXPECT_EQ(5, oDataPoint.getAddress().m_dDeadband);
+	EXPECT_EQ(600000, oDataPoint.getAddress().m_uiHeartbeatMs);
+	network_info::CUniqueDataPoint oUniquePoint{"P1", CWellSiteInfo_obj, CWellSiteDevInfo_obj, oDataPoint};
+	CRefDataForPolling oRefPoint{oUniquePoint, READ_HOLDING_REG};
+	EXPECT_EQ(true, oRefPoint.isReportByException());
+
+	msg_envelope_elem_body_t* pValue100 = msgbus_msg_envelope_new_integer(100);
+	msg_envelope_elem_body_t* pValue104 = msgbus_msg_envelope_new_integer(104);
+	msg_envelope_elem_body_t* pValue106 = msgbus_msg_envelope_new_integer(106);
+	std::vector<uint8_t> vValue100{0x00, 0x64}, vValue104{0x00, 0x68}, vValue106{0x00, 0x6A};
+
+	// First value is always reported
+	EXPECT_EQ(true, oRefPoint.isReportRequired(pValue100, vValue100));
+	oRefPoint.setReported(true, pValue100, vValue100);
+
+	// Change within deadband is not reported, change beyond it is
+	EXPECT_EQ(false, oRefPoint.isReportRequired(pValue104, vValue104));
+	EXPECT_EQ(true, oRefPoint.isReportRequired(pValue106, vValue106));
+
+	// Bad response resets reporting
+	oRefPoint.setReported(false, NULL, std::vector<uint8_t>{});
+	EXPECT_EQ(true, oRefPoint.isReportRequired(pValue100, vValue100));
+
+	msgbus_msg_envelope_elem_destroy(pValue100);
+	msgbus_msg_envelope_elem_destroy(pValue104);
+	msgbus_msg_envelope_elem_destroy(pValue106);
+}
+
+/**
+ * Test case to check report-by-exception of a point whose device was down:
+ * first good value after device recovers is reported even if it is within deadband
+ * @param :[in] None
+ * @param :[out] None
+ * @return None
+ */
+TEST_F(PeriodicRead_ut, reportByException_DeviceRecovery)
+{
+	network_info::CDataPoint oDataPoint;
+	network_info::CDataPoint::build(YAML::Load("{id: P1, attributes: {type: HOLDING_REGISTER, addr: 10, width: 1, datatype: INT16, deadband: 5}}"), oDataPoint, false);
+	network_info::CUniqueDataPoint oUniquePoint{"P1", CWellSiteInfo_obj, CWellSiteDevInfo_obj, oDataPoint};
+	CRefDataForPolling oRefPoint{oUniquePoint, READ_HOLDING_REG};
+	std::shared_ptr<CDeviceRequestQueue> pDeviceQueue = std::make_shared<CDeviceRequestQueue>("site1_dev1");
+	oRefPoint.setDeviceQueue(pDeviceQueue);
+
+	msg_envelope_elem_body_t* pValue100 = msgbus_msg_envelope_new_integer(100);
+	msg_envelope_elem_body_t* pValue104 = msgbus_msg_envelope_new_integer(104);
+	std::vector<uint8_t> vValue100{0x00, 0x64}, vValue104{0x00, 0x68};
+
+	oRefPoint.setReported(true, pValue100, vValue100);
+	EXPECT_EQ(false, oRefPoint.isReportRequired(pValue104, vValue104));
+
+	// Device goes down and recovers
+	std::vector<stPendingRequest> vDropped;
+	struct timespec tsNow = {100, 0};
+	EXPECT_EQ(true, pDeviceQueue->recordTimeout(1, 4000, tsNow, vDropped));
+	EXPECT_EQ(true, pDeviceQueue->recordSuccess());
+
+	// First good value after recovery is reported, later ones follow deadband again
+	EXPECT_EQ(true, oRefPoint.isReportRequired(pValue104, vValue104));
+	oRefPoint.setReported(true, pValue104, vValue104);
+	EXPECT_EQ(false, oRefPoint.isReportRequired(pValue100, vValue100));
+
+	msgbus_msg_envelope_elem_destroy(pValue100);
+	msgbus_msg_envelope_elem_destroy(pValue104);
+}
+
+/**
+ * Test case to check last good response of a polled point is used for on-demand
+ * read only within max age and is refreshed when device returns the same value
+ * @param :[in] None
+ * @param :[out] None
+ * @return None
+ */
+TEST_F(PeriodicRead_ut, readCache_FreshResponse)
+{
+	network_info::CDataPoint oDataPoint;
+	network_info::CDataPoint::build(YAML::Load("{id: P1, attributes: {type: HOLDING_REGISTER, addr: 10, width: 1}}"), oDataPoint, false);
+	network_info::CUniqueDataPoint oUniquePoint{"P1", CWellSiteInfo_obj, CWellSiteDevInfo_obj, oDataPoint};
+	CRefDataForPolling oRefPoint{oUniquePoint, READ_HOLDING_REG};
+	stMbusAppCallbackParams_t stResp{};
+
+	// No response is received yet
+	EXPECT_EQ(false, oRefPoint.getFreshResponse(1000, stResp));
+
+	std::vector<uint8_t> vValue{0x12, 0x34};
+	EXPECT_EQ(true, oRefPoint.saveGoodResponse("0x1234", vValue, "1581488055204186"));
+	EXPECT_EQ(false, oRefPoint.getFreshResponse(0, stResp));
+	EXPECT_EQ(true, oRefPoint.getFreshResponse(1000, stResp));
+	EXPECT_EQ(2, stResp.m_u8MbusRXDataLength);
+	EXPECT_EQ(0x12, stResp.m_au8MbusRXDataDataFields[0]);
+	EXPECT_EQ(0x34, stResp.m_au8MbusRXDataDataFields[1]);
+
+	// Value older than max age is not used
+	std::this_thread::sleep_for(std::chrono::milliseconds(30));
+	EXPECT_EQ(false, oRefPoint.getFreshResponse(10, stResp));
+
+	// Different value does not refresh saved value, same value does
+	oRefPoint.refreshGoodResponse(std::vector<uint8_t>{0x00, 0x01});
+	EXPECT_EQ(false, oRefPoint.getFreshResponse(10, stResp));
+	oRefPoint.refreshGoodResponse(vValue);
+	EXPECT_EQ(true, oRefPoint.getFreshResponse(10, stResp));
+}
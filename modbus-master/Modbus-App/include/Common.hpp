@@ -27,6 +27,7 @@
 #include "ZmqHandler.hpp"
 #include "ConfigManager.hpp"
 #include <string>
+#include <string_view>
 #include <iostream>
 #include <variant>
 #include "EnvironmentVarHandler.hpp"
@@ -37,6 +38,7 @@ extern "C" {
 }
 #endif
 #include <map>
+#include <memory>
 #include <inttypes.h>
 
 #ifdef __linux
@@ -47,6 +49,12 @@ extern "C" {
 
 #define MODBUS_SINGLE_REGISTER_LENGTH (2)
 
+/// number of shards of on-demand request table, shard is selected using TxID
+#define REQ_TABLE_SHARD_COUNT 16
+
+/// max length including terminator of request field echoed in on-demand response
+#define ONDEMAND_ECHO_FIELD_LEN 64
+
 #define WIDTH_ONE 	1
 #define WIDTH_TWO 	2
 #define WIDTH_FOUR 	4
@@ -54,25 +62,24 @@ extern "C" {
 using namespace std;
 using var_hex = std::variant<std::monostate, bool, uint16_t, uint32_t, uint64_t, int16_t, int32_t, int64_t, float, double, std::string>;
 
-/** This structure defines the parameters for On Demand Request **/
+/** This structure defines the parameters for On Demand Request.
+ * Request fields echoed in response are kept in fixed size buffers and point
+ * fields refer to routing index, hence storing or copying request does not allocate **/
 struct stOnDemandRequest
 {
-	std::string m_strAppSeq; /** app sequence number **/
-	std::string m_strWellhead; /** well head name **/
-	std::string m_strMetric; /** Metric name **/
-	std::string m_strVersion; /** version number **/
-	std::string m_strTopic; /** Topic name **/
-	std::string m_sValue; /** data value **/
-	var_hex 	m_ScaledValue; /** ScaledValue **/
-	std::string m_sUsec; /** Seconds number **/
-	std::string m_sTimestamp; /** TimeStamp value **/
+	char m_szAppSeq[ONDEMAND_ECHO_FIELD_LEN]; /** app sequence number **/
+	char m_szMqttTime[ONDEMAND_ECHO_FIELD_LEN]; /** value of mqtt time **/
+	char m_szEiiTime[ONDEMAND_ECHO_FIELD_LEN]; /** value of eii time **/
+	std::string_view m_svTopic; /** point topic i.e. /device/wellhead/point **/
+	std::string_view m_svWellhead; /** well head name **/
+	std::string_view m_svMetric; /** Metric name **/
+	std::string_view m_svDataType; /** data type*/
 	bool m_isByteSwap; /** ByteSwap(true or false)**/
 	bool m_isWordSwap; /** WordSwap(true or false) **/
 	bool m_isRT; /** Real Time(true or false) **/
+	bool m_isWriteReq; /** write or read request(true or false) **/
+	bool m_bIsCached; /** read is answered using last polled value(true or false) **/
 	struct timespec m_obtReqRcvdTS; /** Timestamp showing when a request is received **/
-	std::string m_strMqttTime; /** value of mqtt time **/
-	std::string m_strEiiTime; /** value of eii time **/
-	std::string m_sDataType; /** data type*/
 	double m_dscaleFactor;
 	int m_iWidth;
 	bool m_bIsDataPersist; /** Data Persist flag **/
@@ -132,7 +139,9 @@ unsigned char GetFunctionCode(uint8_t u8ReadWrite,
   * POINT_IS_NOT_WRITABLE: code 108
   * INTERNAL_ERORR: code 109
   * INVALID_CTX: code 110
-  * CODE_MAX: code 111
+  * REQUEST_QUEUE_FULL: code 111
+  * RESPONSE_RING_FULL: code 112
+  * CODE_MAX: code 113
  */
 typedef enum MbusAppErrorCode
 {
@@ -148,6 +157,8 @@ typedef enum MbusAppErrorCode
 	APP_ERROR_POINT_IS_NOT_WRITABLE,
 	APP_INTERNAL_ERORR,
 	APP_ERROR_INVALID_CTX,
+	APP_ERROR_REQUEST_QUEUE_FULL,
+	APP_ERROR_RESPONSE_RING_FULL,
 	APP_ERROR_CODE_MAX
 }eMbusAppErrorCode;
 
@@ -197,6 +208,32 @@ enum eYMlDataType
 	enSTRING,
 	enUNKNOWN
 };
+/** Enumerator specifying decoder to be used for a datapoint value.
+ * It is chosen once using datatype and width of a datapoint */
+enum eValueDecodeType
+{
+	enDECODE_INT16 = 0,
+	enDECODE_INT32,
+	enDECODE_INT64,
+	enDECODE_UINT16,
+	enDECODE_UINT32,
+	enDECODE_UINT64,
+	enDECODE_FLOAT,
+	enDECODE_DOUBLE,
+	enDECODE_BOOLEAN,
+	enDECODE_STRING,
+	enDECODE_INVALID
+};
+
+/** This structure defines parameters to decode a datapoint value from response bytes **/
+struct stValueDecoder
+{
+	eValueDecodeType m_eDecodeType; /** decoder as per datatype and width **/
+	bool m_bIsByteSwap; /** ByteSwap(true or false)**/
+	bool m_bIsWordSwap; /** WordSwap(true or false) **/
+	double m_dScaleFactor; /** scale factor **/
+};
+
 /* Union of unsigned long long int and float */
 typedef union
 {
@@ -228,13 +265,19 @@ namespace common_Handler
 
 std::string swapConversion(std::vector<unsigned char> vt, bool a_bIsByteSwap = false, bool a_bIsWordSwap = false);
 
-bool getReqData(unsigned short seqno, MbusAPI_t& reqData);
+/** handle to request stored in on-demand request table. Request stays valid
+ * as long as handle is held even if it is removed from the table meanwhile */
+typedef std::shared_ptr<MbusAPI_t> reqDataHandle_t;
+
+reqDataHandle_t getReqData(unsigned short seqno);
+
+bool insertReqData(unsigned short, MbusAPI_t&&);
 
-bool insertReqData(unsigned short, MbusAPI_t&);
+reqDataHandle_t removeReqData(unsigned short);
 
-bool updateReqData(unsigned short, MbusAPI_t&);
+size_t getReqDataCount();
 
-void removeReqData(unsigned short);
+bool copyEchoField(char *a_pszDest, std::string_view a_svSrc);
 
 long getReqPriority(const globalConfig::COperation a_Ops);
 
@@ -279,6 +322,17 @@ std::string hexBytesToString(std::string str);
 
 // getDataType
 eYMlDataType getDataType(std::string a_sDataType);
+
+// get decoder type as per datatype and width
+eValueDecodeType getDecodeType(eYMlDataType a_eDataType, int a_iWidth);
+
+// get decoder for a datapoint
+stValueDecoder getValueDecoder(std::string a_sDataType, int a_iWidth,
+		bool a_bIsByteSwap, bool a_bIsWordSwap, double a_dScaleFactor);
+
+// Convert response bytes to raw value after applying byte and word swap
+unsigned long long int bytesToRawValue(const std::vector<unsigned char> &a_vValue,
+		bool a_bIsByteSwap = false, bool a_bIsWordSwap = false);
 }
 
 #endif /* INCLUDE_INC_COMMON_HPP_ */
@@ -0,0 +1,134 @@
+/********************************************************************************
+* Copyright (c) 2021 Intel Corporation.
+
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*********************************************************************************/
+
+
+/*** InFlightTable.hpp is flat table of in-flight requests indexed directly
+ * by transaction ID*/
+
+#ifndef INCLUDE_INC_INFLIGHTTABLE_HPP_
+#define INCLUDE_INC_INFLIGHTTABLE_HPP_
+
+#include <atomic>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/** Number of transaction IDs. TxID in modbus header is of 16 bits*/
+#define TXID_TABLE_SIZE	65536
+
+/**
+ * Table of in-flight requests with one slot per 16-bit transaction ID.
+ * Transaction ID is not tied to identity of the request owner. A free TxID is
+ * claimed when request is sent and is released when response is handled, so
+ * number of owners is not limited by TxID range, only number of requests
+ * in flight at the same time is. Slots are claimed and released with atomic
+ * operations, hence no mutex is needed. TxID 0 is never given out as it
+ * indicates "no request".
+ */
+template <typename T>
+class CInFlightTable
+{
+	std::array<std::atomic<T*>, TXID_TABLE_SIZE> m_arrSlots; /** owner of each TxID*/
+	std::atomic<uint32_t> m_u32NextTxID; /** TxID from which search for free slot starts*/
+	std::atomic<uint32_t> m_u32InFlight; /** number of claimed TxIDs*/
+
+	CInFlightTable(const CInFlightTable&) = delete;	 			// Copy construct
+	CInFlightTable& operator=(const CInFlightTable&) = delete;	// Copy assign
+
+public:
+	CInFlightTable() : m_u32NextTxID{1}, m_u32InFlight{0}
+	{
+		for(auto &slot : m_arrSlots)
+		{
+			slot.store(nullptr, std::memory_order_relaxed);
+		}
+	}
+
+	/**
+	 * Claims a free TxID for given owner. TxIDs are given out in rotation so
+	 * that a released TxID is not reused until all others are used.
+	 * @param a_pOwner	:[in] owner of the request
+	 * @param a_u16TxID	:[out] claimed TxID
+	 * @return 	true : on success,
+	 * 			false : if all TxIDs are in flight
+	 */
+	bool acquire(T *a_pOwner, uint16_t &a_u16TxID)
+	{
+		for(uint32_t u32Try = 0; u32Try < TXID_TABLE_SIZE; ++u32Try)
+		{
+			uint16_t u16TxID = (uint16_t)m_u32NextTxID.fetch_add(1, std::memory_order_relaxed);
+			if(0 == u16TxID)
+			{
+				continue;
+			}
+			T *pExpected = nullptr;
+			if(m_arrSlots[u16TxID].compare_exchange_strong(pExpected, a_pOwner, std::memory_order_acq_rel))
+			{
+				m_u32InFlight.fetch_add(1, std::memory_order_relaxed);
+				a_u16TxID = u16TxID;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+	 * Gets owner of given TxID
+	 * @param a_u16TxID	:[in] TxID
+	 * @return owner, nullptr if TxID is not in flight
+	 */
+	T* get(uint16_t a_u16TxID) const
+	{
+		return m_arrSlots[a_u16TxID].load(std::memory_order_acquire);
+	}
+
+	/**
+	 * Releases given TxID
+	 * @param a_u16TxID	:[in] TxID
+	 * @return owner which was released, nullptr if TxID was not in flight
+	 */
+	T* release(uint16_t a_u16TxID)
+	{
+		T *pOwner = m_arrSlots[a_u16TxID].exchange(nullptr, std::memory_order_acq_rel);
+		if(nullptr != pOwner)
+		{
+			m_u32InFlight.fetch_sub(1, std::memory_order_relaxed);
+		}
+		return pOwner;
+	}
+
+	/**
+	 * Releases all TxIDs
+	 * @return none
+	 */
+	void clear()
+	{
+		for(uint32_t u32TxID = 0; u32TxID < TXID_TABLE_SIZE; ++u32TxID)
+		{
+			release((uint16_t)u32TxID);
+		}
+	}
+
+	uint32_t size() const {return m_u32InFlight.load(std::memory_order_relaxed);}
+};
+
+#endif /* INCLUDE_INC_INFLIGHTTABLE_HPP_ */
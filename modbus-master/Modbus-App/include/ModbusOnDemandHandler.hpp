@@ -28,14 +28,105 @@
 #include "Common.hpp"
 #include <vector>
 #include <queue>
+#include <deque>
+#include <list>
 #include <semaphore.h>
 #include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <map>
+#include <tuple>
+#include <string_view>
+#include <unordered_map>
 #include "eii/msgbus/msgbus.h"
 #include "cjson/cJSON.h"
 #include "PeriodicReadFeature.hpp"
 
+/// max registers in one coalesced write multiple registers request
+#define MAX_COALESCED_REG_COUNT 123
+/// max coils in one coalesced write multiple coils request
+#define MAX_COALESCED_COIL_COUNT 1968
+/// max requests waiting for a worker in each of RT and non-RT work queue
+#define MAX_ONDEMAND_WORK_QUEUE_LEN 1000
+
 const std::string hexDigits {"0123456789ABCDEF"};
 
+/** On-demand write waiting in write aggregation window of a device */
+struct stCoalescedWrite
+{
+	MbusAPI_t m_stMbusApiPram; /** parsed request, its TxID identifies requester*/
+	unsigned char m_u8FunCode; /** function code of request*/
+	void *m_pCallback; /** stack callback of request*/
+};
+
+/** Writes of a device collected during aggregation window */
+struct stWriteBatch
+{
+	std::vector<stCoalescedWrite> m_vWrites; /** writes in arrival order*/
+	std::chrono::steady_clock::time_point m_tpFlush; /** time when window ends*/
+};
+
+/** Request descriptor of a point. It is resolved once from unique point list
+ * and is used as it is for every on-demand request of the point */
+struct stOnDemandRoute
+{
+	int32_t m_i32Ctx; /** context of device*/
+	unsigned char m_u8DevId; /** unit id or slave id*/
+	unsigned char m_u8ReadFunCode; /** function code for read request*/
+	unsigned char m_u8WriteFunCode; /** function code for write request, MBUS_MAX_FUN_CODE if point is not writable*/
+	bool m_bIsByteSwap; /** ByteSwap(true or false)*/
+	bool m_bIsWordSwap; /** WordSwap(true or false)*/
+	bool m_bIsDataPersist; /** Data Persist flag*/
+	uint16_t m_u16StartAddr; /** start address*/
+	uint16_t m_u16Quantity; /** quantity*/
+	int m_iWidth; /** width*/
+	double m_dScaleFactor; /** scale factor*/
+	std::string m_sDataType; /** data type*/
+	std::string m_sWellhead; /** wellhead of point topic*/
+	std::string m_sMetric; /** metric of point topic*/
+	std::string_view m_svTopic; /** point topic, refers to key of unique point list*/
+	const network_info::CUniqueDataPoint *m_pUniquePoint; /** point in unique point list*/
+};
+
+/** Fields of on-demand request borrowed from received envelope. Fields are
+ * valid till envelope is destroyed, hence view is used only while request is parsed */
+struct stOnDemandReqView
+{
+	std::string_view m_svAppSeq; /** app sequence number*/
+	std::string_view m_svMetric; /** Metric name*/
+	std::string_view m_svValue; /** data value*/
+	var_hex m_ScaledValue; /** ScaledValue, used if data value is not given*/
+	std::string_view m_svWellhead; /** well head name*/
+	std::string_view m_svVersion; /** version number*/
+	std::string_view m_svTopic; /** sourcetopic*/
+	std::string_view m_svTimestamp; /** TimeStamp value*/
+	std::string_view m_svUsec; /** Seconds number*/
+	std::string_view m_svMqttTime; /** value of mqtt time*/
+	std::string_view m_svEiiTime; /** value of eii time*/
+};
+
+/** Parameters of a subscribed topic used to process its on-demand requests */
+struct stOnDemandTopic
+{
+	std::string m_sTopic; /** topic for zmq listening*/
+	bool m_bIsRT; /** RT or non-RT(true or false)*/
+	void *m_pCallback; /** stack callback as per the operation*/
+	int m_iRetry; /** retry value to be used for application retry mechanism*/
+	long m_lPriority; /** priority value to be used for stack priority queues*/
+	bool m_bIsWriteReq; /** write or read request*/
+	bool m_bIsBusy; /** a worker is processing write request of this topic, writes of a topic are processed in arrival order*/
+};
+
+/** On-demand request received from ZMQ waiting for a worker */
+struct stOnDemandWork
+{
+	msg_envelope_t *m_pMsg; /** received message*/
+	stOnDemandTopic *m_pTopic; /** topic on which message is received*/
+};
+
+/** Key of write batch: context, unit id, coil or register, RT or non-RT */
+using writeBatchKey_t = std::tuple<int32_t, unsigned char, bool, bool>;
+
 typedef union
 {
 	int16_t i16;
@@ -56,6 +147,21 @@ class onDemandHandler
 {
 	bool m_bIsWriteInitialized; /** write instance (true or false)*/
 
+	std::map<writeBatchKey_t, stWriteBatch> m_mapWriteBatch; /** writes waiting in aggregation window per device*/
+	std::mutex m_mutexWriteBatch; /** mutex for write batches*/
+	std::condition_variable m_cvWriteBatch; /** signals flush thread about new batch*/
+	std::map<unsigned short, std::vector<unsigned short>> m_mapCoalescedTxID; /** TxID of coalesced request to TxIDs of its requesters*/
+	std::mutex m_mutexCoalescedTxID; /** mutex for coalesced TxID map*/
+	std::unordered_map<std::string_view, stOnDemandRoute> m_mapRoute; /** point topic to request descriptor, read-only once built*/
+	std::list<stOnDemandTopic> m_listTopic; /** subscribed topics, list keeps address of topic stable*/
+	std::deque<stOnDemandWork> m_qWorkRT; /** RT requests waiting for a worker*/
+	std::deque<stOnDemandWork> m_qWorkNonRT; /** non-RT requests waiting for a worker*/
+	std::mutex m_mutexWork; /** mutex for topics and work queues*/
+	std::condition_variable m_cvWorkRT; /** signals RT workers about new request*/
+	std::condition_variable m_cvWorkNonRT; /** signals non-RT workers about new request*/
+	std::unordered_map<const network_info::CUniqueDataPoint*, CRefDataForPolling*> m_mapReadCache; /** polled point of unique point, read-only once built*/
+	std::atomic<bool> m_bIsReadCacheBuilt; /** read cache can be used(true or false)*/
+
 	onDemandHandler(); //Default constructor
 	onDemandHandler(onDemandHandler const&);             /// copy constructor is private
 	onDemandHandler& operator=(onDemandHandler const&);  /// assignment operator is private
@@ -68,23 +174,41 @@ class onDemandHandler
 			bool& a_bIsWriteReq,
 			bool& a_bIsRT);
 
+	void addToWriteBatch(const MbusAPI_t &a_stMbusApiPram, unsigned char a_u8FunCode, void *vpCallback);
+
+	void writeBatchFlushThread();
+
+	void sendCoalescedWrites(std::vector<stCoalescedWrite> &a_vWrites);
+
+	void fillRoutingIndex();
+
+	void onDemandWorkerThread(bool a_bIsRT);
+
 public:
 	static onDemandHandler& Instance();
 
-	bool processMsg(msg_envelope_t *msg, std::string stTopic,
+	bool processMsg(msg_envelope_t *msg, const std::string &stTopic,
 			bool a_bIsRT, void *vpCallback,
 			const int a_iRetry,
 			const long a_lPriority,
-			const bool a_bIsWriteReq);
+			const bool a_bIsWriteReq,
+			const eMbusAppErrorCode a_eRejectCode = APP_SUCCESS);
 
 	string getMsgElement(msg_envelope_t *msg, string a_sKey);
 
+	std::string_view getMsgElementView(msg_envelope_t *a_pMsg, const char *a_pszKey);
+
+	bool fillRequestView(msg_envelope_t *a_pMsg, bool a_bIsWriteReq, stOnDemandReqView &a_stReqView);
+
 	eMbusAppErrorCode onDemandInfoHandler(MbusAPI_t *a_pstMbusApiPram,
+			const stOnDemandReqView &a_stReqView,
 			const string a_STopic,
 			void *vpCallback,
-			bool a_IsWriteReq);
+			bool a_IsWriteReq,
+			eMbusAppErrorCode a_eRejectCode = APP_SUCCESS);
 
-	eMbusAppErrorCode jsonParserForOnDemandRequest(MbusAPI_t& stMbusApiPram,
+	eMbusAppErrorCode jsonParserForOnDemandRequest(const stOnDemandReqView &a_stReqView,
+											MbusAPI_t& stMbusApiPram,
 											unsigned char& funcCode,
 											unsigned short txID,
 											const bool a_IsWriteReq);
@@ -103,8 +227,6 @@ public:
 
 	bool isWriteInitialized() {return m_bIsWriteInitialized;}
 
-	bool validateInputJson(std::string stSourcetopic, std::string stWellhead, std::string stCommand);
-
 	void createErrorResponse(eMbusAppErrorCode errorCode,
 			uint8_t  u8FunCode,
 			unsigned short txID,
@@ -121,6 +243,39 @@ public:
 
 	//convert decimal to hexadecimal
 	std::string convertToHexString(uint64_t num, uint8_t width);
+
+	bool isCoalescableWrite(unsigned char a_u8FunCode);
+
+	void groupContiguousWrites(std::vector<stCoalescedWrite> &a_vWrites,
+			std::vector<std::vector<stCoalescedWrite>> &a_vRuns);
+
+	void addContiguousRuns(std::vector<stCoalescedWrite>::iterator a_itrFirst,
+			std::vector<stCoalescedWrite>::iterator a_itrLast,
+			std::vector<std::vector<stCoalescedWrite>> &a_vRuns);
+
+	bool buildCoalescedRequest(const std::vector<stCoalescedWrite> &a_vRun,
+			MbusAPI_t &a_stMbusApiPram, unsigned char &a_u8FunCode);
+
+	bool getCoalescedTxIDs(unsigned short a_u16TxID, std::vector<unsigned short> &a_vTxIDs);
+
+	size_t buildRoutingIndex();
+
+	const stOnDemandRoute* getRoute(std::string_view a_sSourceTopic);
+
+	stOnDemandTopic* registerTopic(const std::string &a_sTopic, bool a_bIsRT,
+			void *vpCallback, int a_iRetry, long a_lPriority, bool a_bIsWriteReq);
+
+	bool enqueueWork(msg_envelope_t *a_pMsg, stOnDemandTopic *a_pTopic);
+
+	bool dequeueWork(stOnDemandWork &a_stWork, bool a_bIsRT);
+
+	void completeWork(const stOnDemandWork &a_stWork);
+
+	void startWorkerPool(uint32_t a_u32WorkerCount);
+
+	size_t buildReadCache();
+
+	bool getCachedRead(const MbusAPI_t &a_stMbusApiPram, stMbusAppCallbackParams_t &a_stResp);
 };
 
 
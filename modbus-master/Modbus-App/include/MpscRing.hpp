@@ -0,0 +1,147 @@
+/********************************************************************************
+* Copyright (c) 2021 Intel Corporation.
+
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*********************************************************************************/
+
+/*** MpscRing.hpp is bounded lock-free ring with preallocated slots for
+ * multiple producers and single consumer*/
+
+#ifndef INCLUDE_INC_MPSCRING_HPP_
+#define INCLUDE_INC_MPSCRING_HPP_
+
+#include <atomic>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Bounded ring of preallocated slots. Any number of threads can push, only one
+ * thread can pop. Each slot carries a sequence number which tells whether slot
+ * is free for producer or filled for consumer, hence no mutex is needed.
+ * Data is filled and consumed in place, nothing is allocated after construction.
+ */
+template <typename T, size_t N>
+class CMpscRing
+{
+	static_assert((N >= 2) && (0 == (N & (N - 1))), "Ring size must be power of 2");
+
+	/**slot of ring*/
+	struct stSlot
+	{
+		std::atomic<size_t> m_seq; /** sequence number of slot*/
+		T m_data; /** data of slot*/
+	};
+
+	std::array<stSlot, N> m_arrSlots; /** preallocated slots*/
+	alignas(64) std::atomic<size_t> m_enqPos; /** next position to be claimed by producer*/
+	alignas(64) std::atomic<size_t> m_deqPos; /** next position to be consumed*/
+	std::atomic<uint64_t> m_u64DropCount; /** number of pushes rejected as ring was full*/
+
+	CMpscRing(const CMpscRing&) = delete;	 			// Copy construct
+	CMpscRing& operator=(const CMpscRing&) = delete;	// Copy assign
+
+public:
+	CMpscRing() : m_enqPos{0}, m_deqPos{0}, m_u64DropCount{0}
+	{
+		for(size_t index = 0; index < N; ++index)
+		{
+			m_arrSlots[index].m_seq.store(index, std::memory_order_relaxed);
+		}
+	}
+
+	/**
+	 * Claims a free slot and fills it using given function
+	 * @param a_fnFill	:[in] function called as a_fnFill(T&) to fill the claimed slot
+	 * @return 	true : on success,
+	 * 			false : if ring is full
+	 */
+	template <typename Fill>
+	bool push(Fill a_fnFill)
+	{
+		size_t pos = m_enqPos.load(std::memory_order_relaxed);
+		stSlot *pSlot = NULL;
+		while(true)
+		{
+			pSlot = &m_arrSlots[pos & (N - 1)];
+			size_t seq = pSlot->m_seq.load(std::memory_order_acquire);
+			intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+			if(0 == diff)
+			{
+				if(m_enqPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				{
+					break;
+				}
+			}
+			else if(diff < 0)
+			{
+				// slot is not yet consumed, ring is full
+				m_u64DropCount.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+			else
+			{
+				pos = m_enqPos.load(std::memory_order_relaxed);
+			}
+		}
+
+		a_fnFill(pSlot->m_data);
+		// make the slot visible to consumer
+		pSlot->m_seq.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * Consumes the oldest filled slot using given function. Must be called
+	 * from single consumer thread only.
+	 * @param a_fnConsume	:[in] function called as a_fnConsume(T&) for the slot
+	 * @return 	true : on success,
+	 * 			false : if ring is empty or oldest slot is still being filled
+	 */
+	template <typename Consume>
+	bool pop(Consume a_fnConsume)
+	{
+		size_t pos = m_deqPos.load(std::memory_order_relaxed);
+		stSlot &slot = m_arrSlots[pos & (N - 1)];
+		size_t seq = slot.m_seq.load(std::memory_order_acquire);
+		if((intptr_t)seq - (intptr_t)(pos + 1) < 0)
+		{
+			return false;
+		}
+
+		a_fnConsume(slot.m_data);
+		m_deqPos.store(pos + 1, std::memory_order_relaxed);
+		// slot is free for producer of next round
+		slot.m_seq.store(pos + N, std::memory_order_release);
+		return true;
+	}
+
+	size_t size() const
+	{
+		size_t enq = m_enqPos.load(std::memory_order_relaxed);
+		size_t deq = m_deqPos.load(std::memory_order_relaxed);
+		return (enq > deq) ? (enq - deq) : 0;
+	}
+
+	size_t capacity() const {return N;}
+
+	uint64_t getDropCount() const {return m_u64DropCount.load(std::memory_order_relaxed);}
+};
+
+#endif /* INCLUDE_INC_MPSCRING_HPP_ */
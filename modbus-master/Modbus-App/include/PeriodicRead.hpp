@@ -30,6 +30,8 @@
 #include <list>
 #include <thread>
 #include <queue>
+#include <array>
+#include <atomic>
 #include <algorithm>
 #include <mutex>
 #include <chrono>
@@ -40,7 +42,21 @@
 #include "PublishJson.hpp"
 #include "ConfigManager.hpp"
 #include "API.h"
-
+#include "MpscRing.hpp"
+#include "PolledUpdate.hpp"
+
+/** Maximum number of data bytes in a Modbus response received from stack */
+#define MAX_MBUS_RESP_DATA_LEN 256
+/** Number of preallocated slots in each response ring, must be power of 2 */
+#define RESPONSE_RING_SIZE 1024
+/** Number of preallocated slots in each overflow ring, must be power of 2 */
+#define OVERFLOW_RING_SIZE 256
+/** Number of response rings, one per callback type */
+#define RESPONSE_RING_COUNT 6
+/** Maximum number of response topics which can be interned */
+#define MAX_INTERNED_TOPICS 32
+/** Topic ID used when topic could not be interned */
+#define INVALID_TOPIC_ID 0xFFFF
 
 /**node for response Q*/
 struct stStackResponse
@@ -54,7 +70,36 @@ struct stStackResponse
 	long m_lPriority; /** msg priority */
 	uint8_t  m_u8FunCode; /** Function code */
 	eMbusCallbackType m_operationType; /** type of operation*/
-	std::string m_strResponseTopic; /** Response topic name*/
+	uint16_t m_u16TopicID; /** Interned ID of response topic name*/
+	bool m_bIsRT; /** Real Time (true or false) */
+};
+
+/**slot of response ring. Data bytes are kept inline so that stack callback does not allocate*/
+struct stStackResponseSlot
+{
+	stException_t m_stException; /** reference of struct stException_t*/
+	std::array<uint8_t, MAX_MBUS_RESP_DATA_LEN> m_au8Value; /** data values*/
+	uint16_t m_u16ValueLen; /** number of valid bytes in m_au8Value*/
+	bool bIsValPresent; /** Value present or not(true or false) */
+	uint8_t u8Reason; /** Reason value */
+	uint16_t u16TransacID; /** Transaction ID number */
+	stTimeStamps m_objStackTimestamps; /** reference of struct stTimeStamps*/
+	long m_lPriority; /** msg priority */
+	uint8_t  m_u8FunCode; /** Function code */
+	eMbusCallbackType m_operationType; /** type of operation*/
+	uint16_t m_u16TopicID; /** Interned ID of response topic name*/
+	bool m_bIsRT; /** Real Time (true or false) */
+};
+
+/**slot of overflow ring. Response which did not fit in response ring is kept without
+ * its data, so that response process thread still completes its request with an error*/
+struct stOverflowSlot
+{
+	uint16_t u16TransacID; /** Transaction ID number */
+	stTimeStamps m_objStackTimestamps; /** reference of struct stTimeStamps*/
+	long m_lPriority; /** msg priority */
+	uint8_t  m_u8FunCode; /** Function code */
+	uint16_t m_u16TopicID; /** Interned ID of response topic name*/
 	bool m_bIsRT; /** Real Time (true or false) */
 };
 
@@ -63,18 +108,11 @@ class CRefDataForPolling;
 /*class for periodic response */
 class CPeriodicReponseProcessor{
 private:
-	std::queue <stStackResponse> stackPollingResQ; /** polling Response queue*/
-	std::queue <stStackResponse> stackRTPollingResQ; /** RT polling Response queue*/
-	std::queue <stStackResponse> stackOnDemandReadResQ; /** On-Demand read response queue*/
-	std::queue <stStackResponse> stackOnDemandRTReadResQ; /** On-Demand RT read response queue*/
-	std::queue <stStackResponse> stackOnDemandWriteResQ; /** On-Demand write response queue*/
-	std::queue <stStackResponse> stackOnDemandRTWriteResQ; /** On-Demand RT write response queue*/
-	std::mutex __resQPollingMutex; /** polling response queue mutex*/
-	std::mutex __resQRTPollingMutex; /** RT polling Response queue mutex*/
-	std::mutex __resQODReadMutex; /** On-Demand read response queue mutex*/
-	std::mutex __resQODRTReadMutex; /* On-Demand RT read response queue mutex*/
-	std::mutex __resQODWriteMutex; /** On-Demand write response queue mutex*/
-	std::mutex __resQODRTWriteMutex; /** On-Demand RT write response queue mutex*/
+	CMpscRing<stStackResponseSlot, RESPONSE_RING_SIZE> m_arrRespRings[RESPONSE_RING_COUNT]; /** response rings, one per callback type*/
+	CMpscRing<stOverflowSlot, OVERFLOW_RING_SIZE> m_arrOverflowRings[RESPONSE_RING_COUNT]; /** responses which did not fit in response ring, one per callback type*/
+	std::array<std::string, MAX_INTERNED_TOPICS> m_arrTopics; /** interned response topics*/
+	std::atomic<uint16_t> m_u16TopicCount; /** number of interned response topics*/
+	std::mutex m_topicMutex; /** used only while interning new topic*/
 	sem_t semPollingRespProcess; /** semaphore for polling response*/
 	sem_t semRTPollingRespProcess; /** semaphore for RT polling response*/
 	sem_t semODReadRespProcess; /** semaphore for On-demand read response*/
@@ -83,7 +121,7 @@ private:
 	sem_t semRTODWriteRespProcess; /** semaphore for RT On-demand write response*/
 	bool m_bIsInitialized; /** true or false*/
 
-	bool pushToQueue(struct stStackResponse &stStackResNode, eMbusCallbackType operationCallbackType);
+	sem_t* getRespSem(eMbusCallbackType operationCallbackType);
 	bool getDataToProcess(struct stStackResponse &a_stStackResNode, eMbusCallbackType operationCallbackType);
 	bool checkForRetry(struct stStackResponse &a_stStackResNode, eMbusCallbackType operationCallbackType);
 	void getCallbackForRetry(void** callbackFunc, eMbusCallbackType operationCallbackType);
@@ -91,6 +129,13 @@ private:
 	bool prepareResponseJson(std::string &a_rtOrNrt, std::string &a_responseMqttTopic, msg_envelope_t** a_pmsg, std::string &a_sValue, const CRefDataForPolling* a_objReqData, stStackResponse a_stResp, struct timespec *a_pstTsPolling);
 	bool postResponseJSON(stStackResponse& a_stResp, const CRefDataForPolling* a_objReqData, struct timespec *a_pstTsPolling);
 	bool postResponseJSON(stStackResponse& a_stResp);
+	bool postBlockResponseJSON(stStackResponse& a_stResp, CRefDataForPolling& a_objBlockLeader);
+	bool fillPolledResponseJson(msg_envelope_t* a_pMsg, std::string &a_sValue, const CRefDataForPolling& a_objReqData, const stStackResponse& a_stResp, struct timespec *a_pstTsPolling,
+			bool &a_bIsReportRequired);
+	bool postPolledResponseJSON(stStackResponse& a_stResp, const CRefDataForPolling* a_objReqData, struct timespec *a_pstTsPolling);
+	bool fillPolledUpdate(stPolledUpdate &a_stUpdate, std::string &a_sValue, const CRefDataForPolling& a_objReqData, const stStackResponse& a_stResp, struct timespec *a_pstTsPolling,
+			bool &a_bIsReportRequired, msg_envelope_elem_body_t* &a_pScaledValue);
+	bool postPolledResponseBinary(stStackResponse& a_stResp, const CRefDataForPolling* a_objReqData, struct timespec *a_pstTsPolling);
 
 	bool initSem();
 	eMbusAppErrorCode respProcessThreads(eMbusCallbackType operationCallbackType,
@@ -99,18 +144,27 @@ private:
 	CPeriodicReponseProcessor();
 	CPeriodicReponseProcessor(CPeriodicReponseProcessor const&);             /// copy constructor is private
 	CPeriodicReponseProcessor& operator=(CPeriodicReponseProcessor const&);  /// assignment operator is private
-	std::string mapMqttToEMBRespTopic(std::string mqttRespTopic, bool isRealTime, std::string tcpOrRtu);	
 
 public:
+	std::string mapMqttToEMBRespTopic(std::string mqttRespTopic, bool isRealTime, std::string tcpOrRtu);
 	static CPeriodicReponseProcessor& Instance();
 	void handleResponse(stMbusAppCallbackParams_t *pstMbusAppCallbackParams,
 						eMbusCallbackType operationCallbackType,
-						std::string strResponseTopic, bool a_bIsRT);
+						uint16_t a_u16TopicID, bool a_bIsRT);
+	void handleResponse(stMbusAppCallbackParams_t *pstMbusAppCallbackParams,
+						eMbusCallbackType operationCallbackType,
+						const std::string &strResponseTopic, bool a_bIsRT);
+	uint16_t internTopic(const std::string &a_sTopic);
+	const std::string& getInternedTopic(uint16_t a_u16TopicID) const;
+	uint64_t getOverflowResponseCount(eMbusCallbackType operationCallbackType) const;
+	uint64_t getDroppedResponseCount(eMbusCallbackType operationCallbackType) const;
 	bool isInitialized() {return m_bIsInitialized;}
 	void initRespHandlerThreads();
 	bool postDummyBADResponse(CRefDataForPolling& a_objReqData, const stException_t m_stException, struct timespec *a_pstRefPollTime);
 	bool postLastResponseForCutoff(CRefDataForPolling& a_objReqData);
+	bool postDeviceStatusJSON(const CRefDataForPolling& a_objReqData, bool a_bIsDown);
 	msg_envelope_elem_body_t* setScaledValue(std::string a_sValue, std::string a_sDataType,double dScaleFactor, int a_iWidth);
+	msg_envelope_elem_body_t* setScaledValue(const std::vector<uint8_t> &a_vValue, const stValueDecoder &a_stDecoder);
 };
 
 
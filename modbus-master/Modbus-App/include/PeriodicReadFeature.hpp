@@ -27,12 +27,18 @@
 
 #include <vector>
 #include <map>
+#include <list>
+#include <deque>
 #include <mutex>
+#include <memory>
 #include <semaphore.h>
 #include "NetworkInfo.hpp"
 #include "ZmqHandler.hpp"
+#include "EmbBatch.hpp"
+#include "PolledUpdate.hpp"
 #include <functional>
 #include "PeriodicRead.hpp"
+#include "InFlightTable.hpp"
 #include "ConfigManager.hpp"
 
 using network_info::CUniqueDataPoint;
@@ -40,6 +46,13 @@ using zmq_handler::stZmqContext;
 using zmq_handler::stZmqPubContext;
 
 class CRefDataForPolling;
+struct stPendingRequest;
+class CDeviceRequestQueue;
+
+/** Maximum number of registers which can be read using a single Modbus request */
+#define MAX_REGISTERS_PER_READ_REQ 125
+/** Maximum number of coils / discrete inputs which can be read using a single Modbus request */
+#define MAX_COILS_PER_READ_REQ 2000
 
 /**class for time record*/
 class CTimeRecord
@@ -56,6 +69,9 @@ class CTimeRecord
 
 	std::vector<CRefDataForPolling> m_vPolledPoints; /** vector of polled points*/
 	std::vector<CRefDataForPolling> m_vPolledPointsRT; /** vector of RT polled points*/
+	std::vector<uint32_t> m_vPhaseOffsets; /** offsets in ms, within interval, at which points are polled*/
+	std::map<uint32_t, std::vector<uint32_t>> m_mapPhasePoints; /** phase offset to index of points, in polled point list, of that phase*/
+	std::map<uint32_t, std::vector<uint32_t>> m_mapPhasePointsRT; /** phase offset to index of points, in RT polled point list, of that phase*/
 	std::mutex m_vectorMutex; /** vector mutex*/
 	bool m_bIsRTAvailable; /** Real Time available(true or false)*/
 	bool m_bIsNonRTAvailable; /** Non RT available (true or false)*/
@@ -66,6 +82,8 @@ class CTimeRecord
 
 	CTimeRecord(CTimeRecord &a_oTimeRecord)
 	: m_vPolledPoints(a_oTimeRecord.m_vPolledPoints), m_vPolledPointsRT(a_oTimeRecord.m_vPolledPointsRT),
+	  m_vPhaseOffsets(a_oTimeRecord.m_vPhaseOffsets),
+	  m_mapPhasePoints(a_oTimeRecord.m_mapPhasePoints), m_mapPhasePointsRT(a_oTimeRecord.m_mapPhasePointsRT),
 	  m_bIsRTAvailable(a_oTimeRecord.m_bIsRTAvailable), m_bIsNonRTAvailable(a_oTimeRecord.m_bIsNonRTAvailable)
 	{
 		m_u32Interval.store(a_oTimeRecord.m_u32Interval);
@@ -92,6 +110,14 @@ class CTimeRecord
 		return m_vPolledPointsRT;
 	}
 	bool add(CRefDataForPolling &a_oPoint);
+	uint32_t buildPollingBlocks(int32_t a_i32MaxGap);
+	uint32_t buildPollingPhases(uint32_t a_u32StepMs);
+	const std::vector<uint32_t>& getPhaseOffsets() const
+	{
+		return m_vPhaseOffsets;
+	}
+	uint32_t buildPhasePoints();
+	const std::vector<uint32_t>& getPhasePoints(uint32_t a_u32PhaseOffset, bool a_bIsRT);
 	uint32_t size() 
 	{
 		std::lock_guard<std::mutex> lock(m_vectorMutex);
@@ -101,19 +127,51 @@ class CTimeRecord
 	bool isNonRTListAvailable() { return m_bIsNonRTAvailable; };
 };
 
-/**Structure of polling tracker*/
+/** Number of slots in polling timer wheel, must be power of 2 */
+#define TIMER_WHEEL_SLOTS 1024
+
+/**Structure of polling tracker. It is an entry of polling timer wheel*/
 struct StPollingTracker
 {
 	uint32_t m_uiPollInterval; /**  polling interval*/
 	std::reference_wrapper<CTimeRecord> m_objTimeRecord; /** wrapper for time record*/
 	bool m_bIsPolling;/** polling or not(true or false)*/
+	uint32_t m_u32PhaseOffset; /** offset in ms, within interval, of points handled by this entry*/
+	uint64_t m_u64ExpiryTick; /** timer tick at which this entry fires next*/
+	uint32_t m_u32PeriodTicks; /** number of timer ticks between two firings*/
+	StPollingTracker* m_pNext; /** next entry in same wheel slot*/
     //constructor
 	StPollingTracker(uint32_t a_uiPollInterval, std::reference_wrapper<CTimeRecord> a_objTimeRecord, bool a_bIsPolling)
 		: m_uiPollInterval{a_uiPollInterval}, m_objTimeRecord{a_objTimeRecord}, m_bIsPolling{a_bIsPolling}
+		, m_u32PhaseOffset{0}, m_u64ExpiryTick{0}, m_u32PeriodTicks{1}, m_pNext{NULL}
 	{
 	}
 };
 
+/**
+ * class for hashed timer wheel. Entries are linked in the slot of their expiry tick,
+ * so scheduling and firing an entry is O(1) and does not allocate. An entry having
+ * expiry beyond one wheel round stays in its slot till its expiry tick is reached.
+ */
+class CTimerWheel
+{
+	private:
+	CTimerWheel(const CTimerWheel&) = delete;	 			// Copy construct
+	CTimerWheel& operator=(const CTimerWheel&) = delete;	// Copy assign
+
+	std::vector<StPollingTracker*> m_vSlots; /** head of entry list of each slot*/
+	uint64_t m_u64CurTick; /** number of ticks elapsed since start*/
+	uint32_t m_u32SlotMask; /** mask to get slot from tick*/
+
+	public:
+	explicit CTimerWheel(uint32_t a_u32SlotCount = TIMER_WHEEL_SLOTS);
+
+	void schedule(StPollingTracker &a_oEntry, uint64_t a_u64ExpiryTick);
+	StPollingTracker* advance();
+	void clear();
+	uint64_t getCurrentTick() const {return m_u64CurTick;}
+};
+
 /**class for time mapper*/
 class CTimeMapper
 {
@@ -124,7 +182,11 @@ class CTimeMapper
 	std::map<uint32_t, CTimeRecord> m_mapTimeRecord; /** map for time record*/
 	std::mutex m_mapMutex; /** map mutex */
 	
-	std::map<uint32_t, std::vector<struct StPollingTracker>> m_mapPollingTracker; /** polling tracker map*/
+	std::list<StPollingTracker> m_lstPollingTracker; /** entries of polling timer wheel*/
+	CTimerWheel m_oTimerWheel; /** timer wheel for polling and cutoff*/
+	uint32_t m_u32TickMs; /** duration of one timer tick in milliseconds*/
+	std::mutex m_wheelMutex; /** timer wheel mutex */
+	uint32_t m_u32StaggerStepMs; /** step of polling phase offsets, 0 if staggering is disabled*/
 
 	// Default constructor
 	CTimeMapper();
@@ -139,8 +201,7 @@ class CTimeMapper
 		return timeMapper;
 	}
 	void ioPeriodicReadTimer(int v);
-	//void checkTimer(uint32_t a_uiInterval, struct timespec& a_tsPollTime);
-	void checkTimer(const uint32_t &a_uiMaxCounter, uint32_t a_uiInterval, struct timespec& a_tsPollTime);
+	void checkTimer(struct timespec& a_tsPollTime);
 	void initTimerFunction();
 
 	/**
@@ -159,14 +220,23 @@ class CTimeMapper
 		}
 		return m_mapTimeRecord.at(uiRef).getPolledPointList();
 	}
+	const std::vector<uint32_t>& getPhasePointList(uint32_t uiRef, uint32_t a_u32PhaseOffset, bool a_bIsRT)
+	{
+		return m_mapTimeRecord.at(uiRef).getPhasePoints(a_u32PhaseOffset, a_bIsRT);
+	}
 
 	bool insert(uint32_t a_uTime, CRefDataForPolling &a_oPoint);
 
+	uint32_t buildPollingBlocks(int32_t a_i32MaxGap);
+	uint32_t buildPollingPhases(uint32_t a_u32StepMs);
+	uint32_t buildDeviceQueues();
+	uint32_t getPolledPoints(std::vector<CRefDataForPolling*> &a_vPoints);
+
 	uint32_t getMinTimerFrequency();
 
-	uint32_t preparePollingTracker();
-	bool getPollingTrackerList(uint32_t a_uiCounter, std::vector<StPollingTracker> &a_listPollInterval);
-	void addToPollingTracker(uint32_t a_uiCounter, CTimeRecord &a_objTimeRecord, bool a_bIsPolling);
+	uint32_t preparePollingTracker(uint32_t a_u32TickMs);
+	void addToPollingTracker(CTimeRecord &a_objTimeRecord, bool a_bIsPolling, uint32_t a_u32FirstDueMs, uint32_t a_u32PhaseOffset = 0);
+	void clearPollingTracker();
 };
 
 /**Structure for polling instance
@@ -175,6 +245,7 @@ struct StPollingInstance
 {
 	uint32_t m_uiPollInterval; /** POlling interval*/
 	struct timespec m_tsPollTime; /** object of struct timespec*/
+	uint32_t m_u32PhaseOffset; /** offset in ms, within interval, of points to be handled*/
 };
 
 /*class For request initiation*/
@@ -192,6 +263,7 @@ private:
 
 	void initiateRequest(struct timespec &a_stPollTimestamp,
 			std::vector<CRefDataForPolling>&,
+			const std::vector<uint32_t> &a_vPhasePoints,
 			bool isRTRequest,
 			const long a_lPriority,
 			int a_nRetry,
@@ -201,15 +273,15 @@ private:
 	sem_t semaphoreReqProcess, semaphoreRespProcess; /** semaphore for request process and response process*/
 	sem_t semaphoreRTReqProcess, semaphoreRTRespProcess; /** semaphore fro RT request process and RT response process*/
 
-	std::map<unsigned short, std::reference_wrapper<CRefDataForPolling>> m_mapTxIDReqData; /**  map for transaction request data*/
-	std::map<unsigned short, std::reference_wrapper<CRefDataForPolling>> m_mapTxIDReqDataRT; /** map for RT transaction request data*/
-	/// mutex for operation on m_mapTxIDReqData map
-	std::mutex m_mutextTxIDMap, m_mutextTxIDMapRT; /** mutex for transaction ID map and transcation ID RT map */
+	CInFlightTable<CRefDataForPolling> m_oTxIDTable; /** in-flight table for transaction request data*/
+	CInFlightTable<CRefDataForPolling> m_oTxIDTableRT; /** in-flight table for RT transaction request data*/
 
 	bool init();
 	bool sendRequest(CRefDataForPolling &a_stRdPrdObj, uint16_t &m_u16TxId,
 			bool isRTRequest, const long a_lPriority, int a_nRetry,
 			void* a_ptrCallbackFunc);
+	bool dispatchRequest(stPendingRequest &a_stReq);
+	void dispatchPendingRequests(CDeviceRequestQueue &a_oDeviceQueue);
 
 	std::queue <struct StPollingInstance> m_qReqFreq, m_qRespFreq; /** queue for request frequest and resposnse queue*/
 	std::queue <struct StPollingInstance> m_qReqFreqRT, m_qRespFreqRT;/** queue for RT request frequency and RT response frequency*/
@@ -231,15 +303,27 @@ public:
 
 	CRefDataForPolling& getTxIDReqData(unsigned short, bool a_bIsRT);
 
-	// function to insert new entry in map
-	void insertTxIDReqData(unsigned short, CRefDataForPolling&, bool a_bIsRT);
+	// function to claim a free txid for a point
+	bool allocateTxID(CRefDataForPolling&, bool a_bIsRT, uint16_t &a_u16TxID);
 
-	// function to check if a txid is present in a map
+	// function to check if a txid is in flight
 	bool isTxIDPresent(unsigned short tokenId, bool a_bIsRT);
 
-	// function to remove entry from the map once reply is sent
+	// function to check if a txid is in flight for given point
+	bool isTxIDOwnedBy(unsigned short tokenId, const CRefDataForPolling &a_objReqData, bool a_bIsRT);
+
+	// function to release txid once reply is sent
 	void removeTxIDReqData(unsigned short, bool a_bIsRT);
 
+	// function to get number of txids in flight
+	uint32_t getInFlightCount(bool a_bIsRT) const;
+
+	// function to free device slot of a request once reply is received
+	void completeRequest(CRefDataForPolling &a_objReqData);
+
+	// function to update device state using reply of a request
+	void recordDeviceResponse(CRefDataForPolling &a_objReqData, const stException_t &a_stException);
+
 	const sem_t& getSemaphoreReqProcess() const {
 		return semaphoreReqProcess;
 	}
@@ -253,8 +337,117 @@ public:
 */
 struct stLastGoodResponse
 {
-	std::string m_sValue; /** data value*/
+	std::string m_sValue; /** data value in hex string, if enabled*/
+	std::vector<uint8_t> m_vValue; /** data value as received from device*/
 	std::string m_sLastUsec; /** value of last seconds*/
+	struct timespec m_tsReceived; /** time when value was last received from device*/
+};
+
+/**structure for report-by-exception state of a polled point
+*/
+struct stReportState
+{
+	bool m_bIsGoodReported; /** last report had good value(true or false)*/
+	bool m_bIsNumeric; /** last reported scaled value is numeric(true or false)*/
+	double m_dValue; /** last reported scaled value, if numeric*/
+	std::vector<uint8_t> m_vValue; /** last reported value as received from device*/
+	struct timespec m_tsReported; /** time of last report*/
+	uint32_t m_u32DownCount; /** down count of device at last report*/
+};
+
+/**structure for publish template of a polled point.
+ * Invariant fields are added to envelope once and only variable fields
+ * are replaced for every response of the point.
+*/
+struct stPublishTemplate
+{
+	std::string m_sDataTopic; /** data topic of point, e.g. /flowmeter/PL0/DP13/update*/
+	std::string m_sEmbTopic; /** EMB topic on which point data is published*/
+	std::string m_sBatchTopic; /** EMB topic on which point data is published in batch, e.g. TCP/RT/update*/
+	bool m_bIsRealTime; /** realtime point(true or false)*/
+	msg_envelope_t* m_pMsg; /** envelope having invariant fields of point*/
+	zmq_handler::stZmqPubHandle* m_pPubHandle; /** publisher of EMB topic, resolved on first publish*/
+	std::string m_sStatusDataTopic; /** data topic of device status, e.g. /flowmeter/PL0/update*/
+	std::string m_sStatusEmbTopic; /** EMB topic on which device status is published*/
+	zmq_handler::stZmqPubHandle* m_pStatusPubHandle; /** publisher of device status EMB topic, resolved on first publish*/
+	stPolledUpdate m_stUpdate; /** update of point in binary form, invariant fields are filled once*/
+	std::string m_sBinBuf; /** encoded binary update, buffer is reused for every response*/
+	std::mutex m_mutex; /** envelope is used for one response at a time*/
+
+	stPublishTemplate() : m_bIsRealTime{false}, m_pMsg{NULL}, m_pPubHandle{NULL}, m_pStatusPubHandle{NULL}
+	{
+	}
+
+	~stPublishTemplate()
+	{
+		if(NULL != m_pMsg)
+		{
+			msgbus_msg_envelope_destroy(m_pMsg);
+			m_pMsg = NULL;
+		}
+	}
+};
+
+/**structure for polling request which is waiting for its turn to be sent to device
+*/
+struct stPendingRequest
+{
+	CRefDataForPolling* m_pReqData; /** point (or block leader) to be polled*/
+	struct timespec m_tsPoll; /** timestamp at which polling interval triggered*/
+	bool m_bIsRT; /** RT request(true or false)*/
+	long m_lPriority; /** priority to be used for sending request*/
+	int m_nRetry; /** request retries to be performed in case of timeout*/
+	void* m_ptrCallbackFunc; /** callback function to be called by stack to send response*/
+};
+
+/** Interval in ms after which a down device is probed first time. It is doubled for every failed probe.*/
+#define DEVICE_PROBE_MIN_BACKOFF_MS 1000
+
+/**
+ * class for polling requests of a device. It limits number of requests in flight
+ * to the device and keeps other requests pending till a response of the device is
+ * received. A slow device, thus, holds only its own requests. Pending RT requests
+ * are sent before pending Non-RT requests.
+ * It also acts as circuit breaker for the device. After given number of consecutive
+ * timeouts, device is treated as down and only one probe request is sent to it
+ * with exponential backoff till the device responds again.
+ */
+class CDeviceRequestQueue
+{
+	CDeviceRequestQueue(const CDeviceRequestQueue&) = delete;	 			// Copy construct
+	CDeviceRequestQueue& operator=(const CDeviceRequestQueue&) = delete;	// Copy assign
+
+	std::string m_sDeviceKey; /** site and device ID of device*/
+	std::deque<stPendingRequest> m_qPending; /** pending Non-RT requests*/
+	std::deque<stPendingRequest> m_qPendingRT; /** pending RT requests*/
+	uint32_t m_u32InFlight; /** number of requests sent to device and not yet responded*/
+	uint32_t m_u32ConsecutiveTimeouts; /** number of timeouts since last response of device*/
+	bool m_bIsDown; /** device is down(true or false)*/
+	uint32_t m_u32BackoffMs; /** interval in ms till next probe of down device*/
+	struct timespec m_tsNextProbe; /** time at which down device is probed next*/
+	std::atomic<uint32_t> m_u32DownCount; /** number of times device is found to be down*/
+	std::mutex m_mutex; /** mutex for queues, in-flight count and device state*/
+
+	public:
+	explicit CDeviceRequestQueue(const std::string &a_sDeviceKey) : m_sDeviceKey{a_sDeviceKey}, m_u32InFlight{0}
+		, m_u32ConsecutiveTimeouts{0}, m_bIsDown{false}, m_u32BackoffMs{0}, m_tsNextProbe{0}, m_u32DownCount{0}
+	{
+	}
+
+	const std::string& getDeviceKey() const {return m_sDeviceKey;}
+	uint32_t getDownCount() const {return m_u32DownCount.load(std::memory_order_acquire);}
+
+	void push(const stPendingRequest &a_stReq);
+	bool pop(uint32_t a_u32MaxInFlight, stPendingRequest &a_stReq);
+	void complete();
+	uint32_t getInFlightCount();
+	size_t getPendingCount();
+
+	bool recordTimeout(uint32_t a_u32TimeoutLimit, uint32_t a_u32MaxBackoffMs, const struct timespec &a_tsNow,
+			std::vector<stPendingRequest> &a_vDropped);
+	bool recordSuccess();
+	bool isPollAllowed(const struct timespec &a_tsNow);
+	bool isDown();
 };
 
 /*class of reference data for polling*/
@@ -263,11 +456,13 @@ class CRefDataForPolling
 	const network_info::CUniqueDataPoint& m_objDataPoint; /**reference of class CUniqueDataPoint*/
 
 	uint8_t m_uiFuncCode; /** code of function*/
+	stValueDecoder m_stValueDecoder; /** decoder for value of this point*/
 
 	std::atomic<bool> m_bIsRespPosted; /** response posted(true or false)*/
 
 	std::atomic<bool> m_bIsLastRespAvailable; /** last response available(true or false) */
 	stLastGoodResponse m_oLastGoodResponse; /** reference of struct m_oLastGoodResponse*/
+	stReportState m_stReportState; /** report-by-exception state, guarded by last response mutex*/
 	struct timespec m_stPollTsForReq; /** reference of struct timespec*/
 	std::mutex m_mutexLastResp; /** last response mutex */
 
@@ -277,6 +472,14 @@ class CRefDataForPolling
 	struct timespec m_stRetryTs; /** reference of struct timespec*/
 	int m_iReqRetriedCnt; /** retried request count*/
 
+	std::vector<std::ptrdiff_t> m_vBlockPointOffset; /** position, relative to this point in polled point list, of other points polled with request of this point*/
+	bool m_bIsBlockMember; /** point is polled with request of another point(true or false)*/
+	uint32_t m_u32PhaseOffset; /** offset in ms, within polling interval, at which point is polled*/
+
+	std::shared_ptr<stPublishTemplate> m_pPublishTemplate; /** publish template, shared with copies of this point*/
+	std::shared_ptr<CDeviceRequestQueue> m_pDeviceQueue; /** request queue of device of this point*/
+	std::atomic<bool> m_bIsReqPending; /** request is waiting in device queue(true or false)*/
+
 	CRefDataForPolling& operator=(const CRefDataForPolling&) = delete;	// Copy assign
 
 	public:
@@ -298,8 +501,19 @@ class CRefDataForPolling
 
 	const CUniqueDataPoint & getDataPoint() const {return m_objDataPoint;}
 
-	bool saveGoodResponse(const std::string& a_sValue, const std::string& a_sUsec);
+	const stValueDecoder& getValueDecoder() const {return m_stValueDecoder;}
+
+	bool buildPublishTemplate();
+	std::shared_ptr<stPublishTemplate> getPublishTemplate() const {return m_pPublishTemplate;}
+
+	bool saveGoodResponse(const std::string& a_sValue, const std::vector<uint8_t>& a_vValue, const std::string& a_sUsec);
 	stLastGoodResponse getLastGoodResponse();
+	void refreshGoodResponse(const std::vector<uint8_t>& a_vValue);
+	bool getFreshResponse(uint32_t a_u32MaxAgeMs, stMbusAppCallbackParams_t &a_stResp);
+
+	bool isReportByException() const;
+	bool isReportRequired(const msg_envelope_elem_body_t* a_pScaledValue, const std::vector<uint8_t>& a_vValue);
+	void setReported(bool a_bIsGood, const msg_envelope_elem_body_t* a_pScaledValue, const std::vector<uint8_t>& a_vValue);
 
 	uint16_t getReqTxID() { return m_uReqTxID.load(); };
 	void setReqTxID(uint16_t a_uTxID) { m_uReqTxID.store(a_uTxID); };
@@ -319,6 +533,23 @@ class CRefDataForPolling
 	}
 
 	MbusAPI_t& getMBusReq() {return m_stMBusReq;};
+
+	uint32_t getPhaseOffset() const {return m_u32PhaseOffset;};
+	std::shared_ptr<CDeviceRequestQueue> getDeviceQueue() const {return m_pDeviceQueue;};
+	void setDeviceQueue(std::shared_ptr<CDeviceRequestQueue> a_pDeviceQueue) {m_pDeviceQueue = a_pDeviceQueue;};
+	bool isReqPending() const {return m_bIsReqPending.load();};
+	void setReqPending(bool a_bIsPending) {m_bIsReqPending.store(a_bIsPending);};
+	void setPhaseOffset(uint32_t a_u32PhaseOffset) {m_u32PhaseOffset = a_u32PhaseOffset;};
+
+	bool isBlockLeader() const {return (false == m_vBlockPointOffset.empty());};
+	bool isBlockMember() const {return m_bIsBlockMember;};
+	std::vector<std::reference_wrapper<CRefDataForPolling>> getBlockPoints();
+	std::vector<std::reference_wrapper<CRefDataForPolling>> getRequestPoints();
+
+	bool canAddToBlock(const CRefDataForPolling &a_oPoint, int32_t a_i32MaxGap) const;
+	bool addToBlock(CRefDataForPolling &a_oPoint);
+	bool getValueFromBlock(uint16_t a_u16BlockStartAddr, const std::vector<uint8_t> &a_vBlockValue,
+			std::vector<uint8_t> &a_vPointValue) const;
 };
 
 /**
@@ -43,6 +43,9 @@ typedef struct {
     publisher_ctx_t* pub_ctx; /** publisher context refernce*/
 } pub_thread_ctx_t;
 
+/** Default max interval in ms between probes of a down device*/
+#define DEVICE_PROBE_MAX_BACKOFF_MS 60000
+
 /** handler for publish json*/
 class PublishJsonHandler
 {
@@ -62,6 +65,16 @@ class PublishJsonHandler
 	std::string m_sWriteResponseTopic_RT; /** write RT response topic name */
 
 	uint32_t u32CutoffIntervalPercentage; /** cutoff interval in percentage*/
+	int32_t m_i32PollingBlockMaxGap; /** max gap allowed between points polled in one request, -1 disables it*/
+	bool m_bIsHexValueEnabled; /** publish hex string "value" field(true or false)*/
+	bool m_bIsBinaryUpdateEnabled; /** publish polled updates in binary form(true or false)*/
+	uint32_t m_u32PollStaggerStepMs; /** step in ms of polling phase offsets, 0 disables staggering*/
+	uint32_t m_u32MaxInFlightPerDevice; /** max polling requests in flight to a device, 0 means no limit*/
+	uint32_t m_u32DeviceDownTimeoutCount; /** consecutive timeouts after which device is treated as down, 0 disables it*/
+	uint32_t m_u32DeviceProbeMaxBackoffMs; /** max interval in ms between probes of a down device*/
+	uint32_t m_u32WriteCoalesceWindowMs; /** window in ms to collect on-demand writes of a device, 0 disables it*/
+	uint32_t m_u32OnDemandWorkerCount; /** number of workers for on-demand requests, 0 means listener threads process them*/
+	uint32_t m_u32ReadCacheMaxAgeMs; /** max age in ms of polled value used to answer on-demand read, 0 disables it*/
 
 	std::string m_sAppName; /** App name*/
 	std::atomic<unsigned short> m_u16TxId; /** Transaction ID*/
@@ -200,6 +213,86 @@ public:
 	void setCutoffIntervalPercentage(uint32_t cutoffIntervalPercentage) {
 		u32CutoffIntervalPercentage = cutoffIntervalPercentage;
 	}
+
+	int32_t getPollingBlockMaxGap() const {
+		return m_i32PollingBlockMaxGap;
+	}
+
+	void setPollingBlockMaxGap(int32_t a_i32PollingBlockMaxGap) {
+		m_i32PollingBlockMaxGap = a_i32PollingBlockMaxGap;
+	}
+
+	uint32_t getPollStaggerStepMs() const {
+		return m_u32PollStaggerStepMs;
+	}
+
+	void setPollStaggerStepMs(uint32_t a_u32PollStaggerStepMs) {
+		m_u32PollStaggerStepMs = a_u32PollStaggerStepMs;
+	}
+
+	uint32_t getMaxInFlightPerDevice() const {
+		return m_u32MaxInFlightPerDevice;
+	}
+
+	void setMaxInFlightPerDevice(uint32_t a_u32MaxInFlightPerDevice) {
+		m_u32MaxInFlightPerDevice = a_u32MaxInFlightPerDevice;
+	}
+
+	uint32_t getDeviceDownTimeoutCount() const {
+		return m_u32DeviceDownTimeoutCount;
+	}
+
+	void setDeviceDownTimeoutCount(uint32_t a_u32DeviceDownTimeoutCount) {
+		m_u32DeviceDownTimeoutCount = a_u32DeviceDownTimeoutCount;
+	}
+
+	uint32_t getDeviceProbeMaxBackoffMs() const {
+		return m_u32DeviceProbeMaxBackoffMs;
+	}
+
+	void setDeviceProbeMaxBackoffMs(uint32_t a_u32DeviceProbeMaxBackoffMs) {
+		m_u32DeviceProbeMaxBackoffMs = a_u32DeviceProbeMaxBackoffMs;
+	}
+
+	uint32_t getWriteCoalesceWindowMs() const {
+		return m_u32WriteCoalesceWindowMs;
+	}
+
+	void setWriteCoalesceWindowMs(uint32_t a_u32WriteCoalesceWindowMs) {
+		m_u32WriteCoalesceWindowMs = a_u32WriteCoalesceWindowMs;
+	}
+
+	uint32_t getOnDemandWorkerCount() const {
+		return m_u32OnDemandWorkerCount;
+	}
+
+	void setOnDemandWorkerCount(uint32_t a_u32OnDemandWorkerCount) {
+		m_u32OnDemandWorkerCount = a_u32OnDemandWorkerCount;
+	}
+
+	uint32_t getReadCacheMaxAgeMs() const {
+		return m_u32ReadCacheMaxAgeMs;
+	}
+
+	void setReadCacheMaxAgeMs(uint32_t a_u32ReadCacheMaxAgeMs) {
+		m_u32ReadCacheMaxAgeMs = a_u32ReadCacheMaxAgeMs;
+	}
+
+	bool isHexValueEnabled() const {
+		return m_bIsHexValueEnabled;
+	}
+
+	void setHexValueEnabled(bool a_bIsHexValueEnabled) {
+		m_bIsHexValueEnabled = a_bIsHexValueEnabled;
+	}
+
+	bool isBinaryUpdateEnabled() const {
+		return m_bIsBinaryUpdateEnabled;
+	}
+
+	void setBinaryUpdateEnabled(bool a_bIsBinaryUpdateEnabled) {
+		m_bIsBinaryUpdateEnabled = a_bIsBinaryUpdateEnabled;
+	}
 };
 
 
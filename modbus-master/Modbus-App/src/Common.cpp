@@ -25,13 +25,34 @@
 #include <chrono>
 #include "Logger.hpp"
 #include <mutex>
+#include <algorithm>
+#include <array>
+#include <unordered_map>
+#include <cstring>
 
 namespace
 {
-	std::map<unsigned short, MbusAPI_t> g_mapRequest;
-}
+	/** One shard of on-demand request table. Each shard has its own lock so that
+	 * requests with different TxIDs seldom wait for each other */
+	struct alignas(64) stReqDataShard
+	{
+		std::mutex m_mutex; /** lock of this shard*/
+		std::unordered_map<unsigned short, common_Handler::reqDataHandle_t> m_mapRequest; /** requests of this shard*/
+	};
 
-std::mutex __appReqJsonLock;
+	std::array<stReqDataShard, REQ_TABLE_SHARD_COUNT> g_arrReqDataShards;
+
+	/**
+	 * Get shard of on-demand request table for given TxID
+	 * @param seqno	:[in] sequence no
+	 * @return shard in which request with given TxID is stored
+	 */
+	stReqDataShard& getReqDataShard(unsigned short seqno)
+	{
+		// consecutive TxIDs are in different shards
+		return g_arrReqDataShards[seqno % REQ_TABLE_SHARD_COUNT];
+	}
+}
 
 /**
  * Swap conversion
@@ -122,49 +143,44 @@ std::string common_Handler::swapConversion(std::vector<unsigned char> vt, bool a
 }
 
 /**
- * Get request data from map
+ * Get request data from on-demand request table. Only handle is copied.
  * @param seqno		:[in] sequence no
- * @param reqData	:[out] reference to store request data
- * @return 	true : on success,
- * 			false : on error
+ * @return 	handle to request data : on success,
+ * 			NULL : if request is not found
  */
-bool common_Handler::getReqData(unsigned short seqno, MbusAPI_t& reqData)
+common_Handler::reqDataHandle_t common_Handler::getReqData(unsigned short seqno)
 {
-	DO_LOG_DEBUG("Start: " + std::to_string(seqno));
-	bool bRet = true;
-	try
+	stReqDataShard &shard = getReqDataShard(seqno);
+	std::lock_guard<std::mutex> lck(shard.m_mutex);
+	auto itr = shard.m_mapRequest.find(seqno);
+	if(shard.m_mapRequest.end() == itr)
 	{
-		std::unique_lock<std::mutex> lck(__appReqJsonLock);
-
-		/// return the context
-		reqData = g_mapRequest.at(seqno);
-	}
-	catch(std::exception &e)
-	{
-		DO_LOG_FATAL(LOGDETAILS(e.what()));
-		bRet = false;
+		// caller decides if missing request is an error, e.g. late response after request is removed
+		DO_LOG_DEBUG("Request not found in map. TxID: " + std::to_string(seqno));
+		return NULL;
 	}
-	DO_LOG_DEBUG("End: ");
-
-	return bRet;
+	return itr->second;
 }
 
 /**
- * Insert request data into the map
+ * Insert request data into on-demand request table. Request is moved into the table,
+ * entry of older request having same TxID, if any, is replaced.
  * @param seqno		:[in] sequence no
  * @param reqData	:[in] request data
  * @return 	true : on success,
  * 			false : on error
  */
-bool common_Handler::insertReqData(unsigned short seqno, MbusAPI_t& reqData)
+bool common_Handler::insertReqData(unsigned short seqno, MbusAPI_t&& reqData)
 {
 	bool bRet = true;
 	try
 	{
-		std::unique_lock<std::mutex> lck(__appReqJsonLock);
+		// allocation is done outside the lock
+		reqDataHandle_t pReqData = std::make_shared<MbusAPI_t>(std::move(reqData));
 
-		/// insert the data
-		g_mapRequest.insert(std::pair <unsigned short, MbusAPI_t> (seqno, reqData));
+		stReqDataShard &shard = getReqDataShard(seqno);
+		std::lock_guard<std::mutex> lck(shard.m_mutex);
+		shard.m_mapRequest[seqno] = std::move(pReqData);
 	}
 	catch (std::exception &e)
 	{
@@ -176,41 +192,61 @@ bool common_Handler::insertReqData(unsigned short seqno, MbusAPI_t& reqData)
 }
 
 /**
- * Update map value at specified key
- * @param seqno		:[in] sequence no
- * @param reqData	:[in] request data
- * @return 	true : on success,
- * 			false : on error
+ * Remove request data from on-demand request table
+ * @param seqno	:[in] sequence no of request to remove
+ * @return 	handle to removed request data : on success,
+ * 			NULL : if request is not found
  */
-bool common_Handler::updateReqData(unsigned short seqno, MbusAPI_t& reqData)
+common_Handler::reqDataHandle_t common_Handler::removeReqData(unsigned short seqno)
 {
-	DO_LOG_DEBUG("Start: ");
-	bool bRet = true;
-	try
+	reqDataHandle_t pReqData;
 	{
-		std::unique_lock<std::mutex> lck(__appReqJsonLock);
-
-		/// insert the data
-		g_mapRequest[seqno] = reqData;
+		stReqDataShard &shard = getReqDataShard(seqno);
+		std::lock_guard<std::mutex> lck(shard.m_mutex);
+		auto itr = shard.m_mapRequest.find(seqno);
+		if(shard.m_mapRequest.end() != itr)
+		{
+			pReqData = std::move(itr->second);
+			shard.m_mapRequest.erase(itr);
+		}
 	}
-	catch (std::exception &e)
+	// request is freed outside the lock if caller does not hold the handle
+	return pReqData;
+}
+
+/**
+ * Get number of requests in on-demand request table
+ * @return number of requests
+ */
+size_t common_Handler::getReqDataCount()
+{
+	size_t count = 0;
+	for(auto &shard : g_arrReqDataShards)
 	{
-		DO_LOG_FATAL(e.what());
-		bRet = false;
+		std::lock_guard<std::mutex> lck(shard.m_mutex);
+		count += shard.m_mapRequest.size();
 	}
-	DO_LOG_DEBUG("End: ");
-
-	return bRet;
+	return count;
 }
 
 /**
- * Remove request data from map
- * @param seqno	:[in] sequence no of request to remove
+ * Copy request field echoed in on-demand response to its fixed size buffer.
+ * Value longer than buffer is truncated.
+ * @param a_pszDest	:[out] buffer of ONDEMAND_ECHO_FIELD_LEN bytes
+ * @param a_svSrc	:[in] value to copy
+ * @return 	true : on success,
+ * 			false : if value is truncated
  */
-void common_Handler::removeReqData(unsigned short seqno)
+bool common_Handler::copyEchoField(char *a_pszDest, std::string_view a_svSrc)
 {
-	std::unique_lock<std::mutex> lck(__appReqJsonLock);
-	g_mapRequest.erase(seqno);
+	if(NULL == a_pszDest)
+	{
+		return false;
+	}
+	size_t len = std::min(a_svSrc.size(), (size_t)(ONDEMAND_ECHO_FIELD_LEN - 1));
+	memcpy(a_pszDest, a_svSrc.data(), len);
+	a_pszDest[len] = '\0';
+	return (len == a_svSrc.size());
 }
 
 /**
@@ -649,3 +685,150 @@ eYMlDataType common_Handler::getDataType(std::string a_sDataType)
 
 }
 
+/**
+ * This function gets the decoder type for given datatype and width.
+ * Decoder type is chosen once for a datapoint and is used to decode every response.
+ * @param a_eDataType	:[in] enumerated datatype
+ * @param a_iWidth		:[in] width of datapoint
+ * @return 	enum decoder type, enDECODE_INVALID if datatype and width do not match
+ */
+eValueDecodeType common_Handler::getDecodeType(eYMlDataType a_eDataType, int a_iWidth)
+{
+	switch(a_eDataType)
+	{
+	case enINT:
+		if(WIDTH_ONE == a_iWidth)
+		{
+			return enDECODE_INT16;
+		}
+		else if(WIDTH_TWO == a_iWidth)
+		{
+			return enDECODE_INT32;
+		}
+		else if(WIDTH_FOUR == a_iWidth)
+		{
+			return enDECODE_INT64;
+		}
+		break;
+	case enUINT:
+		if(WIDTH_ONE == a_iWidth)
+		{
+			return enDECODE_UINT16;
+		}
+		else if(WIDTH_TWO == a_iWidth)
+		{
+			return enDECODE_UINT32;
+		}
+		else if(WIDTH_FOUR == a_iWidth)
+		{
+			return enDECODE_UINT64;
+		}
+		break;
+	case enFLOAT:
+		if(WIDTH_TWO == a_iWidth)
+		{
+			return enDECODE_FLOAT;
+		}
+		break;
+	case enDOUBLE:
+		if(WIDTH_FOUR == a_iWidth)
+		{
+			return enDECODE_DOUBLE;
+		}
+		break;
+	case enBOOLEAN:
+		if(WIDTH_ONE == a_iWidth)
+		{
+			return enDECODE_BOOLEAN;
+		}
+		break;
+	case enSTRING:
+		return enDECODE_STRING;
+	default:
+		break;
+	}
+	return enDECODE_INVALID;
+}
+
+/**
+ * This function prepares decoder for a datapoint
+ * @param a_sDataType	:[in] Datatype received from datapoints.yml
+ * @param a_iWidth		:[in] width of datapoint
+ * @param a_bIsByteSwap	:[in] is byte swap or not
+ * @param a_bIsWordSwap	:[in] is word swap or not
+ * @param a_dScaleFactor:[in] scale factor of datapoint
+ * @return 	decoder to be used for datapoint value
+ */
+stValueDecoder common_Handler::getValueDecoder(std::string a_sDataType, int a_iWidth,
+		bool a_bIsByteSwap, bool a_bIsWordSwap, double a_dScaleFactor)
+{
+	std::transform(a_sDataType.begin(), a_sDataType.end(), a_sDataType.begin(), ::tolower);
+
+	stValueDecoder stDecoder;
+	stDecoder.m_eDecodeType = getDecodeType(getDataType(a_sDataType), a_iWidth);
+	stDecoder.m_bIsByteSwap = a_bIsByteSwap;
+	stDecoder.m_bIsWordSwap = a_bIsWordSwap;
+	stDecoder.m_dScaleFactor = a_dScaleFactor;
+	return stDecoder;
+}
+
+/**
+ * This function converts response bytes to raw value. Bytes are ordered
+ * in same way as swapConversion() orders them in hex string.
+ * @param a_vValue		:[in] response bytes
+ * @param a_bIsByteSwap	:[in] is byte swap or not
+ * @param a_bIsWordSwap	:[in] is word swap or not
+ * @return raw value, 0 if bytes do not fit in 8 bytes
+ */
+unsigned long long int common_Handler::bytesToRawValue(const std::vector<unsigned char> &a_vValue,
+		bool a_bIsByteSwap, bool a_bIsWordSwap)
+{
+	auto numbytes = a_vValue.size();
+	if(numbytes > sizeof(unsigned long long int))
+	{
+		DO_LOG_ERROR("Value is too long to decode: " + std::to_string(numbytes) + " bytes");
+		return 0;
+	}
+
+	auto iPosByte1 = 1, iPosByte2 = 0;
+	auto iPosWord1 = 0, iPosWord2 = 1;
+
+	if(true == a_bIsByteSwap)
+	{
+		iPosByte1 = 0; iPosByte2 = 1;
+	}
+	if(true == a_bIsWordSwap)
+	{
+		iPosWord1 = 1; iPosWord2 = 0;
+	}
+
+	unsigned long long int u64Value = 0;
+	int iCurPos = 0;
+	while(numbytes)
+	{
+		if(numbytes >= 4)
+		{
+			u64Value = (u64Value << 8) | a_vValue[iCurPos + iPosWord1*2 + iPosByte1];
+			u64Value = (u64Value << 8) | a_vValue[iCurPos + iPosWord1*2 + iPosByte2];
+			u64Value = (u64Value << 8) | a_vValue[iCurPos + iPosWord2*2 + iPosByte1];
+			u64Value = (u64Value << 8) | a_vValue[iCurPos + iPosWord2*2 + iPosByte2];
+			numbytes = numbytes - 4;
+			iCurPos = iCurPos + 4;
+		}
+		else if(numbytes >= 2)
+		{
+			u64Value = (u64Value << 8) | a_vValue[iCurPos + iPosByte1];
+			u64Value = (u64Value << 8) | a_vValue[iCurPos + iPosByte2];
+			numbytes = numbytes - 2;
+			iCurPos = iCurPos + 2;
+		}
+		else
+		{
+			u64Value = (u64Value << 8) | a_vValue[iCurPos];
+			--numbytes;
+			++iCurPos;
+		}
+	}
+	return u64Value;
+}
+
@@ -134,6 +134,19 @@ void populatePollingRefData()
 		}
 	}
 
+	// Points are now available in polling lists.
+	// Group adjacent points so that they are polled using a single request
+	uint32_t uiBlockCount = CTimeMapper::instance().buildPollingBlocks(PublishJsonHandler::instance().getPollingBlockMaxGap());
+	DO_LOG_INFO("Number of polling blocks formed: " + std::to_string(uiBlockCount));
+
+	// Spread requests of a polling interval across the interval
+	uint32_t uiPhaseCount = CTimeMapper::instance().buildPollingPhases(PublishJsonHandler::instance().getPollStaggerStepMs());
+	DO_LOG_INFO("Number of polling phases formed: " + std::to_string(uiPhaseCount));
+
+	// Requests of a device are queued and limited independently of other devices
+	uint32_t uiDeviceCount = CTimeMapper::instance().buildDeviceQueues();
+	DO_LOG_INFO("Number of device request queues formed: " + std::to_string(uiDeviceCount));
+
 	DO_LOG_DEBUG("End");
 }
 
@@ -348,6 +361,157 @@ int main(int argc, char* argv[])
 		}
 		DO_LOG_INFO("Cutoff is set to: " + std::to_string(PublishJsonHandler::instance().getCutoffIntervalPercentage()));
 
+		string blockMaxGap;
+		if(!CommonUtils::readEnvVariable("POLLING_BLOCK_MAX_GAP", blockMaxGap))
+		{
+			DO_LOG_INFO("POLLING_BLOCK_MAX_GAP env variable is not set; points will not be grouped in polling blocks");
+			PublishJsonHandler::instance().setPollingBlockMaxGap(-1);
+		}
+		else
+		{
+			PublishJsonHandler::instance().setPollingBlockMaxGap(atoi(blockMaxGap.c_str()));
+		}
+		DO_LOG_INFO("Polling block max gap is set to: " + std::to_string(PublishJsonHandler::instance().getPollingBlockMaxGap()));
+
+		string staggerStep;
+		if(!CommonUtils::readEnvVariable("POLL_STAGGER_STEP_MS", staggerStep))
+		{
+			DO_LOG_INFO("POLL_STAGGER_STEP_MS env variable is not set; points of a polling interval will be polled together");
+			PublishJsonHandler::instance().setPollStaggerStepMs(0);
+		}
+		else
+		{
+			int iStaggerStep = atoi(staggerStep.c_str());
+			PublishJsonHandler::instance().setPollStaggerStepMs((iStaggerStep > 0) ? (uint32_t)iStaggerStep : 0);
+		}
+		DO_LOG_INFO("Polling stagger step is set to: " + std::to_string(PublishJsonHandler::instance().getPollStaggerStepMs()));
+
+		string maxInFlight;
+		if(!CommonUtils::readEnvVariable("MAX_INFLIGHT_PER_DEVICE", maxInFlight))
+		{
+			DO_LOG_INFO("MAX_INFLIGHT_PER_DEVICE env variable is not set; polling requests to a device are not limited");
+			PublishJsonHandler::instance().setMaxInFlightPerDevice(0);
+		}
+		else
+		{
+			int iMaxInFlight = atoi(maxInFlight.c_str());
+			PublishJsonHandler::instance().setMaxInFlightPerDevice((iMaxInFlight > 0) ? (uint32_t)iMaxInFlight : 0);
+		}
+		DO_LOG_INFO("Max polling requests in flight per device is set to: " + std::to_string(PublishJsonHandler::instance().getMaxInFlightPerDevice()));
+
+		string downTimeoutCount;
+		if(!CommonUtils::readEnvVariable("DEVICE_DOWN_TIMEOUT_COUNT", downTimeoutCount))
+		{
+			DO_LOG_INFO("DEVICE_DOWN_TIMEOUT_COUNT env variable is not set; devices are polled even if they do not respond");
+			PublishJsonHandler::instance().setDeviceDownTimeoutCount(0);
+		}
+		else
+		{
+			int iDownTimeoutCount = atoi(downTimeoutCount.c_str());
+			PublishJsonHandler::instance().setDeviceDownTimeoutCount((iDownTimeoutCount > 0) ? (uint32_t)iDownTimeoutCount : 0);
+		}
+		DO_LOG_INFO("Device down timeout count is set to: " + std::to_string(PublishJsonHandler::instance().getDeviceDownTimeoutCount()));
+
+		string probeMaxBackoff;
+		if(CommonUtils::readEnvVariable("DEVICE_PROBE_MAX_BACKOFF_MS", probeMaxBackoff))
+		{
+			int iProbeMaxBackoff = atoi(probeMaxBackoff.c_str());
+			if(iProbeMaxBackoff > 0)
+			{
+				PublishJsonHandler::instance().setDeviceProbeMaxBackoffMs((uint32_t)iProbeMaxBackoff);
+			}
+		}
+		DO_LOG_INFO("Max backoff for probing a down device is set to: " + std::to_string(PublishJsonHandler::instance().getDeviceProbeMaxBackoffMs()));
+
+		string writeCoalesceWindow;
+		if(!CommonUtils::readEnvVariable("WRITE_COALESCE_WINDOW_MS", writeCoalesceWindow))
+		{
+			DO_LOG_INFO("WRITE_COALESCE_WINDOW_MS env variable is not set; on-demand writes are not coalesced");
+			PublishJsonHandler::instance().setWriteCoalesceWindowMs(0);
+		}
+		else
+		{
+			int iWriteCoalesceWindow = atoi(writeCoalesceWindow.c_str());
+			PublishJsonHandler::instance().setWriteCoalesceWindowMs((iWriteCoalesceWindow > 0) ? (uint32_t)iWriteCoalesceWindow : 0);
+		}
+		DO_LOG_INFO("Write coalescing window is set to: " + std::to_string(PublishJsonHandler::instance().getWriteCoalesceWindowMs()));
+
+		string onDemandWorkerCount;
+		if(!CommonUtils::readEnvVariable("ONDEMAND_WORKER_COUNT", onDemandWorkerCount))
+		{
+			DO_LOG_INFO("ONDEMAND_WORKER_COUNT env variable is not set; listener threads process on-demand requests");
+			PublishJsonHandler::instance().setOnDemandWorkerCount(0);
+		}
+		else
+		{
+			int iOnDemandWorkerCount = atoi(onDemandWorkerCount.c_str());
+			PublishJsonHandler::instance().setOnDemandWorkerCount((iOnDemandWorkerCount > 0) ? (uint32_t)iOnDemandWorkerCount : 0);
+		}
+		DO_LOG_INFO("On-demand worker count is set to: " + std::to_string(PublishJsonHandler::instance().getOnDemandWorkerCount()));
+
+		string readCacheMaxAge;
+		if(!CommonUtils::readEnvVariable("READ_CACHE_MAX_AGE_MS", readCacheMaxAge))
+		{
+			DO_LOG_INFO("READ_CACHE_MAX_AGE_MS env variable is not set; on-demand reads are always sent to device");
+			PublishJsonHandler::instance().setReadCacheMaxAgeMs(0);
+		}
+		else
+		{
+			int iReadCacheMaxAge = atoi(readCacheMaxAge.c_str());
+			PublishJsonHandler::instance().setReadCacheMaxAgeMs((iReadCacheMaxAge > 0) ? (uint32_t)iReadCacheMaxAge : 0);
+		}
+		DO_LOG_INFO("Read cache max age is set to: " + std::to_string(PublishJsonHandler::instance().getReadCacheMaxAgeMs()));
+
+		string hexValue;
+		if(!CommonUtils::readEnvVariable("PUBLISH_HEX_VALUE", hexValue))
+		{
+			DO_LOG_INFO("PUBLISH_HEX_VALUE env variable is not set; hex string value will be published");
+			PublishJsonHandler::instance().setHexValueEnabled(true);
+		}
+		else
+		{
+			std::transform(hexValue.begin(), hexValue.end(), hexValue.begin(), ::tolower);
+			PublishJsonHandler::instance().setHexValueEnabled(hexValue != "false");
+		}
+		DO_LOG_INFO("Publishing of hex string value is set to: " + std::to_string(PublishJsonHandler::instance().isHexValueEnabled()));
+
+		string binaryUpdate;
+		if(!CommonUtils::readEnvVariable("PUBLISH_BINARY_UPDATE", binaryUpdate))
+		{
+			DO_LOG_INFO("PUBLISH_BINARY_UPDATE env variable is not set; polled updates will be published as JSON");
+			PublishJsonHandler::instance().setBinaryUpdateEnabled(false);
+		}
+		else
+		{
+			std::transform(binaryUpdate.begin(), binaryUpdate.end(), binaryUpdate.begin(), ::tolower);
+			PublishJsonHandler::instance().setBinaryUpdateEnabled(binaryUpdate == "true");
+		}
+		DO_LOG_INFO("Publishing of binary polled update is set to: " + std::to_string(PublishJsonHandler::instance().isBinaryUpdateEnabled()));
+
+		// polled updates are published in batches if max count of RT or non-RT batch is more than 1
+		stEmbBatchCfg stRTBatchCfg{0, 0}, stNRTBatchCfg{0, 0};
+		auto readBatchCfg = [](const std::string &a_sCountVar, const std::string &a_sLatencyVar, stEmbBatchCfg &a_stCfg) {
+			string sValue;
+			if(true == CommonUtils::readEnvVariable(a_sCountVar.c_str(), sValue))
+			{
+				int iValue = atoi(sValue.c_str());
+				a_stCfg.m_u32MaxCount = (iValue > 0) ? (uint32_t)iValue : 0;
+			}
+			if(true == CommonUtils::readEnvVariable(a_sLatencyVar.c_str(), sValue))
+			{
+				int iValue = atoi(sValue.c_str());
+				a_stCfg.m_u32MaxLatencyMs = (iValue > 0) ? (uint32_t)iValue : 0;
+			}
+			DO_LOG_INFO(a_sCountVar + " is set to: " + std::to_string(a_stCfg.m_u32MaxCount) + ", " +
+					a_sLatencyVar + " is set to: " + std::to_string(a_stCfg.m_u32MaxLatencyMs));
+		};
+		readBatchCfg("EMB_BATCH_RT_MAX_COUNT", "EMB_BATCH_RT_MAX_LATENCY_MS", stRTBatchCfg);
+		readBatchCfg("EMB_BATCH_NRT_MAX_COUNT", "EMB_BATCH_NRT_MAX_LATENCY_MS", stNRTBatchCfg);
+		if(false == CEmbBatchPublisher::instance().init(stRTBatchCfg, stNRTBatchCfg))
+		{
+			DO_LOG_ERROR("Batch publisher could not be started; updates will be published individually");
+		}
+
 		int num_of_publishers = zmq_handler::getNumPubOrSub("pub");
 		// Initializing all the pub/sub topic base context for ZMQ
 		if(num_of_publishers >= 1)
@@ -490,6 +654,13 @@ int main(int argc, char* argv[])
 		// Lets build: reference data for polling
 		populatePollingRefData();
 
+		if(0 != PublishJsonHandler::instance().getReadCacheMaxAgeMs())
+		{
+			// On-demand reads of polled points can be answered using last polled value
+			size_t uiCacheCount = onDemandHandler::Instance().buildReadCache();
+			DO_LOG_INFO("Number of points in read cache: " + std::to_string(uiCacheCount));
+		}
+
 		if(false == CPeriodicReponseProcessor::Instance().isInitialized())
 		{
 			DO_LOG_ERROR("CPeriodicReponseProcessor is not initialized");
@@ -520,6 +691,8 @@ int main(int argc, char* argv[])
 		cv.wait(lck,exitMainThread);
 
 		DO_LOG_INFO("Condition variable is set for application exit.");
+		// pending batches are published before contexts go away
+		CEmbBatchPublisher::instance().stop();
 		DO_LOG_WARN("Exiting the Modbus application gracefully.");
 
 		return EXIT_SUCCESS;
@@ -34,6 +34,7 @@
 #include "eii/utils/json_config.h"
 #include "ModbusOnDemandHandler.hpp"
 #include <string>
+#include <algorithm>
 #include <fenv.h>
 /// stop thread flag
 extern std::atomic<bool> g_stopThread;
@@ -42,7 +43,7 @@ extern std::atomic<bool> g_stopThread;
 /**
  * Constructor
  */
-onDemandHandler::onDemandHandler() : m_bIsWriteInitialized(false)
+onDemandHandler::onDemandHandler() : m_bIsWriteInitialized(false), m_bIsReadCacheBuilt(false)
 {
 	try
 	{
@@ -129,15 +130,19 @@ void onDemandHandler::createErrorResponse(eMbusAppErrorCode errorCode,
 /**
 * Handler function to start the processing of on-demand requests.
 * @param a_pstMbusApiPram	:[in] Structure to read data received from ZMQ
+* @param a_stReqView		:[in] request fields borrowed from received message
 * @param topic				:[in] topic for zmq listening
 * @param vpCallback			:[in] set the stack callback as per the operation
 * @param a_bIsWriteReq		:[in] flag used to distinguish read/write request for further processing
+* @param a_eRejectCode		:[in] error code to answer valid request with instead of processing it, APP_SUCCESS to process it
 * @return 	eMbusAppErrorCode : Error code
 */
 eMbusAppErrorCode onDemandHandler::onDemandInfoHandler(MbusAPI_t *a_pstMbusApiPram,
+		const stOnDemandReqView &a_stReqView,
 		const string a_sTopic,
 		void *vpCallback,
-		bool a_IsWriteReq)
+		bool a_IsWriteReq,
+		eMbusAppErrorCode a_eRejectCode)
 {	
 	eMbusAppErrorCode eFunRetType = APP_SUCCESS;
 	unsigned char  m_u8FunCode;
@@ -155,18 +160,59 @@ eMbusAppErrorCode onDemandHandler::onDemandInfoHandler(MbusAPI_t *a_pstMbusApiPr
 		a_pstMbusApiPram->m_u16TxId = PublishJsonHandler::instance().getTxId();
 		 
 		/// Function called to parse request JSON and fill structure
-		eFunRetType = jsonParserForOnDemandRequest(*a_pstMbusApiPram,
+		eFunRetType = jsonParserForOnDemandRequest(a_stReqView,
+				*a_pstMbusApiPram,
 				m_u8FunCode,
 				a_pstMbusApiPram->m_u16TxId,
 				a_IsWriteReq);
 
-		/// inserting structure to map for retry and to create response JSON.
-		if(false == common_Handler::insertReqData(a_pstMbusApiPram->m_u16TxId, *a_pstMbusApiPram))
+		/// request not for this application is not stored
+		if(APP_ERROR_UNKNOWN_SERVICE_REQUEST == eFunRetType)
+		{
+			return eFunRetType;
+		}
+
+		/// request which cannot be processed now is answered with error response
+		if(APP_SUCCESS == eFunRetType && APP_SUCCESS != a_eRejectCode)
+		{
+			eFunRetType = a_eRejectCode;
+		}
+
+		/// read of polled point is answered from memory if last polled value is fresh
+		stMbusAppCallbackParams_t stCachedResp{};
+		bool bIsCached = (APP_SUCCESS == eFunRetType && false == a_IsWriteReq &&
+				true == getCachedRead(*a_pstMbusApiPram, stCachedResp));
+		a_pstMbusApiPram->m_stOnDemandReqData.m_bIsCached = bIsCached;
+
+		/// storing copy of structure to map for retry and to create response JSON.
+		/// Structure is used below to send request, hence it is not moved
+		if(false == common_Handler::insertReqData(a_pstMbusApiPram->m_u16TxId, MbusAPI_t(*a_pstMbusApiPram)))
 		{
 			DO_LOG_ERROR("Failed to add MbusAPI_t data to map.");
 		}
 
-		if(APP_SUCCESS == eFunRetType && MBUS_MIN_FUN_CODE != m_u8FunCode)
+		if(true == bIsCached)
+		{
+			stCachedResp.m_u8FunctionCode = m_u8FunCode;
+			stCachedResp.m_u16TransactionID = a_pstMbusApiPram->m_u16TxId;
+			stCachedResp.m_u8UnitID = a_pstMbusApiPram->m_u8DevId;
+			stCachedResp.m_lPriority = a_pstMbusApiPram->m_lPriority;
+			stCachedResp.m_u16StartAdd = a_pstMbusApiPram->m_u16StartAddr;
+			stCachedResp.m_u16Quantity = a_pstMbusApiPram->m_u16Quantity;
+			bool bIsRT = a_pstMbusApiPram->m_stOnDemandReqData.m_isRT;
+			CPeriodicReponseProcessor::Instance().handleResponse(&stCachedResp,
+					bIsRT ? MBUS_CALLBACK_ONDEMAND_READ_RT : MBUS_CALLBACK_ONDEMAND_READ,
+					bIsRT ? PublishJsonHandler::instance().getSReadResponseTopicRT() : PublishJsonHandler::instance().getSReadResponseTopic(),
+					bIsRT);
+		}
+		else if(APP_SUCCESS == eFunRetType && true == a_IsWriteReq &&
+				0 != PublishJsonHandler::instance().getWriteCoalesceWindowMs() &&
+				true == isCoalescableWrite(m_u8FunCode))
+		{
+			/// write is sent along with other writes of the device at the end of window
+			addToWriteBatch(*a_pstMbusApiPram, m_u8FunCode, vpCallback);
+		}
+		else if(APP_SUCCESS == eFunRetType && MBUS_MIN_FUN_CODE != m_u8FunCode)
 		{
 			eFunRetType = (eMbusAppErrorCode)Modbus_Stack_API_Call(
 					m_u8FunCode,
@@ -206,6 +252,345 @@ eMbusAppErrorCode onDemandHandler::onDemandInfoHandler(MbusAPI_t *a_pstMbusApiPr
 	return eFunRetType;
 }
 
+/**
+ * Function to check if a write request can be coalesced with other writes of a device.
+ * @param a_u8FunCode	:[in] function code of the write request
+ * @return 	true : if write can be coalesced,
+ * 			false : otherwise
+ */
+bool onDemandHandler::isCoalescableWrite(unsigned char a_u8FunCode)
+{
+	return (WRITE_SINGLE_REG == a_u8FunCode ||
+			WRITE_MULTIPLE_REG == a_u8FunCode ||
+			WRITE_SINGLE_COIL == a_u8FunCode);
+}
+
+/**
+ * Function to add a write request to aggregation window of its device.
+ * Window of the device is started by first write.
+ * @param a_stMbusApiPram	:[in] parsed write request
+ * @param a_u8FunCode		:[in] function code of the write request
+ * @param vpCallback		:[in] stack callback of the write request
+ */
+void onDemandHandler::addToWriteBatch(const MbusAPI_t &a_stMbusApiPram, unsigned char a_u8FunCode, void *vpCallback)
+{
+	writeBatchKey_t key = std::make_tuple(a_stMbusApiPram.m_i32Ctx,
+			a_stMbusApiPram.m_u8DevId,
+			(WRITE_SINGLE_COIL == a_u8FunCode),
+			a_stMbusApiPram.m_stOnDemandReqData.m_isRT);
+	{
+		std::lock_guard<std::mutex> lock(m_mutexWriteBatch);
+		auto itr = m_mapWriteBatch.find(key);
+		if(m_mapWriteBatch.end() == itr)
+		{
+			stWriteBatch stBatch;
+			stBatch.m_tpFlush = std::chrono::steady_clock::now() +
+					std::chrono::milliseconds(PublishJsonHandler::instance().getWriteCoalesceWindowMs());
+			itr = m_mapWriteBatch.emplace(key, std::move(stBatch)).first;
+		}
+		itr->second.m_vWrites.push_back(stCoalescedWrite{a_stMbusApiPram, a_u8FunCode, vpCallback});
+	}
+	m_cvWriteBatch.notify_one();
+}
+
+/**
+ * Thread to send write batches whose aggregation window has ended.
+ */
+void onDemandHandler::writeBatchFlushThread()
+{
+	while(false == g_stopThread.load())
+	{
+		std::vector<std::vector<stCoalescedWrite>> vDueBatches;
+		{
+			std::unique_lock<std::mutex> lock(m_mutexWriteBatch);
+			if(true == m_mapWriteBatch.empty())
+			{
+				// wake up periodically to check stop flag
+				m_cvWriteBatch.wait_for(lock, std::chrono::milliseconds(100));
+			}
+			else
+			{
+				auto tpNext = m_mapWriteBatch.begin()->second.m_tpFlush;
+				for(const auto &batch : m_mapWriteBatch)
+				{
+					tpNext = std::min(tpNext, batch.second.m_tpFlush);
+				}
+				m_cvWriteBatch.wait_until(lock, tpNext);
+			}
+
+			auto tpNow = std::chrono::steady_clock::now();
+			for(auto itr = m_mapWriteBatch.begin(); itr != m_mapWriteBatch.end(); )
+			{
+				if(itr->second.m_tpFlush <= tpNow)
+				{
+					vDueBatches.push_back(std::move(itr->second.m_vWrites));
+					itr = m_mapWriteBatch.erase(itr);
+				}
+				else
+				{
+					++itr;
+				}
+			}
+		}
+
+		for(auto &vWrites : vDueBatches)
+		{
+			sendCoalescedWrites(vWrites);
+		}
+	}
+}
+
+/**
+ * Function to check if two writes have a common address
+ * @param a_stWrite1	:[in] first write
+ * @param a_stWrite2	:[in] second write
+ * @return true/false based on whether writes overlap or not
+ */
+static bool isOverlappingWrite(const stCoalescedWrite &a_stWrite1, const stCoalescedWrite &a_stWrite2)
+{
+	uint32_t u32Start1 = a_stWrite1.m_stMbusApiPram.m_u16StartAddr;
+	uint32_t u32Start2 = a_stWrite2.m_stMbusApiPram.m_u16StartAddr;
+	return (u32Start1 < u32Start2 + a_stWrite2.m_stMbusApiPram.m_u16Quantity) &&
+			(u32Start2 < u32Start1 + a_stWrite1.m_stMbusApiPram.m_u16Quantity);
+}
+
+/**
+ * Function to split writes of a device into runs of contiguous addresses.
+ * Writes are taken in arrival order. When a write overlaps an earlier write,
+ * writes before it are grouped first and it starts a new group, so that
+ * overlapping writes reach the device in arrival order and last write wins.
+ * Writes of a group do not overlap, these are sorted by address and split
+ * into runs of contiguous addresses.
+ * @param a_vWrites	:[in] writes of a device in arrival order, these are sorted by address within a group
+ * @param a_vRuns	:[out] runs of contiguous writes
+ */
+void onDemandHandler::groupContiguousWrites(std::vector<stCoalescedWrite> &a_vWrites,
+		std::vector<std::vector<stCoalescedWrite>> &a_vRuns)
+{
+	a_vRuns.clear();
+	size_t szGroupStart = 0;
+	for(size_t szIndex = 1; szIndex <= a_vWrites.size(); ++szIndex)
+	{
+		bool bIsOverlap = false;
+		for(size_t szPrev = szGroupStart; (szIndex < a_vWrites.size()) && (szPrev < szIndex); ++szPrev)
+		{
+			if(true == isOverlappingWrite(a_vWrites[szPrev], a_vWrites[szIndex]))
+			{
+				bIsOverlap = true;
+				break;
+			}
+		}
+		if((szIndex < a_vWrites.size()) && (false == bIsOverlap))
+		{
+			continue;
+		}
+		addContiguousRuns(a_vWrites.begin() + szGroupStart, a_vWrites.begin() + szIndex, a_vRuns);
+		szGroupStart = szIndex;
+	}
+}
+
+/**
+ * Function to sort non-overlapping writes by address and to add these as
+ * runs of contiguous addresses
+ * @param a_itrFirst	:[in] first write of group
+ * @param a_itrLast		:[in] end of group
+ * @param a_vRuns		:[in,out] runs of contiguous writes, new runs are added at end
+ */
+void onDemandHandler::addContiguousRuns(std::vector<stCoalescedWrite>::iterator a_itrFirst,
+		std::vector<stCoalescedWrite>::iterator a_itrLast,
+		std::vector<std::vector<stCoalescedWrite>> &a_vRuns)
+{
+	std::stable_sort(a_itrFirst, a_itrLast,
+			[](const stCoalescedWrite &a, const stCoalescedWrite &b) {
+				return a.m_stMbusApiPram.m_u16StartAddr < b.m_stMbusApiPram.m_u16StartAddr;
+			});
+
+	// runs of previous group are not extended
+	size_t szFirstRun = a_vRuns.size();
+	uint32_t u32RunEnd = 0;
+	uint32_t u32RunCount = 0;
+	for(auto itr = a_itrFirst; itr != a_itrLast; ++itr)
+	{
+		stCoalescedWrite &stWrite = *itr;
+		bool bIsCoil = (WRITE_SINGLE_COIL == stWrite.m_u8FunCode);
+		uint32_t u32MaxCount = bIsCoil ? MAX_COALESCED_COIL_COUNT : MAX_COALESCED_REG_COUNT;
+		uint32_t u32Start = stWrite.m_stMbusApiPram.m_u16StartAddr;
+		uint32_t u32Count = stWrite.m_stMbusApiPram.m_u16Quantity;
+
+		if(szFirstRun < a_vRuns.size() && u32Start == u32RunEnd &&
+				(u32RunCount + u32Count) <= u32MaxCount)
+		{
+			a_vRuns.back().push_back(stWrite);
+			u32RunCount += u32Count;
+		}
+		else
+		{
+			a_vRuns.push_back(std::vector<stCoalescedWrite>{stWrite});
+			u32RunCount = u32Count;
+		}
+		u32RunEnd = u32Start + u32Count;
+	}
+}
+
+/**
+ * Function to build one write multiple registers/coils request for a run of contiguous writes.
+ * @param a_vRun			:[in] contiguous writes sorted by address
+ * @param a_stMbusApiPram	:[out] coalesced request, TxID is not assigned
+ * @param a_u8FunCode		:[out] function code of coalesced request
+ * @return 	true : on success,
+ * 			false : on error
+ */
+bool onDemandHandler::buildCoalescedRequest(const std::vector<stCoalescedWrite> &a_vRun,
+		MbusAPI_t &a_stMbusApiPram, unsigned char &a_u8FunCode)
+{
+	if(true == a_vRun.empty())
+	{
+		return false;
+	}
+
+	const MbusAPI_t &stFirst = a_vRun.front().m_stMbusApiPram;
+	a_stMbusApiPram = stFirst;
+	a_stMbusApiPram.m_u16TxId = 0;
+	a_stMbusApiPram.m_u16Quantity = 0;
+	memset(a_stMbusApiPram.m_pu8Data, 0, sizeof(a_stMbusApiPram.m_pu8Data));
+
+	if(WRITE_SINGLE_COIL == a_vRun.front().m_u8FunCode)
+	{
+		// coil values are packed as bits, first coil in LSB of first byte
+		for(const auto &stWrite : a_vRun)
+		{
+			uint16_t u16Index = a_stMbusApiPram.m_u16Quantity;
+			if(WRITE_SINGLE_COIL != stWrite.m_u8FunCode || u16Index >= MAX_COALESCED_COIL_COUNT)
+			{
+				return false;
+			}
+			// single coil request carries ON as bytes 0xFF, 0x00
+			if((0xFF == stWrite.m_stMbusApiPram.m_pu8Data[0]) && (0x00 == stWrite.m_stMbusApiPram.m_pu8Data[1]))
+			{
+				a_stMbusApiPram.m_pu8Data[u16Index / 8] |= (1 << (u16Index % 8));
+			}
+			a_stMbusApiPram.m_u16Quantity++;
+		}
+		a_stMbusApiPram.m_u16ByteCount = (a_stMbusApiPram.m_u16Quantity + 7) / 8;
+		a_u8FunCode = WRITE_MULTIPLE_COILS;
+	}
+	else
+	{
+		// registers are already in request format, these are placed one after another
+		for(const auto &stWrite : a_vRun)
+		{
+			uint16_t u16Bytes = stWrite.m_stMbusApiPram.m_u16Quantity * 2;
+			uint16_t u16Offset = a_stMbusApiPram.m_u16Quantity * 2;
+			if(WRITE_SINGLE_COIL == stWrite.m_u8FunCode ||
+					(a_stMbusApiPram.m_u16Quantity + stWrite.m_stMbusApiPram.m_u16Quantity) > MAX_COALESCED_REG_COUNT)
+			{
+				return false;
+			}
+			memcpy(a_stMbusApiPram.m_pu8Data + u16Offset, stWrite.m_stMbusApiPram.m_pu8Data, u16Bytes);
+			a_stMbusApiPram.m_u16Quantity += stWrite.m_stMbusApiPram.m_u16Quantity;
+		}
+		a_stMbusApiPram.m_u16ByteCount = a_stMbusApiPram.m_u16Quantity * 2;
+		a_u8FunCode = WRITE_MULTIPLE_REG;
+	}
+
+	return true;
+}
+
+/**
+ * Function to send writes of a device whose aggregation window has ended.
+ * Each run of contiguous writes is sent as one request. A run having single
+ * write is sent as it is.
+ * @param a_vWrites	:[in] writes of a device
+ */
+void onDemandHandler::sendCoalescedWrites(std::vector<stCoalescedWrite> &a_vWrites)
+{
+	std::vector<std::vector<stCoalescedWrite>> vRuns;
+	groupContiguousWrites(a_vWrites, vRuns);
+
+	for(auto &vRun : vRuns)
+	{
+		try
+		{
+			MbusAPI_t stMbusApiPram;
+			unsigned char u8FunCode = 0;
+			if(vRun.size() > 1 && true == buildCoalescedRequest(vRun, stMbusApiPram, u8FunCode))
+			{
+				stMbusApiPram.m_u16TxId = PublishJsonHandler::instance().getTxId();
+				std::vector<unsigned short> vTxIDs;
+				for(const auto &stWrite : vRun)
+				{
+					vTxIDs.push_back(stWrite.m_stMbusApiPram.m_u16TxId);
+				}
+				{
+					std::lock_guard<std::mutex> lock(m_mutexCoalescedTxID);
+					m_mapCoalescedTxID[stMbusApiPram.m_u16TxId] = vTxIDs;
+				}
+				/// coalesced request is stored for retry
+				if(false == common_Handler::insertReqData(stMbusApiPram.m_u16TxId, MbusAPI_t(stMbusApiPram)))
+				{
+					DO_LOG_ERROR("Failed to add coalesced MbusAPI_t data to map.");
+				}
+
+				if(APP_SUCCESS == Modbus_Stack_API_Call(u8FunCode, &stMbusApiPram, vRun.front().m_pCallback))
+				{
+					DO_LOG_DEBUG("Writes of " + std::to_string(vRun.size()) +
+							" requests are sent as one request. TxID: " + std::to_string(stMbusApiPram.m_u16TxId));
+					continue;
+				}
+
+				DO_LOG_ERROR("Failed to initiate coalesced write request from stack");
+				getCoalescedTxIDs(stMbusApiPram.m_u16TxId, vTxIDs);
+				common_Handler::removeReqData(stMbusApiPram.m_u16TxId);
+				// each requester gets error response
+				for(const auto &stWrite : vRun)
+				{
+					createErrorResponse(APP_ERROR_REQUEST_SEND_FAILED, stWrite.m_u8FunCode,
+							stWrite.m_stMbusApiPram.m_u16TxId,
+							stWrite.m_stMbusApiPram.m_stOnDemandReqData.m_isRT, true);
+				}
+				continue;
+			}
+
+			// writes which cannot be coalesced are sent as they are
+			for(auto &stWrite : vRun)
+			{
+				if(APP_SUCCESS != Modbus_Stack_API_Call(stWrite.m_u8FunCode, &stWrite.m_stMbusApiPram, stWrite.m_pCallback))
+				{
+					DO_LOG_ERROR("Failed to initiate write request from stack");
+					createErrorResponse(APP_ERROR_REQUEST_SEND_FAILED, stWrite.m_u8FunCode,
+							stWrite.m_stMbusApiPram.m_u16TxId,
+							stWrite.m_stMbusApiPram.m_stOnDemandReqData.m_isRT, true);
+				}
+			}
+		}
+		catch(const std::exception &e)
+		{
+			DO_LOG_FATAL(e.what());
+		}
+	}
+}
+
+/**
+ * Function to get TxIDs of requesters of a coalesced write request.
+ * Entry is removed once it is read as response is received only once.
+ * @param a_u16TxID	:[in] TxID of coalesced write request
+ * @param a_vTxIDs	:[out] TxIDs of requesters
+ * @return 	true : if TxID belongs to coalesced write request,
+ * 			false : otherwise
+ */
+bool onDemandHandler::getCoalescedTxIDs(unsigned short a_u16TxID, std::vector<unsigned short> &a_vTxIDs)
+{
+	std::lock_guard<std::mutex> lock(m_mutexCoalescedTxID);
+	auto itr = m_mapCoalescedTxID.find(a_u16TxID);
+	if(m_mapCoalescedTxID.end() == itr)
+	{
+		return false;
+	}
+	a_vTxIDs = std::move(itr->second);
+	m_mapCoalescedTxID.erase(itr);
+	return true;
+}
+
 /**
  * Function to convert values from character to integer.
  * @param input :[in] char to convert to integer
@@ -281,57 +666,6 @@ int hex2bin(const std::string &src, int iOpLen, uint8_t* target)
 	return iOpCharPos;
 }
 
-/**
- * Function to validate request JSON for wellhead & command
- * @param stSourcetopic	:[in] source topic
- * @param stWellhead	:[in] wellhead name
- * @param stCommand		:[in] command name
- * @return 	true : on success,
- * 			false : on error
- */
-bool onDemandHandler::validateInputJson(std::string stSourcetopic, std::string stWellhead, std::string stCommand)
-{
-	bool retValue = false;
-	try
-	{
-		std::size_t found=std::string::npos;
-		std::size_t found1=std::string::npos;
-		std::size_t found2=std::string::npos;
-		std::size_t found3=std::string::npos;
-		std::string strSearchStrin = "/", tempWellhead, tempCommand;
-		found = stSourcetopic.find(strSearchStrin);
-		if (found!=std::string::npos)
-		{
-			found1 = stSourcetopic.find(strSearchStrin.c_str(), found+1);
-		}
-		if (found1!=std::string::npos)
-		{
-			found2 = stSourcetopic.find(strSearchStrin.c_str(), found1+1);
-		}
-		if (found2!=std::string::npos)
-		{
-			tempWellhead = stSourcetopic.substr(found1+1, found2-found1-1);
-			found3 = stSourcetopic.find(strSearchStrin.c_str(), found2+1);
-		}
-		if (found3!=std::string::npos)
-		{
-			tempCommand = stSourcetopic.substr(found2+1, found3-found2-1);
-		}
-
-		if(tempWellhead == stWellhead && tempCommand == stCommand)
-		{
-			retValue = true;
-		}
-	}
-	catch(const std::exception &e)
-	{
-		DO_LOG_FATAL(e.what());
-		DO_LOG_DEBUG("i/p json wellhead or command mismatch with sourcetopic");
-	}
-
-	return retValue;
-}
-
 
 /**
  * Function to reverseScaledValue to Hex String
@@ -657,126 +991,234 @@ bool onDemandHandler::reverseScaledValueToHex(std::string a_sDataType, int a_iWi
 }
 
 
+/**
+ * Function to fill routing index from unique point list.
+ * Function code, address and value format of each point are resolved here
+ * so that an on-demand request needs only one lookup.
+ */
+void onDemandHandler::fillRoutingIndex()
+{
+	const std::map<std::string, network_info::CUniqueDataPoint>& mapUniquePoint = network_info::getUniquePointList();
+	m_mapRoute.reserve(mapUniquePoint.size());
+	for(const auto &pt : mapUniquePoint)
+	{
+		try
+		{
+			const network_info::CDataPoint &obj = pt.second.getDataPoint();
+			const network_info::CWellSiteDevInfo &dev = pt.second.getWellSiteDev();
+			stOnDemandRoute stRoute{};
+
+			stRoute.m_i32Ctx = dev.getCtxInfo();
+#ifdef MODBUS_STACK_TCPIP_ENABLED
+			stRoute.m_u8DevId = dev.getAddressInfo().m_stTCP.m_uiUnitID;
+#else
+			stRoute.m_u8DevId = dev.getAddressInfo().m_stRTU.m_uiSlaveId;
+#endif
+			stRoute.m_bIsByteSwap = obj.getAddress().m_bIsByteSwap;
+			stRoute.m_bIsWordSwap = obj.getAddress().m_bIsWordSwap;
+			stRoute.m_bIsDataPersist = obj.getDataPersist();
+			stRoute.m_u16StartAddr = (uint16_t)obj.getAddress().m_iAddress;
+			stRoute.m_u16Quantity = (uint16_t)obj.getAddress().m_iWidth;
+			stRoute.m_iWidth = obj.getAddress().m_iWidth;
+			stRoute.m_dScaleFactor = obj.getAddress().m_dScaleFactor;
+			stRoute.m_sDataType = obj.getAddress().m_sDataType;
+
+			switch(obj.getAddress().m_eType)
+			{
+			case network_info::eEndPointType::eCoil:
+				stRoute.m_u8ReadFunCode = READ_COIL_STATUS;
+				stRoute.m_u8WriteFunCode = WRITE_SINGLE_COIL;
+				break;
+			case network_info::eEndPointType::eHolding_Register:
+				stRoute.m_u8ReadFunCode = READ_HOLDING_REG;
+				stRoute.m_u8WriteFunCode = (1 == stRoute.m_u16Quantity) ? WRITE_SINGLE_REG : WRITE_MULTIPLE_REG;
+				break;
+			case network_info::eEndPointType::eInput_Register:
+				stRoute.m_u8ReadFunCode = READ_INPUT_REG;
+				stRoute.m_u8WriteFunCode = MBUS_MAX_FUN_CODE;
+				break;
+			case network_info::eEndPointType::eDiscrete_Input:
+				stRoute.m_u8ReadFunCode = READ_INPUT_STATUS;
+				stRoute.m_u8WriteFunCode = MBUS_MAX_FUN_CODE;
+				break;
+			default:
+				stRoute.m_u8ReadFunCode = MBUS_MIN_FUN_CODE;
+				stRoute.m_u8WriteFunCode = MBUS_MIN_FUN_CODE;
+				break;
+			}
+
+			// point topic is like /flowmeter/PL0/D1, wellhead is PL0 and metric is D1
+			const std::string &sTopic = pt.first;
+			std::size_t found1 = sTopic.find('/', 1);
+			std::size_t found2 = (std::string::npos != found1) ? sTopic.find('/', found1 + 1) : std::string::npos;
+			if(std::string::npos != found2)
+			{
+				stRoute.m_sWellhead = sTopic.substr(found1 + 1, found2 - found1 - 1);
+				std::size_t found3 = sTopic.find('/', found2 + 1);
+				stRoute.m_sMetric = sTopic.substr(found2 + 1,
+						(std::string::npos != found3) ? (found3 - found2 - 1) : std::string::npos);
+			}
+
+			// key refers to the key of unique point list which is not changed once built
+			stRoute.m_svTopic = sTopic;
+			stRoute.m_pUniquePoint = &(pt.second);
+			m_mapRoute.emplace(std::string_view(sTopic), std::move(stRoute));
+		}
+		catch(const std::exception &e)
+		{
+			DO_LOG_FATAL(pt.first + ": " + e.what());
+		}
+	}
+}
+
+/**
+ * Function to build routing index of on-demand requests. It shall be called after
+ * network info is built and device contexts are set, before requests are received.
+ * @return size_t : number of points in routing index
+ */
+size_t onDemandHandler::buildRoutingIndex()
+{
+	m_mapRoute.clear();
+	fillRoutingIndex();
+	return m_mapRoute.size();
+}
+
+/**
+ * Function to get request descriptor of a point using sourcetopic of on-demand request.
+ * Nothing is allocated for the lookup.
+ * @param a_sSourceTopic	:[in] sourcetopic like /flowmeter/PL0/D1/read
+ * @return 	pointer to request descriptor : on success,
+ * 			NULL : if point is not handled by this application
+ */
+const stOnDemandRoute* onDemandHandler::getRoute(std::string_view a_sSourceTopic)
+{
+	std::size_t found = a_sSourceTopic.find_last_of('/');
+	if(std::string_view::npos == found || 0 == found)
+	{
+		return NULL;
+	}
+	auto itr = m_mapRoute.find(a_sSourceTopic.substr(0, found));
+	if(m_mapRoute.end() == itr)
+	{
+		return NULL;
+	}
+	return &(itr->second);
+}
+
 /**
  * Function to parse request JSON and fill the structure.
+ * @param a_stReqView		:[in] request fields borrowed from received msg
  * @param stMbusApiPram		:[out] modbus API param structure to fill from received msg
  * @param funcCode			:[out] function code of the request
  * @param txID				:[in] request transaction id
  * @param a_IsWriteReq		:[out] boolean variable to differentiate between read/write request
  * @return appropriate error code
  */
-eMbusAppErrorCode onDemandHandler::jsonParserForOnDemandRequest(MbusAPI_t& a_stMbusApiPram,
+eMbusAppErrorCode onDemandHandler::jsonParserForOnDemandRequest(const stOnDemandReqView &a_stReqView,
+											MbusAPI_t& a_stMbusApiPram,
 											unsigned char& funcCode,
 											unsigned short txID,
 											const bool a_IsWriteReq)
 {
 	// locals
 	eMbusAppErrorCode eFunRetType = APP_SUCCESS;
-	network_info::CDataPoint obj;
-	string strSourceTopic, strValue;
+	string strValue;
 	bool isValidJson = false;
 	bool isScaledValue = false;
 	try
 	{
-		/// Comparing sourcetopic for read/write request.
-		strSourceTopic = a_stMbusApiPram.m_stOnDemandReqData.m_strTopic;
 		/// to check all the values are present in request JSON.
-		if(!a_stMbusApiPram.m_stOnDemandReqData.m_strMetric.empty()
-				&& !a_stMbusApiPram.m_stOnDemandReqData.m_strWellhead.empty()
-				&& !a_stMbusApiPram.m_stOnDemandReqData.m_strVersion.empty()
-				&& !a_stMbusApiPram.m_stOnDemandReqData.m_strTopic.empty()
-				&& !a_stMbusApiPram.m_stOnDemandReqData.m_strMqttTime.empty()
-				&& !a_stMbusApiPram.m_stOnDemandReqData.m_strEiiTime.empty()
-				&& !a_stMbusApiPram.m_stOnDemandReqData.m_strAppSeq.empty()
-				&& !a_stMbusApiPram.m_stOnDemandReqData.m_sUsec.empty()
-				&& !a_stMbusApiPram.m_stOnDemandReqData.m_sTimestamp.empty())
+		if(!a_stReqView.m_svMetric.empty()
+				&& !a_stReqView.m_svWellhead.empty()
+				&& !a_stReqView.m_svVersion.empty()
+				&& !a_stReqView.m_svTopic.empty()
+				&& !a_stReqView.m_svMqttTime.empty()
+				&& !a_stReqView.m_svEiiTime.empty()
+				&& !a_stReqView.m_svAppSeq.empty()
+				&& !a_stReqView.m_svUsec.empty()
+				&& !a_stReqView.m_svTimestamp.empty())
 		{
 			isValidJson = true;		
 
 			if(true == a_IsWriteReq)
 			{
-				if(!a_stMbusApiPram.m_stOnDemandReqData.m_sValue.empty())
+				if(!a_stReqView.m_svValue.empty())
 				{
-					strValue = a_stMbusApiPram.m_stOnDemandReqData.m_sValue;
+					strValue = a_stReqView.m_svValue;
 				}
 				else 
 				{					 
 					isScaledValue = true;				 
 			    }				 
 			}
-			if(isValidJson)
-			{
-				isValidJson = validateInputJson(strSourceTopic,
-					a_stMbusApiPram.m_stOnDemandReqData.m_strWellhead,
-					a_stMbusApiPram.m_stOnDemandReqData.m_strMetric);
-			}
 		}
-		if(!isValidJson)
+
+		/// resolve point of the request using routing index
+		const stOnDemandRoute *pRoute = getRoute(a_stReqView.m_svTopic);
+		if(NULL == pRoute)
 		{
-			DO_LOG_ERROR(" Invalid input json parameter or topic.");
-			eFunRetType = APP_ERROR_INVALID_INPUT_JSON;
+			DO_LOG_INFO(" Request is not for this application. Topic: " + std::string(a_stReqView.m_svTopic));
+			return APP_ERROR_UNKNOWN_SERVICE_REQUEST;
 		}
+		const stOnDemandRoute &stRoute = *pRoute;
+		a_stMbusApiPram.m_i32Ctx = stRoute.m_i32Ctx;
 
-		string strSearchString = "/", stTopic = "";
-		std::size_t found = strSourceTopic.find_last_of(strSearchString);
-		if (found!=std::string::npos)
+		/// fields echoed in response are copied as envelope is destroyed once request is parsed.
+		/// Point fields refer to routing index
+		stOnDemandRequest &stReqData = a_stMbusApiPram.m_stOnDemandReqData;
+		if(false == common_Handler::copyEchoField(stReqData.m_szAppSeq, a_stReqView.m_svAppSeq))
 		{
-			stTopic = strSourceTopic.substr(0, found);
+			/// truncated app_seq cannot be matched by requester, hence request is rejected
+			DO_LOG_ERROR("app_seq is longer than " + std::to_string(ONDEMAND_ECHO_FIELD_LEN - 1) + " characters");
+			isValidJson = false;
 		}
-		if(stTopic.empty())
+		common_Handler::copyEchoField(stReqData.m_szMqttTime, a_stReqView.m_svMqttTime);
+		common_Handler::copyEchoField(stReqData.m_szEiiTime, a_stReqView.m_svEiiTime);
+		stReqData.m_svTopic = stRoute.m_svTopic;
+		stReqData.m_svWellhead = stRoute.m_sWellhead;
+		stReqData.m_svMetric = stRoute.m_sMetric;
+		stReqData.m_isWriteReq = a_IsWriteReq;
+
+		/// sourcetopic shall be of wellhead and command given in request
+		if(isValidJson)
 		{
-			DO_LOG_ERROR("Topic is not found in request json.");
-			eFunRetType = APP_ERROR_INVALID_INPUT_JSON;
+			isValidJson = (stRoute.m_sWellhead == a_stReqView.m_svWellhead &&
+					stRoute.m_sMetric == a_stReqView.m_svMetric);
 		}
-		const std::map<std::string, network_info::CUniqueDataPoint>& mpp = network_info::getUniquePointList();
-		struct network_info::stModbusAddrInfo addrInfo;
-		try
+		if(!isValidJson)
 		{
-			addrInfo = mpp.at(stTopic).getWellSiteDev().getAddressInfo();
-			a_stMbusApiPram.m_i32Ctx = mpp.at(stTopic).getWellSiteDev().getCtxInfo();
+			DO_LOG_ERROR(" Invalid input json parameter or topic.");
+			eFunRetType = APP_ERROR_INVALID_INPUT_JSON;
 		}
-		catch(const std::out_of_range& oor)
-		{
-			DO_LOG_INFO(" Request is not for this application." + std::string(oor.what()));
 
-			return APP_ERROR_UNKNOWN_SERVICE_REQUEST;
-		}
 		// Next section should be executed only if request is for this container and
 		// request is valid
 		if(APP_SUCCESS == eFunRetType)
 		{
-			
-			obj = mpp.at(stTopic).getDataPoint();
-#ifdef MODBUS_STACK_TCPIP_ENABLED
-			a_stMbusApiPram.m_u8DevId = addrInfo.m_stTCP.m_uiUnitID;
-#else
-			a_stMbusApiPram.m_u8DevId = addrInfo.m_stRTU.m_uiSlaveId;
-#endif
-			a_stMbusApiPram.m_stOnDemandReqData.m_isByteSwap = obj.getAddress().m_bIsByteSwap;
-			a_stMbusApiPram.m_stOnDemandReqData.m_isWordSwap = obj.getAddress().m_bIsWordSwap;
+			a_stMbusApiPram.m_u8DevId = stRoute.m_u8DevId;
+			a_stMbusApiPram.m_stOnDemandReqData.m_isByteSwap = stRoute.m_bIsByteSwap;
+			a_stMbusApiPram.m_stOnDemandReqData.m_isWordSwap = stRoute.m_bIsWordSwap;
 
-			a_stMbusApiPram.m_stOnDemandReqData.m_sDataType = obj.getAddress().m_sDataType;
-			a_stMbusApiPram.m_stOnDemandReqData.m_dscaleFactor = obj.getAddress().m_dScaleFactor;
+			a_stMbusApiPram.m_stOnDemandReqData.m_svDataType = stRoute.m_sDataType;
+			a_stMbusApiPram.m_stOnDemandReqData.m_dscaleFactor = stRoute.m_dScaleFactor;
 
-			a_stMbusApiPram.m_stOnDemandReqData.m_iWidth = obj.getAddress().m_iWidth;
+			a_stMbusApiPram.m_stOnDemandReqData.m_iWidth = stRoute.m_iWidth;
 
-			a_stMbusApiPram.m_u16StartAddr = (uint16_t)obj.getAddress().m_iAddress;
-			a_stMbusApiPram.m_u16Quantity = (uint16_t)obj.getAddress().m_iWidth;
+			a_stMbusApiPram.m_u16StartAddr = stRoute.m_u16StartAddr;
+			a_stMbusApiPram.m_u16Quantity = stRoute.m_u16Quantity;
 
 			// Include dataPersist flag's value in struct m_stOnDemandReqData in case of On Demand Request(Read and Write)
 			// The same struct m_stOnDemandReqData is used while preparing JSON payload response for Read On Demand and Write On Demand.
-			a_stMbusApiPram.m_stOnDemandReqData.m_bIsDataPersist = obj.getDataPersist();
-			
-			network_info::eEndPointType eType = obj.getAddress().m_eType;
+			a_stMbusApiPram.m_stOnDemandReqData.m_bIsDataPersist = stRoute.m_bIsDataPersist;
 
 			// Convert back the scaledValue to Hex depending on datatype, width, scalefactor of the specific datapoints
 
 			if (isScaledValue)
 			{
-				if (false == reverseScaledValueToHex(a_stMbusApiPram.m_stOnDemandReqData.m_sDataType,
-												a_stMbusApiPram.m_stOnDemandReqData.m_iWidth,
-												a_stMbusApiPram.m_stOnDemandReqData.m_dscaleFactor,
-												a_stMbusApiPram.m_stOnDemandReqData.m_ScaledValue,
+				if (false == reverseScaledValueToHex(stRoute.m_sDataType,
+												stRoute.m_iWidth,
+												stRoute.m_dScaleFactor,
+												a_stReqView.m_ScaledValue,
 												strValue))
 				 
 					{
@@ -785,29 +1227,15 @@ eMbusAppErrorCode onDemandHandler::jsonParserForOnDemandRequest(MbusAPI_t& a_stM
 					}			
  
 			}
-			/// to find function code of received requestS
-			switch(eType)
+			/// function code of the point is resolved while building routing index
+			funcCode = a_IsWriteReq ? stRoute.m_u8WriteFunCode : stRoute.m_u8ReadFunCode;
+			if(MBUS_MIN_FUN_CODE == funcCode)
 			{
-			case network_info::eEndPointType::eCoil:
-				funcCode = a_IsWriteReq ? WRITE_SINGLE_COIL: READ_COIL_STATUS;
-				break;
-			case network_info::eEndPointType::eHolding_Register:
-				funcCode = a_IsWriteReq ? a_stMbusApiPram.m_u16Quantity == 1 ? WRITE_SINGLE_REG: WRITE_MULTIPLE_REG : READ_HOLDING_REG;
-				break;
-			case network_info::eEndPointType::eInput_Register:
-				funcCode = READ_INPUT_REG;
-				break;
-			case network_info::eEndPointType::eDiscrete_Input:
-				funcCode = READ_INPUT_STATUS;
-				break;
-			default:
-				DO_LOG_ERROR(" Invalid type in datapoint:: " + a_stMbusApiPram.m_stOnDemandReqData.m_strMetric);
-				break;
+				DO_LOG_ERROR(" Invalid type in datapoint:: " + stRoute.m_sMetric);
 			}
 
-			if(a_IsWriteReq && (funcCode == READ_INPUT_REG || funcCode == READ_INPUT_STATUS))
+			if(a_IsWriteReq && MBUS_MAX_FUN_CODE == funcCode)
 			{
-				funcCode = MBUS_MAX_FUN_CODE;
 				return APP_ERROR_POINT_IS_NOT_WRITABLE;
 			}
 
@@ -851,7 +1279,7 @@ eMbusAppErrorCode onDemandHandler::jsonParserForOnDemandRequest(MbusAPI_t& a_stM
 			}
 			if(true == a_IsWriteReq && funcCode != WRITE_MULTIPLE_COILS)
 			{
-				if((true == obj.getAddress().m_bIsByteSwap || true == obj.getAddress().m_bIsWordSwap))
+				if((true == stRoute.m_bIsByteSwap || true == stRoute.m_bIsWordSwap))
 				{
 					std::vector<uint8_t> tempVt;
 					int i = 0;
@@ -867,8 +1295,8 @@ eMbusAppErrorCode onDemandHandler::jsonParserForOnDemandRequest(MbusAPI_t& a_stM
 						i = i+2;
 					}
 					strValue = common_Handler::swapConversion(tempVt,
-							!obj.getAddress().m_bIsByteSwap,
-							obj.getAddress().m_bIsWordSwap);
+							!stRoute.m_bIsByteSwap,
+							stRoute.m_bIsWordSwap);
 				}
 				int retVal = hex2bin(strValue, a_stMbusApiPram.m_u16ByteCount, a_stMbusApiPram.m_pu8Data);
 				if(-1 == retVal)
@@ -1016,6 +1444,17 @@ void onDemandHandler::createOnDemandListener()
 	if(tempRet == false) {
 		exit(1);
 	} 
+	if(0 != PublishJsonHandler::instance().getWriteCoalesceWindowMs())
+	{
+		// thread to send writes at the end of aggregation window
+		std::thread(&onDemandHandler::writeBatchFlushThread, this).detach();
+	}
+	// device contexts are set by now. Build routing index for on-demand requests
+	size_t uiRouteCount = buildRoutingIndex();
+	DO_LOG_INFO("Number of points in on-demand routing index: " + std::to_string(uiRouteCount));
+
+	// workers process requests received by listener threads
+	startWorkerPool(PublishJsonHandler::instance().getOnDemandWorkerCount());
 	for(std::vector<std::string>::iterator it = stTopics.begin(); it != stTopics.end(); ++it)
 	{
 		if(it->empty()) {
@@ -1093,6 +1532,74 @@ string onDemandHandler::getMsgElement(msg_envelope_t *a_Msg,
 }
 
 
+/**
+ * Function to get string value from zmq message without copying it
+ * @param a_pMsg	:[in] actual message received from ZMQ
+ * @param a_pszKey	:[in] key to find
+ * @return value referring to message, empty if key is not present or is not a string
+ */
+std::string_view onDemandHandler::getMsgElementView(msg_envelope_t *a_pMsg, const char *a_pszKey)
+{
+	msg_envelope_elem_body_t* data = NULL;
+	if(NULL == a_pMsg || NULL == a_pszKey)
+	{
+		return std::string_view{};
+	}
+	if(MSG_SUCCESS != msgbus_msg_envelope_get(a_pMsg, a_pszKey, &data) ||
+			NULL == data || MSG_ENV_DT_STRING != data->type || NULL == data->body.string)
+	{
+		return std::string_view{};
+	}
+#ifdef INSTRUMENTATION_LOG
+	DO_LOG_DEBUG(std::string(a_pszKey) + ":" + data->body.string);
+#endif
+	return std::string_view(data->body.string);
+}
+
+/**
+ * Function to fill request view from zmq message. Fields are not copied,
+ * hence view shall not be used once message is destroyed.
+ * @param a_pMsg		:[in] actual message received from ZMQ
+ * @param a_bIsWriteReq	:[in] flag used to distinguish read/write request
+ * @param a_stReqView	:[out] request view to fill
+ * @return 	true : on success,
+ * 			false : if write request does not have valid value
+ */
+bool onDemandHandler::fillRequestView(msg_envelope_t *a_pMsg, bool a_bIsWriteReq, stOnDemandReqView &a_stReqView)
+{
+	a_stReqView.m_svAppSeq = getMsgElementView(a_pMsg, "app_seq");
+	a_stReqView.m_svMetric = getMsgElementView(a_pMsg, "command");
+	if(a_bIsWriteReq)
+	{
+		a_stReqView.m_svValue = getMsgElementView(a_pMsg, "value");
+		if(a_stReqView.m_svValue.empty())
+		{
+			if(false == getScaledValueElement(a_pMsg, "scaledValue", a_stReqView.m_ScaledValue))
+			{
+				return false;
+			}
+		}
+	}
+	a_stReqView.m_svWellhead = getMsgElementView(a_pMsg, "wellhead");
+	a_stReqView.m_svVersion = getMsgElementView(a_pMsg, "version");
+	a_stReqView.m_svTopic = getMsgElementView(a_pMsg, "sourcetopic");
+	a_stReqView.m_svTimestamp = getMsgElementView(a_pMsg, "timestamp");
+	a_stReqView.m_svUsec = getMsgElementView(a_pMsg, "usec");
+	a_stReqView.m_svMqttTime = getMsgElementView(a_pMsg, "tsMsgRcvdFromMQTT");
+	a_stReqView.m_svEiiTime = getMsgElementView(a_pMsg, "tsMsgPublishOnEII");
+	//In case when sparkplug is connected with EMB.
+	if(a_stReqView.m_svMqttTime.empty())
+	{
+		a_stReqView.m_svMqttTime = getMsgElementView(a_pMsg, "tsMsgRcvdFromExtMQTTToSP");
+	}
+	//In case when sparkplug is connected with EMB.
+	if(a_stReqView.m_svEiiTime.empty())
+	{
+		a_stReqView.m_svEiiTime = getMsgElementView(a_pMsg, "tsMsgPublishSPtoEMB");
+	}
+	return true;
+}
+
 /**
  * Function to get value from zmq message based on given key
  * @param msg	:	[in] actual message received from ZMQ
@@ -1184,21 +1691,22 @@ DO_LOG_DEBUG(a_sKey + ":" +  "DT_NONE");
  * @param a_iRetry		:[in] set the retry value to be used for application retry mechanism
  * @param a_lPriority	:[in] set the priority value to be used for stack priority queues
  * @param a_bIsWriteReq	:[in] flag used to distinguish read/write request for further processing
+ * @param a_eRejectCode	:[in] error code to answer request with instead of processing it, APP_SUCCESS to process it
  * @return[bool] true: on Success
  * 				 false: On failure
  */
 bool onDemandHandler::processMsg(msg_envelope_t *msg,
-		std::string stTopic,
+		const std::string &stTopic,
 		bool a_bIsRT,
 		void *vpCallback,
 		const int a_iRetry,
 		const long a_lPriority,
-		const bool a_bIsWriteReq)
+		const bool a_bIsWriteReq,
+		const eMbusAppErrorCode a_eRejectCode)
 {	
 	MbusAPI_t stMbusApiPram = {};
 	timespec_get(&stMbusApiPram.m_stOnDemandReqData.m_obtReqRcvdTS, TIME_UTC);
 	bool bRet = false;
-	std::string retScaledVal="";
 
 	if(NULL == msg || NULL == vpCallback)
 	{
@@ -1216,34 +1724,13 @@ bool onDemandHandler::processMsg(msg_envelope_t *msg,
 		DO_LOG_DEBUG("On-demand request received on "+ stTopic + " realtime:: "+ std::to_string(a_bIsRT) + " with following parameters::");
 #endif
 
-	stMbusApiPram.m_stOnDemandReqData.m_strAppSeq = getMsgElement(msg, "app_seq");
-	stMbusApiPram.m_stOnDemandReqData.m_strMetric = getMsgElement(msg, "command");	
-	if (a_bIsWriteReq)
+	// fields refer to envelope, hence envelope is destroyed only after request is parsed
+	stOnDemandReqView stReqView;
+	if(false == fillRequestView(msg, a_bIsWriteReq, stReqView))
 	{
-		stMbusApiPram.m_stOnDemandReqData.m_sValue = getMsgElement(msg, "value");
-		if (stMbusApiPram.m_stOnDemandReqData.m_sValue.empty())
-		{		
-			if (false == getScaledValueElement(msg, "scaledValue", stMbusApiPram.m_stOnDemandReqData.m_ScaledValue))
-			{
-				DO_LOG_ERROR("Invalid scaledValue received from message envelope of mqtt-bridge");
-				return false;
-			}		 
-		}
-	}	 
-	stMbusApiPram.m_stOnDemandReqData.m_strWellhead = getMsgElement(msg, "wellhead");
-	stMbusApiPram.m_stOnDemandReqData.m_strVersion = getMsgElement(msg, "version");
-	stMbusApiPram.m_stOnDemandReqData.m_strTopic = getMsgElement(msg, "sourcetopic");
-	stMbusApiPram.m_stOnDemandReqData.m_sTimestamp = getMsgElement(msg, "timestamp");
-	stMbusApiPram.m_stOnDemandReqData.m_sUsec = getMsgElement(msg, "usec");
-	stMbusApiPram.m_stOnDemandReqData.m_strMqttTime = getMsgElement(msg, "tsMsgRcvdFromMQTT");
-	stMbusApiPram.m_stOnDemandReqData.m_strEiiTime = getMsgElement(msg, "tsMsgPublishOnEII");
-	//In case when sparkplug is connected with EMB. 
-	if( stMbusApiPram.m_stOnDemandReqData.m_strMqttTime.empty()){
-		stMbusApiPram.m_stOnDemandReqData.m_strMqttTime = getMsgElement(msg, "tsMsgRcvdFromExtMQTTToSP");
-	}
-	//In case when sparkplug is connected with EMB.
-	if( stMbusApiPram.m_stOnDemandReqData.m_strEiiTime.empty()){
-		stMbusApiPram.m_stOnDemandReqData.m_strEiiTime = getMsgElement(msg, "tsMsgPublishSPtoEMB");
+		DO_LOG_ERROR("Invalid scaledValue received from message envelope of mqtt-bridge");
+		msgbus_msg_envelope_destroy(msg);
+		return false;
 	}
 	stMbusApiPram.m_stOnDemandReqData.m_isRT = a_bIsRT;
 
@@ -1251,7 +1738,7 @@ bool onDemandHandler::processMsg(msg_envelope_t *msg,
 	stMbusApiPram.m_nRetry = a_iRetry;
 	stMbusApiPram.m_lPriority = a_lPriority;
 	
-	onDemandInfoHandler(&stMbusApiPram, stTopic, vpCallback, a_bIsWriteReq);
+	onDemandInfoHandler(&stMbusApiPram, stReqView, stTopic, vpCallback, a_bIsWriteReq, a_eRejectCode);
 
 	if(msg != NULL)
 	{
@@ -1298,6 +1785,8 @@ void onDemandHandler::subscribeDeviceListener(const std::string stTopic,
 	{
 		zmq_handler::stZmqContext& msgbus_ctx = zmq_handler::getCTX(stTopic);
 		zmq_handler::stZmqSubContext& stsub_ctx = zmq_handler::getSubCTX(stTopic);
+		stOnDemandTopic *pTopic = registerTopic(stTopic, a_bIsRT, vpCallback, a_iRetry, a_lPriority, a_bIsWriteReq);
+		bool bIsWorkerPool = (0 != PublishJsonHandler::instance().getOnDemandWorkerCount());
 
 		while((msgbus_ctx.m_pContext != NULL) && (NULL != stsub_ctx.sub_ctx)
 				&& (false == g_stopThread.load()))
@@ -1308,8 +1797,21 @@ void onDemandHandler::subscribeDeviceListener(const std::string stTopic,
 				DO_LOG_ERROR("Failed to receive message errno ::" + std::to_string(ret));
 				continue;
 			}
-			// process messages
-			processMsg(msg, stTopic, a_bIsRT, vpCallback, a_iRetry, a_lPriority, a_bIsWriteReq);
+			if(true == bIsWorkerPool)
+			{
+				// message is processed by worker, listener continues to receive
+				if(false == enqueueWork(msg, pTopic))
+				{
+					// workers are not keeping up, hence request is answered with error
+					processMsg(msg, stTopic, a_bIsRT, vpCallback, a_iRetry, a_lPriority, a_bIsWriteReq,
+							APP_ERROR_REQUEST_QUEUE_FULL);
+				}
+			}
+			else
+			{
+				// process messages
+				processMsg(msg, stTopic, a_bIsRT, vpCallback, a_iRetry, a_lPriority, a_bIsWriteReq);
+			}
 		}
 	}
 	catch(const std::exception& e)
@@ -1318,6 +1820,219 @@ void onDemandHandler::subscribeDeviceListener(const std::string stTopic,
 	}
 }
 
+/**
+ * Function to build read cache which maps unique point to its polled point.
+ * It shall be called once polling data is built. Cache is built only once.
+ * @return number of polled points in read cache
+ */
+size_t onDemandHandler::buildReadCache()
+{
+	if(true == m_bIsReadCacheBuilt.load(std::memory_order_acquire))
+	{
+		return m_mapReadCache.size();
+	}
+	std::vector<CRefDataForPolling*> vPoints;
+	CTimeMapper::instance().getPolledPoints(vPoints);
+	m_mapReadCache.reserve(vPoints.size());
+	for(CRefDataForPolling *pPoint : vPoints)
+	{
+		m_mapReadCache.emplace(&(pPoint->getDataPoint()), pPoint);
+	}
+	// listener threads are already running, cache is used only after it is built
+	m_bIsReadCacheBuilt.store(true, std::memory_order_release);
+	return m_mapReadCache.size();
+}
+
+/**
+ * Function to get response of on-demand read from last polled value of the point.
+ * Value is used only if it is received from device within READ_CACHE_MAX_AGE_MS.
+ * @param a_stMbusApiPram	:[in] parsed read request
+ * @param a_stResp			:[out] response data and timestamps, if value is fresh
+ * @return 	true : if read can be answered from last polled value,
+ * 			false : otherwise
+ */
+bool onDemandHandler::getCachedRead(const MbusAPI_t &a_stMbusApiPram, stMbusAppCallbackParams_t &a_stResp)
+{
+	uint32_t u32MaxAgeMs = PublishJsonHandler::instance().getReadCacheMaxAgeMs();
+	if(0 == u32MaxAgeMs || false == m_bIsReadCacheBuilt.load(std::memory_order_acquire))
+	{
+		return false;
+	}
+	auto itrRoute = m_mapRoute.find(a_stMbusApiPram.m_stOnDemandReqData.m_svTopic);
+	if(m_mapRoute.end() == itrRoute)
+	{
+		return false;
+	}
+	auto itrPoint = m_mapReadCache.find(itrRoute->second.m_pUniquePoint);
+	if(m_mapReadCache.end() == itrPoint ||
+			false == itrPoint->second->getFreshResponse(u32MaxAgeMs, a_stResp))
+	{
+		return false;
+	}
+	// Request does not go through stack, hence all stack timestamps are the time of cache hit
+	timespec_get(&a_stResp.m_objTimeStamps.tsReqRcvd, TIME_UTC);
+	a_stResp.m_objTimeStamps.tsReqSent = a_stResp.m_objTimeStamps.tsReqRcvd;
+	a_stResp.m_objTimeStamps.tsRespRcvd = a_stResp.m_objTimeStamps.tsReqRcvd;
+	a_stResp.m_objTimeStamps.tsRespSent = a_stResp.m_objTimeStamps.tsReqRcvd;
+	a_stResp.m_u8ExceptionExcCode = 0;
+	a_stResp.m_u8ExceptionExcStatus = 0;
+	return true;
+}
+
+/**
+ * Function to register a subscribed topic. Requests received on the topic refer to it.
+ * @param a_sTopic		:[in] topic for zmq listening
+ * @param a_bIsRT		:[in] flag used to distinguish RT/NON-RT request
+ * @param vpCallback	:[in] stack callback as per the operation
+ * @param a_iRetry		:[in] retry value to be used for application retry mechanism
+ * @param a_lPriority	:[in] priority value to be used for stack priority queues
+ * @param a_bIsWriteReq	:[in] flag used to distinguish read/write request
+ * @return pointer to registered topic, it is valid till application exits
+ */
+stOnDemandTopic* onDemandHandler::registerTopic(const std::string &a_sTopic, bool a_bIsRT,
+		void *vpCallback, int a_iRetry, long a_lPriority, bool a_bIsWriteReq)
+{
+	std::lock_guard<std::mutex> lock(m_mutexWork);
+	m_listTopic.push_back(stOnDemandTopic{a_sTopic, a_bIsRT, vpCallback, a_iRetry, a_lPriority, a_bIsWriteReq, false});
+	return &m_listTopic.back();
+}
+
+/**
+ * Function to add received request to work queue as per its RT flag
+ * @param a_pMsg	:[in] message received from ZMQ
+ * @param a_pTopic	:[in] topic on which message is received
+ * @return 	true : if request is queued or discarded,
+ * 			false : if work queue is full, message is not consumed
+ */
+bool onDemandHandler::enqueueWork(msg_envelope_t *a_pMsg, stOnDemandTopic *a_pTopic)
+{
+	if(NULL == a_pTopic)
+	{
+		DO_LOG_ERROR("NULL topic received..discarding the request");
+		if(NULL != a_pMsg)
+		{
+			msgbus_msg_envelope_destroy(a_pMsg);
+		}
+		return true;
+	}
+	{
+		std::lock_guard<std::mutex> lock(m_mutexWork);
+		std::deque<stOnDemandWork> &qWork = a_pTopic->m_bIsRT ? m_qWorkRT : m_qWorkNonRT;
+		if(MAX_ONDEMAND_WORK_QUEUE_LEN <= qWork.size())
+		{
+			DO_LOG_ERROR("On-demand work queue is full, rejecting request of topic: " + a_pTopic->m_sTopic);
+			return false;
+		}
+		qWork.push_back(stOnDemandWork{a_pMsg, a_pTopic});
+	}
+	(a_pTopic->m_bIsRT ? m_cvWorkRT : m_cvWorkNonRT).notify_one();
+	return true;
+}
+
+/**
+ * Function to get next request to process from RT or non-RT work queue.
+ * A write request is not taken while an earlier write of the same topic is being
+ * processed, so that writes of a topic reach the device in arrival order.
+ * Read requests do not change device state and are processed by parallel workers.
+ * It shall be called with work mutex locked.
+ * @param a_stWork	:[out] request to process
+ * @param a_bIsRT	:[in] take from RT or non-RT queue(true or false)
+ * @return 	true : if request is available,
+ * 			false : otherwise
+ */
+bool onDemandHandler::dequeueWork(stOnDemandWork &a_stWork, bool a_bIsRT)
+{
+	std::deque<stOnDemandWork> &qWork = a_bIsRT ? m_qWorkRT : m_qWorkNonRT;
+	for(auto itr = qWork.begin(); itr != qWork.end(); ++itr)
+	{
+		stOnDemandTopic &stTopic = *(itr->m_pTopic);
+		if(true == stTopic.m_bIsWriteReq)
+		{
+			if(true == stTopic.m_bIsBusy)
+			{
+				continue;
+			}
+			stTopic.m_bIsBusy = true;
+		}
+		a_stWork = *itr;
+		qWork.erase(itr);
+		return true;
+	}
+	return false;
+}
+
+/**
+ * Function to mark processing of request as complete so that next write
+ * of the same topic can be taken
+ * @param a_stWork	:[in] processed request
+ */
+void onDemandHandler::completeWork(const stOnDemandWork &a_stWork)
+{
+	if(false == a_stWork.m_pTopic->m_bIsWriteReq)
+	{
+		// reads are not serialized, nothing waits for this one
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(m_mutexWork);
+		a_stWork.m_pTopic->m_bIsBusy = false;
+	}
+	// write of this topic might be waiting
+	(a_stWork.m_pTopic->m_bIsRT ? m_cvWorkRT : m_cvWorkNonRT).notify_all();
+}
+
+/**
+ * Worker thread to process on-demand requests received by listener threads
+ * @param a_bIsRT	:[in] worker processes RT or non-RT requests(true or false)
+ */
+void onDemandHandler::onDemandWorkerThread(bool a_bIsRT)
+{
+	globalConfig::COperationInfo &refOps = globalConfig::CGlobalConfig::getInstance().getOpOnDemandReadConfig();
+	globalConfig::set_thread_sched_param(a_bIsRT ? refOps.getRTConfig() : refOps.getNonRTConfig());
+	std::condition_variable &cvWork = a_bIsRT ? m_cvWorkRT : m_cvWorkNonRT;
+
+	while(false == g_stopThread.load())
+	{
+		stOnDemandWork stWork{};
+		{
+			std::unique_lock<std::mutex> lock(m_mutexWork);
+			if(false == dequeueWork(stWork, a_bIsRT))
+			{
+				// wake up periodically to check stop flag
+				cvWork.wait_for(lock, std::chrono::milliseconds(100));
+				continue;
+			}
+		}
+
+		try
+		{
+			const stOnDemandTopic &stTopic = *stWork.m_pTopic;
+			processMsg(stWork.m_pMsg, stTopic.m_sTopic, stTopic.m_bIsRT, stTopic.m_pCallback,
+					stTopic.m_iRetry, stTopic.m_lPriority, stTopic.m_bIsWriteReq);
+		}
+		catch(const std::exception& e)
+		{
+			DO_LOG_FATAL(e.what());
+		}
+		completeWork(stWork);
+	}
+}
+
+/**
+ * Function to start worker threads for on-demand requests. RT and non-RT
+ * requests have their own workers running with respective thread priority.
+ * @param a_u32WorkerCount	:[in] number of workers for each of RT and non-RT, 0 means listener threads process requests
+ */
+void onDemandHandler::startWorkerPool(uint32_t a_u32WorkerCount)
+{
+	for(uint32_t u32Index = 0; u32Index < a_u32WorkerCount; u32Index++)
+	{
+		std::thread(&onDemandHandler::onDemandWorkerThread, this, true).detach();
+		std::thread(&onDemandHandler::onDemandWorkerThread, this, false).detach();
+	}
+	DO_LOG_INFO("Number of on-demand workers started for each of RT and non-RT: " + std::to_string(a_u32WorkerCount));
+}
+
 /**
 * Function to convert decimal to its corresponding hexadecimal format 
 * @param num  :[in] input decimal number which is required to be converted to hexadecimal
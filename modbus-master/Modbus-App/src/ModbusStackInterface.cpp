@@ -48,10 +48,14 @@ void OnDemandRead_AppCallback(stMbusAppCallbackParams_t *pstMbusAppCallbackParam
 		DO_LOG_DEBUG("Response received from stack is null for on-demand read");
 		return;
 	}
+	// topic is interned on first response only
+	static const uint16_t u16TopicID =
+			CPeriodicReponseProcessor::Instance().internTopic(PublishJsonHandler::instance().getSReadResponseTopic());
+
 	/// handle response to process response
 	CPeriodicReponseProcessor::Instance().handleResponse(pstMbusAppCallbackParams,
 															MBUS_CALLBACK_ONDEMAND_READ,
-															PublishJsonHandler::instance().getSReadResponseTopic(),
+															u16TopicID,
 															false);
 	DO_LOG_DEBUG("End");
 }
@@ -70,10 +74,14 @@ void OnDemandReadRT_AppCallback(stMbusAppCallbackParams_t *pstMbusAppCallbackPar
 		return;
 	}
 
+	// topic is interned on first response only
+	static const uint16_t u16TopicID =
+			CPeriodicReponseProcessor::Instance().internTopic(PublishJsonHandler::instance().getSReadResponseTopicRT());
+
 	/// handle response to process response
 	CPeriodicReponseProcessor::Instance().handleResponse(pstMbusAppCallbackParams,
 															MBUS_CALLBACK_ONDEMAND_READ_RT,
-															PublishJsonHandler::instance().getSReadResponseTopicRT(),
+															u16TopicID,
 															true);
 
 	DO_LOG_DEBUG("End");
@@ -94,10 +102,14 @@ void OnDemandWrite_AppCallback(stMbusAppCallbackParams_t *pstMbusAppCallbackPara
 		return;
 	}
 
+	// topic is interned on first response only
+	static const uint16_t u16TopicID =
+			CPeriodicReponseProcessor::Instance().internTopic(PublishJsonHandler::instance().getSWriteResponseTopic());
+
 	/// handle response to process response
 	CPeriodicReponseProcessor::Instance().handleResponse(pstMbusAppCallbackParams,
 														MBUS_CALLBACK_ONDEMAND_WRITE,
-														PublishJsonHandler::instance().getSWriteResponseTopic(),
+														u16TopicID,
 														false);
 
 	DO_LOG_DEBUG("End");
@@ -117,10 +129,14 @@ void OnDemandWriteRT_AppCallback(stMbusAppCallbackParams_t *pstMbusAppCallbackPa
 		return;
 	}
 
+	// topic is interned on first response only
+	static const uint16_t u16TopicID =
+			CPeriodicReponseProcessor::Instance().internTopic(PublishJsonHandler::instance().getSWriteResponseTopicRT());
+
 	/// handle response to process response
 	CPeriodicReponseProcessor::Instance().handleResponse(pstMbusAppCallbackParams,
 														MBUS_CALLBACK_ONDEMAND_WRITE_RT,
-														PublishJsonHandler::instance().getSWriteResponseTopicRT(),
+														u16TopicID,
 														true);
 
 	DO_LOG_DEBUG("End");
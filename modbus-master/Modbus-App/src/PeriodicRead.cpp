@@ -30,6 +30,10 @@
 #include <ctime>
 #include <chrono>
 #include <functional>
+#include <tuple>
+#include <set>
+#include <unordered_map>
+#include <algorithm>
 #include <sys/timerfd.h>
 #include <poll.h>
 #include <unistd.h>
@@ -37,6 +41,7 @@
 #include "CommonDataShare.hpp"
 #include <stdlib.h>
 #include <fenv.h>
+#include <cmath>
 /// flag to check thread stop condition
 std::atomic<bool> g_stopThread;
 
@@ -55,6 +60,22 @@ extern "C" {
 /// variable to store timer instance
 timer_t gTimerid;
 
+/** number of lower bits of driver_seq used for time in milliseconds, rest are for roll ID of point*/
+#define DRIVER_SEQ_TIME_BITS 40
+
+/**
+ * Gets driver sequence of a point. Roll ID of point is kept in upper bits and time in
+ * milliseconds, modulo 2^40, in lower bits, so sequence is unique across points.
+ * @param a_u32RollID	:[in] roll ID of point
+ * @param a_u64Msec		:[in] current time in milliseconds
+ * @return driver sequence
+ */
+static uint64_t getDriverSeq(uint32_t a_u32RollID, uint64_t a_u64Msec)
+{
+	static_assert((ROLL_ID_APP_BITS + ROLL_ID_POINT_BITS + DRIVER_SEQ_TIME_BITS) <= 64, "driver_seq does not fit in 64 bits");
+	return ((uint64_t)a_u32RollID << DRIVER_SEQ_TIME_BITS) | (a_u64Msec & ((1ULL << DRIVER_SEQ_TIME_BITS) - 1));
+}
+
 /**
  * Get time based parameters like usec, timestamp, transaction id, etc. based on current time
  * @param a_objReqData	:[in] request data
@@ -74,11 +95,49 @@ void getTimeBasedParams(const CRefDataForPolling& a_objReqData, std::string &a_s
 			(unsigned long long int)(std::chrono::duration_cast<std::chrono::milliseconds>(p1.time_since_epoch()).count())
 		};
 		std::stringstream ss;
-		ss << (unsigned long long)(((unsigned long long)(a_objReqData.getDataPoint().getMyRollID()) << 48) | u64);
+		ss << (unsigned long long)getDriverSeq(a_objReqData.getDataPoint().getMyRollID(), u64);
 		a_sTxID.insert(0, ss.str());
 	}
 }
 
+/**
+ * Get time based parameters of binary update based on current time
+ * @param a_objReqData	:[in] request data
+ * @param a_i64Usec		:[out] current time in micro-seconds
+ * @param a_u64TxID		:[out] transaction id
+ * @return none
+ */
+static void getTimeBasedParams(const CRefDataForPolling& a_objReqData, int64_t &a_i64Usec, uint64_t &a_u64TxID)
+{
+	const auto p1 = std::chrono::system_clock::now();
+	a_i64Usec = (int64_t)std::chrono::duration_cast<std::chrono::microseconds>(p1.time_since_epoch()).count();
+	a_u64TxID = getDriverSeq(a_objReqData.getDataPoint().getMyRollID(), (uint64_t)(a_i64Usec / 1000));
+}
+
+/**
+ * Get timestamp and transaction id of JSON update based on current time. Values are
+ * written in given buffers, nothing is allocated.
+ * @param a_objReqData	:[in] request data
+ * @param a_szTimeStamp	:[out] time stamp
+ * @param a_szTxID		:[out] transaction id
+ * @return none
+ */
+static void getTimeBasedParams(const CRefDataForPolling& a_objReqData, char (&a_szTimeStamp)[32], char (&a_szTxID)[32])
+{
+	int64_t i64Usec = 0;
+	uint64_t u64TxID = 0;
+	getTimeBasedParams(a_objReqData, i64Usec, u64TxID);
+	snprintf(a_szTxID, sizeof(a_szTxID), "%llu", (unsigned long long)u64TxID);
+
+	a_szTimeStamp[0] = '\0';
+	std::time_t rawtime = (std::time_t)(i64Usec / 1000000);
+	std::tm stTime;
+	if(NULL != gmtime_r(&rawtime, &stTime))
+	{
+		std::strftime(a_szTimeStamp, sizeof(a_szTimeStamp), "%Y-%m-%d %H:%M:%S", &stTime);
+	}
+}
+
 /**
  * Gets timestmp in micro-seconds from given timepsec structure
  * @param ts	:[in] time to convert to nano-seconds
@@ -115,10 +174,11 @@ bool CPeriodicReponseProcessor::prepareResponseJson(std::string &a_rtOrNrt, std:
 	int aWidth;
 	std::string response_topic_mqtt;
 	std::string rtOrNrt;
+	stValueDecoder stDecoder;
+	bool bIsCached = false;
 
 	try
 	{
-		MbusAPI_t stMbusApiPram = {};
 		std::string sTimestamp, sUsec, sTxID;
 		a_sValue.clear();
 		msg_envelope_elem_body_t* ptTopic = NULL;
@@ -168,6 +228,9 @@ bool CPeriodicReponseProcessor::prepareResponseJson(std::string &a_rtOrNrt, std:
 			aScaleFactor = a_objReqData->getDataPoint().getDataPoint().getAddress().m_dScaleFactor;
 
 			aWidth = a_objReqData->getDataPoint().getDataPoint().getAddress().m_iWidth;
+
+			// Decoder is chosen once for polled point
+			stDecoder = a_objReqData->getValueDecoder();
 			
 			// Include dataPersist flag and its value into JSON payload in case of Polling.
 			bool isDataPersist = a_objReqData->getDataPoint().getDataPoint().getDataPersist();
@@ -185,42 +248,46 @@ bool CPeriodicReponseProcessor::prepareResponseJson(std::string &a_rtOrNrt, std:
 		}
 		else
 		{
-			bool bRetVal = common_Handler::getReqData(a_stResp.u16TransacID, stMbusApiPram);
-			if(false == bRetVal)
+			common_Handler::reqDataHandle_t pReqData = common_Handler::getReqData(a_stResp.u16TransacID);
+			if(NULL == pReqData)
 			{
 				DO_LOG_FATAL("Could not get data in map for on-demand request");
 				return FALSE;
 			}
+			const MbusAPI_t &stMbusApiPram = *pReqData;
 
 			/// application sequence
-			msg_envelope_elem_body_t* ptAppSeq = msgbus_msg_envelope_new_string(stMbusApiPram.m_stOnDemandReqData.m_strAppSeq.c_str());
+			msg_envelope_elem_body_t* ptAppSeq = msgbus_msg_envelope_new_string(stMbusApiPram.m_stOnDemandReqData.m_szAppSeq);
 			/// topic
-			response_topic_mqtt = stMbusApiPram.m_stOnDemandReqData.m_strTopic.append("Response"); // frame the response topic for mqtt like /flowmeter/PL0/DP13/writeResponse or /flowmeter/PL0/DP13/readResponse
+			// frame the response topic for mqtt like /flowmeter/PL0/DP13/writeResponse or /flowmeter/PL0/DP13/readResponse
+			response_topic_mqtt.assign(stMbusApiPram.m_stOnDemandReqData.m_svTopic);
+			response_topic_mqtt.append(stMbusApiPram.m_stOnDemandReqData.m_isWriteReq ? "/writeResponse" : "/readResponse");
 			ptTopic = msgbus_msg_envelope_new_string(response_topic_mqtt.c_str());
 			/// wellhead
-			ptWellhead = msgbus_msg_envelope_new_string(stMbusApiPram.m_stOnDemandReqData.m_strWellhead.c_str());
+			ptWellhead = msgbus_msg_envelope_new_string(std::string(stMbusApiPram.m_stOnDemandReqData.m_svWellhead).c_str());
 			/// metric
-			ptMetric = msgbus_msg_envelope_new_string(stMbusApiPram.m_stOnDemandReqData.m_strMetric.c_str());
+			ptMetric = msgbus_msg_envelope_new_string(std::string(stMbusApiPram.m_stOnDemandReqData.m_svMetric).c_str());
 			/// RealTime
 			ptRealTime =  msgbus_msg_envelope_new_string(std::to_string(stMbusApiPram.m_stOnDemandReqData.m_isRT).c_str());
 			rtOrNrt = std::to_string(stMbusApiPram.m_stOnDemandReqData.m_isRT);
 			/// add timestamps for req recvd by app
 			msg_envelope_elem_body_t* ptAppTSReqRcvd = msgbus_msg_envelope_new_string( (std::to_string(get_micros(stMbusApiPram.m_stOnDemandReqData.m_obtReqRcvdTS))).c_str() );
 			/// message received from MQTT Time
-			msg_envelope_elem_body_t* ptMqttTime = msgbus_msg_envelope_new_string(stMbusApiPram.m_stOnDemandReqData.m_strMqttTime.c_str());
+			msg_envelope_elem_body_t* ptMqttTime = msgbus_msg_envelope_new_string(stMbusApiPram.m_stOnDemandReqData.m_szMqttTime);
 			/// message received from MQTT Time
-			msg_envelope_elem_body_t* ptEiiTime = msgbus_msg_envelope_new_string(stMbusApiPram.m_stOnDemandReqData.m_strEiiTime.c_str());
+			msg_envelope_elem_body_t* ptEiiTime = msgbus_msg_envelope_new_string(stMbusApiPram.m_stOnDemandReqData.m_szEiiTime);
 
 			msgbus_msg_envelope_put(msg, "reqRcvdByApp", ptAppTSReqRcvd);
 			msgbus_msg_envelope_put(msg, "app_seq", ptAppSeq);
 			msgbus_msg_envelope_put(msg, "tsMsgRcvdFromMQTT", ptMqttTime);
 			msgbus_msg_envelope_put(msg, "tsMsgPublishOnEII", ptEiiTime);
 
+			bIsCached = stMbusApiPram.m_stOnDemandReqData.m_bIsCached;
 			bIsByteSwap = stMbusApiPram.m_stOnDemandReqData.m_isByteSwap;
 			bIsWordSwap = stMbusApiPram.m_stOnDemandReqData.m_isWordSwap;
 
 			// Point data type
-			aDataType = stMbusApiPram.m_stOnDemandReqData.m_sDataType;
+			aDataType = stMbusApiPram.m_stOnDemandReqData.m_svDataType;
 			std::transform(aDataType.begin(), aDataType.end(), aDataType.begin(), ::tolower);
 
 			// Point Scale Factor
@@ -228,6 +295,8 @@ bool CPeriodicReponseProcessor::prepareResponseJson(std::string &a_rtOrNrt, std:
 
 			aWidth = stMbusApiPram.m_stOnDemandReqData.m_iWidth;
 
+			stDecoder = common_Handler::getValueDecoder(aDataType, aWidth, bIsByteSwap, bIsWordSwap, aScaleFactor);
+
 			// dataPersist flag is added in modbus msgbus_msg_envelope in case of on-demand read and write request 
 			bool isDataPersist = stMbusApiPram.m_stOnDemandReqData.m_bIsDataPersist;
 			ptDataPersist = msgbus_msg_envelope_new_bool(isDataPersist);
@@ -257,6 +326,11 @@ bool CPeriodicReponseProcessor::prepareResponseJson(std::string &a_rtOrNrt, std:
 		msgbus_msg_envelope_put(msg, "wellhead", ptWellhead);
 		msgbus_msg_envelope_put(msg, "metric", ptMetric);
 		msgbus_msg_envelope_put(msg, "realtime", ptRealTime);
+		if(true == bIsCached)
+		{
+			// on-demand read is answered using last polled value
+			msgbus_msg_envelope_put(msg, "cached", msgbus_msg_envelope_new_bool(true));
+		}
 
 		// add timestamps
 		msgbus_msg_envelope_put(msg, "reqRcvdInStack", ptStackTSReqRcvd);
@@ -272,52 +346,22 @@ bool CPeriodicReponseProcessor::prepareResponseJson(std::string &a_rtOrNrt, std:
 				a_stResp.m_u8FunCode == READ_INPUT_STATUS ||
 				a_stResp.m_u8FunCode == READ_INPUT_REG)
 		{
-			if(TRUE == a_stResp.bIsValPresent)
+			// Hex string value is published only if it is enabled
+			bool bIsHexValueEnabled = PublishJsonHandler::instance().isHexValueEnabled();
+			if((TRUE == a_stResp.bIsValPresent) && (0 != a_stResp.m_Value.size()))
 			{
-				std::vector<uint8_t> vt = a_stResp.m_Value;
-				if(0 != vt.size())
+				if(true == bIsHexValueEnabled)
 				{
-					a_sValue = common_Handler::swapConversion(vt, bIsByteSwap, bIsWordSwap);
-									
-					msg_envelope_elem_body_t* ptScaleValue = setScaledValue(a_sValue, aDataType, aScaleFactor, aWidth);
-					msgbus_msg_envelope_put(msg, "scaledValue", ptScaleValue);					
-
+					a_sValue = common_Handler::swapConversion(a_stResp.m_Value, bIsByteSwap, bIsWordSwap);
 					msg_envelope_elem_body_t* ptValue = msgbus_msg_envelope_new_string(a_sValue.c_str());
 					msgbus_msg_envelope_put(msg, "value", ptValue);
-					msg_envelope_elem_body_t* ptStatus = msgbus_msg_envelope_new_string("Good");
-					msgbus_msg_envelope_put(msg, "status", ptStatus);
 				}
-				else
-				{
-					msg_envelope_elem_body_t* ptStatus = msgbus_msg_envelope_new_string("Bad");
-
-					int iErrCode = a_stResp.m_stException.m_u8ExcStatus * ERORR_MULTIPLIER + a_stResp.m_stException.m_u8ExcCode;
-					msg_envelope_elem_body_t* ptErrorDetails = msgbus_msg_envelope_new_string(std::to_string(iErrCode).c_str());
-					msgbus_msg_envelope_put(msg, "status", ptStatus);
-					msgbus_msg_envelope_put(msg, "error_code", ptErrorDetails);
-
-					// Use last known value for polling
-					if(MBUS_CALLBACK_POLLING == a_stResp.m_operationType || MBUS_CALLBACK_POLLING_RT == a_stResp.m_operationType)
-					{
-						stLastGoodResponse objLastResp =
-								(const_cast<CRefDataForPolling*>(a_objReqData))->getLastGoodResponse();
-
-						msg_envelope_elem_body_t* ptValue = msgbus_msg_envelope_new_string(objLastResp.m_sValue.c_str());
-						msgbus_msg_envelope_put(msg, "value", ptValue);
 
-						msg_envelope_elem_body_t* ptScaleValue = setScaledValue(objLastResp.m_sValue,aDataType,aScaleFactor,aWidth);
-						msgbus_msg_envelope_put(msg, "scaledValue", ptScaleValue);
+				msg_envelope_elem_body_t* ptScaleValue = setScaledValue(a_stResp.m_Value, stDecoder);
+				msgbus_msg_envelope_put(msg, "scaledValue", ptScaleValue);
 
-						msg_envelope_elem_body_t* ptLastUsec = msgbus_msg_envelope_new_string(objLastResp.m_sLastUsec.c_str());
-						msgbus_msg_envelope_put(msg, "lastGoodUsec", ptLastUsec);
-					}
-					else
-					{
-						// it is on-demand read response
-						msg_envelope_elem_body_t* ptValue = msgbus_msg_envelope_new_string("");
-						msgbus_msg_envelope_put(msg, "value", ptValue);
-					}
-				}
+				msg_envelope_elem_body_t* ptStatus = msgbus_msg_envelope_new_string("Good");
+				msgbus_msg_envelope_put(msg, "status", ptStatus);
 			}
 			else
 			{
@@ -333,16 +377,19 @@ bool CPeriodicReponseProcessor::prepareResponseJson(std::string &a_rtOrNrt, std:
 				{
 					stLastGoodResponse objLastResp =
 							(const_cast<CRefDataForPolling*>(a_objReqData))->getLastGoodResponse();
-					msg_envelope_elem_body_t* ptValue = msgbus_msg_envelope_new_string(objLastResp.m_sValue.c_str());
-					msgbus_msg_envelope_put(msg, "value", ptValue);
+					if(true == bIsHexValueEnabled)
+					{
+						msg_envelope_elem_body_t* ptValue = msgbus_msg_envelope_new_string(objLastResp.m_sValue.c_str());
+						msgbus_msg_envelope_put(msg, "value", ptValue);
+					}
 
-					msg_envelope_elem_body_t* ptScaleValue = setScaledValue(objLastResp.m_sValue, aDataType, aScaleFactor, aWidth);
+					msg_envelope_elem_body_t* ptScaleValue = setScaledValue(objLastResp.m_vValue, stDecoder);
 					msgbus_msg_envelope_put(msg, "scaledValue", ptScaleValue);
 
 					msg_envelope_elem_body_t* ptLastUsec = msgbus_msg_envelope_new_string(objLastResp.m_sLastUsec.c_str());
 					msgbus_msg_envelope_put(msg, "lastGoodUsec", ptLastUsec);
 				}
-				else
+				else if(true == bIsHexValueEnabled)
 				{
 					// it is on-demand read response
 					msg_envelope_elem_body_t* ptValue = msgbus_msg_envelope_new_string("");
@@ -437,13 +484,25 @@ bool CPeriodicReponseProcessor::postResponseJSON(stStackResponse& a_stResp, cons
 	}
 	msg_envelope_t* g_msg = NULL;
 
+	// Polled point having publish template, only variable fields need to be filled
+	if((MBUS_CALLBACK_POLLING == a_stResp.m_operationType || MBUS_CALLBACK_POLLING_RT == a_stResp.m_operationType)
+			&& (NULL != a_objReqData->getPublishTemplate()))
+	{
+		if(true == PublishJsonHandler::instance().isBinaryUpdateEnabled())
+		{
+			// update is converted to JSON only where it leaves EII
+			return postPolledResponseBinary(a_stResp, a_objReqData, a_pstTsPolling);
+		}
+		return postPolledResponseJSON(a_stResp, a_objReqData, a_pstTsPolling);
+	}
+
 	try
 	{
 		std::string sValue{""};
 		std::string rtOrNrt;
 		std::string responseMqttTopic;
-		std::string embTopic;
-		std::string appName = PublishJsonHandler::instance().getAppName(); // gets the appName as TCP (Modbus TCP) or RTU (modbus RTU).
+		// publisher per response topic, resolved on first response of the topic by this thread
+		static thread_local std::unordered_map<std::string, zmq_handler::stZmqPubHandle*> mapPubHandles[2];
 		if(FALSE == prepareResponseJson(rtOrNrt, responseMqttTopic, &g_msg, sValue, a_objReqData, a_stResp, a_pstTsPolling))
 		{
 			DO_LOG_INFO( " Error in preparing response");
@@ -453,10 +512,22 @@ bool CPeriodicReponseProcessor::postResponseJSON(stStackResponse& a_stResp, cons
 		{
 			// map the mqtt topic to emb topic format to publish to EMB bus.
 			bool isRT = (rtOrNrt.compare("1")==0)?true:false;
-			embTopic = mapMqttToEMBRespTopic(responseMqttTopic, isRT, appName); // TCP/RT/readResponse/flowmeter/PL0/D13 or RTU/NRT/writeResponse/flowmeter/PL0/D13 or RTU/NRT/update/flowmeter/PL0/D13
-			//Get the context for this EMB Response PUB topic
-
-			zmq_handler::prepareContext(true, (zmq_handler::getPubCtxCfg()).m_pub_msgbus_ctx, embTopic, (zmq_handler::getPubCtxCfg()).m_pub_config);
+			zmq_handler::stZmqPubHandle *pPubHandle = NULL;
+			auto itrHandle = mapPubHandles[isRT].find(responseMqttTopic);
+			if(mapPubHandles[isRT].end() != itrHandle)
+			{
+				pPubHandle = itrHandle->second;
+			}
+			else
+			{
+				// TCP/RT/readResponse/flowmeter/PL0/D13 or RTU/NRT/writeResponse/flowmeter/PL0/D13 or RTU/NRT/update/flowmeter/PL0/D13
+				std::string embTopic = mapMqttToEMBRespTopic(responseMqttTopic, isRT, PublishJsonHandler::instance().getAppName());
+				pPubHandle = zmq_handler::getPubHandle(embTopic);
+				if(NULL != pPubHandle)
+				{
+					mapPubHandles[isRT].emplace(responseMqttTopic, pPubHandle);
+				}
+			}
 			if(MBUS_CALLBACK_POLLING == a_stResp.m_operationType || MBUS_CALLBACK_POLLING_RT == a_stResp.m_operationType)
 			{
 			}
@@ -466,17 +537,17 @@ bool CPeriodicReponseProcessor::postResponseJSON(stStackResponse& a_stResp, cons
 			}
 			std::string sUsec{""};
 
-			if(true == zmq_handler::publishJson(sUsec, g_msg, embTopic, "usec"))
+			if(true == zmq_handler::publishJson(sUsec, g_msg, pPubHandle, "usec"))
 			{
 				// Message is successfully published
 				// For polling operation having value field, store it as last known value and usec
 				if(MBUS_CALLBACK_POLLING == a_stResp.m_operationType || MBUS_CALLBACK_POLLING_RT == a_stResp.m_operationType)
 				{
 					// Check if value was available.
-					if(false == sValue.empty())
+					if((true == a_stResp.bIsValPresent) && (false == a_stResp.m_Value.empty()))
 					{
 						// save last known response
-						(const_cast<CRefDataForPolling*>(a_objReqData))->saveGoodResponse(sValue, sUsec);
+						(const_cast<CRefDataForPolling*>(a_objReqData))->saveGoodResponse(sValue, a_stResp.m_Value, sUsec);
 					}
 				}
 				DO_LOG_DEBUG("Msg published successfully");
@@ -521,252 +592,833 @@ bool CPeriodicReponseProcessor::postResponseJSON(stStackResponse& a_stResp, cons
 }
 
 /**
- * Post dummy bad response as actual response is not received
- * @param a_objReqData	:[in] request for which to send dummy response
- * @param m_stException	:[in] exception
- * @param a_pstRefPollTime:[in] Polling timestamp for given request
+ * Adds element to envelope. Element is destroyed if it could not be added.
+ * @param a_pMsg	:[in] envelope
+ * @param a_pcKey	:[in] field name
+ * @param a_pElem	:[in] element to add
  * @return 	true : on success,
  * 			false : on error
  */
-bool CPeriodicReponseProcessor::postDummyBADResponse(CRefDataForPolling& a_objReqData,
-		const stException_t m_stException, struct timespec *a_pstRefPollTime = NULL)
+static bool putEnvelopeField(msg_envelope_t* a_pMsg, const char* a_pcKey, msg_envelope_elem_body_t* a_pElem)
 {
-	try
+	if(NULL == a_pElem)
 	{
-		// Prepare dummy response
-		stStackResponse stResp = {};
-		stResp.bIsValPresent = false;
-		stResp.m_Value.clear();
-		stResp.u16TransacID = 0;
-		stResp.u8Reason = m_stException.m_u8ExcCode;
-		stResp.m_stException.m_u8ExcCode = m_stException.m_u8ExcCode;
-		stResp.m_stException.m_u8ExcStatus = m_stException.m_u8ExcStatus;
-		stResp.m_operationType = MBUS_CALLBACK_POLLING;
-		stResp.m_u8FunCode = a_objReqData.getFunctionCode();
-
-		// fill the topic as per realtime and non-realtime
-		if(a_objReqData.getDataPoint().getRTFlag())
-		{
-			stResp.m_strResponseTopic = PublishJsonHandler::instance().getPolledDataTopicRT();
-		}
-		else
-		{
-			stResp.m_strResponseTopic = PublishJsonHandler::instance().getPolledDataTopic();
-		}
-
-		// Post it
-		postResponseJSON(stResp, &a_objReqData, a_pstRefPollTime);
-
-		// Response is posted. Mark the flag
-		a_objReqData.setResponsePosted(true);
+		DO_LOG_ERROR("Error: memory not allocated");
+		return false;
 	}
-	catch(const std::exception& e)
+	if(MSG_SUCCESS != msgbus_msg_envelope_put(a_pMsg, a_pcKey, a_pElem))
 	{
-		DO_LOG_FATAL(e.what());
+		DO_LOG_ERROR(std::string("Could not add field: ") + a_pcKey);
+		msgbus_msg_envelope_elem_destroy(a_pElem);
+		return false;
 	}
-
-	// return true on success
-	return TRUE;
+	return true;
 }
 
 /**
- * Post response json to ZMQ using given response data
- * @param a_stResp	:[in] response data
+ * Sets field of envelope to given element. Present element of field is updated in place
+ * when both are scalar or both are strings fitting in present buffer, given element is
+ * then destroyed. Otherwise present element is replaced by given element.
+ * @param a_pMsg	:[in] envelope
+ * @param a_pcKey	:[in] field name
+ * @param a_pElem	:[in] element to set, it is owned by this function
  * @return 	true : on success,
  * 			false : on error
  */
-bool CPeriodicReponseProcessor::postResponseJSON(stStackResponse& a_stResp)
+static bool setEnvelopeField(msg_envelope_t* a_pMsg, const char* a_pcKey, msg_envelope_elem_body_t* a_pElem)
 {
-	try
+	if(NULL == a_pElem)
 	{
-		if(MBUS_CALLBACK_POLLING == a_stResp.m_operationType || MBUS_CALLBACK_POLLING_RT == a_stResp.m_operationType)
-		{
-			CRefDataForPolling& objReqData = CRequestInitiator::instance().getTxIDReqData(a_stResp.u16TransacID, a_stResp.m_bIsRT);
-			// Node is found in transaction map. Remove it now.
-			CRequestInitiator::instance().removeTxIDReqData(a_stResp.u16TransacID, a_stResp.m_bIsRT);
-			// Response is received. Reset response awaited status
-			objReqData.getDataPoint().setIsAwaitResp(false);
-			// reset txid
-			objReqData.setReqTxID(0);
-			
-			if(TRUE == postResponseJSON(a_stResp, &objReqData))
-			{
-				// Response is posted. Mark the flag
-				objReqData.setResponsePosted(true);
-			}
-		}
-		else
-		{
-			postResponseJSON(a_stResp, NULL);
-		}
+		DO_LOG_ERROR("Error: memory not allocated");
+		return false;
 	}
-	catch(const std::exception& e)
+	if(MSG_ENV_DT_STRING == a_pElem->type)
 	{
-		DO_LOG_FATAL(std::to_string(a_stResp.u16TransacID) + e.what());
+		bool bRet = zmq_handler::setStringField(a_pMsg, a_pcKey, a_pElem->body.string);
+		msgbus_msg_envelope_elem_destroy(a_pElem);
+		return bRet;
 	}
 
-	// return true on success
-	return TRUE;
+	auto fnIsScalar = [](msg_envelope_data_type_t a_eType)
+	{
+		return (MSG_ENV_DT_INT == a_eType) || (MSG_ENV_DT_FLOATING == a_eType) || (MSG_ENV_DT_BOOLEAN == a_eType);
+	};
+	msg_envelope_elem_body_t* pPresent = NULL;
+	if((MSG_SUCCESS == msgbus_msg_envelope_get(a_pMsg, a_pcKey, &pPresent)) && (NULL != pPresent))
+	{
+		if(fnIsScalar(pPresent->type) && fnIsScalar(a_pElem->type))
+		{
+			pPresent->type = a_pElem->type;
+			pPresent->body = a_pElem->body;
+			msgbus_msg_envelope_elem_destroy(a_pElem);
+			return true;
+		}
+		msgbus_msg_envelope_remove(a_pMsg, a_pcKey);
+	}
+	return putEnvelopeField(a_pMsg, a_pcKey, a_pElem);
 }
 
 /**
- * Initialize semaphore for all RT and Non-RT operations for response processing
+ * Sets field of envelope to given time in micro-seconds
+ * @param a_pMsg	:[in] envelope
+ * @param a_pcKey	:[in] field name
+ * @param a_ts		:[in] time to set
  * @return 	true : on success,
  * 			false : on error
  */
-bool CPeriodicReponseProcessor::initSem()
+static bool setEnvelopeMicros(msg_envelope_t* a_pMsg, const char* a_pcKey, struct timespec a_ts)
 {
-	//
-	int okPolling = sem_init(&semPollingRespProcess, 0, 0 /* Initial value of zero*/);
-	int okPollingRT = sem_init(&semRTPollingRespProcess, 0, 0 /* Initial value of zero*/);
-	int okODRead = sem_init(&semODReadRespProcess, 0, 0 /* Initial value of zero*/);
-	int okODReadRT = sem_init(&semRTODReadRespProcess, 0, 0 /* Initial value of zero*/);
-	int okODWrite = sem_init(&semODWriteRespProcess, 0, 0 /* Initial value of zero*/);
-	int okODWriteRT = sem_init(&semRTODWriteRespProcess, 0, 0 /* Initial value of zero*/);
-	if (okPolling == -1 || okPollingRT == -1 || okODRead == -1 || okODReadRT == -1 || okODWrite == -1 || okODWriteRT ==-1)
-	{
-		DO_LOG_FATAL("Could not create unnamed semaphore " + std::to_string(errno) + " " + strerror(errno));
-	   return false;
-	}
-	return true;
+	char szBuf[32];
+	snprintf(szBuf, sizeof(szBuf), "%lu", get_micros(a_ts));
+	return zmq_handler::setStringField(a_pMsg, a_pcKey, szBuf);
 }
 
 /**
- * Response process thread
- * @param operationCallbackType	:[in] operation type, polling, on-demand, RT/Non_RT
- * @param a_refSem: [in] semaphore applicable for given operation type for listening on response data from a queue
- * @param a_refOps: [in] global config reference for given operation
- * @return appropriate error code
+ * Fills variable fields of polled response in publish template envelope of the point.
+ * Fields of previous response are updated in place, hence a response allocates
+ * only its scaled value, and fields are added or removed only when status changes.
+ * @param a_pMsg		:[in] template envelope of point
+ * @param a_sValue		:[out] Value, if available
+ * @param a_objReqData	:[in] request data
+ * @param a_stResp		:[in] response data
+ * @param a_pstTsPolling:[in] polling timestamp, if any
+ * @param a_bIsReportRequired:[out] false if good value is within deadband of point and
+ * 								envelope is left as it is, true otherwise
+ * @return 	true : on success,
+ * 			false : on error
  */
-eMbusAppErrorCode CPeriodicReponseProcessor::respProcessThreads(eMbusCallbackType operationCallbackType,
-		sem_t& a_refSem,
-		globalConfig::COperation& a_refOps)
+bool CPeriodicReponseProcessor::fillPolledResponseJson(msg_envelope_t* a_pMsg, std::string &a_sValue,
+		const CRefDataForPolling& a_objReqData, const stStackResponse& a_stResp, struct timespec *a_pstTsPolling,
+		bool &a_bIsReportRequired)
 {
-	eMbusAppErrorCode eRetType = APP_SUCCESS;
-	sem_t& l_sem = a_refSem;
-
-	// set the thread priority
-	globalConfig::set_thread_sched_param(a_refOps);
-
-	globalConfig::display_thread_sched_attr("respProcessThreads param::");
-
+	a_bIsReportRequired = true;
+	if(NULL == a_pMsg)
+	{
+		return false;
+	}
+	bool bRetValue = true;
+	a_sValue.clear();
 
-	while(false == g_stopThread.load())
+	const stValueDecoder &stDecoder = a_objReqData.getValueDecoder();
+	bool bIsGood = (TRUE == a_stResp.bIsValPresent) && (0 != a_stResp.m_Value.size());
+	msg_envelope_elem_body_t* pScaledValue = NULL;
+	if(true == bIsGood)
 	{
-		/// iterate Queue one by one to send message on Pl-bus
-		do
+		pScaledValue = setScaledValue(a_stResp.m_Value, stDecoder);
+		if(false == (const_cast<CRefDataForPolling&>(a_objReqData)).isReportRequired(pScaledValue, a_stResp.m_Value))
 		{
-			if((sem_wait(&l_sem)) == -1 && errno == EINTR)
+			// Change is within deadband and heartbeat is not due
+			if(NULL != pScaledValue)
 			{
-				continue;	// Continue if interrupted by handler
+				msgbus_msg_envelope_elem_destroy(pScaledValue);
 			}
+			a_bIsReportRequired = false;
+			return true;
+		}
+	}
 
-			stStackResponse res;
-			try
-			{
-				if(false == getDataToProcess(res, operationCallbackType))
-				{
-					break;
-				}
-				// fill the response in JSON
-				postResponseJSON(res);
-				res.m_Value.clear();
-			}
-			catch(const std::exception& e)
-			{
-				DO_LOG_FATAL(e.what());
-			}
-		}while(0);
+	// Polling time is explicitly given, use that, otherwise use one from reference polling point
+	struct timespec stTsPolling = (NULL != a_pstTsPolling) ? *a_pstTsPolling : a_objReqData.getTimestampOfPollReq();
+	bRetValue &= setEnvelopeMicros(a_pMsg, "tsPollingTime", stTsPolling);
+
+	// add timestamps from stack
+	bRetValue &= setEnvelopeMicros(a_pMsg, "reqRcvdInStack", a_stResp.m_objStackTimestamps.tsReqRcvd);
+	bRetValue &= setEnvelopeMicros(a_pMsg, "reqSentByStack", a_stResp.m_objStackTimestamps.tsReqSent);
+	bRetValue &= setEnvelopeMicros(a_pMsg, "respRcvdByStack", a_stResp.m_objStackTimestamps.tsRespRcvd);
+	bRetValue &= setEnvelopeMicros(a_pMsg, "respPostedByStack", a_stResp.m_objStackTimestamps.tsRespSent);
+
+	bool bIsHexValueEnabled = PublishJsonHandler::instance().isHexValueEnabled();
+	if(true == bIsGood)
+	{
+		if(true == bIsHexValueEnabled)
+		{
+			a_sValue = common_Handler::swapConversion(a_stResp.m_Value, stDecoder.m_bIsByteSwap, stDecoder.m_bIsWordSwap);
+			bRetValue &= zmq_handler::setStringField(a_pMsg, "value", a_sValue.c_str());
+		}
+		bRetValue &= setEnvelopeField(a_pMsg, "scaledValue", pScaledValue);
+		bRetValue &= zmq_handler::setStringField(a_pMsg, "status", "Good");
+		// fields of bad response, present only if previous response was bad
+		msgbus_msg_envelope_remove(a_pMsg, "error_code");
+		msgbus_msg_envelope_remove(a_pMsg, "lastGoodUsec");
+	}
+	else
+	{
+		char szErrCode[16];
+		int iErrCode = a_stResp.m_stException.m_u8ExcStatus * ERORR_MULTIPLIER + a_stResp.m_stException.m_u8ExcCode;
+		snprintf(szErrCode, sizeof(szErrCode), "%d", iErrCode);
+		bRetValue &= zmq_handler::setStringField(a_pMsg, "status", "Bad");
+		bRetValue &= zmq_handler::setStringField(a_pMsg, "error_code", szErrCode);
+
+		// Use last known value
+		stLastGoodResponse objLastResp = (const_cast<CRefDataForPolling&>(a_objReqData)).getLastGoodResponse();
+		if(true == bIsHexValueEnabled)
+		{
+			bRetValue &= zmq_handler::setStringField(a_pMsg, "value", objLastResp.m_sValue.c_str());
+		}
+		bRetValue &= setEnvelopeField(a_pMsg, "scaledValue", setScaledValue(objLastResp.m_vValue, stDecoder));
+		bRetValue &= zmq_handler::setStringField(a_pMsg, "lastGoodUsec", objLastResp.m_sLastUsec.c_str());
 	}
 
-	return eRetType;
+	// Adding timestamp at last
+	char szTimestamp[32], szTxID[32];
+	getTimeBasedParams(a_objReqData, szTimestamp, szTxID);
+	bRetValue &= zmq_handler::setStringField(a_pMsg, "driver_seq", szTxID);
+	bRetValue &= zmq_handler::setStringField(a_pMsg, "timestamp", szTimestamp);
+
+	return bRetValue;
 }
 
 /**
- * Push response to queue
- * @param stStackResNode :[in] response node
- * @param operationCallbackType: [in] operation type (polling/on-demand/RT/Non-RT) defines queue to be used
+ * Fills variable fields of polled response in binary update of the point.
+ * Fields are same as the ones filled by fillPolledResponseJson.
+ * @param a_stUpdate	:[in] binary update of point having invariant fields
+ * @param a_sValue		:[out] Value, if available
+ * @param a_objReqData	:[in] request data
+ * @param a_stResp		:[in] response data
+ * @param a_pstTsPolling:[in] polling timestamp, if any
+ * @param a_bIsReportRequired:[out] false if good value is within deadband of point and
+ * 								update is left as it is, true otherwise
+ * @param a_pScaledValue:[out] scaled value of good response, caller destroys it
  * @return 	true : on success,
  * 			false : on error
  */
-bool CPeriodicReponseProcessor::pushToQueue(struct stStackResponse &stStackResNode, eMbusCallbackType operationCallbackType)
+bool CPeriodicReponseProcessor::fillPolledUpdate(stPolledUpdate &a_stUpdate, std::string &a_sValue,
+		const CRefDataForPolling& a_objReqData, const stStackResponse& a_stResp, struct timespec *a_pstTsPolling,
+		bool &a_bIsReportRequired, msg_envelope_elem_body_t* &a_pScaledValue)
 {
-	try
+	a_bIsReportRequired = true;
+	a_pScaledValue = NULL;
+	a_sValue.clear();
+
+	const stValueDecoder &stDecoder = a_objReqData.getValueDecoder();
+	bool bIsGood = (TRUE == a_stResp.bIsValPresent) && (0 != a_stResp.m_Value.size());
+	if(true == bIsGood)
 	{
-		switch(operationCallbackType)
-		{
-		case MBUS_CALLBACK_POLLING:
-		{
-			std::lock_guard<std::mutex> lock(__resQPollingMutex);
-			stackPollingResQ.push(stStackResNode);
-			sem_post(&semPollingRespProcess);	// Signal response process thread
-		}
-			break;
-		case MBUS_CALLBACK_POLLING_RT:
-		{
-			std::lock_guard<std::mutex> lock(__resQRTPollingMutex);
-			stackRTPollingResQ.push(stStackResNode);
-			sem_post(&semRTPollingRespProcess);	// Signal response process thread
-		}
-			break;
-		case MBUS_CALLBACK_ONDEMAND_READ:
+		a_pScaledValue = setScaledValue(a_stResp.m_Value, stDecoder);
+		if(false == (const_cast<CRefDataForPolling&>(a_objReqData)).isReportRequired(a_pScaledValue, a_stResp.m_Value))
 		{
-			std::lock_guard<std::mutex> lock(__resQODReadMutex);
-			stackOnDemandReadResQ.push(stStackResNode);
-			sem_post(&semODReadRespProcess);	// Signal response process thread
+			// Change is within deadband and heartbeat is not due
+			if(NULL != a_pScaledValue)
+			{
+				msgbus_msg_envelope_elem_destroy(a_pScaledValue);
+				a_pScaledValue = NULL;
+			}
+			a_bIsReportRequired = false;
+			return true;
 		}
-			break;
-		case MBUS_CALLBACK_ONDEMAND_READ_RT:
+	}
+
+	// Polling time is explicitly given, use that, otherwise use one from reference polling point
+	struct timespec stTsPolling = (NULL != a_pstTsPolling) ? *a_pstTsPolling : a_objReqData.getTimestampOfPollReq();
+	a_stUpdate.m_i64TsPolling = (int64_t)get_micros(stTsPolling);
+	a_stUpdate.m_i64ReqRcvdInStack = (int64_t)get_micros(a_stResp.m_objStackTimestamps.tsReqRcvd);
+	a_stUpdate.m_i64ReqSentByStack = (int64_t)get_micros(a_stResp.m_objStackTimestamps.tsReqSent);
+	a_stUpdate.m_i64RespRcvdByStack = (int64_t)get_micros(a_stResp.m_objStackTimestamps.tsRespRcvd);
+	a_stUpdate.m_i64RespPostedByStack = (int64_t)get_micros(a_stResp.m_objStackTimestamps.tsRespSent);
+
+	bool bRetValue = true;
+	a_stUpdate.m_bIsHexValue = PublishJsonHandler::instance().isHexValueEnabled();
+	a_stUpdate.m_sHexValue.clear();
+	if(true == bIsGood)
+	{
+		if(true == a_stUpdate.m_bIsHexValue)
 		{
-			std::lock_guard<std::mutex> lock(__resQODRTReadMutex);
-			stackOnDemandRTReadResQ.push(stStackResNode);
-			sem_post(&semRTODReadRespProcess);	// Signal response process thread
+			a_sValue = common_Handler::swapConversion(a_stResp.m_Value, stDecoder.m_bIsByteSwap, stDecoder.m_bIsWordSwap);
+			a_stUpdate.m_sHexValue = a_sValue;
 		}
-			break;
-		case MBUS_CALLBACK_ONDEMAND_WRITE:
+		bRetValue &= CPolledUpdateCodec::setScaledValue(a_stUpdate, a_pScaledValue);
+		a_stUpdate.m_eStatus = enPOLLED_STATUS_GOOD;
+		a_stUpdate.m_u32ErrorCode = 0;
+		a_stUpdate.m_i64LastGoodUsec = 0;
+	}
+	else
+	{
+		int iErrCode = a_stResp.m_stException.m_u8ExcStatus * ERORR_MULTIPLIER + a_stResp.m_stException.m_u8ExcCode;
+		a_stUpdate.m_eStatus = enPOLLED_STATUS_BAD;
+		a_stUpdate.m_u32ErrorCode = (uint32_t)iErrCode;
+
+		// Use last known value
+		stLastGoodResponse objLastResp = (const_cast<CRefDataForPolling&>(a_objReqData)).getLastGoodResponse();
+		if(true == a_stUpdate.m_bIsHexValue)
 		{
-			std::lock_guard<std::mutex> lock(__resQODWriteMutex);
-			stackOnDemandWriteResQ.push(stStackResNode);
-			sem_post(&semODWriteRespProcess);	// Signal response process thread
+			a_stUpdate.m_sHexValue = objLastResp.m_sValue;
 		}
-			break;
-		case MBUS_CALLBACK_ONDEMAND_WRITE_RT:
+		msg_envelope_elem_body_t* pLastValue = setScaledValue(objLastResp.m_vValue, stDecoder);
+		bRetValue &= CPolledUpdateCodec::setScaledValue(a_stUpdate, pLastValue);
+		if(NULL != pLastValue)
 		{
-			std::lock_guard<std::mutex> lock(__resQODRTWriteMutex);
-			stackOnDemandRTWriteResQ.push(stStackResNode);
-			sem_post(&semRTODWriteRespProcess);	// Signal response process thread
-		}
-			break;
-		default:
-			DO_LOG_FATAL("Invalid callback called.");
-			break;
+			msgbus_msg_envelope_elem_destroy(pLastValue);
 		}
-
-		return true;
-	}
-	catch(const std::exception& e)
-	{
-		DO_LOG_FATAL(e.what());
+		a_stUpdate.m_i64LastGoodUsec = strtoll(objLastResp.m_sLastUsec.c_str(), NULL, 10);
 	}
 
-	return false;
+	// Adding timestamp at last
+	getTimeBasedParams(a_objReqData, a_stUpdate.m_i64Timestamp, a_stUpdate.m_u64DriverSeq);
+
+	return bRetValue;
 }
 
 /**
- * In case of response timeout reply, checks if retry is applicable.
- * Retries the request, if applicable
- * @param stStackResNode :[in] response node
- * @param operationCallbackType: [in] operation type (polling/on-demand/RT/Non-RT) defines queue to be used
- * @return 	true : if no retry is applicable
- * 			false : in case of error or retry is done
+ * Post polling response to ZMQ using publish template of the point
+ * @param a_stResp		:[in] response data
+ * @param a_objReqData	:[in] request data
+ * @param a_pstTsPolling:[in] polling timestamp, if any
+ * @return 	true : on success,
+ * 			false : on error
  */
-bool CPeriodicReponseProcessor::checkForRetry(struct stStackResponse &a_stStackResNode, eMbusCallbackType operationCallbackType)
+bool CPeriodicReponseProcessor::postPolledResponseJSON(stStackResponse& a_stResp, const CRefDataForPolling* a_objReqData, struct timespec *a_pstTsPolling)
 {
-	bool retValue = false;
+	if(NULL == a_objReqData)
+	{
+		return FALSE;
+	}
+	std::shared_ptr<stPublishTemplate> pTemplate = a_objReqData->getPublishTemplate();
+	if(NULL == pTemplate)
+	{
+		return FALSE;
+	}
+
+	try
+	{
+		std::lock_guard<std::mutex> lock(pTemplate->m_mutex);
+		std::string sValue{""};
+		bool bIsReportRequired = true;
+		if(false == fillPolledResponseJson(pTemplate->m_pMsg, sValue, *a_objReqData, a_stResp, a_pstTsPolling, bIsReportRequired))
+		{
+			DO_LOG_INFO( " Error in preparing response");
+			return FALSE;
+		}
+		if(false == bIsReportRequired)
+		{
+			DO_LOG_DEBUG(a_objReqData->getDataPoint().getID() + ": Value is within deadband. Not published.");
+			// unchanged value is still fresh for on-demand reads
+			(const_cast<CRefDataForPolling*>(a_objReqData))->refreshGoodResponse(a_stResp.m_Value);
+			return TRUE;
+		}
+
+		std::string sUsec{""};
+		bool bIsPublished = false;
+		if(true == CEmbBatchPublisher::instance().isEnabled(pTemplate->m_bIsRealTime))
+		{
+			// update is published along with other updates of RT or non-RT class
+			bIsPublished = CEmbBatchPublisher::instance().addMsg(sUsec, pTemplate->m_pMsg,
+					pTemplate->m_sBatchTopic, pTemplate->m_bIsRealTime, "usec");
+		}
+		if(false == bIsPublished)
+		{
+			// publisher of EMB Response PUB topic is resolved once per point
+			if(NULL == pTemplate->m_pPubHandle)
+			{
+				pTemplate->m_pPubHandle = zmq_handler::getPubHandle(pTemplate->m_sEmbTopic);
+			}
+			bIsPublished = zmq_handler::publishJson(sUsec, pTemplate->m_pMsg, pTemplate->m_pPubHandle, "usec");
+		}
+
+		if(true == bIsPublished)
+		{
+			// Message is successfully published
+			// Check if value was available. Store it as last known value and usec
+			bool bIsGood = (true == a_stResp.bIsValPresent) && (false == a_stResp.m_Value.empty());
+			if(true == bIsGood)
+			{
+				(const_cast<CRefDataForPolling*>(a_objReqData))->saveGoodResponse(sValue, a_stResp.m_Value, sUsec);
+			}
+			if(true == a_objReqData->isReportByException())
+			{
+				msg_envelope_elem_body_t* pScaledValue = NULL;
+				msgbus_msg_envelope_get(pTemplate->m_pMsg, "scaledValue", &pScaledValue);
+				(const_cast<CRefDataForPolling*>(a_objReqData))->setReported(bIsGood, pScaledValue, a_stResp.m_Value);
+			}
+			DO_LOG_DEBUG("Msg published successfully");
+		}
+		else
+		{
+			DO_LOG_ERROR("Failed to publish msg on EII");
+		}
+
+#ifdef INSTRUMENTATION_LOG
+		msg_envelope_serialized_part_t* parts = NULL;
+		int num_parts = msgbus_msg_envelope_serialize(pTemplate->m_pMsg, &parts);
+		if(num_parts > 0)
+		{
+			if(NULL != parts[0].bytes)
+			{
+				std::string s(parts[0].bytes);
+
+				DO_LOG_DEBUG("TxID:" + std::to_string(a_stResp.u16TransacID)
+								+ ", Msg: " + s);
+			}
+			msgbus_msg_envelope_serialize_destroy(parts, num_parts);
+		}
+#endif
+	}
+	catch(const std::exception& e)
+	{
+		DO_LOG_FATAL("Exception :: " + std::string(e.what()) + " " + "Tx ID:: " + std::to_string(a_stResp.u16TransacID));
+	}
+
+	// return true on success
+	return TRUE;
+}
+
+/**
+ * Post polling response to ZMQ as binary update. Update is published as
+ * CT_BLOB envelope or as entry of batch of updates.
+ * @param a_stResp		:[in] response data
+ * @param a_objReqData	:[in] request data
+ * @param a_pstTsPolling:[in] polling timestamp, if any
+ * @return 	true : on success,
+ * 			false : on error
+ */
+bool CPeriodicReponseProcessor::postPolledResponseBinary(stStackResponse& a_stResp, const CRefDataForPolling* a_objReqData, struct timespec *a_pstTsPolling)
+{
+	if(NULL == a_objReqData)
+	{
+		return FALSE;
+	}
+	std::shared_ptr<stPublishTemplate> pTemplate = a_objReqData->getPublishTemplate();
+	if(NULL == pTemplate)
+	{
+		return FALSE;
+	}
+
+	msg_envelope_elem_body_t* pScaledValue = NULL;
+	try
+	{
+		std::lock_guard<std::mutex> lock(pTemplate->m_mutex);
+		std::string sValue{""};
+		bool bIsReportRequired = true;
+		if(false == fillPolledUpdate(pTemplate->m_stUpdate, sValue, *a_objReqData, a_stResp, a_pstTsPolling, bIsReportRequired, pScaledValue))
+		{
+			DO_LOG_INFO( " Error in preparing response");
+			if(NULL != pScaledValue)
+			{
+				msgbus_msg_envelope_elem_destroy(pScaledValue);
+			}
+			return FALSE;
+		}
+		if(false == bIsReportRequired)
+		{
+			DO_LOG_DEBUG(a_objReqData->getDataPoint().getID() + ": Value is within deadband. Not published.");
+			// unchanged value is still fresh for on-demand reads
+			(const_cast<CRefDataForPolling*>(a_objReqData))->refreshGoodResponse(a_stResp.m_Value);
+			return TRUE;
+		}
+
+		// publish time is part of encoded update
+		pTemplate->m_stUpdate.m_i64Usec = (int64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+				std::chrono::system_clock::now().time_since_epoch()).count();
+		CPolledUpdateCodec::encode(pTemplate->m_stUpdate, pTemplate->m_sBinBuf);
+
+		bool bIsPublished = false;
+		if(true == CEmbBatchPublisher::instance().isEnabled(pTemplate->m_bIsRealTime))
+		{
+			// update is published along with other updates of RT or non-RT class
+			bIsPublished = CEmbBatchPublisher::instance().addMsg(pTemplate->m_sBatchTopic, pTemplate->m_bIsRealTime,
+					pTemplate->m_sDataTopic, pTemplate->m_sBinBuf.data(), pTemplate->m_sBinBuf.size());
+		}
+		if(false == bIsPublished)
+		{
+			if(NULL == pTemplate->m_pPubHandle)
+			{
+				pTemplate->m_pPubHandle = zmq_handler::getPubHandle(pTemplate->m_sEmbTopic);
+			}
+			bIsPublished = zmq_handler::publishBlob(pTemplate->m_pPubHandle, pTemplate->m_sBinBuf.data(), pTemplate->m_sBinBuf.size());
+		}
+
+		if(true == bIsPublished)
+		{
+			bool bIsGood = (true == a_stResp.bIsValPresent) && (false == a_stResp.m_Value.empty());
+			if(true == bIsGood)
+			{
+				(const_cast<CRefDataForPolling*>(a_objReqData))->saveGoodResponse(sValue, a_stResp.m_Value,
+						std::to_string(pTemplate->m_stUpdate.m_i64Usec));
+			}
+			if(true == a_objReqData->isReportByException())
+			{
+				(const_cast<CRefDataForPolling*>(a_objReqData))->setReported(bIsGood, pScaledValue, a_stResp.m_Value);
+			}
+			DO_LOG_DEBUG("Msg published successfully");
+		}
+		else
+		{
+			DO_LOG_ERROR("Failed to publish msg on EII");
+		}
+	}
+	catch(const std::exception& e)
+	{
+		DO_LOG_FATAL("Exception :: " + std::string(e.what()) + " " + "Tx ID:: " + std::to_string(a_stResp.u16TransacID));
+	}
+	if(NULL != pScaledValue)
+	{
+		msgbus_msg_envelope_elem_destroy(pScaledValue);
+	}
+
+	// return true on success
+	return TRUE;
+}
+
+/**
+ * Post dummy bad response as actual response is not received
+ * @param a_objReqData	:[in] request for which to send dummy response
+ * @param m_stException	:[in] exception
+ * @param a_pstRefPollTime:[in] Polling timestamp for given request
+ * @return 	true : on success,
+ * 			false : on error
+ */
+bool CPeriodicReponseProcessor::postDummyBADResponse(CRefDataForPolling& a_objReqData,
+		const stException_t m_stException, struct timespec *a_pstRefPollTime = NULL)
+{
+	try
+	{
+		// Prepare dummy response
+		stStackResponse stResp = {};
+		stResp.bIsValPresent = false;
+		stResp.m_Value.clear();
+		stResp.u16TransacID = 0;
+		stResp.u8Reason = m_stException.m_u8ExcCode;
+		stResp.m_stException.m_u8ExcCode = m_stException.m_u8ExcCode;
+		stResp.m_stException.m_u8ExcStatus = m_stException.m_u8ExcStatus;
+		stResp.m_operationType = MBUS_CALLBACK_POLLING;
+		stResp.m_u8FunCode = a_objReqData.getFunctionCode();
+
+		// fill the topic as per realtime and non-realtime
+		if(a_objReqData.getDataPoint().getRTFlag())
+		{
+			stResp.m_u16TopicID = internTopic(PublishJsonHandler::instance().getPolledDataTopicRT());
+		}
+		else
+		{
+			stResp.m_u16TopicID = internTopic(PublishJsonHandler::instance().getPolledDataTopic());
+		}
+
+		// Post it
+		postResponseJSON(stResp, &a_objReqData, a_pstRefPollTime);
+
+		// Response is posted. Mark the flag
+		a_objReqData.setResponsePosted(true);
+	}
+	catch(const std::exception& e)
+	{
+		DO_LOG_FATAL(e.what());
+	}
+
+	// return true on success
+	return TRUE;
+}
+
+/**
+ * Post consolidated state of device of given point. It is published once when
+ * device is found to be down, instead of BAD response of every point, and once
+ * when device responds again.
+ * @param a_objReqData	:[in] point of the device
+ * @param a_bIsDown		:[in] device is down(true or false)
+ * @return 	true : on success,
+ * 			false : on error
+ */
+bool CPeriodicReponseProcessor::postDeviceStatusJSON(const CRefDataForPolling& a_objReqData, bool a_bIsDown)
+{
+	msg_envelope_t* msg = NULL;
+	try
+	{
+		const CUniqueDataPoint &objUniquePoint = a_objReqData.getDataPoint();
+		bool bIsRT = objUniquePoint.getRTFlag();
+		std::string sDataTopic;
+		zmq_handler::stZmqPubHandle *pPubHandle = NULL;
+		std::shared_ptr<stPublishTemplate> pTemplate = a_objReqData.getPublishTemplate();
+		if(NULL != pTemplate)
+		{
+			// publisher of device status topic is resolved once per point
+			std::lock_guard<std::mutex> lock(pTemplate->m_mutex);
+			if(NULL == pTemplate->m_pStatusPubHandle)
+			{
+				pTemplate->m_pStatusPubHandle = zmq_handler::getPubHandle(pTemplate->m_sStatusEmbTopic);
+			}
+			pPubHandle = pTemplate->m_pStatusPubHandle;
+			sDataTopic = pTemplate->m_sStatusDataTopic;
+		}
+		else
+		{
+			// e.g. /flowmeter/PL0/update
+			sDataTopic = SEPARATOR_CHAR + objUniquePoint.getWellSiteDev().getID() + SEPARATOR_CHAR
+					+ objUniquePoint.getWellSite().getID() + SEPARATOR_CHAR + PERIODIC_GENERIC_TOPIC;
+			pPubHandle = zmq_handler::getPubHandle(mapMqttToEMBRespTopic(sDataTopic, bIsRT, PublishJsonHandler::instance().getAppName()));
+		}
+
+		msg = msgbus_msg_envelope_new(CT_JSON);
+		if(NULL == msg)
+		{
+			DO_LOG_ERROR("Error: memory not allocated");
+			return false;
+		}
+
+		std::string sTimestamp, sUsec;
+		CcommonEnvManager::Instance().getTimeParams(sTimestamp, sUsec);
+
+		msgbus_msg_envelope_put(msg, "version", msgbus_msg_envelope_new_string("2.0"));
+		msgbus_msg_envelope_put(msg, "data_topic", msgbus_msg_envelope_new_string(sDataTopic.c_str()));
+		msgbus_msg_envelope_put(msg, "wellhead", msgbus_msg_envelope_new_string(objUniquePoint.getWellSite().getID().c_str()));
+		msgbus_msg_envelope_put(msg, "metric", msgbus_msg_envelope_new_string("deviceStatus"));
+		msgbus_msg_envelope_put(msg, "realtime", msgbus_msg_envelope_new_string(std::to_string(bIsRT).c_str()));
+		msgbus_msg_envelope_put(msg, "deviceStatus", msgbus_msg_envelope_new_string((true == a_bIsDown) ? "down" : "up"));
+		msgbus_msg_envelope_put(msg, "status", msgbus_msg_envelope_new_string((true == a_bIsDown) ? "Bad" : "Good"));
+		msgbus_msg_envelope_put(msg, "timestamp", msgbus_msg_envelope_new_string(sTimestamp.c_str()));
+
+		std::string sPubUsec{""};
+		if(false == zmq_handler::publishJson(sPubUsec, msg, pPubHandle, "usec"))
+		{
+			DO_LOG_ERROR("Failed to publish device status on EII: " + sDataTopic);
+			msgbus_msg_envelope_destroy(msg);
+			return false;
+		}
+		DO_LOG_INFO("Device status published: " + sDataTopic + ((true == a_bIsDown) ? " down" : " up"));
+	}
+	catch(const std::exception& e)
+	{
+		DO_LOG_FATAL(e.what());
+		if(NULL != msg)
+		{
+			msgbus_msg_envelope_destroy(msg);
+		}
+		return false;
+	}
+	msgbus_msg_envelope_destroy(msg);
+	return true;
+}
+
+/**
+ * Post response json to ZMQ using given response data
+ * @param a_stResp	:[in] response data
+ * @return 	true : on success,
+ * 			false : on error
+ */
+bool CPeriodicReponseProcessor::postResponseJSON(stStackResponse& a_stResp)
+{
+	try
+	{
+		if(MBUS_CALLBACK_POLLING == a_stResp.m_operationType || MBUS_CALLBACK_POLLING_RT == a_stResp.m_operationType)
+		{
+			CRefDataForPolling& objReqData = CRequestInitiator::instance().getTxIDReqData(a_stResp.u16TransacID, a_stResp.m_bIsRT);
+			// Node is found in transaction map. Remove it now.
+			CRequestInitiator::instance().removeTxIDReqData(a_stResp.u16TransacID, a_stResp.m_bIsRT);
+			// Response is received. Reset response awaited status
+			objReqData.getDataPoint().setIsAwaitResp(false);
+			// reset txid
+			objReqData.setReqTxID(0);
+			// Track device health, then device can take next pending request
+			CRequestInitiator::instance().recordDeviceResponse(objReqData, a_stResp.m_stException);
+			CRequestInitiator::instance().completeRequest(objReqData);
+
+			if(true == objReqData.isBlockLeader())
+			{
+				// Response is received for a block of points. Post it for each point
+				postBlockResponseJSON(a_stResp, objReqData);
+			}
+			else if(TRUE == postResponseJSON(a_stResp, &objReqData))
+			{
+				// Response is posted. Mark the flag
+				objReqData.setResponsePosted(true);
+			}
+		}
+		else
+		{
+			std::vector<unsigned short> vTxIDs;
+			if(true == onDemandHandler::Instance().getCoalescedTxIDs(a_stResp.u16TransacID, vTxIDs))
+			{
+				// Response is of coalesced write. Post it for each requester
+				common_Handler::removeReqData(a_stResp.u16TransacID);
+				for(unsigned short u16TxID : vTxIDs)
+				{
+					a_stResp.u16TransacID = u16TxID;
+					postResponseJSON(a_stResp, NULL);
+				}
+			}
+			else
+			{
+				postResponseJSON(a_stResp, NULL);
+			}
+		}
+	}
+	catch(const std::exception& e)
+	{
+		DO_LOG_FATAL(std::to_string(a_stResp.u16TransacID) + e.what());
+	}
+
+	// return true on success
+	return TRUE;
+}
+
+/**
+ * Post response json to ZMQ for each point of a polling block.
+ * Response of the block is split as per address and width of each point.
+ * @param a_stResp			:[in] response data received for the block
+ * @param a_objBlockLeader	:[in] point whose request is used to poll the block
+ * @return 	true : on success,
+ * 			false : on error
+ */
+bool CPeriodicReponseProcessor::postBlockResponseJSON(stStackResponse& a_stResp, CRefDataForPolling& a_objBlockLeader)
+{
+	try
+	{
+		uint16_t u16BlockStartAddr = a_objBlockLeader.getMBusReq().m_u16StartAddr;
+
+		std::vector<std::reference_wrapper<CRefDataForPolling>> vBlockPoints = a_objBlockLeader.getRequestPoints();
+
+		for(auto &refPoint : vBlockPoints)
+		{
+			CRefDataForPolling &objPoint = refPoint.get();
+			stStackResponse stPointResp = a_stResp;
+			stPointResp.m_Value.clear();
+
+			if(true == a_stResp.bIsValPresent)
+			{
+				if(false == objPoint.getValueFromBlock(u16BlockStartAddr, a_stResp.m_Value, stPointResp.m_Value))
+				{
+					// Received data does not cover this point
+					DO_LOG_ERROR(objPoint.getDataPoint().getID() + ": Value is not present in block response");
+					stPointResp.bIsValPresent = false;
+					stPointResp.u8Reason = 0;
+					stPointResp.m_stException.m_u8ExcCode = APP_ERROR_EMPTY_DATA_RECVD_FROM_STACK;
+					stPointResp.m_stException.m_u8ExcStatus = 0;
+				}
+			}
+
+			// Response is received. Reset response awaited status and txid
+			objPoint.getDataPoint().setIsAwaitResp(false);
+			objPoint.setReqTxID(0);
+
+			if(TRUE == postResponseJSON(stPointResp, &objPoint))
+			{
+				// Response is posted. Mark the flag
+				objPoint.setResponsePosted(true);
+			}
+		}
+	}
+	catch(const std::exception& e)
+	{
+		DO_LOG_FATAL(std::to_string(a_stResp.u16TransacID) + e.what());
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+/**
+ * Initialize semaphore for all RT and Non-RT operations for response processing
+ * @return 	true : on success,
+ * 			false : on error
+ */
+bool CPeriodicReponseProcessor::initSem()
+{
+	//
+	int okPolling = sem_init(&semPollingRespProcess, 0, 0 /* Initial value of zero*/);
+	int okPollingRT = sem_init(&semRTPollingRespProcess, 0, 0 /* Initial value of zero*/);
+	int okODRead = sem_init(&semODReadRespProcess, 0, 0 /* Initial value of zero*/);
+	int okODReadRT = sem_init(&semRTODReadRespProcess, 0, 0 /* Initial value of zero*/);
+	int okODWrite = sem_init(&semODWriteRespProcess, 0, 0 /* Initial value of zero*/);
+	int okODWriteRT = sem_init(&semRTODWriteRespProcess, 0, 0 /* Initial value of zero*/);
+	if (okPolling == -1 || okPollingRT == -1 || okODRead == -1 || okODReadRT == -1 || okODWrite == -1 || okODWriteRT ==-1)
+	{
+		DO_LOG_FATAL("Could not create unnamed semaphore " + std::to_string(errno) + " " + strerror(errno));
+	   return false;
+	}
+	return true;
+}
+
+/**
+ * Response process thread
+ * @param operationCallbackType	:[in] operation type, polling, on-demand, RT/Non_RT
+ * @param a_refSem: [in] semaphore applicable for given operation type for listening on response data from a queue
+ * @param a_refOps: [in] global config reference for given operation
+ * @return appropriate error code
+ */
+eMbusAppErrorCode CPeriodicReponseProcessor::respProcessThreads(eMbusCallbackType operationCallbackType,
+		sem_t& a_refSem,
+		globalConfig::COperation& a_refOps)
+{
+	eMbusAppErrorCode eRetType = APP_SUCCESS;
+	sem_t& l_sem = a_refSem;
+	// response node is reused so that its value buffer is allocated only once
+	stStackResponse res;
+
+	// set the thread priority
+	globalConfig::set_thread_sched_param(a_refOps);
+
+	globalConfig::display_thread_sched_attr("respProcessThreads param::");
+
+
+	while(false == g_stopThread.load())
+	{
+		if((sem_wait(&l_sem)) == -1 && errno == EINTR)
+		{
+			continue;	// Continue if interrupted by handler
+		}
+
+		/// drain the ring one by one to send message on Pl-bus.
+		/// Semaphore is only a wake-up signal, a single wake-up may find more than one response.
+		try
+		{
+			while(true == getDataToProcess(res, operationCallbackType))
+			{
+				if(true == checkForRetry(res, operationCallbackType))
+				{
+					// fill the response in JSON
+					postResponseJSON(res);
+				}
+			}
+		}
+		catch(const std::exception& e)
+		{
+			DO_LOG_FATAL(e.what());
+		}
+	}
+
+	return eRetType;
+}
+
+/**
+ * Get semaphore used to signal response process thread of given operation type
+ * @param operationCallbackType: [in] operation type (polling/on-demand/RT/Non-RT)
+ * @return 	pointer to semaphore : on success,
+ * 			NULL : on invalid operation type
+ */
+sem_t* CPeriodicReponseProcessor::getRespSem(eMbusCallbackType operationCallbackType)
+{
+	switch(operationCallbackType)
+	{
+	case MBUS_CALLBACK_POLLING:
+		return &semPollingRespProcess;
+	case MBUS_CALLBACK_POLLING_RT:
+		return &semRTPollingRespProcess;
+	case MBUS_CALLBACK_ONDEMAND_READ:
+		return &semODReadRespProcess;
+	case MBUS_CALLBACK_ONDEMAND_READ_RT:
+		return &semRTODReadRespProcess;
+	case MBUS_CALLBACK_ONDEMAND_WRITE:
+		return &semODWriteRespProcess;
+	case MBUS_CALLBACK_ONDEMAND_WRITE_RT:
+		return &semRTODWriteRespProcess;
+	default:
+		break;
+	}
+	return NULL;
+}
+
+/**
+ * In case of response timeout reply, checks if retry is applicable.
+ * Retries the request, if applicable
+ * @param stStackResNode :[in] response node
+ * @param operationCallbackType: [in] operation type (polling/on-demand/RT/Non-RT) defines queue to be used
+ * @return 	true : if no retry is applicable
+ * 			false : in case of error or retry is done
+ */
+bool CPeriodicReponseProcessor::checkForRetry(struct stStackResponse &a_stStackResNode, eMbusCallbackType operationCallbackType)
+{
+	bool retValue = false;
 	try
 	{
 		MbusAPI_t *pReqData = NULL;
-		MbusAPI_t tempData;
+		common_Handler::reqDataHandle_t pOnDemandReq;
 		eMbusAppErrorCode eFunRetType = APP_SUCCESS;
 		if(a_stStackResNode.m_stException.m_u8ExcCode == STACK_ERROR_RECV_TIMEOUT &&
 				a_stStackResNode.m_stException.m_u8ExcStatus == 2)
@@ -792,10 +1444,9 @@ bool CPeriodicReponseProcessor::checkForRetry(struct stStackResponse &a_stStackR
 			}
 			else
 			{
-				if(true == common_Handler::getReqData(a_stStackResNode.u16TransacID, tempData))
-				{
-					pReqData = &tempData;
-				}
+				// retry count is updated in place using handle
+				pOnDemandReq = common_Handler::getReqData(a_stStackResNode.u16TransacID);
+				pReqData = pOnDemandReq.get();
 			}
 
 			if(NULL == pReqData)
@@ -808,12 +1459,6 @@ bool CPeriodicReponseProcessor::checkForRetry(struct stStackResponse &a_stStackR
 				DO_LOG_INFO("Retry called for transaction id:: "+std::to_string(reqData.m_u16TxId));
 				/// decrement retry value by 1
 				reqData.m_nRetry--;
-				if((MBUS_CALLBACK_POLLING != operationCallbackType) &&
-									(MBUS_CALLBACK_POLLING_RT != operationCallbackType))
-				{
-					/// updating structure in map with decremented retry value
-					common_Handler::updateReqData(a_stStackResNode.u16TransacID, reqData);
-				}
 
 				void* ptrAppCallback = NULL;
 				getCallbackForRetry(&ptrAppCallback, operationCallbackType);
@@ -846,122 +1491,86 @@ bool CPeriodicReponseProcessor::checkForRetry(struct stStackResponse &a_stStackR
 }
 
 /**
- * Get response data to process from queue
+ * Copies response from ring slot to response node
+ * @param a_stSlot :[in] ring slot
+ * @param a_stStackResNode :[out] response node, its value buffer is reused
+ * @return none
+ */
+static void copyResponseSlot(const stStackResponseSlot &a_stSlot, stStackResponse &a_stStackResNode)
+{
+	a_stStackResNode.m_stException = a_stSlot.m_stException;
+	// assign reuses capacity of the vector
+	a_stStackResNode.m_Value.assign(a_stSlot.m_au8Value.begin(), a_stSlot.m_au8Value.begin() + a_stSlot.m_u16ValueLen);
+	a_stStackResNode.bIsValPresent = a_stSlot.bIsValPresent;
+	a_stStackResNode.u8Reason = a_stSlot.u8Reason;
+	a_stStackResNode.u16TransacID = a_stSlot.u16TransacID;
+	a_stStackResNode.m_objStackTimestamps = a_stSlot.m_objStackTimestamps;
+	a_stStackResNode.m_lPriority = a_stSlot.m_lPriority;
+	a_stStackResNode.m_u8FunCode = a_stSlot.m_u8FunCode;
+	a_stStackResNode.m_operationType = a_stSlot.m_operationType;
+	a_stStackResNode.m_u16TopicID = a_stSlot.m_u16TopicID;
+	a_stStackResNode.m_bIsRT = a_stSlot.m_bIsRT;
+}
+
+/**
+ * Get response data to process from response ring. Only response process thread
+ * of given operation type calls this function. Once response ring is drained,
+ * responses from overflow ring are given with APP_ERROR_RESPONSE_RING_FULL error,
+ * since their data was not kept.
  * @param a_stStackResNode :[out] response node
- * @param operationCallbackType: [in] operation type (polling/on-demand/RT/Non-RT) defines queue to be used
+ * @param operationCallbackType: [in] operation type (polling/on-demand/RT/Non-RT) defines ring to be used
  * @return 	true : on success,
- * 			false : on error
+ * 			false : if rings are empty or on error
  */
 bool CPeriodicReponseProcessor::getDataToProcess(struct stStackResponse &a_stStackResNode, eMbusCallbackType operationCallbackType)
 {
-	bool retValue = false;
-	try
+	if((operationCallbackType < MBUS_CALLBACK_POLLING) || (operationCallbackType >= RESPONSE_RING_COUNT))
 	{
-		switch (operationCallbackType)
-		{
-		case MBUS_CALLBACK_POLLING:
-		{
-			std::lock_guard<std::mutex> lock(__resQPollingMutex);
-			if(stackPollingResQ.empty())
-			{
-				DO_LOG_DEBUG("Response queue is empty");
-				return false;
-			}
-			a_stStackResNode = stackPollingResQ.front();
-			stackPollingResQ.pop();
-		}
-		break;
-		case MBUS_CALLBACK_POLLING_RT:
-		{
-			std::lock_guard<std::mutex> lock(__resQRTPollingMutex);
-			if(stackRTPollingResQ.empty())
-			{
-				DO_LOG_DEBUG("Response queue is empty");
-				return false;
-			}
-			a_stStackResNode = stackRTPollingResQ.front();
-			stackRTPollingResQ.pop();
-		}
-		break;
-		case MBUS_CALLBACK_ONDEMAND_READ:
-		{
-			std::lock_guard<std::mutex> lock(__resQODReadMutex);
-			if(stackOnDemandReadResQ.empty())
-			{
-				DO_LOG_DEBUG("Response queue is empty");
-				return false;
-			}
-			a_stStackResNode = stackOnDemandReadResQ.front();
-			stackOnDemandReadResQ.pop();
-		}
-		break;
-		case MBUS_CALLBACK_ONDEMAND_READ_RT:
-		{
-			std::lock_guard<std::mutex> lock(__resQODRTReadMutex);
-			if(stackOnDemandRTReadResQ.empty())
-			{
-				DO_LOG_DEBUG("Response queue is empty");
-				return false;
-			}
-			a_stStackResNode = stackOnDemandRTReadResQ.front();
-			stackOnDemandRTReadResQ.pop();
-		}
-		break;
-		case MBUS_CALLBACK_ONDEMAND_WRITE:
-		{
-			std::lock_guard<std::mutex> lock(__resQODWriteMutex);
-			if(stackOnDemandWriteResQ.empty())
-			{
-				DO_LOG_DEBUG("Response queue is empty");
-				return false;
-			}
-			a_stStackResNode = stackOnDemandWriteResQ.front();
-			stackOnDemandWriteResQ.pop();
-		}
-		break;
-		case MBUS_CALLBACK_ONDEMAND_WRITE_RT:
-		{
-			std::lock_guard<std::mutex> lock(__resQODRTWriteMutex);
-			if(stackOnDemandRTWriteResQ.empty())
-			{
-				DO_LOG_DEBUG("Response queue is empty");
-				return false;
-			}
-			a_stStackResNode = stackOnDemandRTWriteResQ.front();
-			stackOnDemandRTWriteResQ.pop();
-		}
-		break;
-		default:
-			DO_LOG_FATAL("Invaid callback to get data from queue.");
-			break;
-		}
-
-		if(false == checkForRetry(a_stStackResNode, operationCallbackType))
-		{
-			return false;
-		}
-
-		retValue = true;
+		DO_LOG_FATAL("Invaid callback to get data from queue.");
+		return false;
 	}
-	catch(const std::exception& e)
+
+	if(true == m_arrRespRings[operationCallbackType].pop([&a_stStackResNode](stStackResponseSlot &a_stSlot)
 	{
-		DO_LOG_FATAL(e.what());
+		copyResponseSlot(a_stSlot, a_stStackResNode);
+	}))
+	{
+		return true;
 	}
 
-	return retValue;
+	return m_arrOverflowRings[operationCallbackType].pop([&](stOverflowSlot &a_stSlot)
+	{
+		a_stStackResNode.m_stException.m_u8ExcCode = APP_ERROR_RESPONSE_RING_FULL;
+		a_stStackResNode.m_stException.m_u8ExcStatus = 0;
+		a_stStackResNode.m_Value.clear();
+		a_stStackResNode.bIsValPresent = false;
+		a_stStackResNode.u8Reason = 0;
+		a_stStackResNode.u16TransacID = a_stSlot.u16TransacID;
+		a_stStackResNode.m_objStackTimestamps = a_stSlot.m_objStackTimestamps;
+		a_stStackResNode.m_lPriority = a_stSlot.m_lPriority;
+		a_stStackResNode.m_u8FunCode = a_stSlot.m_u8FunCode;
+		a_stStackResNode.m_operationType = operationCallbackType;
+		a_stStackResNode.m_u16TopicID = a_stSlot.m_u16TopicID;
+		a_stStackResNode.m_bIsRT = a_stSlot.m_bIsRT;
+		DO_LOG_WARN("Response did not fit in response ring, reported as error. TxID: " +
+				std::to_string(a_stSlot.u16TransacID));
+	});
 }
 
 /**
- * Receives raw response data and pushes to queue for processing
+ * Receives raw response data and pushes to response ring for processing.
+ * This is called from stack callback thread. It neither allocates nor waits on a mutex.
+ * When response ring is full, response is kept without its data in overflow ring so that
+ * its request is still completed. When that is full as well, response is dropped and counted.
  * @param pstMbusAppCallbackParams :[in] response received from stack
  * @param operationCallbackType :[in] Operation type - polling/on-demand/RT/Non-RT
- * @param strResponseTopic: [in] ZMQ topic to be used. Defined by calling callback function
+ * @param a_u16TopicID: [in] interned ID of ZMQ topic to be used. Defined by calling callback function
  * @param a_bIsRT: [in] indicates whether it is a RT request
  * @return none
  */
 void CPeriodicReponseProcessor::handleResponse(stMbusAppCallbackParams_t *pstMbusAppCallbackParams,
 												eMbusCallbackType operationCallbackType,
-												string strResponseTopic,
+												uint16_t a_u16TopicID,
 												bool a_bIsRT)
 {
 	if(pstMbusAppCallbackParams == NULL)
@@ -970,49 +1579,164 @@ void CPeriodicReponseProcessor::handleResponse(stMbusAppCallbackParams_t *pstMbu
 		return;
 	}
 
-	struct stStackResponse stStackResNode;
-	stStackResNode.bIsValPresent = false;
-	stStackResNode.u8Reason = 0;
-	stStackResNode.m_operationType = operationCallbackType;
-	stStackResNode.m_u8FunCode = pstMbusAppCallbackParams->m_u8FunctionCode;
-	stStackResNode.m_strResponseTopic = strResponseTopic;
-	stStackResNode.m_bIsRT = a_bIsRT;
-
-	try
+	sem_t *pSem = getRespSem(operationCallbackType);
+	if(NULL == pSem)
 	{
-		stStackResNode.m_stException.m_u8ExcCode = pstMbusAppCallbackParams->m_u8ExceptionExcCode;
-		stStackResNode.m_stException.m_u8ExcStatus = pstMbusAppCallbackParams->m_u8ExceptionExcStatus;
-
-		stStackResNode.u16TransacID = pstMbusAppCallbackParams->m_u16TransactionID;
-
-		memcpy_s((&stStackResNode.m_objStackTimestamps),
-				sizeof(stTimeStamps),
-				&pstMbusAppCallbackParams->m_objTimeStamps,
-				sizeof(pstMbusAppCallbackParams->m_objTimeStamps));
+		DO_LOG_FATAL("Invalid callback called.");
+		return;
+	}
 
-		stStackResNode.m_lPriority = pstMbusAppCallbackParams->m_lPriority;
+	auto fnFillSlot = [&](stStackResponseSlot &a_stSlot)
+	{
+		a_stSlot.m_operationType = operationCallbackType;
+		a_stSlot.m_u8FunCode = pstMbusAppCallbackParams->m_u8FunctionCode;
+		a_stSlot.m_u16TopicID = a_u16TopicID;
+		a_stSlot.m_bIsRT = a_bIsRT;
+		a_stSlot.m_stException.m_u8ExcCode = pstMbusAppCallbackParams->m_u8ExceptionExcCode;
+		a_stSlot.m_stException.m_u8ExcStatus = pstMbusAppCallbackParams->m_u8ExceptionExcStatus;
+		a_stSlot.u16TransacID = pstMbusAppCallbackParams->m_u16TransactionID;
+		a_stSlot.m_objStackTimestamps = pstMbusAppCallbackParams->m_objTimeStamps;
+		a_stSlot.m_lPriority = pstMbusAppCallbackParams->m_lPriority;
+		a_stSlot.m_u16ValueLen = 0;
 
 		if((0 == pstMbusAppCallbackParams->m_u8ExceptionExcStatus) &&
 				(0 == pstMbusAppCallbackParams->m_u8ExceptionExcCode))
 		{
-			stStackResNode.u8Reason = 1;
-			stStackResNode.bIsValPresent = true;
-			for (uint8_t index=0; index < pstMbusAppCallbackParams->m_u8MbusRXDataLength ; index++)
-			{
-				stStackResNode.m_Value.push_back(pstMbusAppCallbackParams->m_au8MbusRXDataDataFields[index]);
-			}
+			a_stSlot.u8Reason = 1;
+			a_stSlot.bIsValPresent = true;
+			a_stSlot.m_u16ValueLen = std::min<uint16_t>(pstMbusAppCallbackParams->m_u8MbusRXDataLength, MAX_MBUS_RESP_DATA_LEN);
+			memcpy(a_stSlot.m_au8Value.data(), pstMbusAppCallbackParams->m_au8MbusRXDataDataFields, a_stSlot.m_u16ValueLen);
 		}
 		else
 		{
-			stStackResNode.u8Reason = 0;
-			stStackResNode.bIsValPresent = false;
+			a_stSlot.u8Reason = 0;
+			a_stSlot.bIsValPresent = false;
 		}
-		pushToQueue(stStackResNode, operationCallbackType);
+	};
+
+	if(true == m_arrRespRings[operationCallbackType].push(fnFillSlot))
+	{
+		sem_post(pSem);	// Signal response process thread
+		return;
 	}
-	catch(const std::exception& e)
+
+	// Ring is full. Response process thread releases TxID, in-flight slot and awaited
+	// status of polled point, or request entry of on-demand request, using overflow ring.
+	bool bIsPushed = m_arrOverflowRings[operationCallbackType].push([&](stOverflowSlot &a_stSlot)
+	{
+		a_stSlot.u16TransacID = pstMbusAppCallbackParams->m_u16TransactionID;
+		a_stSlot.m_objStackTimestamps = pstMbusAppCallbackParams->m_objTimeStamps;
+		a_stSlot.m_lPriority = pstMbusAppCallbackParams->m_lPriority;
+		a_stSlot.m_u8FunCode = pstMbusAppCallbackParams->m_u8FunctionCode;
+		a_stSlot.m_u16TopicID = a_u16TopicID;
+		a_stSlot.m_bIsRT = a_bIsRT;
+	});
+	if(true == bIsPushed)
+	{
+		sem_post(pSem);	// Signal response process thread
+	}
+	// else response is dropped, it is counted by overflow ring
+}
+
+/**
+ * Receives raw response data and pushes to response ring for processing.
+ * Topic is interned first, hence this should not be used from stack callback thread.
+ * @param pstMbusAppCallbackParams :[in] response received from stack
+ * @param operationCallbackType :[in] Operation type - polling/on-demand/RT/Non-RT
+ * @param strResponseTopic: [in] ZMQ topic to be used
+ * @param a_bIsRT: [in] indicates whether it is a RT request
+ * @return none
+ */
+void CPeriodicReponseProcessor::handleResponse(stMbusAppCallbackParams_t *pstMbusAppCallbackParams,
+												eMbusCallbackType operationCallbackType,
+												const std::string &strResponseTopic,
+												bool a_bIsRT)
+{
+	handleResponse(pstMbusAppCallbackParams, operationCallbackType, internTopic(strResponseTopic), a_bIsRT);
+}
+
+/**
+ * Gets ID for given topic. Topic is added to interned topics if not already present.
+ * Interned topics are never removed, so IDs stay valid for lifetime of the application.
+ * @param a_sTopic :[in] topic name
+ * @return 	topic ID : on success,
+ * 			INVALID_TOPIC_ID : if no more topics can be interned
+ */
+uint16_t CPeriodicReponseProcessor::internTopic(const std::string &a_sTopic)
+{
+	// Topics below count are never modified, so these can be searched without lock
+	uint16_t u16Count = m_u16TopicCount.load(std::memory_order_acquire);
+	for(uint16_t u16Index = 0; u16Index < u16Count; ++u16Index)
+	{
+		if(m_arrTopics[u16Index] == a_sTopic)
+		{
+			return u16Index;
+		}
+	}
+
+	std::lock_guard<std::mutex> lock(m_topicMutex);
+	u16Count = m_u16TopicCount.load(std::memory_order_acquire);
+	for(uint16_t u16Index = 0; u16Index < u16Count; ++u16Index)
+	{
+		if(m_arrTopics[u16Index] == a_sTopic)
+		{
+			return u16Index;
+		}
+	}
+	if(u16Count >= MAX_INTERNED_TOPICS)
+	{
+		DO_LOG_ERROR("Could not intern topic: " + a_sTopic);
+		return INVALID_TOPIC_ID;
+	}
+	m_arrTopics[u16Count] = a_sTopic;
+	m_u16TopicCount.store(u16Count + 1, std::memory_order_release);
+	return u16Count;
+}
+
+/**
+ * Gets topic name for given interned topic ID
+ * @param a_u16TopicID :[in] topic ID
+ * @return 	topic name : on success,
+ * 			empty string : if ID is not valid
+ */
+const std::string& CPeriodicReponseProcessor::getInternedTopic(uint16_t a_u16TopicID) const
+{
+	static const std::string sEmpty{""};
+	if(a_u16TopicID >= m_u16TopicCount.load(std::memory_order_acquire))
+	{
+		return sEmpty;
+	}
+	return m_arrTopics[a_u16TopicID];
+}
+
+/**
+ * Gets number of responses which did not fit in response ring. Such responses
+ * are reported with APP_ERROR_RESPONSE_RING_FULL error, unless they are dropped.
+ * @param operationCallbackType :[in] Operation type - polling/on-demand/RT/Non-RT
+ * @return 	number of responses which did not fit in response ring
+ */
+uint64_t CPeriodicReponseProcessor::getOverflowResponseCount(eMbusCallbackType operationCallbackType) const
+{
+	if((operationCallbackType < MBUS_CALLBACK_POLLING) || (operationCallbackType >= RESPONSE_RING_COUNT))
+	{
+		return 0;
+	}
+	return m_arrRespRings[operationCallbackType].getDropCount();
+}
+
+/**
+ * Gets number of responses dropped as both response ring and overflow ring were full.
+ * Requests of these responses are not completed.
+ * @param operationCallbackType :[in] Operation type - polling/on-demand/RT/Non-RT
+ * @return 	number of dropped responses
+ */
+uint64_t CPeriodicReponseProcessor::getDroppedResponseCount(eMbusCallbackType operationCallbackType) const
+{
+	if((operationCallbackType < MBUS_CALLBACK_POLLING) || (operationCallbackType >= RESPONSE_RING_COUNT))
 	{
-		DO_LOG_FATAL(e.what());
+		return 0;
 	}
+	return m_arrOverflowRings[operationCallbackType].getDropCount();
 }
 
 /**
@@ -1029,10 +1753,14 @@ eMbusAppErrorCode readPeriodicCallBack(stMbusAppCallbackParams_t *pstMbusAppCall
 		return APP_ERROR_EMPTY_DATA_RECVD_FROM_STACK;
 	}
 
+	// topic is interned on first response only
+	static const uint16_t u16TopicID =
+			CPeriodicReponseProcessor::Instance().internTopic(PublishJsonHandler::instance().getPolledDataTopic());
+
 	//handle response
 	CPeriodicReponseProcessor::Instance().handleResponse(pstMbusAppCallbackParams,
 														MBUS_CALLBACK_POLLING,
-														PublishJsonHandler::instance().getPolledDataTopic(),
+														u16TopicID,
 														false);
 	return APP_SUCCESS;
 }
@@ -1051,10 +1779,14 @@ eMbusAppErrorCode readPeriodicRTCallBack(stMbusAppCallbackParams_t *pstMbusAppCa
 		return APP_ERROR_EMPTY_DATA_RECVD_FROM_STACK;
 	}
 
+	// topic is interned on first response only
+	static const uint16_t u16TopicID =
+			CPeriodicReponseProcessor::Instance().internTopic(PublishJsonHandler::instance().getPolledDataTopicRT());
+
 	//handle response
 	CPeriodicReponseProcessor::Instance().handleResponse(pstMbusAppCallbackParams,
 														MBUS_CALLBACK_POLLING_RT,
-														PublishJsonHandler::instance().getPolledDataTopicRT(),
+														u16TopicID,
 														true);
 	return APP_SUCCESS;
 }
@@ -1111,7 +1843,7 @@ void CPeriodicReponseProcessor::getCallbackForRetry(void**callbackFunc, eMbusCal
  * @param None
  * @return none
  */
-CPeriodicReponseProcessor::CPeriodicReponseProcessor() : m_bIsInitialized(false)
+CPeriodicReponseProcessor::CPeriodicReponseProcessor() : m_u16TopicCount(0), m_bIsInitialized(false)
 {
 	try
 	{
@@ -1173,25 +1905,20 @@ void CPeriodicReponseProcessor::initRespHandlerThreads()
 	}
 }
 /**
- * setScaledValue: This function scales up original value received from modbus device for the datapoint. Original Value is 
- * received in string datatype. This function first converts hex string value into a datatype which is set in datapoints.yml.
- * Therafter, it scales up converted value based on scale factor.
- * @param  a_sValue	    :[in] Original Value in Hex string format
- * @param  a_sDataType	:[in] Datatype of the datapoint as specfied in datapoint.yml
- * @param  dScaleFactor :[in] Scale factor to be used in scaling up the original value.
- * @param  a_iWidth     :[in] Width of the datapoint as specfied in datapoint.yml
+ * scaleRawValue: This function converts raw value received from modbus device into a datatype
+ * which is set in datapoints.yml. Thereafter, it scales up converted value based on scale factor.
+ * @param  a_u64RawValue :[in] Raw value after applying byte and word swap
+ * @param  a_eDecodeType :[in] Decoder type as per datatype and width of the datapoint
+ * @param  dScaleFactor	 :[in] Scale factor to be used in scaling up the original value.
  * @return 	 msg_envelope_elem_body_t pointer that envelopes the scaled value to be sent on EIS
  */
-msg_envelope_elem_body_t* CPeriodicReponseProcessor::setScaledValue(std::string a_sValue, std::string a_sDataType, double dScaleFactor, int a_iWidth)
+static msg_envelope_elem_body_t* scaleRawValue(unsigned long long int a_u64RawValue, eValueDecodeType a_eDecodeType, double dScaleFactor)
 {
-	// get enumerated datatype for datapoint
-	eYMlDataType oYMlDataType = common_Handler::getDataType(a_sDataType);
-
 	// Check if datatype is int and its width is 1 (2 bytes). It represents int16_t.
-	if(oYMlDataType == enINT && a_iWidth == WIDTH_ONE)
+	if(a_eDecodeType == enDECODE_INT16)
 	{
-		// Convert original hex string value into short int(int16)
-		short int convertedValue = common_Handler::hexBytesToShortInt(a_sValue);
+		// Convert raw value into short int(int16)
+		short int convertedValue = static_cast<short int>(a_u64RawValue);
 		// Scales up converted value by multiplying with scale factor.		
 		int iScaleValue = convertedValue * dScaleFactor;
 		// checks scaledValue is less than min value of int16	
@@ -1211,10 +1938,10 @@ msg_envelope_elem_body_t* CPeriodicReponseProcessor::setScaledValue(std::string
 		return ptScaleValue;
 	}
 	// Check if datatype is int and its width is 2 (4 bytes). It represents int32_t.
-	else if(oYMlDataType == enINT && a_iWidth == WIDTH_TWO)
+	else if(a_eDecodeType == enDECODE_INT32)
 	{   
-		// Convert original hex string value into int(int32)
-		int convertedValue = common_Handler::hexBytesToInt(a_sValue);
+		// Convert raw value into int(int32)
+		int convertedValue = static_cast<int>(a_u64RawValue);
 		// Scales up converted value by multiplying with scale factor.	
 		long long int iScaleValue = convertedValue * dScaleFactor;
 		// checks scaledValue is less than min value of int32	
@@ -1234,10 +1961,10 @@ msg_envelope_elem_body_t* CPeriodicReponseProcessor::setScaledValue(std::string
 		return ptScaleValue;
 	}
 	// Check if datatype is int and its width is 4 (8 bytes). It represents int64_t.
-	else if(oYMlDataType == enINT && a_iWidth == WIDTH_FOUR)
+	else if(a_eDecodeType == enDECODE_INT64)
 	{
-		// Convert original hex string value into int(int64)
-		long long int convertedValue = common_Handler::hexBytesToLongLongInt(a_sValue);
+		// Convert raw value into int(int64)
+		long long int convertedValue = static_cast<long long int>(a_u64RawValue);
 		// Scales up converted value by multiplying with scale factor.	
 		long long int iScaleValue = convertedValue * dScaleFactor;	
 		// checks scaledValue is less than min value of int64	
@@ -1257,10 +1984,10 @@ msg_envelope_elem_body_t* CPeriodicReponseProcessor::setScaledValue(std::string
 		return ptScaleValue;
 	}
 	// Check if datatype is unsigned int and its width is 1 (2 bytes). It represents uint16_t.
-	else if(oYMlDataType == enUINT && a_iWidth == WIDTH_ONE)
+	else if(a_eDecodeType == enDECODE_UINT16)
 	{
-		// Convert original hex string value into uint(uint16)
-		unsigned short int convertedValue = common_Handler::hexBytesToUShortInt(a_sValue);
+		// Convert raw value into uint(uint16)
+		unsigned short int convertedValue = static_cast<unsigned short int>(a_u64RawValue);
 		// Scales up converted value by multiplying with scale factor.
 		unsigned int iScaleValue = convertedValue * dScaleFactor;	
 		// checks scaledValue is less than min value of uint16_t		
@@ -1280,10 +2007,10 @@ msg_envelope_elem_body_t* CPeriodicReponseProcessor::setScaledValue(std::string
 		return ptScaleValue;
 	}
 	// Check if datatype is uint and its width is 2 (4 bytes). It represents uint32_t.
-	else if(oYMlDataType == enUINT && a_iWidth == WIDTH_TWO)
+	else if(a_eDecodeType == enDECODE_UINT32)
 	{
-		// Convert original hex string value into uint(uint32)
-		unsigned int convertedValue = common_Handler::hexBytesToUnsignedInt(a_sValue);
+		// Convert raw value into uint(uint32)
+		unsigned int convertedValue = static_cast<unsigned int>(a_u64RawValue);
 		// When converted value is 4294967295 (Max Value can receive 0xFFFFFFFF) and Scale Factor is 100.
 		// Scale value becomes 429496729500. To accommodate this scale value, data type is used as
 		// unsigned long long int.
@@ -1305,10 +2032,10 @@ msg_envelope_elem_body_t* CPeriodicReponseProcessor::setScaledValue(std::string
 		return ptScaleValue;
 	}
 	// Check if datatype is uint and its width is 4 (8 bytes). It represents uint64_t.
-	else if(oYMlDataType == enUINT && a_iWidth == WIDTH_FOUR)
+	else if(a_eDecodeType == enDECODE_UINT64)
 	{
-		// Convert original hex string value into uint(uint64)
-		unsigned long long int convertedValue = common_Handler::hexBytesToUnsignedLongLongInt(a_sValue);
+		// Convert raw value into uint(uint64)
+		unsigned long long int convertedValue = a_u64RawValue;
 		unsigned long long int iScaleValue = 0;
 		//< Below expression type cast (unsigned long long int) is required as dScaleFactor is having
 		//< 8 byte width and having exponent and mantisa, which truncates when convertedValue is
@@ -1332,11 +2059,13 @@ msg_envelope_elem_body_t* CPeriodicReponseProcessor::setScaledValue(std::string
 		return ptScaleValue;
 	}
 	// Check if datatype is float and its width is 2 (4 bytes). It represents float.
-	else if(oYMlDataType == enFLOAT && a_iWidth == WIDTH_TWO)
+	else if(a_eDecodeType == enDECODE_FLOAT)
 	{
 		fesetround(FE_TONEAREST);
-		// Convert original hex string value into float
-		float convertedValue = common_Handler::hexBytesToFloat(a_sValue);
+		// Convert raw value into float
+		hexStrToFlt ohexStrToFlt;
+		ohexStrToFlt.hexValue = a_u64RawValue;
+		float convertedValue = ohexStrToFlt.actualFltVal;
 		// Scales up converted value by multiplying with scale factor.				
 		double fScaleValue = convertedValue * dScaleFactor;
 		// checks scaledValue is less than min value of float				
@@ -1372,11 +2101,13 @@ msg_envelope_elem_body_t* CPeriodicReponseProcessor::setScaledValue(std::string
 		return ptScaleValue;
 	}
 	// Check if datatype is double and its width is 4 (8 bytes). It represents double.
-	else if(oYMlDataType == enDOUBLE && a_iWidth == WIDTH_FOUR)
+	else if(a_eDecodeType == enDECODE_DOUBLE)
 	{
 		fesetround(FE_TONEAREST);
-		// Convert original hex string value into double
-		double convertedValue = common_Handler::hexBytesToDouble(a_sValue);	
+		// Convert raw value into double
+		hexStrToDbl ohexStrToDbl;
+		ohexStrToDbl.hexValue = a_u64RawValue;
+		double convertedValue = ohexStrToDbl.actualDblVal;	
 		// Scales up converted value by multiplying with scale factor.			
 		long double dScaleValue = convertedValue * dScaleFactor;	
 		// checks scaledValue is less than min value of double		
@@ -1412,27 +2143,81 @@ msg_envelope_elem_body_t* CPeriodicReponseProcessor::setScaledValue(std::string
 		return ptScaleValue;
 	}
 	// Check if datatype is boolean and its width is 1 (2 bytes). It represents boolean.
-	else if(oYMlDataType == enBOOLEAN && a_iWidth == WIDTH_ONE)
+	else if(a_eDecodeType == enDECODE_BOOLEAN)
 	{
-		// Convert original hex string value into bool
-		bool bScaledValue = common_Handler::hexBytesToBool(a_sValue);	
+		// Convert raw value into bool
+		bool bScaledValue = (0 != a_u64RawValue);	
 		msg_envelope_elem_body_t* ptScaleValue = msgbus_msg_envelope_new_bool(bScaledValue);
 		return ptScaleValue;
 	}
-	// Check if datatype is string.
-	else if(oYMlDataType == enSTRING)
+	// Invalid datatype received.
+	else
 	{
-		std::string sScaledValue = a_sValue;		
+		std::string sScaledValue = "Empty Data";
 		msg_envelope_elem_body_t* ptScaleValue = msgbus_msg_envelope_new_string(sScaledValue.c_str());
 		return ptScaleValue;
 	}
-	// Invalid datatype received.
-	else
+}
+
+/**
+ * setScaledValue: This function scales up original value received from modbus device for the datapoint. Original Value is 
+ * received in string datatype. This function first converts hex string value into a datatype which is set in datapoints.yml.
+ * Therafter, it scales up converted value based on scale factor.
+ * @param  a_sValue	    :[in] Original Value in Hex string format
+ * @param  a_sDataType	:[in] Datatype of the datapoint as specfied in datapoint.yml
+ * @param  dScaleFactor :[in] Scale factor to be used in scaling up the original value.
+ * @param  a_iWidth     :[in] Width of the datapoint as specfied in datapoint.yml
+ * @return 	 msg_envelope_elem_body_t pointer that envelopes the scaled value to be sent on EIS
+ */
+msg_envelope_elem_body_t* CPeriodicReponseProcessor::setScaledValue(std::string a_sValue, std::string a_sDataType, double dScaleFactor, int a_iWidth)
+{
+	// get decoder type for datapoint
+	eValueDecodeType eDecodeType = common_Handler::getDecodeType(common_Handler::getDataType(a_sDataType), a_iWidth);
+
+	// Check if datatype is string.
+	if(enDECODE_STRING == eDecodeType)
 	{
-		std::string sScaledValue = "Empty Data";
+		msg_envelope_elem_body_t* ptScaleValue = msgbus_msg_envelope_new_string(a_sValue.c_str());
+		return ptScaleValue;
+	}
+
+	unsigned long long int u64RawValue = 0;
+	if(enDECODE_INVALID != eDecodeType)
+	{
+		// Convert original hex string value into raw value
+		u64RawValue = common_Handler::hexBytesToUnsignedLongLongInt(a_sValue);
+	}
+	return scaleRawValue(u64RawValue, eDecodeType, dScaleFactor);
+}
+
+/**
+ * setScaledValue: This function scales up original value received from modbus device for the datapoint.
+ * Value is decoded straight from response bytes using decoder of the datapoint. Hex string is
+ * built only for string datatype.
+ * @param  a_vValue	    :[in] Original Value as received from modbus device
+ * @param  a_stDecoder	:[in] Decoder of the datapoint
+ * @return 	 msg_envelope_elem_body_t pointer that envelopes the scaled value to be sent on EIS
+ */
+msg_envelope_elem_body_t* CPeriodicReponseProcessor::setScaledValue(const std::vector<uint8_t> &a_vValue, const stValueDecoder &a_stDecoder)
+{
+	// Check if datatype is string.
+	if(enDECODE_STRING == a_stDecoder.m_eDecodeType)
+	{
+		std::string sScaledValue{""};
+		if(false == a_vValue.empty())
+		{
+			sScaledValue = common_Handler::swapConversion(a_vValue, a_stDecoder.m_bIsByteSwap, a_stDecoder.m_bIsWordSwap);
+		}
 		msg_envelope_elem_body_t* ptScaleValue = msgbus_msg_envelope_new_string(sScaledValue.c_str());
 		return ptScaleValue;
 	}
+
+	unsigned long long int u64RawValue = 0;
+	if(enDECODE_INVALID != a_stDecoder.m_eDecodeType)
+	{
+		u64RawValue = common_Handler::bytesToRawValue(a_vValue, a_stDecoder.m_bIsByteSwap, a_stDecoder.m_bIsWordSwap);
+	}
+	return scaleRawValue(u64RawValue, a_stDecoder.m_eDecodeType, a_stDecoder.m_dScaleFactor);
 }
 
 /**
@@ -1621,9 +2406,13 @@ bool CRequestInitiator::getFreqRefForPollCycle(struct StPollingInstance &a_stPol
 }
 
 /**
- * Initiate request for polling
+ * Initiate request for polling. Requests are added to queue of their device
+ * and are then sent in round-robin order across devices, within in-flight limit
+ * of each device. Requests exceeding the limit are sent when a response of the
+ * device is received.
  * @param a_stPollTimestamp:[in] timestamp at which polling interval triggered
- * @param a_vReqData	:[in] List of points to be polled
+ * @param a_vReqData	:[in] List of points of polling interval
+ * @param a_vPhasePoints	:[in] index, in list of points, of points to be polled in this phase
  * @param isRTRequest	:[in] boolean variable to distinguish between RT/Non-RT requests
  * @param a_lPriority	:[in] priority assigned to message when sending a request
  * @param a_nRetry		:[in] request retries to be performed in case of timeout
@@ -1631,66 +2420,194 @@ bool CRequestInitiator::getFreqRefForPollCycle(struct StPollingInstance &a_stPol
  * @return none
  */
 void CRequestInitiator::initiateRequest(struct timespec &a_stPollTimestamp, std::vector<CRefDataForPolling>& a_vReqData,
+		const std::vector<uint32_t> &a_vPhasePoints,
 		bool isRTRequest,
 		const long a_lPriority,
 		int a_nRetry,
 		void* a_ptrCallbackFunc)
 {
-	for(auto &objReqData: a_vReqData)
+	// Devices having new requests, in order of their first request
+	std::vector<std::shared_ptr<CDeviceRequestQueue>> vDevices;
+
+	for(uint32_t u32Index : a_vPhasePoints)
 	{
+		CRefDataForPolling &objReqData = a_vReqData[u32Index];
+
+		// Points of a polling block are requested along with the block leader
+		if(true == objReqData.isBlockMember())
+		{
+			continue;
+		}
+
+		std::shared_ptr<CDeviceRequestQueue> pDeviceQueue = objReqData.getDeviceQueue();
+		if((NULL != pDeviceQueue) && (true == pDeviceQueue->isDown()))
+		{
+			// Device is down and its status is already published. Only a probe is
+			// sent, once its backoff is over, to find out if device is up again.
+			if((true == objReqData.getDataPoint().isIsAwaitResp()) || (false == pDeviceQueue->isPollAllowed(a_stPollTimestamp)))
+			{
+				continue;
+			}
+		}
+
 		// Check if a response is already awaited
 		if(true == objReqData.getDataPoint().isIsAwaitResp())
 		{
+			// Points for which last request was sent
+			std::vector<std::reference_wrapper<CRefDataForPolling>> vReqPoints = objReqData.getRequestPoints();
+
 			// waiting for response. Send BAD response
 			stException_t m_stException = {};
 			m_stException.m_u8ExcCode = APP_ERROR_DUMMY_RESPONSE;
 			m_stException.m_u8ExcStatus = 0;
 			uint16_t lastTxID = objReqData.getReqTxID();
-			DO_LOG_INFO("Post dummy response as response not received for - Point: " + objReqData.getDataPoint().getID()
-						+ ", LastTxID: " + std::to_string(lastTxID));
-			CPeriodicReponseProcessor::Instance().postDummyBADResponse(objReqData, m_stException, &a_stPollTimestamp);
-
-			if(false == CRequestInitiator::instance().isTxIDPresent(lastTxID, isRTRequest))
+			// Request waiting in device queue has no TxID yet. Last TxID may be given
+			// to another point once it is released, hence its owner is checked.
+			bool bIsTxIDPresent = objReqData.isReqPending() || CRequestInitiator::instance().isTxIDOwnedBy(lastTxID, objReqData, isRTRequest);
+			for(auto &refPoint : vReqPoints)
 			{
-				DO_LOG_INFO("TxID is not present in map.Resetting the response status");
-				objReqData.getDataPoint().setIsAwaitResp(false);
+				CRefDataForPolling &objPoint = refPoint.get();
+				DO_LOG_INFO("Post dummy response as response not received for - Point: " + objPoint.getDataPoint().getID()
+							+ ", LastTxID: " + std::to_string(lastTxID));
+				CPeriodicReponseProcessor::Instance().postDummyBADResponse(objPoint, m_stException, &a_stPollTimestamp);
+
+				if(false == bIsTxIDPresent)
+				{
+					DO_LOG_INFO("TxID is not present in map.Resetting the response status");
+					objPoint.getDataPoint().setIsAwaitResp(false);
+				}
 			}
 			continue;
 		}
 
+		stPendingRequest stReq{&objReqData, a_stPollTimestamp, isRTRequest, a_lPriority, a_nRetry, a_ptrCallbackFunc};
+		if(NULL == pDeviceQueue)
 		{
-			// generate the TX ID
-			//uint16_t m_u16TxId = PublishJsonHandler::instance().getTxId();
-			uint16_t m_u16TxId = objReqData.getDataPoint().getMyRollID();
-
-			// Set data for this polling request
-			objReqData.setDataForNewReq(m_u16TxId, a_stPollTimestamp);
+			// Device queues are not formed. Send request right away.
+			dispatchRequest(stReq);
+			continue;
+		}
 
-			DO_LOG_DEBUG("Trying to send request for - Point: " + 
-						objReqData.getDataPoint().getID() +
-						", with TxID: " + std::to_string(m_u16TxId));
+		// Response is awaited from now on, even while request is pending in device queue.
+		// Cutoff of this cycle applies to pending request as well.
+		objReqData.setReqPending(true);
+		objReqData.getDataPoint().setIsAwaitResp(true);
+		objReqData.setResponsePosted(false);
+		for(auto &refMember : objReqData.getBlockPoints())
+		{
+			refMember.get().setResponsePosted(false);
+		}
+		pDeviceQueue->push(stReq);
+		if(vDevices.end() == std::find(vDevices.begin(), vDevices.end(), pDeviceQueue))
+		{
+			vDevices.push_back(pDeviceQueue);
+		}
+	}
 
-			// Send a request
-			if (true == sendRequest(objReqData, m_u16TxId, isRTRequest, a_lPriority, a_nRetry, a_ptrCallbackFunc))
+	// Send one request of each device in turn, so that all devices get equal chance
+	uint32_t u32MaxInFlight = PublishJsonHandler::instance().getMaxInFlightPerDevice();
+	bool bIsSent = true;
+	while(true == bIsSent)
+	{
+		bIsSent = false;
+		for(auto &pDeviceQueue : vDevices)
+		{
+			stPendingRequest stReq;
+			if(true == pDeviceQueue->pop(u32MaxInFlight, stReq))
 			{
-				// Request is sent successfully
-				// No action
+				dispatchRequest(stReq);
+				bIsSent = true;
 			}
-			else
-			{
-				objReqData.getDataPoint().setIsAwaitResp(false);
-				stException_t m_stException = {};
-				m_stException.m_u8ExcCode = APP_ERROR_REQUEST_SEND_FAILED;
-				m_stException.m_u8ExcStatus = 0;
-				CPeriodicReponseProcessor::Instance().postDummyBADResponse(objReqData, m_stException);
+		}
+	}
+}
 
-				/// remove node from TxID map
-				CRequestInitiator::instance().removeTxIDReqData(m_u16TxId, isRTRequest);
-				// reset txid
-				objReqData.setReqTxID(0);
-				DO_LOG_ERROR("sendRequest failed");
-			}
+/**
+ * Sends a polling request. Slot of request in its device queue, if any,
+ * is already taken and it is freed if request cannot be sent.
+ * @param a_stReq	:[in] request to be sent
+ * @return 	true : on success,
+ * 			false : on error
+ */
+bool CRequestInitiator::dispatchRequest(stPendingRequest &a_stReq)
+{
+	CRefDataForPolling &objReqData = *a_stReq.m_pReqData;
+	objReqData.setReqPending(false);
+
+	// Points for which this request is sent
+	std::vector<std::reference_wrapper<CRefDataForPolling>> vReqPoints = objReqData.getRequestPoints();
+
+	stException_t m_stException = {};
+	m_stException.m_u8ExcCode = APP_ERROR_REQUEST_SEND_FAILED;
+	m_stException.m_u8ExcStatus = 0;
+
+	// claim a free TX ID. It is not tied to the point.
+	uint16_t m_u16TxId = 0;
+	if(false == allocateTxID(objReqData, a_stReq.m_bIsRT, m_u16TxId))
+	{
+		for(auto &refPoint : vReqPoints)
+		{
+			CRefDataForPolling &objPoint = refPoint.get();
+			objPoint.getDataPoint().setIsAwaitResp(false);
+			CPeriodicReponseProcessor::Instance().postDummyBADResponse(objPoint, m_stException);
+		}
+		DO_LOG_ERROR("No free TxID, in-flight requests: " + std::to_string(getInFlightCount(a_stReq.m_bIsRT)));
+		if(NULL != objReqData.getDeviceQueue())
+		{
+			objReqData.getDeviceQueue()->complete();
 		}
+		return false;
+	}
+
+	// Set data for this polling request
+	for(auto &refPoint : vReqPoints)
+	{
+		refPoint.get().setDataForNewReq(m_u16TxId, a_stReq.m_tsPoll);
+	}
+
+	DO_LOG_DEBUG("Trying to send request for - Point: " +
+				objReqData.getDataPoint().getID() +
+				", Points in request: " + std::to_string(vReqPoints.size()) +
+				", with TxID: " + std::to_string(m_u16TxId));
+
+	// Send a request
+	if (true == sendRequest(objReqData, m_u16TxId, a_stReq.m_bIsRT, a_stReq.m_lPriority, a_stReq.m_nRetry, a_stReq.m_ptrCallbackFunc))
+	{
+		// Request is sent successfully
+		return true;
+	}
+
+	for(auto &refPoint : vReqPoints)
+	{
+		CRefDataForPolling &objPoint = refPoint.get();
+		objPoint.getDataPoint().setIsAwaitResp(false);
+		CPeriodicReponseProcessor::Instance().postDummyBADResponse(objPoint, m_stException);
+		// reset txid
+		objPoint.setReqTxID(0);
+	}
+
+	/// remove node from TxID map
+	CRequestInitiator::instance().removeTxIDReqData(m_u16TxId, a_stReq.m_bIsRT);
+	if(NULL != objReqData.getDeviceQueue())
+	{
+		objReqData.getDeviceQueue()->complete();
+	}
+	DO_LOG_ERROR("sendRequest failed");
+	return false;
+}
+
+/**
+ * Sends pending requests of a device as long as its in-flight limit allows
+ * @param a_oDeviceQueue	:[in] request queue of device
+ * @return none
+ */
+void CRequestInitiator::dispatchPendingRequests(CDeviceRequestQueue &a_oDeviceQueue)
+{
+	uint32_t u32MaxInFlight = PublishJsonHandler::instance().getMaxInFlightPerDevice();
+	stPendingRequest stReq;
+	while(true == a_oDeviceQueue.pop(u32MaxInFlight, stReq))
+	{
+		dispatchRequest(stReq);
 	}
 }
 
@@ -1754,7 +2671,10 @@ void CRequestInitiator::threadReqInit(bool isRTPoint,
 						break;
 					}
 					std::vector<CRefDataForPolling>& vReqData = CTimeMapper::instance().getPolledPointList(stPollRef.m_uiPollInterval, isRTPoint);
-					initiateRequest(stPollRef.m_tsPollTime, vReqData, isRTPoint, (CTimeMapper::instance().getFreqIndex(stPollRef.m_uiPollInterval) +
+					// only points of the phase which is due are visited
+					const std::vector<uint32_t>& vPhasePoints = CTimeMapper::instance().getPhasePointList(stPollRef.m_uiPollInterval,
+							stPollRef.m_u32PhaseOffset, isRTPoint);
+					initiateRequest(stPollRef.m_tsPollTime, vReqData, vPhasePoints, isRTPoint, (CTimeMapper::instance().getFreqIndex(stPollRef.m_uiPollInterval) +
 							l_reqPriority + 1), nRetry, ptrCallbackFunc);
 				} while(0);
 
@@ -1824,10 +2744,14 @@ void CRequestInitiator::threadCheckCutoffRespInit(bool isRTPoint,
 				}
 				std::vector<CRefDataForPolling>& vReqData =
 						CTimeMapper::instance().getPolledPointList(stPollRef.m_uiPollInterval, isRTPoint);
+				// Cutoff of point follows its own phase
+				const std::vector<uint32_t>& vPhasePoints = CTimeMapper::instance().getPhasePointList(stPollRef.m_uiPollInterval,
+						stPollRef.m_u32PhaseOffset, isRTPoint);
 
 				// Check if responses are sent
-				for(auto &objPolledPoint : vReqData)
+				for(uint32_t u32Index : vPhasePoints)
 				{
+					CRefDataForPolling &objPolledPoint = vReqData[u32Index];
 					if(true == objPolledPoint.isResponsePosted())
 					{
 						DO_LOG_DEBUG(objPolledPoint.getDataPoint().getID()
@@ -1893,16 +2817,9 @@ void CRequestInitiator::initiateMessages(struct StPollingInstance &a_stPollRef,
  */
 CRequestInitiator::~CRequestInitiator()
 {
-	{
-		// Clear Non-RT structures
-		std::lock_guard<std::mutex> lock(m_mutextTxIDMap);
-		m_mapTxIDReqData.clear();
-	}
-	{
-		// Clear RT structures
-		std::lock_guard<std::mutex> lock(m_mutextTxIDMapRT);
-		m_mapTxIDReqDataRT.clear();
-	}
+	// Clear Non-RT and RT structures
+	m_oTxIDTable.clear();
+	m_oTxIDTableRT.clear();
 	sem_destroy(&semaphoreReqProcess);
 	sem_destroy(&semaphoreRespProcess);
 	sem_destroy(&semaphoreRTReqProcess);
@@ -1910,139 +2827,367 @@ CRequestInitiator::~CRequestInitiator()
 }
 
 /**
- * Constructor: This is a singleton class used to send requests for polling.
- * Constructor initiates the data.
- * @param: none
- * @return none
+ * Constructor: This is a singleton class used to send requests for polling.
+ * Constructor initiates the data.
+ * @param: none
+ * @return none
+ */
+CRequestInitiator::CRequestInitiator() : m_uiIsNextRequest(0)
+{
+	try
+	{
+		init();
+	}
+	catch(const std::exception& e)
+	{
+		DO_LOG_FATAL("Unable to initiate instance: Exception:");
+		DO_LOG_FATAL(e.what());
+	}
+}
+
+/**
+ * Get point reference for given TxID
+ * @param tokenId	:[in] TxID for which point is to be found
+ * @param a_bIsRT	:[in] indicates whether it is a RT request
+ * @return point reference; throws std::out_of_range if TxID is not in flight
+ */
+CRefDataForPolling& CRequestInitiator::getTxIDReqData(unsigned short tokenId, bool a_bIsRT)
+{
+	CRefDataForPolling *pRefData = (true == a_bIsRT) ? m_oTxIDTableRT.get(tokenId) : m_oTxIDTable.get(tokenId);
+	if(NULL == pRefData)
+	{
+		throw std::out_of_range("TxID is not in flight: " + std::to_string(tokenId));
+	}
+	return *pRefData;
+}
+
+/**
+ * Check if a given TxID is in flight
+ * @param tokenId	:[in] check request for request with token
+ * @param a_bIsRT	:[in] indicates whether it is a RT request
+ * @return true: present, false: absent
+ */
+bool CRequestInitiator::isTxIDPresent(unsigned short tokenId, bool a_bIsRT)
+{
+	if(0 == tokenId)
+	{
+		// TxID 0 is never given out
+		return false;
+	}
+	if(true == a_bIsRT)
+	{
+		return (NULL != m_oTxIDTableRT.get(tokenId));
+	}
+	return (NULL != m_oTxIDTable.get(tokenId));
+}
+
+/**
+ * Check if a given TxID is in flight for given point. A released TxID may be
+ * given to another point, hence TxID last used by a point is checked this way.
+ * @param tokenId		:[in] TxID to be checked
+ * @param a_objReqData	:[in] point for which TxID is checked
+ * @param a_bIsRT		:[in] indicates whether it is a RT request
+ * @return true: TxID is in flight for the point, false: otherwise
+ */
+bool CRequestInitiator::isTxIDOwnedBy(unsigned short tokenId, const CRefDataForPolling &a_objReqData, bool a_bIsRT)
+{
+	if(0 == tokenId)
+	{
+		// TxID 0 is never given out
+		return false;
+	}
+	if(true == a_bIsRT)
+	{
+		return (&a_objReqData == m_oTxIDTableRT.get(tokenId));
+	}
+	return (&a_objReqData == m_oTxIDTable.get(tokenId));
+}
+
+/**
+ * Claims a free TxID for a point. TxID is independent of the point, so
+ * number of points is not limited by the 16-bit TxID range.
+ * @param objRefData	:[in] reference to polling data
+ * @param a_bIsRT		:[in] defines whether it is a RT request or not
+ * @param a_u16TxID		:[out] claimed TxID
+ * @return 	true : on success,
+ * 			false : if all TxIDs are in flight
+ */
+bool CRequestInitiator::allocateTxID(CRefDataForPolling &objRefData, bool a_bIsRT, uint16_t &a_u16TxID)
+{
+	if(true == a_bIsRT)
+	{
+		return m_oTxIDTableRT.acquire(&objRefData, a_u16TxID);
+	}
+	return m_oTxIDTable.acquire(&objRefData, a_u16TxID);
+}
+
+/**
+ * Releases TxID once data is posted on ZMQ for polling.
+ * @param tokenId :[in] TxID to be released
+ * @param a_bIsRT :[in] indicates whether it is a RT request
+ * @return none
+ */
+void CRequestInitiator::removeTxIDReqData(unsigned short tokenId, bool a_bIsRT)
+{
+	if(true == a_bIsRT)
+	{
+		m_oTxIDTableRT.release(tokenId);
+	}
+	else
+	{
+		m_oTxIDTable.release(tokenId);
+	}
+}
+
+/**
+ * Get number of TxIDs in flight
+ * @param a_bIsRT :[in] indicates whether it is a RT request
+ * @return number of TxIDs in flight
+ */
+uint32_t CRequestInitiator::getInFlightCount(bool a_bIsRT) const
+{
+	return (true == a_bIsRT) ? m_oTxIDTableRT.size() : m_oTxIDTable.size();
+}
+
+/**
+ * Frees slot of a request in its device queue once response is received
+ * and sends next pending request of the device
+ * @param a_objReqData :[in] point (or block leader) for which response is received
+ * @return none
+ */
+void CRequestInitiator::completeRequest(CRefDataForPolling &a_objReqData)
+{
+	std::shared_ptr<CDeviceRequestQueue> pDeviceQueue = a_objReqData.getDeviceQueue();
+	if(NULL == pDeviceQueue)
+	{
+		return;
+	}
+	pDeviceQueue->complete();
+	dispatchPendingRequests(*pDeviceQueue);
+}
+
+/**
+ * Updates state of device of a point using response of its request. Device
+ * going down or coming up is published once as device status.
+ * @param a_objReqData	:[in] point (or block leader) for which response is received
+ * @param a_stException	:[in] exception of the response
+ * @return none
+ */
+void CRequestInitiator::recordDeviceResponse(CRefDataForPolling &a_objReqData, const stException_t &a_stException)
+{
+	std::shared_ptr<CDeviceRequestQueue> pDeviceQueue = a_objReqData.getDeviceQueue();
+	if(NULL == pDeviceQueue)
+	{
+		return;
+	}
+
+	// Same condition as is used for retry
+	if((STACK_ERROR_RECV_TIMEOUT == a_stException.m_u8ExcCode) && (2 == a_stException.m_u8ExcStatus))
+	{
+		struct timespec tsNow;
+		timespec_get(&tsNow, TIME_UTC);
+		std::vector<stPendingRequest> vDropped;
+		if(true == pDeviceQueue->recordTimeout(PublishJsonHandler::instance().getDeviceDownTimeoutCount(),
+				PublishJsonHandler::instance().getDeviceProbeMaxBackoffMs(), tsNow, vDropped))
+		{
+			DO_LOG_ERROR(pDeviceQueue->getDeviceKey() + ": device is down, dropped pending requests: " + std::to_string(vDropped.size()));
+			for(auto &stReq : vDropped)
+			{
+				// Device status replaces responses of these points
+				std::vector<std::reference_wrapper<CRefDataForPolling>> vReqPoints = stReq.m_pReqData->getRequestPoints();
+				for(auto &refPoint : vReqPoints)
+				{
+					refPoint.get().setReqPending(false);
+					refPoint.get().getDataPoint().setIsAwaitResp(false);
+					refPoint.get().setResponsePosted(true);
+				}
+			}
+			CPeriodicReponseProcessor::Instance().postDeviceStatusJSON(a_objReqData, true);
+		}
+	}
+	else if(true == pDeviceQueue->recordSuccess())
+	{
+		DO_LOG_INFO(pDeviceQueue->getDeviceKey() + ": device is up, polling is resumed");
+		CPeriodicReponseProcessor::Instance().postDeviceStatusJSON(a_objReqData, false);
+	}
+}
+
+/**
+ * Adds a request to pending queue of device
+ * @param a_stReq	:[in] request to be added
+ * @return none
+ */
+void CDeviceRequestQueue::push(const stPendingRequest &a_stReq)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if(true == a_stReq.m_bIsRT)
+	{
+		m_qPendingRT.push_back(a_stReq);
+	}
+	else
+	{
+		m_qPending.push_back(a_stReq);
+	}
+}
+
+/**
+ * Takes oldest pending request of device, RT first, if in-flight limit allows.
+ * Request is counted as in flight from now on.
+ * @param a_u32MaxInFlight	:[in] max requests in flight to device, 0 means no limit
+ * @param a_stReq			:[out] request to be sent
+ * @return 	true : if request is taken,
+ * 			false : if no request is pending or limit is reached
  */
-CRequestInitiator::CRequestInitiator() : m_uiIsNextRequest(0)
+bool CDeviceRequestQueue::pop(uint32_t a_u32MaxInFlight, stPendingRequest &a_stReq)
 {
-	try
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if((0 != a_u32MaxInFlight) && (m_u32InFlight >= a_u32MaxInFlight))
 	{
-		init();
+		return false;
 	}
-	catch(const std::exception& e)
+	std::deque<stPendingRequest> &qPending = (false == m_qPendingRT.empty()) ? m_qPendingRT : m_qPending;
+	if(true == qPending.empty())
 	{
-		DO_LOG_FATAL("Unable to initiate instance: Exception:");
-		DO_LOG_FATAL(e.what());
+		return false;
 	}
+	a_stReq = qPending.front();
+	qPending.pop_front();
+	++m_u32InFlight;
+	return true;
 }
 
 /**
- * Get point information corresponding to a transaction id for requested data
- * @param tokenId	:[in] get request for request with token
- * @param a_bIsRT	:[in] indicates whether it is a RT request
- * @return point reference
+ * Marks one in-flight request of device as completed
+ * @return none
  */
-CRefDataForPolling& CRequestInitiator::getTxIDReqData(unsigned short tokenId, bool a_bIsRT)
+void CDeviceRequestQueue::complete()
 {
-	if(true == a_bIsRT)
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if(0 < m_u32InFlight)
 	{
-		// This is RT request. Use RT-related structures
-		/// Ensure that only on thread can execute at a time
-		std::lock_guard<std::mutex> lock(m_mutextTxIDMapRT);
-
-		// return the request ID
-		return m_mapTxIDReqDataRT.at(tokenId);
+		--m_u32InFlight;
 	}
+}
 
-	// This is Non-RT request. Use Non-RT-related structures
-	/// Ensure that only one thread can execute at a time
-	std::lock_guard<std::mutex> lock(m_mutextTxIDMap);
+/**
+ * Get number of requests in flight to device
+ * @return number of requests in flight
+ */
+uint32_t CDeviceRequestQueue::getInFlightCount()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_u32InFlight;
+}
 
-	// return the request ID
-	return m_mapTxIDReqData.at(tokenId);
+/**
+ * Get number of requests waiting to be sent to device
+ * @return number of pending requests
+ */
+size_t CDeviceRequestQueue::getPendingCount()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_qPending.size() + m_qPendingRT.size();
 }
 
 /**
- * Check if a given TxID is present in TxID map
- * @param tokenId	:[in] check request for request with token
- * @param a_bIsRT	:[in] indicates whether it is a RT request
- * @return true: present, false: absent
+ * Records a timeout of device. Device is treated as down once given number of
+ * consecutive timeouts is reached and its pending requests are dropped. For a
+ * down device, every further timeout doubles interval till next probe.
+ * @param a_u32TimeoutLimit	:[in] consecutive timeouts after which device is down, 0 disables it
+ * @param a_u32MaxBackoffMs	:[in] max interval in ms between two probes
+ * @param a_tsNow			:[in] current time
+ * @param a_vDropped		:[out] pending requests which are dropped
+ * @return 	true : if device is down now and was up before,
+ * 			false : otherwise
  */
-bool CRequestInitiator::isTxIDPresent(unsigned short tokenId, bool a_bIsRT)
+bool CDeviceRequestQueue::recordTimeout(uint32_t a_u32TimeoutLimit, uint32_t a_u32MaxBackoffMs, const struct timespec &a_tsNow,
+		std::vector<stPendingRequest> &a_vDropped)
 {
-	if(true == a_bIsRT)
+	std::lock_guard<std::mutex> lock(m_mutex);
+	++m_u32ConsecutiveTimeouts;
+	if((0 == a_u32TimeoutLimit) || (m_u32ConsecutiveTimeouts < a_u32TimeoutLimit))
 	{
-		// This is RT request. Use RT-related structures
-		/// Ensure that only one thread can execute at a time
-		std::lock_guard<std::mutex> lock(m_mutextTxIDMapRT);
+		return false;
+	}
 
-		// check if data is present
-		if(m_mapTxIDReqDataRT.end() != m_mapTxIDReqDataRT.find(tokenId))
-		{
-			// token id is found
-			return true;
-		}
+	bool bIsNowDown = (false == m_bIsDown);
+	if(true == bIsNowDown)
+	{
+		m_bIsDown = true;
+		m_u32DownCount.fetch_add(1, std::memory_order_release);
+		m_u32BackoffMs = std::min<uint32_t>(DEVICE_PROBE_MIN_BACKOFF_MS, a_u32MaxBackoffMs);
+		a_vDropped.insert(a_vDropped.end(), m_qPendingRT.begin(), m_qPendingRT.end());
+		a_vDropped.insert(a_vDropped.end(), m_qPending.begin(), m_qPending.end());
+		m_qPendingRT.clear();
+		m_qPending.clear();
 	}
 	else
 	{
-		// This is Non-RT request. Use Non-RT-related structures
-		/// Ensure that only one thread can execute at a time
-		std::lock_guard<std::mutex> lock(m_mutextTxIDMap);
-
-		// check if data is present
-		if(m_mapTxIDReqData.end() != m_mapTxIDReqData.find(tokenId))
-		{
-			// token id is found
-			return true;
-		}
+		// Probe failed
+		m_u32BackoffMs = std::min<uint32_t>(m_u32BackoffMs * 2, a_u32MaxBackoffMs);
 	}
-	// Token id is not found
-	return false;
+
+	uint64_t u64NextProbeNs = ((uint64_t)a_tsNow.tv_sec * 1000000000ULL) + a_tsNow.tv_nsec + ((uint64_t)m_u32BackoffMs * 1000000ULL);
+	m_tsNextProbe.tv_sec = (time_t)(u64NextProbeNs / 1000000000ULL);
+	m_tsNextProbe.tv_nsec = (long)(u64NextProbeNs % 1000000000ULL);
+	return bIsNowDown;
 }
 
 /**
- * Insert new TxID and point reference entry in map
- * @param token 		:[in] token
- * @param objRefData	:[in] reference to polling data
- * @param a_bIsRT		:[in] defines whether it is a RT request or not
- * @return none
+ * Records a response of device. Any response, including a modbus exception,
+ * means that device is reachable.
+ * @return 	true : if device was down and is up now,
+ * 			false : otherwise
  */
-void CRequestInitiator::insertTxIDReqData(unsigned short token, CRefDataForPolling &objRefData, bool a_bIsRT)
+bool CDeviceRequestQueue::recordSuccess()
 {
-	if(true  == a_bIsRT)
-	{
-		// This is RT request. Use RT-related structures
-		/// Ensure that only on thread can execute at a time
-		std::lock_guard<std::mutex> lock(m_mutextTxIDMapRT);
-
-		// insert the data in request map
-		m_mapTxIDReqDataRT.emplace(token, objRefData);
-	}
-	else
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_u32ConsecutiveTimeouts = 0;
+	if(false == m_bIsDown)
 	{
-		// This is Non-RT request. Use Non-RT-related structures
-		/// Ensure that only on thread can execute at a time
-		std::lock_guard<std::mutex> lock(m_mutextTxIDMap);
-
-		// insert the data in request map
-		m_mapTxIDReqData.emplace(token, objRefData);
+		return false;
 	}
+	m_bIsDown = false;
+	m_u32BackoffMs = 0;
+	return true;
 }
 
 /**
- * Removes entry from the map once data is posted on ZMQ for polling.
- * @param tokenId :[in] remove entry with given token id
- * @param a_bIsRT :[in] indicates whether it is a RT request
- * @return none
+ * Checks if a request can be sent to device. A device which is up can always
+ * be polled. A down device is polled by one probe request once its backoff
+ * interval is over; next probe is due after one more backoff interval.
+ * @param a_tsNow	:[in] current time
+ * @return 	true : if request can be sent,
+ * 			false : otherwise
  */
-void CRequestInitiator::removeTxIDReqData(unsigned short tokenId, bool a_bIsRT)
+bool CDeviceRequestQueue::isPollAllowed(const struct timespec &a_tsNow)
 {
-	if(true == a_bIsRT)
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if(false == m_bIsDown)
 	{
-		// This is RT request. Use RT-related structures
-		/// Ensure that only one thread can execute at a time
-		std::lock_guard<std::mutex> lock(m_mutextTxIDMapRT);
-		m_mapTxIDReqDataRT.erase(tokenId);
+		return true;
 	}
-	else
+	if((a_tsNow.tv_sec < m_tsNextProbe.tv_sec) ||
+			((a_tsNow.tv_sec == m_tsNextProbe.tv_sec) && (a_tsNow.tv_nsec < m_tsNextProbe.tv_nsec)))
 	{
-		// This is Non-RT request. Use Non-RT-related structures
-		/// Ensure that only one thread can execute at a time
-		std::lock_guard<std::mutex> lock(m_mutextTxIDMap);
-		m_mapTxIDReqData.erase(tokenId);
+		return false;
 	}
+	// This is the probe. Guard against probe which never completes.
+	uint64_t u64NextProbeNs = ((uint64_t)a_tsNow.tv_sec * 1000000000ULL) + a_tsNow.tv_nsec + ((uint64_t)m_u32BackoffMs * 1000000ULL);
+	m_tsNextProbe.tv_sec = (time_t)(u64NextProbeNs / 1000000000ULL);
+	m_tsNextProbe.tv_nsec = (long)(u64NextProbeNs % 1000000000ULL);
+	return true;
+}
+
+/**
+ * Checks if device is down
+ * @return 	true : if device is down,
+ * 			false : otherwise
+ */
+bool CDeviceRequestQueue::isDown()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_bIsDown;
 }
 
 /**
@@ -2051,7 +3196,7 @@ void CRequestInitiator::removeTxIDReqData(unsigned short tokenId, bool a_bIsRT)
  * @param none
  * @return none
  */
-CTimeMapper::CTimeMapper()
+CTimeMapper::CTimeMapper() : m_oTimerWheel{TIMER_WHEEL_SLOTS}, m_u32TickMs{1}, m_u32StaggerStepMs{0}
 {
 }
 
@@ -2067,75 +3212,40 @@ void CTimeMapper::initTimerFunction()
 }
 
 /**
- * This function checks if for given timer-counter, is there any polling activity or
- * cutoff check needed. If yes, the function accordingly initiates a process to signal respective threads
- * If a polling has to be triggered for certain interval, the function sets next applicable trigger point
- * in terms of future counter-timer value.
- * @param a_uiMaxCounter:[in] Maximum counter used for timer tracking
- * @param a_uiCounter:[in] current counter value
+ * This function advances polling timer wheel by one tick and checks if there is
+ * any polling activity or cutoff check due on this tick. If yes, the function accordingly
+ * initiates a process to signal respective threads. Fired entries are scheduled again
+ * for their next period.
  * @param a_tsPollTime:[in] current polling timestamp
  * @return none
  */
-void CTimeMapper::checkTimer(const uint32_t &a_uiMaxCounter, uint32_t a_uiCounter, struct timespec& a_tsPollTime)
-{
-    try
-	{
-    	std::vector<StPollingTracker> listPollTracker;
-    	if(true == getPollingTrackerList(a_uiCounter, listPollTracker))
-    	{
-    		std::vector<std::reference_wrapper<CTimeRecord>> listPolledTimeRecords;
-    		listPolledTimeRecords.clear();
-    		struct StPollingInstance stPollRef;
-    		stPollRef.m_tsPollTime = a_tsPollTime;
-    		// list found for counter
-    		for(auto &pollInterval: listPollTracker)
-    		{
-    			CTimeRecord &a = pollInterval.m_objTimeRecord.get();
-				stPollRef.m_uiPollInterval = a.getInterval();
-				if(true == pollInterval.m_bIsPolling)
-				{
-					CRequestInitiator::instance().initiateMessages(stPollRef, a, true);
-					listPolledTimeRecords.push_back(a);
-				}
-				else
-				{
-					CRequestInitiator::instance().initiateMessages(stPollRef, a, false);
-				}
-    		}
-
-    		// set future counter-timer value for polled intervals
-    		for(auto &elememt: listPolledTimeRecords)
-    		{
-    			CTimeRecord &a = elememt.get();
-				// If it is polling interval, calculate next polling and cutoff intervals
-				uint32_t uiNextPolling = (a_uiCounter + a.getInterval());
-				uint32_t uiNextCutoff = (a_uiCounter + a.getCutoffInterval());
-				if((a_uiCounter == a_uiMaxCounter)
-						&& (a_uiMaxCounter == a.getInterval()))
-				{
-					uiNextPolling = a_uiMaxCounter;
-				}
-				if(uiNextPolling > a_uiMaxCounter)
-				{
-					uiNextPolling = uiNextPolling % a_uiMaxCounter;
-				}
-				if(uiNextCutoff > a_uiMaxCounter)
-				{
-					uiNextCutoff = uiNextCutoff % a_uiMaxCounter;
-				}
-				// set next polling interval
-				addToPollingTracker(uiNextPolling, a, true);
-				// set next cutoff interval
-				addToPollingTracker(uiNextCutoff, a, false);
-    		}
-
-    		listPolledTimeRecords.clear();
-    	}
-    	else
-    	{
-    		/// No polling is needed for counter
-    		DO_LOG_INFO("No polling for: " + std::to_string(a_uiCounter));
-    	}
+void CTimeMapper::checkTimer(struct timespec& a_tsPollTime)
+{
+	try
+	{
+		std::lock_guard<std::mutex> lock(m_wheelMutex);
+		StPollingTracker *pFired = m_oTimerWheel.advance();
+		if(NULL == pFired)
+		{
+			/// No polling is needed for this tick
+			return;
+		}
+
+		struct StPollingInstance stPollRef;
+		stPollRef.m_tsPollTime = a_tsPollTime;
+		while(NULL != pFired)
+		{
+			// entry is linked in another slot while scheduling, so take next one first
+			StPollingTracker *pNext = pFired->m_pNext;
+			CTimeRecord &a = pFired->m_objTimeRecord.get();
+			stPollRef.m_uiPollInterval = a.getInterval();
+			stPollRef.m_u32PhaseOffset = pFired->m_u32PhaseOffset;
+			CRequestInitiator::instance().initiateMessages(stPollRef, a, pFired->m_bIsPolling);
+
+			// set next polling or cutoff tick
+			m_oTimerWheel.schedule(*pFired, pFired->m_u64ExpiryTick + pFired->m_u32PeriodTicks);
+			pFired = pNext;
+		}
 	}
 	catch (std::exception &e)
 	{
@@ -2145,7 +3255,7 @@ void CTimeMapper::checkTimer(const uint32_t &a_uiMaxCounter, uint32_t a_uiCounte
 
 /**
  * Initializes data structure to send request for polling.
- * Adds a point in a map for request-response matching in future.
+ * TxID is already claimed for the point for request-response matching.
  * @param a_stRdPrdObj:	[in] request to send
  * @param m_u16TxId	:	[in] TxID
  * @param isRTRequest: 	[in] RT/Non-Rt
@@ -2179,10 +3289,6 @@ bool CRequestInitiator::sendRequest(CRefDataForPolling &a_stRdPrdObj,
 		stMbusApiPram.m_nRetry = a_nRetry;
 
 
-#ifdef UNIT_TEST
-		stMbusApiPram.m_u16TxId = 5;
-#endif
-		CRequestInitiator::instance().insertTxIDReqData(stMbusApiPram.m_u16TxId, a_stRdPrdObj, isRTRequest);
 #ifdef MODBUS_STACK_TCPIP_ENABLED
 		u8ReturnType = Modbus_Stack_API_Call(a_stRdPrdObj.getFunctionCode(), &stMbusApiPram, a_ptrCallbackFunc);
 #else
@@ -2216,7 +3322,7 @@ bool CRequestInitiator::sendRequest(CRefDataForPolling &a_stRdPrdObj,
  */
 CTimeRecord::CTimeRecord(uint32_t a_u32Interval, CRefDataForPolling &a_oPoint)
 	: m_u32Interval(a_u32Interval), m_u32CutoffInterval(a_u32Interval),
-	  m_bIsRTAvailable(false), m_bIsNonRTAvailable(false)
+	  m_vPhaseOffsets(1, 0), m_bIsRTAvailable(false), m_bIsNonRTAvailable(false)
 {
 	DO_LOG_INFO("getCutoffIntervalPercentage " + std::to_string(PublishJsonHandler::instance().getCutoffIntervalPercentage()));
 	m_u32CutoffInterval.store(a_u32Interval *
@@ -2274,6 +3380,130 @@ bool CTimeMapper::insert(uint32_t a_uTime, CRefDataForPolling &a_oPointD)
 	return bRet;
 }
 
+/**
+ * Groups points of all polling intervals into polling blocks.
+ * This needs to be called once all points are inserted.
+ * @param a_i32MaxGap	:[in] max number of unused registers/coils allowed between
+ * 							two points of a block. Negative value disables grouping.
+ * @return 	number : number of polling blocks formed
+ */
+uint32_t CTimeMapper::buildPollingBlocks(int32_t a_i32MaxGap)
+{
+	uint32_t uiBlockCount = 0;
+	if(0 > a_i32MaxGap)
+	{
+		DO_LOG_INFO("Polling blocks are disabled. Each point is polled using separate request");
+		return uiBlockCount;
+	}
+	try
+	{
+		std::lock_guard<std::mutex> lock(m_mapMutex);
+		for(auto &itr : m_mapTimeRecord)
+		{
+			uiBlockCount += itr.second.buildPollingBlocks(a_i32MaxGap);
+		}
+	}
+	catch (std::exception &e)
+	{
+		DO_LOG_FATAL(e.what());
+	}
+	return uiBlockCount;
+}
+
+/**
+ * Spreads points of all polling intervals across their interval using phase offsets.
+ * This needs to be called once polling blocks are formed.
+ * @param a_u32StepMs	:[in] step in ms of phase offsets. 0 disables staggering.
+ * @return 	number : total number of polling phases
+ */
+uint32_t CTimeMapper::buildPollingPhases(uint32_t a_u32StepMs)
+{
+	uint32_t uiPhaseCount = 0;
+	try
+	{
+		std::lock_guard<std::mutex> lock(m_mapMutex);
+		m_u32StaggerStepMs = a_u32StepMs;
+		for(auto &itr : m_mapTimeRecord)
+		{
+			uiPhaseCount += itr.second.buildPollingPhases(a_u32StepMs);
+		}
+	}
+	catch (std::exception &e)
+	{
+		DO_LOG_FATAL(e.what());
+	}
+	return uiPhaseCount;
+}
+
+/**
+ * Forms one request queue per device and assigns it to all points of the device,
+ * across all polling intervals, so that in-flight requests of a device can be limited.
+ * @return 	number : number of device queues formed
+ */
+uint32_t CTimeMapper::buildDeviceQueues()
+{
+	std::map<std::string, std::shared_ptr<CDeviceRequestQueue>> mapDeviceQueues;
+	try
+	{
+		auto assignQueue = [&mapDeviceQueues](std::vector<CRefDataForPolling> &a_vPoints)
+		{
+			for(auto &objPoint : a_vPoints)
+			{
+				const CUniqueDataPoint &objUniquePoint = objPoint.getDataPoint();
+				std::string sDeviceKey = objUniquePoint.getWellSite().getID() + SEPARATOR_CHAR + objUniquePoint.getWellSiteDev().getID();
+				std::shared_ptr<CDeviceRequestQueue> &pDeviceQueue = mapDeviceQueues[sDeviceKey];
+				if(NULL == pDeviceQueue)
+				{
+					pDeviceQueue = std::make_shared<CDeviceRequestQueue>(sDeviceKey);
+				}
+				objPoint.setDeviceQueue(pDeviceQueue);
+			}
+		};
+
+		std::lock_guard<std::mutex> lock(m_mapMutex);
+		for(auto &itr : m_mapTimeRecord)
+		{
+			assignQueue(itr.second.getPolledPointList());
+			assignQueue(itr.second.getPolledPointListRT());
+		}
+	}
+	catch (std::exception &e)
+	{
+		DO_LOG_FATAL(e.what());
+	}
+	return (uint32_t)mapDeviceQueues.size();
+}
+
+/**
+ * Gets all polled points, RT as well as Non-RT. Points are not moved once
+ * polling lists are built, hence pointers stay valid.
+ * @param a_vPoints	:[out] polled points
+ * @return number of polled points
+ */
+uint32_t CTimeMapper::getPolledPoints(std::vector<CRefDataForPolling*> &a_vPoints)
+{
+	try
+	{
+		std::lock_guard<std::mutex> lock(m_mapMutex);
+		for(auto &itr : m_mapTimeRecord)
+		{
+			for(auto &objPoint : itr.second.getPolledPointList())
+			{
+				a_vPoints.push_back(&objPoint);
+			}
+			for(auto &objPoint : itr.second.getPolledPointListRT())
+			{
+				a_vPoints.push_back(&objPoint);
+			}
+		}
+	}
+	catch (std::exception &e)
+	{
+		DO_LOG_FATAL(e.what());
+	}
+	return (uint32_t)a_vPoints.size();
+}
+
 /**
  * Destructor: Deinit data, i.e. TimeRecord map
  *
@@ -2377,6 +3607,11 @@ uint32_t CTimeMapper::getMinTimerFrequency()
 	{
 		DO_LOG_FATAL(e.what());
 	}
+	// Phase offsets are multiples of stagger step, timer should tick on those too
+	if(0 != m_u32StaggerStepMs)
+	{
+		ulMinFreq = gcd(m_u32StaggerStepMs, ulMinFreq);
+	}
 	DO_LOG_DEBUG("Minimum frequency: " + std::to_string(ulMinFreq));
 	return ulMinFreq;
 }
@@ -2412,14 +3647,216 @@ bool CTimeRecord::add(CRefDataForPolling &a_oPoint)
 	}
 	catch (std::exception &e)
 	{
-		string tempw = " Exception in CTimeRecord:";
-		tempw.append(e.what());
-		tempw.append(", Point: ");
-		tempw.append(a_oPoint.getDataPoint().getID());
-		DO_LOG_FATAL(tempw);
-		bRet = false;
+		string tempw = " Exception in CTimeRecord:";
+		tempw.append(e.what());
+		tempw.append(", Point: ");
+		tempw.append(a_oPoint.getDataPoint().getID());
+		DO_LOG_FATAL(tempw);
+		bRet = false;
+	}
+	return bRet;
+}
+
+/**
+ * Compares points for grouping them in polling blocks.
+ * Points are ordered by context, unit id, function code and start address.
+ * @param a_oPt1	:[in] first point
+ * @param a_oPt2	:[in] second point
+ * @return 	true : if first point is to be placed before second point
+ * 			false : otherwise
+ */
+static bool comparePollingBlockOrder(std::reference_wrapper<CRefDataForPolling> a_oPt1,
+		std::reference_wrapper<CRefDataForPolling> a_oPt2)
+{
+	const MbusAPI_t &stReq1 = a_oPt1.get().getMBusReq();
+	const MbusAPI_t &stReq2 = a_oPt2.get().getMBusReq();
+	return std::make_tuple(stReq1.m_i32Ctx, stReq1.m_u8DevId, a_oPt1.get().getFunctionCode(), stReq1.m_u16StartAddr, stReq1.m_u16Quantity)
+			< std::make_tuple(stReq2.m_i32Ctx, stReq2.m_u8DevId, a_oPt2.get().getFunctionCode(), stReq2.m_u16StartAddr, stReq2.m_u16Quantity);
+}
+
+/**
+ * Groups points of given list into polling blocks. First point of a block
+ * (lowest address) leads the block and its request covers all points of the block.
+ * @param a_vPoints		:[in] list of points to be grouped
+ * @param a_i32MaxGap	:[in] max number of unused registers/coils allowed between two points
+ * @return 	number : number of polling blocks having more than one point
+ */
+static uint32_t formPollingBlocks(std::vector<CRefDataForPolling> &a_vPoints, int32_t a_i32MaxGap)
+{
+	std::vector<std::reference_wrapper<CRefDataForPolling>> vSortedPoints(a_vPoints.begin(), a_vPoints.end());
+	std::sort(vSortedPoints.begin(), vSortedPoints.end(), comparePollingBlockOrder);
+
+	uint32_t uiBlockCount = 0;
+	CRefDataForPolling *pBlockLeader = NULL;
+	for(auto &refPoint : vSortedPoints)
+	{
+		if((NULL != pBlockLeader) && (true == pBlockLeader->canAddToBlock(refPoint.get(), a_i32MaxGap)))
+		{
+			if(false == pBlockLeader->isBlockLeader())
+			{
+				++uiBlockCount;
+			}
+			pBlockLeader->addToBlock(refPoint.get());
+			continue;
+		}
+		// Point cannot be added to current block. Start a new block.
+		pBlockLeader = &(refPoint.get());
+	}
+	return uiBlockCount;
+}
+
+/**
+ * Groups RT and Non-RT points of this polling interval into polling blocks.
+ * Points are grouped if these are from same device, use same function code and
+ * together do not exceed the maximum size of a Modbus read request.
+ * @param a_i32MaxGap	:[in] max number of unused registers/coils allowed between two points
+ * @return 	number : number of polling blocks having more than one point
+ */
+uint32_t CTimeRecord::buildPollingBlocks(int32_t a_i32MaxGap)
+{
+	uint32_t uiBlockCount = 0;
+	try
+	{
+		std::lock_guard<std::mutex> lock(m_vectorMutex);
+		uiBlockCount += formPollingBlocks(m_vPolledPoints, a_i32MaxGap);
+		uiBlockCount += formPollingBlocks(m_vPolledPointsRT, a_i32MaxGap);
+		DO_LOG_INFO("Interval: " + std::to_string(m_u32Interval) + ", polling blocks: " + std::to_string(uiBlockCount));
+	}
+	catch (std::exception &e)
+	{
+		DO_LOG_FATAL(e.what());
+	}
+	return uiBlockCount;
+}
+
+/**
+ * Assigns phase offsets to points of a polling list. Requests of a device are spread
+ * evenly across the interval starting from an offset derived from device ID, so that
+ * offsets are same across restarts and devices do not start in the same phase.
+ * Points of a polling block use phase offset of the block leader.
+ * @param a_vPoints		:[in] list of points of a polling interval
+ * @param a_u32Interval	:[in] polling interval in ms
+ * @param a_u32StepMs	:[in] step in ms of phase offsets
+ * @param a_setOffsets	:[out] phase offsets which are used
+ * @return 	none
+ */
+static void assignPhaseOffsets(std::vector<CRefDataForPolling> &a_vPoints, uint32_t a_u32Interval,
+		uint32_t a_u32StepMs, std::set<uint32_t> &a_setOffsets)
+{
+	uint32_t u32Phases = a_u32Interval / a_u32StepMs;
+
+	// Requests of every device in the order of polling list
+	std::map<std::string, std::vector<std::reference_wrapper<CRefDataForPolling>>> mapDevReqs;
+	for(auto &objPoint : a_vPoints)
+	{
+		if(false == objPoint.isBlockMember())
+		{
+			const CUniqueDataPoint &objUniquePoint = objPoint.getDataPoint();
+			mapDevReqs[objUniquePoint.getWellSite().getID() + SEPARATOR_CHAR + objUniquePoint.getWellSiteDev().getID()].push_back(objPoint);
+		}
+	}
+
+	for(auto &itr : mapDevReqs)
+	{
+		uint32_t u32BasePhase = (uint32_t)(std::hash<std::string>{}(itr.first) % u32Phases);
+		uint32_t u32ReqCount = (uint32_t)itr.second.size();
+		for(uint32_t u32Index = 0; u32Index < u32ReqCount; ++u32Index)
+		{
+			uint32_t u32Phase = (u32BasePhase + (uint32_t)(((uint64_t)u32Index * u32Phases) / u32ReqCount)) % u32Phases;
+			uint32_t u32Offset = u32Phase * a_u32StepMs;
+
+			CRefDataForPolling &objReq = itr.second[u32Index].get();
+			objReq.setPhaseOffset(u32Offset);
+			for(auto &refMember : objReq.getBlockPoints())
+			{
+				refMember.get().setPhaseOffset(u32Offset);
+			}
+			a_setOffsets.insert(u32Offset);
+		}
+	}
+}
+
+/**
+ * Spreads RT and Non-RT points of this polling interval across the interval.
+ * This needs to be called after polling blocks are formed.
+ * @param a_u32StepMs	:[in] step in ms of phase offsets, 0 disables staggering
+ * @return 	number : number of phases of this interval
+ */
+uint32_t CTimeRecord::buildPollingPhases(uint32_t a_u32StepMs)
+{
+	try
+	{
+		std::lock_guard<std::mutex> lock(m_vectorMutex);
+		if((0 == a_u32StepMs) || (m_u32Interval / a_u32StepMs) <= 1)
+		{
+			// All points are polled together
+			m_vPhaseOffsets.assign(1, 0);
+			return (uint32_t)m_vPhaseOffsets.size();
+		}
+
+		std::set<uint32_t> setOffsets;
+		assignPhaseOffsets(m_vPolledPoints, m_u32Interval, a_u32StepMs, setOffsets);
+		assignPhaseOffsets(m_vPolledPointsRT, m_u32Interval, a_u32StepMs, setOffsets);
+		if(setOffsets.empty())
+		{
+			setOffsets.insert(0);
+		}
+		m_vPhaseOffsets.assign(setOffsets.begin(), setOffsets.end());
+		DO_LOG_INFO("Interval: " + std::to_string(m_u32Interval) + ", polling phases: " + std::to_string(m_vPhaseOffsets.size()));
+	}
+	catch (std::exception &e)
+	{
+		DO_LOG_FATAL(e.what());
+	}
+	return (uint32_t)m_vPhaseOffsets.size();
+}
+
+/**
+ * Groups RT and Non-RT points of this polling interval as per their phase
+ * offset, so that a phase visits only its own points.
+ * This needs to be called after polling phases are formed.
+ * @return 	number : number of phases having points
+ */
+uint32_t CTimeRecord::buildPhasePoints()
+{
+	try
+	{
+		std::lock_guard<std::mutex> lock(m_vectorMutex);
+		auto fnBuild = [](const std::vector<CRefDataForPolling> &a_vPoints,
+				std::map<uint32_t, std::vector<uint32_t>> &a_mapPhasePoints)
+		{
+			a_mapPhasePoints.clear();
+			for(uint32_t u32Index = 0; u32Index < (uint32_t)a_vPoints.size(); ++u32Index)
+			{
+				a_mapPhasePoints[a_vPoints[u32Index].getPhaseOffset()].push_back(u32Index);
+			}
+		};
+		fnBuild(m_vPolledPoints, m_mapPhasePoints);
+		fnBuild(m_vPolledPointsRT, m_mapPhasePointsRT);
+	}
+	catch (std::exception &e)
+	{
+		DO_LOG_FATAL(e.what());
+	}
+	return (uint32_t)std::max(m_mapPhasePoints.size(), m_mapPhasePointsRT.size());
+}
+
+/**
+ * Gets points of given phase of this polling interval
+ * @param a_u32PhaseOffset	:[in] phase offset in ms
+ * @param a_bIsRT			:[in] RT or Non-RT points(true or false)
+ * @return 	index, in polled point list, of points of the phase. Empty if phase has no point.
+ */
+const std::vector<uint32_t>& CTimeRecord::getPhasePoints(uint32_t a_u32PhaseOffset, bool a_bIsRT)
+{
+	static const std::vector<uint32_t> vNoPoints;
+	const std::map<uint32_t, std::vector<uint32_t>> &mapPhasePoints = a_bIsRT ? m_mapPhasePointsRT : m_mapPhasePoints;
+	auto itr = mapPhasePoints.find(a_u32PhaseOffset);
+	if(mapPhasePoints.end() == itr)
+	{
+		return vNoPoints;
 	}
-	return bRet;
+	return itr->second;
 }
 
 /**
@@ -2441,109 +3878,176 @@ CTimeRecord::~CTimeRecord()
 }
 
 /**
- * Prepares time tracker data for polling operation.
- * Sets first timer-counter value for given polling intervals.
- * @param none
- * @return 	Maximum polling interval
+ * Prepares timer wheel for polling operation.
+ * For every phase of polling interval, one entry is added for polling and one for cutoff.
+ * First polling is done after one polling interval plus phase offset and cutoff follows it
+ * after cutoff interval.
+ * @param a_u32TickMs	:[in] duration of one timer tick in milliseconds
+ * @return 	number of entries added to timer wheel
  */
-uint32_t CTimeMapper::preparePollingTracker()
+uint32_t CTimeMapper::preparePollingTracker(uint32_t a_u32TickMs)
 {
-	// This function prepares a tracker list for polling and returns maximum polling interval.
-	uint32_t ulMaxPollInterval = 0;
+	uint32_t uiEntryCount = 0;
 	try
 	{
+		clearPollingTracker();
+		{
+			std::lock_guard<std::mutex> lock(m_wheelMutex);
+			m_u32TickMs = (0 == a_u32TickMs) ? 1 : a_u32TickMs;
+		}
+
 		std::lock_guard<std::mutex> lock(m_mapMutex);
 		for(auto &it: m_mapTimeRecord)
 		{
-			ulMaxPollInterval = it.first;
-
-			// set polling interval
-			addToPollingTracker(ulMaxPollInterval, it.second, true);
+			CTimeRecord &objTimeRecord = it.second;
+			// each wheel entry handles points of its own phase only
+			objTimeRecord.buildPhasePoints();
+			for(uint32_t u32PhaseOffset : objTimeRecord.getPhaseOffsets())
+			{
+				// set polling interval
+				addToPollingTracker(objTimeRecord, true, objTimeRecord.getInterval() + u32PhaseOffset, u32PhaseOffset);
+				// set cutoff interval. It follows polling of same phase.
+				addToPollingTracker(objTimeRecord, false,
+						objTimeRecord.getInterval() + u32PhaseOffset + objTimeRecord.getCutoffInterval(), u32PhaseOffset);
+				uiEntryCount += 2;
+			}
 		}
 	}
 	catch (std::exception &e)
 	{
 		DO_LOG_FATAL(e.what());
 	}
-	DO_LOG_DEBUG("Maximum poll interval: " + std::to_string(ulMaxPollInterval));
-	return ulMaxPollInterval;
-}
-
-/**
- * Compares 2 polling intervals. Used to sort the list to ensure lower polling interval
- * occurs first.
- * @param i1: [in] argument 1: Polling interval 1
- * @param i2: [in] argument 2: Polling interval 2
- * @return 	true if 1st argument is smaller that 2nd argument
- */
-bool compareInterval(StPollingTracker i1, StPollingTracker i2)
-{
-    return (i1.m_uiPollInterval < i2.m_uiPollInterval);
+	DO_LOG_DEBUG("Number of timer wheel entries: " + std::to_string(uiEntryCount));
+	return uiEntryCount;
 }
 
 /**
- * Adds given reference data of polling interval to the tracker for timer-counter
- * @param a_uiCounter: Timer-counter against which data needs to be added
- * @param a_objTimeRecord: Reference of TimeRecord object corresponding to teh polling interval
+ * Adds given polling interval to timer wheel. Entry fires first after given time
+ * and thereafter after every polling interval. Time which is not a multiple of
+ * timer tick is rounded up to next tick.
+ * @param a_objTimeRecord: Reference of TimeRecord object corresponding to the polling interval
  * @param a_bIsPolling: True: Polling interval, False: Cutoff Interval
+ * @param a_u32FirstDueMs: Time in milliseconds, from start of timer, of first firing
+ * @param a_u32PhaseOffset: Phase offset of points handled by this entry
  * @return 	none
  */
-void CTimeMapper::addToPollingTracker(uint32_t a_uiCounter, CTimeRecord &a_objTimeRecord, bool a_bIsPolling)
+void CTimeMapper::addToPollingTracker(CTimeRecord &a_objTimeRecord, bool a_bIsPolling, uint32_t a_u32FirstDueMs, uint32_t a_u32PhaseOffset)
 {
-	// This function adds given reference data to polling interval to the tracker
 	try
 	{
-		struct StPollingTracker stTemp{a_objTimeRecord.getInterval(), a_objTimeRecord, a_bIsPolling};
-		auto itr = m_mapPollingTracker.find(a_uiCounter);
-		if(itr == m_mapPollingTracker.end())
-		{
-			std::vector<StPollingTracker> listTemp;
-			listTemp.push_back(stTemp);
-			m_mapPollingTracker.insert(
-				std::pair<uint32_t, std::vector<StPollingTracker>> (a_uiCounter, listTemp));
-		}
-		else
+		std::lock_guard<std::mutex> lock(m_wheelMutex);
+		m_lstPollingTracker.emplace_back(a_objTimeRecord.getInterval(), a_objTimeRecord, a_bIsPolling);
+		StPollingTracker &stEntry = m_lstPollingTracker.back();
+		stEntry.m_u32PhaseOffset = a_u32PhaseOffset;
+
+		stEntry.m_u32PeriodTicks = (a_objTimeRecord.getInterval() + m_u32TickMs - 1) / m_u32TickMs;
+		if(0 == stEntry.m_u32PeriodTicks)
 		{
-			auto &list = itr->second;
-			list.push_back(stTemp);
-			std::sort(list.begin(), list.end(), compareInterval);
+			stEntry.m_u32PeriodTicks = 1;
 		}
+		uint64_t u64FirstTick = m_oTimerWheel.getCurrentTick() + (a_u32FirstDueMs + m_u32TickMs - 1) / m_u32TickMs;
+		m_oTimerWheel.schedule(stEntry, u64FirstTick);
 	}
 	catch (std::exception &e)
 	{
 		DO_LOG_FATAL(e.what());
 	}
-	return ;
 }
 
 /**
- * Extracts list of polling intervals corresponding to given timer-counter
- * @param a_uiCounter: Timer-counter for which data needs to be extracted
- * @param a_listPollInterval: Out parameter: List of polling intervals
- * @return 	true: if data is available
- * 			false: no data is available
+ * Removes all entries from timer wheel
+ * @param none
+ * @return 	none
  */
-bool CTimeMapper::getPollingTrackerList(uint32_t a_uiCounter, std::vector<StPollingTracker> &a_listPollInterval)
+void CTimeMapper::clearPollingTracker()
 {
-	try
+	std::lock_guard<std::mutex> lock(m_wheelMutex);
+	m_oTimerWheel.clear();
+	m_lstPollingTracker.clear();
+}
+
+/**
+ * Constructor: Creates timer wheel with given number of slots
+ * @param a_u32SlotCount	:[in] number of slots, rounded up to power of 2
+ */
+CTimerWheel::CTimerWheel(uint32_t a_u32SlotCount) : m_u64CurTick{0}, m_u32SlotMask{0}
+{
+	uint32_t u32Slots = 1;
+	while(u32Slots < a_u32SlotCount)
 	{
-		auto itr = m_mapPollingTracker.find(a_uiCounter);
-		if(itr != m_mapPollingTracker.end())
-		{
-			a_listPollInterval = itr->second;
-			itr->second.clear();
-			return true;
-		}
+		u32Slots <<= 1;
 	}
-	catch (std::exception &e)
+	m_vSlots.assign(u32Slots, NULL);
+	m_u32SlotMask = u32Slots - 1;
+}
+
+/**
+ * Schedules an entry to fire at given tick. Tick which is already passed
+ * is moved to next tick.
+ * @param a_oEntry			:[in] entry to schedule. It should not be already scheduled.
+ * @param a_u64ExpiryTick	:[in] tick at which entry should fire
+ * @return none
+ */
+void CTimerWheel::schedule(StPollingTracker &a_oEntry, uint64_t a_u64ExpiryTick)
+{
+	if(a_u64ExpiryTick <= m_u64CurTick)
 	{
-		DO_LOG_FATAL(e.what());
+		a_u64ExpiryTick = m_u64CurTick + 1;
 	}
-	return false;
+	a_oEntry.m_u64ExpiryTick = a_u64ExpiryTick;
+
+	StPollingTracker *&pHead = m_vSlots[a_u64ExpiryTick & m_u32SlotMask];
+	a_oEntry.m_pNext = pHead;
+	pHead = &a_oEntry;
+}
+
+/**
+ * Advances the wheel by one tick and unlinks entries expiring on the new tick.
+ * Unlinked entries are ordered by polling interval so that lower interval is handled first.
+ * @param none
+ * @return 	list of expired entries linked using m_pNext, NULL if no entry expired
+ */
+StPollingTracker* CTimerWheel::advance()
+{
+	++m_u64CurTick;
+	StPollingTracker **ppLink = &m_vSlots[m_u64CurTick & m_u32SlotMask];
+	StPollingTracker *pFired = NULL;
+
+	while(NULL != *ppLink)
+	{
+		StPollingTracker *pEntry = *ppLink;
+		if(pEntry->m_u64ExpiryTick != m_u64CurTick)
+		{
+			// entry is due in later round of wheel
+			ppLink = &pEntry->m_pNext;
+			continue;
+		}
+		*ppLink = pEntry->m_pNext;
+
+		// insert in fired list as per polling interval
+		StPollingTracker **ppPos = &pFired;
+		while((NULL != *ppPos) && ((*ppPos)->m_uiPollInterval <= pEntry->m_uiPollInterval))
+		{
+			ppPos = &(*ppPos)->m_pNext;
+		}
+		pEntry->m_pNext = *ppPos;
+		*ppPos = pEntry;
+	}
+	return pFired;
+}
+
+/**
+ * Removes all entries from the wheel
+ * @param none
+ * @return none
+ */
+void CTimerWheel::clear()
+{
+	std::fill(m_vSlots.begin(), m_vSlots.end(), (StPollingTracker*)NULL);
 }
 
 /**
- * Function to track timer-counter for polling operations
+ * Function to tick polling timer wheel
  * @param : [in] interval in milliseconds: Minimum timer tick value
  * @return : none
  */
@@ -2558,21 +4062,13 @@ void PeriodicTimer::timerThread(uint32_t interval)
 
 	globalConfig::display_thread_sched_attr("timerThread param::");
 
-	uint32_t uiMaxCounter = CTimeMapper::instance().preparePollingTracker();
-	uint32_t uiCurCounter = 0;
-	DO_LOG_INFO("Maximum counter = " + std::to_string(uiMaxCounter))
-
-	// checking ounter value
-	if(0 == uiMaxCounter)
-	{
-		uiMaxCounter = 1;
-		DO_LOG_INFO("Maximum counter was 0. Now set as = " + std::to_string(uiMaxCounter));
-	}
 	// interval is in milliseconds
 	if(0 == interval)
 	{
 		interval = 1;
 	}
+	uint32_t uiEntryCount = CTimeMapper::instance().preparePollingTracker(interval);
+	DO_LOG_INFO("Timer tick = " + std::to_string(interval) + " ms, timer wheel entries = " + std::to_string(uiEntryCount));
 
 	struct timespec ts;
 	int rc = clock_getres(CLOCK_MONOTONIC, &ts);
@@ -2585,8 +4081,6 @@ void PeriodicTimer::timerThread(uint32_t interval)
 		DO_LOG_ERROR("Clock resolution: " + std::to_string((long)ts.tv_sec) + " seconds, " + std::to_string((long)ts.tv_nsec) + " nanoseconds");
 	}
 
-	uint32_t uiMsecInterval = interval;
-
 	// for following calculation, convert interval to nanoseconds
 	interval = interval*1000*1000;
 	rc = clock_gettime(CLOCK_MONOTONIC, &ts);
@@ -2615,15 +4109,8 @@ void PeriodicTimer::timerThread(uint32_t interval)
 				DO_LOG_FATAL("Fatal error: polling timer: clock_gettime failed in polling: " + std::to_string(errno) + "  " + strerror(errno));
 				//return;
 			}
-			uiCurCounter = uiCurCounter + uiMsecInterval;
 			/// call timer function
-			CTimeMapper::instance().checkTimer(uiMaxCounter, uiCurCounter, tsPoll);
-
-			// reset the counter
-			if(uiCurCounter == uiMaxCounter)
-			{
-				uiCurCounter = 0;
-			}
+			CTimeMapper::instance().checkTimer(tsPoll);
 		}
 		else
 		{
@@ -2660,10 +4147,16 @@ void PeriodicTimer::timer_stop(void)
  */
 CRefDataForPolling::CRefDataForPolling(const CRefDataForPolling &a_refPolling) :
 		m_objDataPoint{a_refPolling.m_objDataPoint}, m_uiFuncCode{a_refPolling.m_uiFuncCode}
+		, m_stValueDecoder{a_refPolling.m_stValueDecoder}
 		, m_bIsRespPosted{false}, m_bIsLastRespAvailable{false}
 		, m_stPollTsForReq{a_refPolling.m_stPollTsForReq}, m_stMBusReq{a_refPolling.m_stMBusReq}
 		, m_stRetryTs{0}, m_iReqRetriedCnt{0}
+		, m_vBlockPointOffset{a_refPolling.m_vBlockPointOffset}, m_bIsBlockMember{a_refPolling.m_bIsBlockMember}
+		, m_u32PhaseOffset{a_refPolling.m_u32PhaseOffset}
+		, m_pPublishTemplate{a_refPolling.m_pPublishTemplate}
+		, m_pDeviceQueue{a_refPolling.m_pDeviceQueue}, m_bIsReqPending{false}
 {
+	m_stReportState = {false, false, 0, {}, {0}, 0};
 	m_oLastGoodResponse.m_sValue = "";
 	m_oLastGoodResponse.m_sLastUsec = "";
 }
@@ -2676,11 +4169,18 @@ CRefDataForPolling::CRefDataForPolling(const CRefDataForPolling &a_refPolling) :
 CRefDataForPolling::CRefDataForPolling(const CUniqueDataPoint &a_objDataPoint, uint8_t a_uiFuncCode) :
 				m_objDataPoint{a_objDataPoint}, m_uiFuncCode{a_uiFuncCode}
 				, m_bIsRespPosted{false}, m_bIsLastRespAvailable{false}, m_stPollTsForReq{0}, m_stMBusReq{0}
-				, m_stRetryTs{0}, m_iReqRetriedCnt{0}
+				, m_stRetryTs{0}, m_iReqRetriedCnt{0}, m_bIsBlockMember{false}, m_u32PhaseOffset{0}
+				, m_bIsReqPending{false}
 {
+	m_stReportState = {false, false, 0, {}, {0}, 0};
 	m_oLastGoodResponse.m_sValue = "";
 	m_oLastGoodResponse.m_sLastUsec = "";
 
+	// Choose decoder for value of this point
+	const network_info::stDataPointAddress &stAddress = m_objDataPoint.getDataPoint().getAddress();
+	m_stValueDecoder = common_Handler::getValueDecoder(stAddress.m_sDataType, stAddress.m_iWidth,
+			stAddress.m_bIsByteSwap, stAddress.m_bIsWordSwap, stAddress.m_dScaleFactor);
+
 	// Pre-Build parameters of request structure for later use
 	m_stMBusReq.m_u16StartAddr = m_objDataPoint.getDataPoint().getAddress().m_iAddress;
 	m_stMBusReq.m_u16Quantity = m_objDataPoint.getDataPoint().getAddress().m_iWidth;
@@ -2703,24 +4203,256 @@ CRefDataForPolling::CRefDataForPolling(const CUniqueDataPoint &a_objDataPoint, u
 	m_stMBusReq.m_u8DevId = m_objDataPoint.getWellSiteDev().getAddressInfo().m_stRTU.m_uiSlaveId;
 #endif
 
+	// Invariant part of published message is prepared once
+	if(false == buildPublishTemplate())
+	{
+		DO_LOG_ERROR(m_objDataPoint.getID() + ": publish template is not available. Message will be prepared for every response.");
+	}
+}
+
+/**
+ * Builds publish template for this point. Template contains envelope having
+ * fields which do not change across responses of this point, i.e. version,
+ * data_topic, wellhead, metric, realtime, datatype and dataPersist.
+ * @param nothing
+ * @return 	true : on success,
+ * 			false : on error
+ */
+bool CRefDataForPolling::buildPublishTemplate()
+{
+	try
+	{
+		std::shared_ptr<stPublishTemplate> pTemplate = std::make_shared<stPublishTemplate>();
+		const network_info::CDataPoint &oDataPoint = m_objDataPoint.getDataPoint();
+
+		pTemplate->m_bIsRealTime = oDataPoint.getPollingConfig().m_bIsRealTime;
+		pTemplate->m_sDataTopic = m_objDataPoint.getID() + SEPARATOR_CHAR + PERIODIC_GENERIC_TOPIC;
+		pTemplate->m_sEmbTopic = CPeriodicReponseProcessor::Instance().mapMqttToEMBRespTopic(pTemplate->m_sDataTopic,
+				pTemplate->m_bIsRealTime, PublishJsonHandler::instance().getAppName());
+		pTemplate->m_sBatchTopic = PublishJsonHandler::instance().getAppName() + SEPARATOR_CHAR +
+				((true == pTemplate->m_bIsRealTime) ? "RT" : "NRT") + SEPARATOR_CHAR + PERIODIC_GENERIC_TOPIC;
+		pTemplate->m_sStatusDataTopic = SEPARATOR_CHAR + m_objDataPoint.getWellSiteDev().getID() + SEPARATOR_CHAR
+				+ m_objDataPoint.getWellSite().getID() + SEPARATOR_CHAR + PERIODIC_GENERIC_TOPIC;
+		pTemplate->m_sStatusEmbTopic = CPeriodicReponseProcessor::Instance().mapMqttToEMBRespTopic(pTemplate->m_sStatusDataTopic,
+				m_objDataPoint.getRTFlag(), PublishJsonHandler::instance().getAppName());
+
+		pTemplate->m_pMsg = msgbus_msg_envelope_new(CT_JSON);
+		if(NULL == pTemplate->m_pMsg)
+		{
+			DO_LOG_ERROR("Error: memory not allocated");
+			return false;
+		}
+
+		std::string sDataType{oDataPoint.getAddress().m_sDataType};
+		std::transform(sDataType.begin(), sDataType.end(), sDataType.begin(), ::tolower);
+
+		msgbus_msg_envelope_put(pTemplate->m_pMsg, "version", msgbus_msg_envelope_new_string("2.0"));
+		msgbus_msg_envelope_put(pTemplate->m_pMsg, "data_topic", msgbus_msg_envelope_new_string(pTemplate->m_sDataTopic.c_str()));
+		msgbus_msg_envelope_put(pTemplate->m_pMsg, "wellhead", msgbus_msg_envelope_new_string(m_objDataPoint.getWellSite().getID().c_str()));
+		msgbus_msg_envelope_put(pTemplate->m_pMsg, "metric", msgbus_msg_envelope_new_string(oDataPoint.getID().c_str()));
+		msgbus_msg_envelope_put(pTemplate->m_pMsg, "realtime", msgbus_msg_envelope_new_string(std::to_string(pTemplate->m_bIsRealTime).c_str()));
+		if(!sDataType.empty())
+		{
+			msgbus_msg_envelope_put(pTemplate->m_pMsg, "datatype", msgbus_msg_envelope_new_string(sDataType.c_str()));
+		}
+		msgbus_msg_envelope_put(pTemplate->m_pMsg, "dataPersist", msgbus_msg_envelope_new_bool(oDataPoint.getDataPersist()));
+
+		// invariant fields of binary update, point is identified by its roll ID
+		stPolledUpdate &stUpdate = pTemplate->m_stUpdate;
+		stUpdate.m_sDataTopic = pTemplate->m_sDataTopic;
+		stUpdate.m_u32PointId = m_objDataPoint.getMyRollID();
+		stUpdate.m_sWellhead = m_objDataPoint.getWellSite().getID();
+		stUpdate.m_sMetric = oDataPoint.getID();
+		stUpdate.m_sDataType = sDataType;
+		stUpdate.m_bIsRealTime = pTemplate->m_bIsRealTime;
+		stUpdate.m_bIsDataPersist = oDataPoint.getDataPersist();
+
+		m_pPublishTemplate = pTemplate;
+	}
+	catch(const std::exception& e)
+	{
+		DO_LOG_FATAL(e.what());
+		return false;
+	}
+	return true;
+}
+
+/**
+ * Gets scaled value as a number
+ * @param a_pScaledValue	:[in] scaled value
+ * @param a_dValue			:[out] numeric value
+ * @return 	true : if scaled value is numeric,
+ * 			false : otherwise
+ */
+static bool getNumericValue(const msg_envelope_elem_body_t* a_pScaledValue, double &a_dValue)
+{
+	if(NULL == a_pScaledValue)
+	{
+		return false;
+	}
+	switch(a_pScaledValue->type)
+	{
+	case MSG_ENV_DT_INT:
+		a_dValue = (double)a_pScaledValue->body.integer;
+		return true;
+	case MSG_ENV_DT_FLOATING:
+		a_dValue = a_pScaledValue->body.floating;
+		return true;
+	case MSG_ENV_DT_BOOLEAN:
+		a_dValue = (true == a_pScaledValue->body.boolean) ? 1 : 0;
+		return true;
+	default:
+		return false;
+	}
+}
+
+/**
+ * Checks if report-by-exception is configured for this point, i.e. deadband or heartbeat
+ * @return 	true : if configured,
+ * 			false : if every value is to be reported
+ */
+bool CRefDataForPolling::isReportByException() const
+{
+	const network_info::stDataPointAddress &stAddress = m_objDataPoint.getDataPoint().getAddress();
+	return (0 != stAddress.m_dDeadband) || (0 != stAddress.m_dDeadbandPercent) || (0 != stAddress.m_uiHeartbeatMs);
+}
+
+/**
+ * Checks if a good value needs to be reported. It is reported if it is first good
+ * value after start, after a bad response or after device of point was down, if heartbeat interval is over since
+ * last report, or if it differs from last reported value by more than the deadband.
+ * Deadband is larger of absolute deadband and percent deadband of last reported value.
+ * Non-numeric values are reported on any change.
+ * @param a_pScaledValue	:[in] scaled value
+ * @param a_vValue			:[in] value as received from device
+ * @return 	true : if value is to be reported,
+ * 			false : otherwise
+ */
+bool CRefDataForPolling::isReportRequired(const msg_envelope_elem_body_t* a_pScaledValue, const std::vector<uint8_t>& a_vValue)
+{
+	if(false == isReportByException())
+	{
+		return true;
+	}
+	const network_info::stDataPointAddress &stAddress = m_objDataPoint.getDataPoint().getAddress();
+
+	std::lock_guard<std::mutex> lock(m_mutexLastResp);
+	if(false == m_stReportState.m_bIsGoodReported)
+	{
+		return true;
+	}
+	// last report is stale if device was down since then
+	if((NULL != m_pDeviceQueue) && (m_pDeviceQueue->getDownCount() != m_stReportState.m_u32DownCount))
+	{
+		return true;
+	}
+
+	if(0 != stAddress.m_uiHeartbeatMs)
+	{
+		struct timespec tsNow;
+		timespec_get(&tsNow, TIME_UTC);
+		int64_t i64ElapsedMs = ((int64_t)tsNow.tv_sec - m_stReportState.m_tsReported.tv_sec) * 1000
+				+ (tsNow.tv_nsec - m_stReportState.m_tsReported.tv_nsec) / 1000000;
+		if(i64ElapsedMs >= (int64_t)stAddress.m_uiHeartbeatMs)
+		{
+			return true;
+		}
+	}
+
+	double dValue = 0;
+	if((false == m_stReportState.m_bIsNumeric) || (false == getNumericValue(a_pScaledValue, dValue)))
+	{
+		return (a_vValue != m_stReportState.m_vValue);
+	}
+	double dDeadband = std::max(stAddress.m_dDeadband, std::fabs(m_stReportState.m_dValue) * stAddress.m_dDeadbandPercent / 100);
+	return (std::fabs(dValue - m_stReportState.m_dValue) > dDeadband);
+}
+
+/**
+ * Records a published value as last reported value of point
+ * @param a_bIsGood			:[in] published value is good(true or false)
+ * @param a_pScaledValue	:[in] published scaled value
+ * @param a_vValue			:[in] published value as received from device
+ * @return none
+ */
+void CRefDataForPolling::setReported(bool a_bIsGood, const msg_envelope_elem_body_t* a_pScaledValue, const std::vector<uint8_t>& a_vValue)
+{
+	std::lock_guard<std::mutex> lock(m_mutexLastResp);
+	m_stReportState.m_bIsGoodReported = a_bIsGood;
+	if(true == a_bIsGood)
+	{
+		m_stReportState.m_bIsNumeric = getNumericValue(a_pScaledValue, m_stReportState.m_dValue);
+		m_stReportState.m_vValue = a_vValue;
+		timespec_get(&m_stReportState.m_tsReported, TIME_UTC);
+		m_stReportState.m_u32DownCount = (NULL != m_pDeviceQueue) ? m_pDeviceQueue->getDownCount() : 0;
+	}
 }
 
 /**
  * Saves last known good polling response data for given point
- * @param a_sValue	:[in] data value
+ * @param a_sValue	:[in] data value in hex string, if enabled
+ * @param a_vValue	:[in] data value as received from device
  * @param a_sUsec	:[in] associated timestamp
  * @return 	true : on success,
  * 			false : on error
  */
-bool CRefDataForPolling::saveGoodResponse(const std::string& a_sValue, const std::string& a_sUsec)
+bool CRefDataForPolling::saveGoodResponse(const std::string& a_sValue, const std::vector<uint8_t>& a_vValue, const std::string& a_sUsec)
 {
 	std::lock_guard<std::mutex> lock(m_mutexLastResp);
 	m_oLastGoodResponse.m_sValue = a_sValue;
+	m_oLastGoodResponse.m_vValue = a_vValue;
 	m_oLastGoodResponse.m_sLastUsec = a_sUsec;
+	timespec_get(&m_oLastGoodResponse.m_tsReceived, TIME_UTC);
 	m_bIsLastRespAvailable.store(true);
 	return true;
 }
 
+/**
+ * Marks last good response as received now if device again responded with the same value.
+ * It is used when response is not published, e.g. value is within deadband.
+ * @param a_vValue	:[in] data value as received from device
+ * @return none
+ */
+void CRefDataForPolling::refreshGoodResponse(const std::vector<uint8_t>& a_vValue)
+{
+	std::lock_guard<std::mutex> lock(m_mutexLastResp);
+	if(true == m_bIsLastRespAvailable.load() && a_vValue == m_oLastGoodResponse.m_vValue)
+	{
+		timespec_get(&m_oLastGoodResponse.m_tsReceived, TIME_UTC);
+	}
+}
+
+/**
+ * Gets last good response of point if it is received within given age.
+ * It is used to answer on-demand read of the point without sending request to device.
+ * @param a_u32MaxAgeMs	:[in] max age in ms of response, 0 means response is never fresh
+ * @param a_stResp		:[out] data is filled, if response is fresh
+ * @return 	true : if fresh response is available,
+ * 			false : otherwise
+ */
+bool CRefDataForPolling::getFreshResponse(uint32_t a_u32MaxAgeMs, stMbusAppCallbackParams_t &a_stResp)
+{
+	if(0 == a_u32MaxAgeMs || false == m_bIsLastRespAvailable.load())
+	{
+		return false;
+	}
+	struct timespec tsNow;
+	timespec_get(&tsNow, TIME_UTC);
+
+	std::lock_guard<std::mutex> lock(m_mutexLastResp);
+	const std::vector<uint8_t> &vValue = m_oLastGoodResponse.m_vValue;
+	int64_t i64AgeMs = ((int64_t)tsNow.tv_sec - m_oLastGoodResponse.m_tsReceived.tv_sec) * 1000
+			+ (tsNow.tv_nsec - m_oLastGoodResponse.m_tsReceived.tv_nsec) / 1000000;
+	if(i64AgeMs > (int64_t)a_u32MaxAgeMs || vValue.empty() ||
+			vValue.size() > sizeof(a_stResp.m_au8MbusRXDataDataFields))
+	{
+		return false;
+	}
+	memcpy(a_stResp.m_au8MbusRXDataDataFields, vValue.data(), vValue.size());
+	a_stResp.m_u8MbusRXDataLength = (uint8_t)vValue.size();
+	return true;
+}
+
 /**
  * Get last saved good response (if any) for given polling point
  * @param nothing
@@ -2751,4 +4483,158 @@ void CRefDataForPolling::setDataForNewReq(uint16_t a_uTxID, struct timespec& a_t
 	m_iReqRetriedCnt = 0;
 }
 
+/**
+ * Checks if given point can be polled using request of this point.
+ * Points are expected to be checked in increasing order of address.
+ * @param a_oPoint		:[in] point to be added to block led by this point
+ * @param a_i32MaxGap	:[in] max number of unused registers/coils allowed between two points
+ * @return 	true : if point can be added,
+ * 			false : otherwise
+ */
+bool CRefDataForPolling::canAddToBlock(const CRefDataForPolling &a_oPoint, int32_t a_i32MaxGap) const
+{
+	if((0 > a_i32MaxGap) || (true == m_bIsBlockMember) || (true == a_oPoint.m_bIsBlockMember) || (this == &a_oPoint))
+	{
+		return false;
+	}
+	// Points should belong to same device and should use same function code
+	if((m_uiFuncCode != a_oPoint.m_uiFuncCode) ||
+			(m_stMBusReq.m_i32Ctx != a_oPoint.m_stMBusReq.m_i32Ctx) ||
+			(m_stMBusReq.m_u8DevId != a_oPoint.m_stMBusReq.m_u8DevId))
+	{
+		return false;
+	}
+
+	uint32_t uiBlockStart = m_stMBusReq.m_u16StartAddr;
+	uint32_t uiBlockEnd = uiBlockStart + m_stMBusReq.m_u16Quantity;
+	uint32_t uiPointStart = a_oPoint.m_stMBusReq.m_u16StartAddr;
+	uint32_t uiPointEnd = uiPointStart + a_oPoint.m_stMBusReq.m_u16Quantity;
+	if((uiPointStart < uiBlockStart) || (uiPointStart > (uiBlockEnd + (uint32_t)a_i32MaxGap)))
+	{
+		return false;
+	}
+
+	// Check the size of resultant request
+	uint32_t uiMaxQuantity = MAX_REGISTERS_PER_READ_REQ;
+	if((READ_COIL_STATUS == m_uiFuncCode) || (READ_INPUT_STATUS == m_uiFuncCode))
+	{
+		uiMaxQuantity = MAX_COILS_PER_READ_REQ;
+	}
+	if((std::max(uiBlockEnd, uiPointEnd) - uiBlockStart) > uiMaxQuantity)
+	{
+		return false;
+	}
+	return true;
+}
+
+/**
+ * Adds given point to the block led by this point. Request of this point
+ * is extended to cover the given point. Given point shall be in the same
+ * polled point list as this point. Its position relative to this point is
+ * stored, which remains valid when the list is reallocated or copied.
+ * @param a_oPoint	:[in] point to be added to block led by this point
+ * @return 	true : on success,
+ * 			false : on error
+ */
+bool CRefDataForPolling::addToBlock(CRefDataForPolling &a_oPoint)
+{
+	uint32_t uiBlockEnd = m_stMBusReq.m_u16StartAddr + m_stMBusReq.m_u16Quantity;
+	uint32_t uiPointEnd = a_oPoint.m_stMBusReq.m_u16StartAddr + a_oPoint.m_stMBusReq.m_u16Quantity;
+	if(uiPointEnd > uiBlockEnd)
+	{
+		m_stMBusReq.m_u16Quantity = (uint16_t)(uiPointEnd - m_stMBusReq.m_u16StartAddr);
+	}
+
+	// Coil and discrete input are single bytes. All others are 2 byte registers
+	m_stMBusReq.m_u16ByteCount = m_stMBusReq.m_u16Quantity;
+	if((READ_COIL_STATUS != m_uiFuncCode) && (READ_INPUT_STATUS != m_uiFuncCode))
+	{
+		m_stMBusReq.m_u16ByteCount = m_stMBusReq.m_u16Quantity * 2;
+	}
+
+	a_oPoint.m_bIsBlockMember = true;
+	m_vBlockPointOffset.push_back(&a_oPoint - this);
+	return true;
+}
+
+/**
+ * Gets other points polled with request of this point
+ * @return list of points of block led by this point, empty if point is not a block leader
+ */
+std::vector<std::reference_wrapper<CRefDataForPolling>> CRefDataForPolling::getBlockPoints()
+{
+	std::vector<std::reference_wrapper<CRefDataForPolling>> vBlockPoints;
+	vBlockPoints.reserve(m_vBlockPointOffset.size());
+	for(std::ptrdiff_t iOffset : m_vBlockPointOffset)
+	{
+		vBlockPoints.push_back(std::ref(*(this + iOffset)));
+	}
+	return vBlockPoints;
+}
+
+/**
+ * Gets points for which request of this point is sent i.e. this point
+ * followed by other points of the block led by it
+ * @return list of points polled with request of this point
+ */
+std::vector<std::reference_wrapper<CRefDataForPolling>> CRefDataForPolling::getRequestPoints()
+{
+	std::vector<std::reference_wrapper<CRefDataForPolling>> vReqPoints{std::ref(*this)};
+	vReqPoints.reserve(1 + m_vBlockPointOffset.size());
+	for(std::ptrdiff_t iOffset : m_vBlockPointOffset)
+	{
+		vReqPoints.push_back(std::ref(*(this + iOffset)));
+	}
+	return vReqPoints;
+}
+
+/**
+ * Extracts value of this point from response data received for a polling block.
+ * Register values are copied as is. Coil and discrete input values are bit-packed
+ * and are re-packed starting from first bit as if the point was read alone.
+ * @param a_u16BlockStartAddr	:[in] start address of block request
+ * @param a_vBlockValue			:[in] data received for block request
+ * @param a_vPointValue			:[out] data for this point
+ * @return 	true : on success,
+ * 			false : if block data does not cover this point
+ */
+bool CRefDataForPolling::getValueFromBlock(uint16_t a_u16BlockStartAddr, const std::vector<uint8_t> &a_vBlockValue,
+		std::vector<uint8_t> &a_vPointValue) const
+{
+	a_vPointValue.clear();
+	uint32_t uiPointStart = m_objDataPoint.getDataPoint().getAddress().m_iAddress;
+	uint32_t uiWidth = m_objDataPoint.getDataPoint().getAddress().m_iWidth;
+	if((uiPointStart < a_u16BlockStartAddr) || (0 == uiWidth))
+	{
+		return false;
+	}
+	uint32_t uiOffset = uiPointStart - a_u16BlockStartAddr;
+
+	if((READ_COIL_STATUS == m_uiFuncCode) || (READ_INPUT_STATUS == m_uiFuncCode))
+	{
+		if(((uiOffset + uiWidth - 1) / 8) >= a_vBlockValue.size())
+		{
+			return false;
+		}
+		a_vPointValue.assign((uiWidth + 7) / 8, 0);
+		for(uint32_t uiBit = 0; uiBit < uiWidth; ++uiBit)
+		{
+			uint32_t uiSrcBit = uiOffset + uiBit;
+			if(a_vBlockValue[uiSrcBit / 8] & (1 << (uiSrcBit % 8)))
+			{
+				a_vPointValue[uiBit / 8] |= (uint8_t)(1 << (uiBit % 8));
+			}
+		}
+		return true;
+	}
 
+	// Each register is of 2 bytes
+	uiOffset = uiOffset * 2;
+	uint32_t uiLength = uiWidth * 2;
+	if((uiOffset + uiLength) > a_vBlockValue.size())
+	{
+		return false;
+	}
+	a_vPointValue.assign(a_vBlockValue.begin() + uiOffset, a_vBlockValue.begin() + uiOffset + uiLength);
+	return true;
+}
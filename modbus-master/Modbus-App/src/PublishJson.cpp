@@ -41,6 +41,16 @@ using namespace zmq_handler;
 PublishJsonHandler::PublishJsonHandler()
 {
 	u32CutoffIntervalPercentage = 0;
+	m_i32PollingBlockMaxGap = -1;
+	m_bIsHexValueEnabled = true;
+	m_bIsBinaryUpdateEnabled = false;
+	m_u32PollStaggerStepMs = 0;
+	m_u32MaxInFlightPerDevice = 0;
+	m_u32DeviceDownTimeoutCount = 0;
+	m_u32DeviceProbeMaxBackoffMs = DEVICE_PROBE_MAX_BACKOFF_MS;
+	m_u32WriteCoalesceWindowMs = 0;
+	m_u32OnDemandWorkerCount = 0;
+	m_u32ReadCacheMaxAgeMs = 0;
 }
 
 /**
@@ -55,7 +55,7 @@ extern void postMsgstoMQTT();
 extern void signalHandler(int signal);
 extern bool addSrTopic(std::string &json, std::string& topic);
 extern void postMsgsToEII(QMgr::CQueueMgr& qMgr);
-extern bool processMsg(msg_envelope_t *msg, CMQTTPublishHandler &mqttPublisher);
+extern bool processMsg(msg_envelope_t *msg, CMQTTPublishHandler &mqttPublisher, bool a_bIsRealTime = false);
 extern void processMsgToSendOnEII(CMessageObject &recvdMsg, const bool isRealtime);
 extern void getOperation(std::string topic, globalConfig::COperation& operation);
 
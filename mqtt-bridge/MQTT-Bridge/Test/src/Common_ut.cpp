@@ -75,3 +75,52 @@ TEST_F(Common_ut, addTimestampsToMsg_KeyAddedSuccessfully)
 	EXPECT_EQ(true, RetVal);
 
 }
+
+/**
+ * Test case to check if convertToEnvelope() reads realtime flag while converting payload
+ * and rejects payload which is not a JSON object
+ * @param :[in] None
+ * @param :[out] None
+ * @return None
+ */
+TEST_F(Common_ut, convertToEnvelope_RealtimeFlag)
+{
+	bool bIsRealtime = false;
+	std::string message = "{\"wellhead\": \"PL0\",\"command\": \"D1\",\"value\": \"0x00\",\"app_seq\": \"1234\",\"realtime\":\"1\"}";
+	msg_envelope_t *pMsg = CCommon::getInstance().convertToEnvelope(message, bIsRealtime, false);
+	ASSERT_NE((msg_envelope_t*)NULL, pMsg);
+	EXPECT_EQ(true, bIsRealtime);
+	EXPECT_EQ(true, CCommon::getInstance().addIngressFields(pMsg, "/flowmeter/PL0/D1/write", timespec{}));
+	msg_envelope_elem_body_t *pData = NULL;
+	EXPECT_EQ(MSG_SUCCESS, msgbus_msg_envelope_get(pMsg, "sourcetopic", &pData));
+	msgbus_msg_envelope_destroy(pMsg);
+
+	// default is used when realtime is not given
+	pMsg = CCommon::getInstance().convertToEnvelope("{\"command\": \"D1\"}", bIsRealtime, true);
+	ASSERT_NE((msg_envelope_t*)NULL, pMsg);
+	EXPECT_EQ(true, bIsRealtime);
+	msgbus_msg_envelope_destroy(pMsg);
+
+	EXPECT_EQ((msg_envelope_t*)NULL, CCommon::getInstance().convertToEnvelope("InvMsg", bIsRealtime, false));
+	EXPECT_EQ((msg_envelope_t*)NULL, CCommon::getInstance().convertToEnvelope("[{\"value\": 1}]", bIsRealtime, false));
+}
+
+/**
+ * Test case to check if appendJsonField() adds field at end of serialized JSON object
+ * @param :[in] None
+ * @param :[out] None
+ * @return None
+ */
+TEST_F(Common_ut, appendJsonField_SerializedJson)
+{
+	std::string sJson = "{\"data_topic\":\"/flowmeter/PL0/D1/update\"}";
+	EXPECT_EQ(true, CCommon::getInstance().appendJsonField(sJson, "tsMsgRcvdForProcessing", "1571887474111145"));
+	EXPECT_EQ("{\"data_topic\":\"/flowmeter/PL0/D1/update\",\"tsMsgRcvdForProcessing\":\"1571887474111145\"}", sJson);
+
+	std::string sEmpty = "{ }";
+	EXPECT_EQ(true, CCommon::getInstance().appendJsonField(sEmpty, "ts", "1"));
+	EXPECT_EQ("{ \"ts\":\"1\"}", sEmpty);
+
+	std::string sInvalid = "InvMsg";
+	EXPECT_EQ(false, CCommon::getInstance().appendJsonField(sInvalid, "ts", "1"));
+}
@@ -21,6 +21,7 @@
 *********************************************************************************/
 
 #include "../include/MQTTPublishHandler_ut.hpp"
+#include <cstdlib>
 
 void MQTTPublishHandler_ut::SetUp() {
 	// Setup code
@@ -65,3 +66,81 @@ TEST_F(MQTTPublishHandler_ut, createNPubMsg_ValidTopic_ValidMsg)
 	CMQTTPublishHandler mqttPublisher_ut("tcp://mqtt_test_container:11883", ValidTopic, 1);
 	EXPECT_EQ( true, mqttPublisher_ut.createNPubMsg(ValidMsg, ValidTopic) );
 }
+
+/**
+ * Test case to check that a topic is always mapped to same connection of publisher pool
+ * @param :[in] None
+ * @param :[out] None
+ * @return None
+ */
+TEST_F(MQTTPublishHandler_ut, publisherPool_TopicAffinity)
+{
+	CMQTTPublisherPool &publisherPool = CMQTTPublisherPool::instance();
+	uint32_t u32OldSize = publisherPool.getPoolSize();
+	uint32_t u32OldWindow = publisherPool.getInFlightWindow();
+	eMQTTPublishPolicy eOldPolicy = publisherPool.getPublishPolicy();
+	uint32_t u32OldMaxPending = publisherPool.getMaxPending();
+	stSpoolConfig stOldSpool = publisherPool.getSpoolConfig();
+
+	publisherPool.init(4, 100, eOldPolicy, u32OldMaxPending, stOldSpool);
+	size_t index = publisherPool.getConnectionIndex(ValidTopic);
+	EXPECT_EQ(index, publisherPool.getConnectionIndex(ValidTopic));
+	EXPECT_LT(index, (size_t)4);
+
+	publisherPool.init(u32OldSize, u32OldWindow, eOldPolicy, u32OldMaxPending, stOldSpool);
+}
+
+/**
+ * Test case to check that messages are spooled while broker is not connected
+ * and are loaded again by next publisher using same spool
+ * @param :[in] None
+ * @param :[out] None
+ * @return None
+ */
+TEST_F(MQTTPublishHandler_ut, createNPubMsg_SpoolWhenDisconnected)
+{
+	std::string sDir = "/tmp/mqtt_bridge_spool_ut";
+	std::string sCmd = "rm -rf " + sDir;
+	(void)system(sCmd.c_str());
+	stSpoolConfig stSpool{sDir, 4096, 4, 0};
+	{
+		// no broker listens on this port
+		CMQTTPublishHandler mqttPublisher_ut("tcp://127.0.0.1:1", "spool_ut", 1);
+		ASSERT_EQ( true, mqttPublisher_ut.enableSpool(sDir, stSpool) );
+		std::string sMsg1{ValidMsg}, sMsg2{ValidMsg};
+		EXPECT_EQ( true, mqttPublisher_ut.createNPubMsg(sMsg1, ValidTopic, true) );
+		EXPECT_EQ( true, mqttPublisher_ut.createNPubMsg(sMsg2, ValidTopic, false) );
+		EXPECT_EQ( (uint64_t)2, mqttPublisher_ut.getSpoolDepth() );
+	}
+
+	CMQTTPublishHandler mqttPublisher_ut("tcp://127.0.0.1:1", "spool_ut", 1);
+	ASSERT_EQ( true, mqttPublisher_ut.enableSpool(sDir, stSpool) );
+	EXPECT_EQ( (uint64_t)2, mqttPublisher_ut.getSpoolDepth() );
+	(void)system(sCmd.c_str());
+}
+
+/**
+ * Test case to check that spooled message stays in spool when it cannot be
+ * handed to MQTT client
+ * @param :[in] None
+ * @param :[out] None
+ * @return None
+ */
+TEST_F(MQTTPublishHandler_ut, publishSpooledMsg_NotConnected)
+{
+	std::string sDir = "/tmp/mqtt_bridge_spool_drain_ut";
+	std::string sCmd = "rm -rf " + sDir;
+	(void)system(sCmd.c_str());
+	stSpoolConfig stSpool{sDir, 4096, 4, 0};
+	{
+		// no broker listens on this port
+		CMQTTPublishHandler mqttPublisher_ut("tcp://127.0.0.1:1", "spool_drain_ut", 1);
+		ASSERT_EQ( true, mqttPublisher_ut.enableSpool(sDir, stSpool) );
+		std::string sMsg{ValidMsg};
+		EXPECT_EQ( true, mqttPublisher_ut.createNPubMsg(sMsg, ValidTopic, true) );
+		EXPECT_EQ( false, mqttPublisher_ut.publishSpooledMsg(true) );
+		EXPECT_EQ( false, mqttPublisher_ut.publishSpooledMsg(false) );
+		EXPECT_EQ( (uint64_t)1, mqttPublisher_ut.getSpoolDepth() );
+	}
+	(void)system(sCmd.c_str());
+}
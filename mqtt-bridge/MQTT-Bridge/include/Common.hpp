@@ -28,6 +28,10 @@
 
 #include <string>
 #include <vector>
+#include "eii/msgbus/msgbus.h"
+
+/** bytes reserved in MQTT payload for time stamps appended while bridging*/
+#define TS_FIELDS_RESERVE 128
 
 /**
  * class CCommon that manages common environment variables & timestamp for msg payload
@@ -51,6 +55,10 @@ public:
 	bool addTimestampsToMsg(std::string &a_sMsg, std::string tsKey, std::string strTimestamp);
 	void getCurrentTimestampsInString(std::string &a_sMsg);
 
+	msg_envelope_t* convertToEnvelope(const std::string &a_sJson, bool &a_bIsRealtime, const bool a_bIsDefault);
+	bool addIngressFields(msg_envelope_t *a_pMsg, const std::string &a_sTopic, struct timespec a_tsRcvd);
+	bool appendJsonField(std::string &a_sJson, const char *a_pszKey, const std::string &a_sValue);
+
 	/**
 	 * Get single instance of this class
 	 * @param None
@@ -28,17 +28,133 @@
 #define MQTT_PUBLISH_HANDLER_HPP_
 
 #include "MQTTPubSubClient.hpp"
+#include "MqttSpool.hpp"
+#include <map>
+#include <memory>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <condition_variable>
+
+/** default size of spool segment file, 4 MiB*/
+#define DEFAULT_SPOOL_SEGMENT_SIZE (4 * 1024 * 1024)
+/** default max segment files per spool*/
+#define DEFAULT_SPOOL_MAX_SEGMENTS 64
+/** default max messages per second published from spool*/
+#define DEFAULT_SPOOL_DRAIN_RATE 1000
+/** default max messages per connection waiting for room in in-flight window*/
+#define DEFAULT_PUBLISH_MAX_PENDING 1000
+/** max publisher connections per QoS*/
+#define MAX_PUBLISHER_POOL_SIZE 256
+/** max in-flight window of a connection, paho client keeps it as int*/
+#define MAX_PUBLISH_INFLIGHT_WINDOW 65535
+/** max messages per connection waiting for room in in-flight window*/
+#define MAX_PUBLISH_MAX_PENDING 1000000
+/** min and max size of spool segment file, 64 KiB to 1 GiB*/
+#define MIN_SPOOL_SEGMENT_SIZE (64 * 1024)
+#define MAX_SPOOL_SEGMENT_SIZE (1024 * 1024 * 1024)
+/** max segment files per spool*/
+#define MAX_SPOOL_MAX_SEGMENTS 100000
+/** max messages per second published from spool*/
+#define MAX_SPOOL_DRAIN_RATE 1000000
+
+/** Configuration of spool which keeps messages while broker cannot take them*/
+struct stSpoolConfig
+{
+	std::string m_sDir; /** base directory of spools, empty means spool is disabled*/
+	uint32_t m_u32SegmentSize; /** size of a segment file in bytes*/
+	uint32_t m_u32MaxSegments; /** max segment files per spool*/
+	uint32_t m_u32DrainRate; /** max messages per second published from spool, 0 means no limit*/
+};
 
 /**
  * CMQTTPublishHandler class manages instance that handles Publish message on MQTT broker
  */
 class CMQTTPublishHandler : public CMQTTBaseHandler
 {
+	uint32_t m_u32InFlightWindow; /** max messages waiting for acknowledgement, 0 means no limit*/
+	eMQTTPublishPolicy m_ePolicy; /** what happens to message when in-flight window is full*/
+
+	CMqttSpool m_oRTSpool; /** spool of RT messages, drained before non-RT spool*/
+	CMqttSpool m_oNRTSpool; /** spool of non-RT messages*/
+	uint32_t m_u32DrainRate; /** max messages per second published from spool, 0 means no limit*/
+	std::atomic<bool> m_bIsDrainStop; /** drain thread is to stop(true or false)*/
+	std::thread m_threadDrain; /** thread publishing spooled messages*/
+	std::mutex m_mutexDrain; /** mutex for drain wait*/
+	std::condition_variable m_cvDrain; /** signals drain thread about connection or spooled message*/
+	std::atomic<uint64_t> m_u64DrainRate; /** messages per second published from spool in last interval*/
+
+	void drainSpool();
+	void logSpoolStats(uint64_t &a_u64LastDrained, std::chrono::steady_clock::time_point &a_tpLastLog);
+
 public:
-	CMQTTPublishHandler(std::string strPlBusUrl, std::string strClientID, int iQOS);
+	CMQTTPublishHandler(std::string strPlBusUrl, std::string strClientID, int iQOS, uint32_t a_u32InFlightWindow = 0,
+			eMQTTPublishPolicy a_ePolicy = enPUBLISH_POLICY_BLOCK, uint32_t a_u32MaxPending = DEFAULT_PUBLISH_MAX_PENDING);
 	~CMQTTPublishHandler();
 
-	bool createNPubMsg(std::string &a_sMsg, std::string &a_sTopic);
+	void connected(const std::string &a_sCause) override;
+
+	bool enableSpool(const std::string &a_sDir, const stSpoolConfig &a_stConfig);
+
+	/** checks if messages are spooled when broker cannot take them*/
+	bool isSpoolEnabled() {return m_oNRTSpool.isOpen();}
+
+	/** returns number of messages waiting in spools*/
+	uint64_t getSpoolDepth() {return m_oRTSpool.getDepth() + m_oNRTSpool.getDepth();}
+
+	bool publishSpooledMsg(bool a_bIsRealTime);
+
+	/** returns messages per second published from spools in last interval*/
+	uint64_t getSpoolDrainRate() {return m_u64DrainRate.load();}
+
+	/** returns policy used when in-flight window is full*/
+	eMQTTPublishPolicy getPublishPolicy() {return m_ePolicy;}
+
+	bool createNPubMsg(std::string &a_sMsg, std::string &a_sTopic, bool a_bIsRealTime = false);
+};
+
+/**
+ * CMQTTPublisherPool class manages fixed number of MQTT publisher connections
+ * shared by all EII listener threads. A topic is always published from same
+ * connection, which keeps order of messages of a topic.
+ */
+class CMQTTPublisherPool
+{
+	std::mutex m_mutexPool; /** mutex for publisher connections*/
+	std::mutex m_mutexCreate; /** serializes creation of publisher connections*/
+	std::map<int, std::vector<std::unique_ptr<CMQTTPublishHandler>>> m_mapPublishers; /** connections per QoS, created on first use*/
+	uint32_t m_u32PoolSize; /** connections per QoS, 0 means a connection per topic*/
+	uint32_t m_u32InFlightWindow; /** max messages waiting for acknowledgement per connection*/
+	eMQTTPublishPolicy m_ePolicy; /** what happens to message when in-flight window is full*/
+	uint32_t m_u32MaxPending; /** max messages per connection waiting for room in in-flight window*/
+	stSpoolConfig m_stSpoolConfig; /** spool configuration of connections*/
+
+	CMQTTPublisherPool();
+	CMQTTPublishHandler* findPublisher(const std::string &a_sTopic, int a_iQOS);
+	// delete copy and move constructors and assign operators
+	CMQTTPublisherPool(const CMQTTPublisherPool&) = delete;	 			// Copy construct
+	CMQTTPublisherPool& operator=(const CMQTTPublisherPool&) = delete;	// Copy assign
+
+public:
+	static CMQTTPublisherPool& instance();
+
+	void init(uint32_t a_u32PoolSize, uint32_t a_u32InFlightWindow, eMQTTPublishPolicy a_ePolicy,
+			uint32_t a_u32MaxPending, const stSpoolConfig &a_stSpoolConfig);
+	void initFromEnv();
+
+	uint32_t getPoolSize() {return m_u32PoolSize;}
+	uint32_t getInFlightWindow() {return m_u32InFlightWindow;}
+	eMQTTPublishPolicy getPublishPolicy() {return m_ePolicy;}
+	uint32_t getMaxPending() {return m_u32MaxPending;}
+	const stSpoolConfig& getSpoolConfig() {return m_stSpoolConfig;}
+
+	bool enableSpool(CMQTTPublishHandler &a_rPublisher, const std::string &a_sClientID);
+
+	CMQTTPublishHandler* createPublisher(const std::string &a_sUrl, const std::string &a_sClientID, int a_iQOS);
+
+	size_t getConnectionIndex(const std::string &a_sTopic);
+
+	CMQTTPublishHandler& getPublisher(const std::string &a_sTopic, int a_iQOS);
 };
 
 #endif
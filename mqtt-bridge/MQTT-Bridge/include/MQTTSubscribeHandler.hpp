@@ -53,8 +53,6 @@ class CMQTTHandler : public CMQTTBaseHandler
 	void handleConnSuccessThread();
 	void signalIntMQTTConnDoneThread();
 
-	bool parseMQTTMsg(const std::string &sJson, bool &isRealtime, const bool bIsDefault);
-
 	bool pushMsgInQ(mqtt::const_message_ptr& msg);
 
 public:
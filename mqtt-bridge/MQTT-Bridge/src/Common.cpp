@@ -24,7 +24,9 @@
 #include "Common.hpp"
 #include <cjson/cJSON.h>
 #include <algorithm>
+#include <cstring>
 #include "EnvironmentVarHandler.hpp"
+#include "JsonEnvelope.hpp"
 
 /**
  * Constructor initializes CCommon instance and retrieves common environment variables
@@ -161,3 +163,102 @@ bool CCommon::addTimestampsToMsg(std::string &a_sMsg, std::string tsKey, std::st
 		return false;
 	}
 }
+
+/**
+ * Converts JSON payload received from MQTT into EII message envelope. Payload
+ * is converted in one pass without building JSON document, "realtime" flag is
+ * then read from envelope.
+ * @param a_sJson 		:[in] JSON payload received from MQTT
+ * @param a_bIsRealtime	:[out] is it a message for real-time operation
+ * @param a_bIsDefault	:[in] default RT value, used if payload does not have "realtime" as "0" or "1"
+ * @return envelope on success, caller owns and destroys it;
+ * 			NULL on error
+ */
+msg_envelope_t* CCommon::convertToEnvelope(const std::string &a_sJson, bool &a_bIsRealtime, const bool a_bIsDefault)
+{
+	// converter reuses its buffers, hence one converter per thread
+	static thread_local CJsonToEnvelope oConverter;
+
+	a_bIsRealtime = a_bIsDefault;
+	msg_envelope_t *msg = oConverter.convert(a_sJson);
+	if(NULL == msg)
+	{
+		DO_LOG_ERROR("Message received from MQTT could not be parsed in json format");
+		return NULL;
+	}
+
+	msg_envelope_elem_body_t *pRealtime = NULL;
+	if((MSG_SUCCESS == msgbus_msg_envelope_get(msg, "realtime", &pRealtime)) &&
+		(NULL != pRealtime) && (MSG_ENV_DT_STRING == pRealtime->type) && (NULL != pRealtime->body.string))
+	{
+		if(0 == strcmp(pRealtime->body.string, "0"))
+		{
+			a_bIsRealtime = false;
+		}
+		else if(0 == strcmp(pRealtime->body.string, "1"))
+		{
+			a_bIsRealtime = true;
+		}
+	}
+	return msg;
+}
+
+/**
+ * Adds fields describing reception from MQTT in message to be published on EII
+ * @param a_pMsg 		:[in] message envelope in which to add fields
+ * @param a_sTopic		:[in] MQTT topic on which message is received
+ * @param a_tsRcvd		:[in] time at which message is received from MQTT
+ * @return true/false based on success/failure
+ */
+bool CCommon::addIngressFields(msg_envelope_t *a_pMsg, const std::string &a_sTopic, struct timespec a_tsRcvd)
+{
+	if(NULL == a_pMsg)
+	{
+		return false;
+	}
+
+	msg_envelope_elem_body_t *ptTime = msgbus_msg_envelope_new_string(std::to_string(get_micros(a_tsRcvd)).c_str());
+	if(NULL == ptTime)
+	{
+		return false;
+	}
+	msgbus_msg_envelope_put(a_pMsg, "tsMsgRcvdFromMQTT", ptTime);
+
+	msg_envelope_elem_body_t *ptTopic = msgbus_msg_envelope_new_string(a_sTopic.c_str());
+	if(NULL == ptTopic)
+	{
+		return false;
+	}
+	msgbus_msg_envelope_put(a_pMsg, "sourcetopic", ptTopic);
+	return true;
+}
+
+/**
+ * Appends string field to serialized JSON object without parsing it. Value is
+ * not escaped, hence it is to be used for values like time stamps only.
+ * @param a_sJson	:[in/out] serialized JSON object
+ * @param a_pszKey	:[in] key of field
+ * @param a_sValue	:[in] value of field
+ * @return true/false based on success/failure
+ */
+bool CCommon::appendJsonField(std::string &a_sJson, const char *a_pszKey, const std::string &a_sValue)
+{
+	// remove } bracket to add new key value pair to existing json
+	size_t pos = a_sJson.find_last_of('}');
+	if(std::string::npos == pos)
+	{
+		return false;
+	}
+	a_sJson.resize(pos);
+	size_t last = a_sJson.find_last_not_of(" \t\r\n");
+	if(std::string::npos == last)
+	{
+		return false;
+	}
+	if('{' != a_sJson[last])
+	{
+		a_sJson.push_back(',');
+	}
+	a_sJson.append("\"").append(a_pszKey).append("\":\"").append(a_sValue).append("\"}");
+	return true;
+}
@@ -24,20 +24,43 @@
 #include "cjson/cJSON.h"
 #include "Common.hpp"
 #include "ConfigManager.hpp"
+#include "EnvironmentVarHandler.hpp"
+#include "YamlUtil.hpp"
+#include <functional>
+#include <algorithm>
+
+/** time for which publisher waits for in-flight window before checking stop*/
+#define INFLIGHT_WAIT_MS 1000
+/** time for which drain thread waits for connection or spooled message before checking stop*/
+#define SPOOL_DRAIN_IDLE_MS 1000
+/** interval at which spool depth and drain rate are logged while spool is in use*/
+#define SPOOL_STATS_INTERVAL_SEC 10
+
+extern std::atomic<bool> g_shouldStop;
 
 /**
  * Constructor Initializes MQTT publisher
  * @param strPlBusUrl :[in] MQTT broker URL
  * @param strClientID :[in] client ID with which to subscribe (this is topic name)
  * @param iQOS :[in] QOS value with which publisher will publish messages
+ * @param a_u32InFlightWindow :[in] max messages waiting for acknowledgement, 0 means no limit
+ * @param a_ePolicy :[in] what happens to message when in-flight window is full, spool policy
+ * 					is in effect only after spool is enabled, block is used till then
+ * @param a_u32MaxPending :[in] max messages waiting for room in in-flight window
  * @return None
  */
-CMQTTPublishHandler::CMQTTPublishHandler(std::string strPlBusUrl, std::string strClientID, int iQOS):
+CMQTTPublishHandler::CMQTTPublishHandler(std::string strPlBusUrl, std::string strClientID, int iQOS, uint32_t a_u32InFlightWindow,
+		eMQTTPublishPolicy a_ePolicy, uint32_t a_u32MaxPending):
 	CMQTTBaseHandler(strPlBusUrl, strClientID, iQOS, (false == CcommonEnvManager::Instance().getDevMode()),
-        "/run/secrets/rootca/cacert.pem", "/run/secrets/mymqttcerts/mymqttcerts_client_certificate.pem", "/run/secrets/mymqttcerts/mymqttcerts_client_key.pem", "MQTTSubListener")
+        "/run/secrets/rootca/cacert.pem", "/run/secrets/mymqttcerts/mymqttcerts_client_certificate.pem", "/run/secrets/mymqttcerts/mymqttcerts_client_key.pem", "MQTTSubListener"),
+	m_u32InFlightWindow{a_u32InFlightWindow}, m_ePolicy{a_ePolicy}, m_u32DrainRate{0}, m_bIsDrainStop{false}, m_u64DrainRate{0}
 {
 	try
 	{
+		if(0 != m_u32InFlightWindow)
+		{
+			setPublishWindow(m_u32InFlightWindow, a_u32MaxPending);
+		}
 		connect();
 		DO_LOG_DEBUG("MQTT initialized successfully. QOS to be used: " + std::to_string(m_QOS));
 	}
@@ -48,13 +71,147 @@ CMQTTPublishHandler::CMQTTPublishHandler(std::string strPlBusUrl, std::string st
 }
 
 /**
- * Publish message on MQTT broker
- * @param a_sMsg :[in] message to publish
+ * Opens RT and non-RT spools of this connection and starts thread which
+ * publishes spooled messages once broker is connected. Messages are spooled
+ * from now on when in-flight window is full.
+ * @param a_sDir :[in] directory of spools of this connection
+ * @param a_stConfig :[in] spool configuration
+ * @return true/false based on success/failure
+ */
+bool CMQTTPublishHandler::enableSpool(const std::string &a_sDir, const stSpoolConfig &a_stConfig)
+{
+	if(true == isSpoolEnabled())
+	{
+		return true;
+	}
+	if((false == m_oRTSpool.open(a_sDir, "RT", a_stConfig.m_u32SegmentSize, a_stConfig.m_u32MaxSegments)) ||
+			(false == m_oNRTSpool.open(a_sDir, "NRT", a_stConfig.m_u32SegmentSize, a_stConfig.m_u32MaxSegments)))
+	{
+		DO_LOG_ERROR("Spool could not be opened in " + a_sDir + ". Messages are not spooled.");
+		m_oRTSpool.close();
+		m_oNRTSpool.close();
+		return false;
+	}
+	m_u32DrainRate = a_stConfig.m_u32DrainRate;
+	m_ePolicy = enPUBLISH_POLICY_SPOOL;
+	m_threadDrain = std::thread(&CMQTTPublishHandler::drainSpool, this);
+	DO_LOG_INFO("Spool enabled in " + a_sDir + ", spooled messages: " + std::to_string(getSpoolDepth()));
+	return true;
+}
+
+/**
+ * This is a callback function which gets called when publisher is connected
+ * with MQTT broker. It wakes up drain thread.
+ * @param a_sCause :[in] reason for connect
+ * @return None
+ */
+void CMQTTPublishHandler::connected(const std::string &a_sCause)
+{
+	DO_LOG_DEBUG(a_sCause);
+	m_cvDrain.notify_all();
+}
+
+/**
+ * Logs spool depth and drain rate, once per interval
+ * @param a_u64LastDrained :[in,out] messages drained till last log
+ * @param a_tpLastLog :[in,out] time of last log
+ * @return None
+ */
+void CMQTTPublishHandler::logSpoolStats(uint64_t &a_u64LastDrained, std::chrono::steady_clock::time_point &a_tpLastLog)
+{
+	auto tpNow = std::chrono::steady_clock::now();
+	auto i64Sec = std::chrono::duration_cast<std::chrono::seconds>(tpNow - a_tpLastLog).count();
+	if(SPOOL_STATS_INTERVAL_SEC > i64Sec)
+	{
+		return;
+	}
+	uint64_t u64Drained = m_oRTSpool.getDrainedCount() + m_oNRTSpool.getDrainedCount();
+	m_u64DrainRate.store((u64Drained - a_u64LastDrained) / (uint64_t)i64Sec);
+	if((0 != getSpoolDepth()) || (u64Drained != a_u64LastDrained))
+	{
+		DO_LOG_INFO("Spool depth RT: " + std::to_string(m_oRTSpool.getDepth()) +
+				", NRT: " + std::to_string(m_oNRTSpool.getDepth()) +
+				", drain rate: " + std::to_string(m_u64DrainRate.load()) + " msg/s" +
+				", dropped: " + std::to_string(m_oRTSpool.getDroppedCount() + m_oNRTSpool.getDroppedCount()));
+	}
+	a_u64LastDrained = u64Drained;
+	a_tpLastLog = tpNow;
+}
+
+/**
+ * Publishes oldest message of a spool through publish window. Message is removed
+ * from spool only after MQTT client takes it, else it stays in spool to be tried again.
+ * @param a_bIsRealTime :[in] RT or non-RT spool(true or false)
+ * @return true/false based on whether message is published or not
+ */
+bool CMQTTPublishHandler::publishSpooledMsg(bool a_bIsRealTime)
+{
+	CMqttSpool &oSpool = (true == a_bIsRealTime) ? m_oRTSpool : m_oNRTSpool;
+	std::string sTopic, sMsg;
+	if((false == oSpool.front(sTopic, sMsg)) ||
+			(false == publishMsgWindowed(sMsg, sTopic, enPUBLISH_POLICY_SPOOL, 0)))
+	{
+		return false;
+	}
+	return oSpool.pop();
+}
+
+/**
+ * Thread function to publish spooled messages once broker is connected.
+ * RT messages are published before non-RT messages, each spool in order of
+ * arrival. Message is removed from spool only after it is handed to MQTT client.
+ * @param None
+ * @return None
+ */
+void CMQTTPublishHandler::drainSpool()
+{
+	uint64_t u64LastDrained = 0;
+	auto tpLastLog = std::chrono::steady_clock::now();
+	// gap between messages to keep drain rate under limit
+	std::chrono::microseconds gap((0 == m_u32DrainRate) ? 0 : (1000000 / m_u32DrainRate));
+
+	while(false == m_bIsDrainStop.load())
+	{
+		try
+		{
+			logSpoolStats(u64LastDrained, tpLastLog);
+			bool bIsRealTime = (0 != m_oRTSpool.getDepth());
+			if((false == isConnected()) || ((false == bIsRealTime) && (0 == m_oNRTSpool.getDepth())))
+			{
+				std::unique_lock<std::mutex> lock(m_mutexDrain);
+				m_cvDrain.wait_for(lock, std::chrono::milliseconds(SPOOL_DRAIN_IDLE_MS));
+				continue;
+			}
+			if(false == waitForPublishWindow(INFLIGHT_WAIT_MS))
+			{
+				continue;
+			}
+			// connection may be lost while waiting for window, message then stays in spool
+			publishSpooledMsg(bIsRealTime);
+			if(0 != gap.count())
+			{
+				std::this_thread::sleep_for(gap);
+			}
+		}
+		catch (const std::exception &e)
+		{
+			DO_LOG_ERROR(e.what());
+		}
+	}
+}
+
+/**
+ * Publish message on MQTT broker. If spool is enabled, message is spooled
+ * when broker is not connected, when in-flight window is full or when
+ * earlier messages of same class are still in spool. Otherwise message is
+ * published through in-flight window, and waits for room in window or drops
+ * oldest waiting message as per publish policy.
+ * @param a_sMsg :[in] message to publish, its buffer is moved into MQTT message
  * @param a_sTopic :[in] topic on which to publish message
- * @param a_tsMsgRcvd :[in] time stamp to add while publishing
+ * @param a_bIsRealTime :[in] RT or non-RT message(true or false), RT messages are drained first from spool
  * @return true/false based on success/failure
  */
-bool CMQTTPublishHandler::createNPubMsg(std::string &a_sMsg, std::string &a_sTopic)
+bool CMQTTPublishHandler::createNPubMsg(std::string &a_sMsg, std::string &a_sTopic, bool a_bIsRealTime)
 {
 	try
 	{
@@ -76,20 +233,58 @@ bool CMQTTPublishHandler::createNPubMsg(std::string &a_sMsg, std::string &a_sTop
 		timespec_get(&tsMsgPublish, TIME_UTC);
 		std::string strTsPublish = std::to_string(CCommon::getInstance().get_micros(tsMsgPublish));
 
-		// remove } bracket to add new key value pair to existing json
-		a_sMsg.pop_back();
-
-		std::string msgWithTimeStamp =  a_sMsg + ","+ "\"tsMsgReadyForPublish\"" + ":" + "\"" + strTsPublish + "\"" + "}";
+		if(false == CCommon::getInstance().appendJsonField(a_sMsg, "tsMsgReadyForPublish", strTsPublish))
+		{
+			DO_LOG_ERROR("Message is not a JSON object. No action for topic: " + a_sTopic);
+			return false;
+		}
 
 		//publish data to MQTT
 #ifdef INSTRUMENTATION_LOG
 		DO_LOG_DEBUG("ZMQ Message: Time: "
 				+ std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count())
-		+ ", Msg: " + msgWithTimeStamp);
+		+ ", Msg: " + a_sMsg);
 #endif
 
-		publishMsg(msgWithTimeStamp, a_sTopic);
-		return true;
+		if((enPUBLISH_POLICY_SPOOL == m_ePolicy) && (true == isSpoolEnabled()))
+		{
+			CMqttSpool &oSpool = (true == a_bIsRealTime) ? m_oRTSpool : m_oNRTSpool;
+			// once messages are spooled, following messages are also spooled till
+			// spool is drained, which keeps order of messages
+			if((0 != oSpool.getDepth()) ||
+					(false == publishMsgWindowed(a_sMsg, a_sTopic, enPUBLISH_POLICY_SPOOL, 0)))
+			{
+				bool bRet = oSpool.append(a_sTopic, a_sMsg);
+				m_cvDrain.notify_all();
+				return bRet;
+			}
+			return true;
+		}
+
+		if(0 == m_u32InFlightWindow)
+		{
+			// message buffer is moved into MQTT message
+			publishMsg(std::move(a_sMsg), a_sTopic);
+			return true;
+		}
+
+		// back-pressure: message is published without waiting for its acknowledgement,
+		// block policy waits only when broker has not acknowledged a full window
+		// and pending messages are at max
+		eMQTTPublishPolicy ePolicy = (enPUBLISH_POLICY_DROP_OLDEST == m_ePolicy) ? m_ePolicy : enPUBLISH_POLICY_BLOCK;
+		uint64_t u64Dropped = getDroppedCount();
+		bool bRet = false;
+		while((false == (bRet = publishMsgWindowed(a_sMsg, a_sTopic, ePolicy, INFLIGHT_WAIT_MS))) &&
+				(enPUBLISH_POLICY_BLOCK == ePolicy) && (false == g_shouldStop.load()))
+		{
+			DO_LOG_WARN("In-flight window is full, waiting to publish on topic: " + a_sTopic);
+		}
+		if(u64Dropped != getDroppedCount())
+		{
+			DO_LOG_WARN("In-flight window is full, oldest pending message is dropped. Dropped messages: " +
+					std::to_string(getDroppedCount()));
+		}
+		return bRet;
 	}
 	catch (const std::exception &exc)
 	{
@@ -103,4 +298,212 @@ bool CMQTTPublishHandler::createNPubMsg(std::string &a_sMsg, std::string &a_sTop
  */
 CMQTTPublishHandler::~CMQTTPublishHandler()
 {
+	m_bIsDrainStop.store(true);
+	m_cvDrain.notify_all();
+	if(true == m_threadDrain.joinable())
+	{
+		m_threadDrain.join();
+	}
+}
+
+/**
+ * Constructor
+ */
+CMQTTPublisherPool::CMQTTPublisherPool() : m_u32PoolSize{0}, m_u32InFlightWindow{0},
+	m_ePolicy{enPUBLISH_POLICY_BLOCK}, m_u32MaxPending{DEFAULT_PUBLISH_MAX_PENDING}, m_stSpoolConfig{"", 0, 0, 0}
+{
+}
+
+/**
+ * Maintain single instance of this class
+ * @param None
+ * @return Reference of this instance of this class
+ */
+CMQTTPublisherPool& CMQTTPublisherPool::instance()
+{
+	static CMQTTPublisherPool _self;
+	return _self;
+}
+
+/**
+ * Sets size of pool, to be called before any publisher is taken from pool
+ * @param a_u32PoolSize :[in] connections per QoS, 0 means a connection per topic
+ * @param a_u32InFlightWindow :[in] max messages waiting for acknowledgement per connection, 0 means no limit
+ * @param a_ePolicy :[in] what happens to message when in-flight window is full
+ * @param a_u32MaxPending :[in] max messages per connection waiting for room in in-flight window
+ * @param a_stSpoolConfig :[in] spool configuration of connections, empty directory means no spool
+ * @return None
+ */
+void CMQTTPublisherPool::init(uint32_t a_u32PoolSize, uint32_t a_u32InFlightWindow, eMQTTPublishPolicy a_ePolicy,
+		uint32_t a_u32MaxPending, const stSpoolConfig &a_stSpoolConfig)
+{
+	std::lock_guard<std::mutex> lock(m_mutexPool);
+	m_u32PoolSize = a_u32PoolSize;
+	m_u32InFlightWindow = a_u32InFlightWindow;
+	m_ePolicy = a_ePolicy;
+	m_u32MaxPending = a_u32MaxPending;
+	m_stSpoolConfig = a_stSpoolConfig;
+}
+
+/**
+ * Sets pool, in-flight window, publish policy and spool configuration from
+ * environment variables. Variable which is not set or is out of range keeps
+ * its default value. To be called before any publisher is taken from pool.
+ * @param None
+ * @return None
+ */
+void CMQTTPublisherPool::initFromEnv()
+{
+	// MQTT publisher connections shared by EII listeners, 0 means a connection per topic
+	uint32_t u32PoolSize = 0;
+	uint32_t u32InFlightWindow = 0;
+	CommonUtils::readEnvVariable("MQTT_PUBLISHER_POOL_SIZE", 0, MAX_PUBLISHER_POOL_SIZE, u32PoolSize);
+	CommonUtils::readEnvVariable("MQTT_PUBLISH_INFLIGHT_WINDOW", 0, MAX_PUBLISH_INFLIGHT_WINDOW, u32InFlightWindow);
+	DO_LOG_INFO("MQTT publisher pool size: " + std::to_string(u32PoolSize) +
+			", in-flight window: " + std::to_string(u32InFlightWindow));
+
+	// spool keeps messages on disk while broker is not reachable, empty directory disables it
+	stSpoolConfig stSpool{"", DEFAULT_SPOOL_SEGMENT_SIZE, DEFAULT_SPOOL_MAX_SEGMENTS, DEFAULT_SPOOL_DRAIN_RATE};
+	CommonUtils::readEnvVariable("MQTT_SPOOL_DIR", stSpool.m_sDir);
+	CommonUtils::readEnvVariable("MQTT_SPOOL_SEGMENT_SIZE", MIN_SPOOL_SEGMENT_SIZE, MAX_SPOOL_SEGMENT_SIZE, stSpool.m_u32SegmentSize);
+	CommonUtils::readEnvVariable("MQTT_SPOOL_MAX_SEGMENTS", 1, MAX_SPOOL_MAX_SEGMENTS, stSpool.m_u32MaxSegments);
+	CommonUtils::readEnvVariable("MQTT_SPOOL_DRAIN_RATE", 0, MAX_SPOOL_DRAIN_RATE, stSpool.m_u32DrainRate);
+	DO_LOG_INFO("MQTT spool directory: " + stSpool.m_sDir + ", segment size: " + std::to_string(stSpool.m_u32SegmentSize) +
+			", max segments: " + std::to_string(stSpool.m_u32MaxSegments) +
+			", drain rate: " + std::to_string(stSpool.m_u32DrainRate));
+
+	// what happens to message when in-flight window is full: block, drop_oldest or spool
+	eMQTTPublishPolicy ePolicy = (true == stSpool.m_sDir.empty()) ? enPUBLISH_POLICY_BLOCK : enPUBLISH_POLICY_SPOOL;
+	std::string sPolicy;
+	if(true == CommonUtils::readEnvVariable("MQTT_PUBLISH_POLICY", sPolicy))
+	{
+		if("block" == sPolicy)
+		{
+			ePolicy = enPUBLISH_POLICY_BLOCK;
+		}
+		else if("drop_oldest" == sPolicy)
+		{
+			ePolicy = enPUBLISH_POLICY_DROP_OLDEST;
+		}
+		else if("spool" == sPolicy)
+		{
+			ePolicy = enPUBLISH_POLICY_SPOOL;
+		}
+		else
+		{
+			DO_LOG_ERROR("Invalid MQTT_PUBLISH_POLICY: " + sPolicy + ". Default policy is used.");
+		}
+	}
+	uint32_t u32MaxPending = DEFAULT_PUBLISH_MAX_PENDING;
+	CommonUtils::readEnvVariable("MQTT_PUBLISH_MAX_PENDING", 1, MAX_PUBLISH_MAX_PENDING, u32MaxPending);
+	DO_LOG_INFO("MQTT publish policy: " + std::to_string(ePolicy) + ", max pending messages: " + std::to_string(u32MaxPending));
+
+	init(u32PoolSize, u32InFlightWindow, ePolicy, u32MaxPending, stSpool);
+}
+
+/**
+ * Enables spool of publisher connection if spool policy and spool are
+ * configured. Each connection has its own spool directory named after its
+ * client ID. If spool cannot be enabled, connection uses block policy.
+ * @param a_rPublisher :[in] publisher connection
+ * @param a_sClientID :[in] client ID of connection
+ * @return true/false based on whether spool is enabled
+ */
+bool CMQTTPublisherPool::enableSpool(CMQTTPublishHandler &a_rPublisher, const std::string &a_sClientID)
+{
+	if((enPUBLISH_POLICY_SPOOL != m_ePolicy) || (true == m_stSpoolConfig.m_sDir.empty()))
+	{
+		return false;
+	}
+	std::string sSubDir{a_sClientID};
+	std::replace(sSubDir.begin(), sSubDir.end(), '/', '_');
+	return a_rPublisher.enableSpool(m_stSpoolConfig.m_sDir + "/" + sSubDir, m_stSpoolConfig);
+}
+
+/**
+ * Creates publisher connection with publish configuration of pool and
+ * enables its spool if configured
+ * @param a_sUrl :[in] MQTT broker URL
+ * @param a_sClientID :[in] client ID of connection
+ * @param a_iQOS :[in] QOS value with which messages are published
+ * @return publisher connection, owned by caller
+ */
+CMQTTPublishHandler* CMQTTPublisherPool::createPublisher(const std::string &a_sUrl, const std::string &a_sClientID, int a_iQOS)
+{
+	CMQTTPublishHandler *pPublisher = new CMQTTPublishHandler(a_sUrl, a_sClientID, a_iQOS,
+			m_u32InFlightWindow, m_ePolicy, m_u32MaxPending);
+	enableSpool(*pPublisher, a_sClientID);
+	return pPublisher;
+}
+
+/**
+ * Gets index of connection to be used for a topic
+ * @param a_sTopic :[in] topic to be published
+ * @return index of connection in pool
+ */
+size_t CMQTTPublisherPool::getConnectionIndex(const std::string &a_sTopic)
+{
+	if(0 == m_u32PoolSize)
+	{
+		return 0;
+	}
+	return std::hash<std::string>()(a_sTopic) % m_u32PoolSize;
+}
+
+/**
+ * Finds existing publisher connection for a topic
+ * @param a_sTopic :[in] topic to be published
+ * @param a_iQOS :[in] QOS value with which messages of topic are published
+ * @return publisher connection, NULL if connections of QoS are not created yet
+ */
+CMQTTPublishHandler* CMQTTPublisherPool::findPublisher(const std::string &a_sTopic, int a_iQOS)
+{
+	std::lock_guard<std::mutex> lock(m_mutexPool);
+	auto itr = m_mapPublishers.find(a_iQOS);
+	if((m_mapPublishers.end() == itr) || (true == itr->second.empty()))
+	{
+		return NULL;
+	}
+	return itr->second[getConnectionIndex(a_sTopic) % itr->second.size()].get();
+}
+
+/**
+ * Gets publisher connection for a topic. Connections of a QoS are created
+ * when first topic with that QoS asks for a publisher. Connections are
+ * created and connected without holding pool mutex, hence topics whose
+ * connections exist are not held up while broker is being connected.
+ * @param a_sTopic :[in] topic to be published
+ * @param a_iQOS :[in] QOS value with which messages of topic are published
+ * @return publisher connection
+ */
+CMQTTPublishHandler& CMQTTPublisherPool::getPublisher(const std::string &a_sTopic, int a_iQOS)
+{
+	CMQTTPublishHandler *pPublisher = findPublisher(a_sTopic, a_iQOS);
+	if(NULL != pPublisher)
+	{
+		return *pPublisher;
+	}
+
+	// only one thread creates connections, so that a client ID and its spool are used by one connection
+	std::lock_guard<std::mutex> lockCreate(m_mutexCreate);
+	pPublisher = findPublisher(a_sTopic, a_iQOS);
+	if(NULL != pPublisher)
+	{
+		return *pPublisher;
+	}
+
+	std::vector<std::unique_ptr<CMQTTPublishHandler>> vPublishers;
+	uint32_t u32Count = (0 == m_u32PoolSize) ? 1 : m_u32PoolSize;
+	std::string sUrl = EnvironmentInfo::getInstance().getDataFromEnvMap("MQTT_URL_FOR_EXPORT");
+	for(uint32_t u32Index = 0; u32Index < u32Count; ++u32Index)
+	{
+		std::string sClientID = "MQTT_EXPORT_PUB_QOS" + std::to_string(a_iQOS) + "_" + std::to_string(u32Index);
+		vPublishers.push_back(std::unique_ptr<CMQTTPublishHandler>(createPublisher(sUrl, sClientID, a_iQOS)));
+	}
+	DO_LOG_INFO("Created " + std::to_string(u32Count) + " MQTT publisher connections for QOS " + std::to_string(a_iQOS));
+
+	std::lock_guard<std::mutex> lock(m_mutexPool);
+	std::vector<std::unique_ptr<CMQTTPublishHandler>> &vPoolPublishers = m_mapPublishers[a_iQOS];
+	vPoolPublishers = std::move(vPublishers);
+	return *(vPoolPublishers[getConnectionIndex(a_sTopic) % vPoolPublishers.size()]);
 }
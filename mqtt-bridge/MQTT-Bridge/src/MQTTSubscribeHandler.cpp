@@ -214,72 +214,6 @@ void CMQTTHandler::handleConnSuccessThread()
 	}
 }
 
-/**
-* parse message to retrieve QOS and topic names
-* @param json :[in] message from which to retrieve real-time
-* @param isRealtime :[in] is it a message for real-time operation
-* @param bIsDefault :[in] default RT value
-* @return true/false based on success/failure
-*/
-bool CMQTTHandler::parseMQTTMsg(const std::string &sJson, bool &isRealtime, const bool bIsDefault)
-{
-	bool bRetVal = false;
-
-	try
-	{
-		isRealtime = bIsDefault;
-		cJSON *root = cJSON_Parse(sJson.c_str());
-		if (NULL == root)
-		{
-			DO_LOG_ERROR("Message received from MQTT could not be parsed in json format");
-			return bRetVal;
-		}
-
-		if(! cJSON_HasObjectItem(root, "realtime"))
-		{
-			DO_LOG_DEBUG("Message received from MQTT does not have key \"realtime\", request will be sent as non-RT");
-			if (NULL != root)
-				cJSON_Delete(root);
-
-			return true;
-		}
-
-		char *crealtime = cJSON_GetObjectItem(root, "realtime")->valuestring;
-		if (NULL == crealtime)
-		{
-			DO_LOG_ERROR("Key 'realtime' could not be found in message received from ZMQ");
-			if (NULL != root)
-			{
-				cJSON_Delete(root);
-			}
-			return true;
-		}
-		else
-		{
-			if(strcmp(crealtime, "0") == 0)
-			{
-				isRealtime = false;
-			}
-			else if(strcmp(crealtime, "1") == 0)
-			{
-				isRealtime = true;
-			}
-		}
-
-		if (NULL != root)
-			cJSON_Delete(root);
-
-		bRetVal = true;
-	}
-	catch (std::exception &ex)
-	{
-		DO_LOG_ERROR(ex.what());
-		bRetVal = false;
-	}
-
-	return bRetVal;
-}
-
 /**
  * Push message in message queue to send on EII
  * @param msg :[in] reference of message to push in queue
@@ -302,9 +236,8 @@ bool CMQTTHandler::pushMsgInQ(mqtt::const_message_ptr& a_msgMQTT)
 				return false;
 			}
 		};
-		std::string sTopic{a_msgMQTT->get_topic()};
-		std::string payload{a_msgMQTT->get_payload()};
-		CMessageObject oTemp{a_msgMQTT};
+		const std::string &sTopic = a_msgMQTT->get_topic();
+		const std::string &payload = a_msgMQTT->get_payload();
 		bool bDefRT = false;
 		bool isWrite = false;
 		// Decide whether to use polling queue or writeResponse queue
@@ -334,13 +267,21 @@ bool CMQTTHandler::pushMsgInQ(mqtt::const_message_ptr& a_msgMQTT)
 			return false;
 		}
 		
-		//parse payload to check if realtime is true or false
+		// payload is parsed only here, converted envelope is queued so that
+		// EII publisher threads do not parse it again
 		bool isRealTime = false;
-		if( ! parseMQTTMsg(payload.c_str(), isRealTime, bDefRT))
+		msg_envelope_t *pEnvelope = CCommon::getInstance().convertToEnvelope(payload, isRealTime, bDefRT);
+		if(NULL == pEnvelope)
 		{
 			DO_LOG_DEBUG("Could not parse MQTT msg");
 			return false;
 		}
+		CMessageObject oTemp{a_msgMQTT, pEnvelope};
+		if(false == CCommon::getInstance().addIngressFields(oTemp.getEnvelope(), sTopic, oTemp.getTimestamp()))
+		{
+			DO_LOG_ERROR("Could not add MQTT receive details in msg");
+			return false;
+		}
 
 		//if payload contains realtime flag, push message to real time queue
 		if(isRealTime)
@@ -30,6 +30,9 @@
 #include "ConfigManager.hpp"
 #include "EnvironmentVarHandler.hpp"
 #include "ZmqHandler.hpp"
+#include "EmbBatch.hpp"
+#include "PolledUpdate.hpp"
+#include <unordered_map>
 
 #ifdef UNIT_TEST
 #include <gtest/gtest.h>
@@ -54,13 +57,89 @@ std::atomic<bool> g_shouldStop(false);
 #define WRITE_RESPONSE 			"NRT/writeResponse"
 #define WRITE_RESPONSE_RT		"RT/writeResponse"
 
+/**
+ * Converts binary polled update in JSON and publishes it on MQTT. JSON form
+ * is built only here, where update leaves EII.
+ * @param a_stUpdate	:[in] decoded update
+ * @param a_sTsRcvd	:[in] time at which update is received from EII
+ * @param mqttPublisher :[in] mqtt publisher instance from which to publish message
+ * @param a_bIsRealTime :[in] RT or non-RT message(true or false)
+ * returns true/false based on success/failure
+ */
+bool publishPolledUpdate(const stPolledUpdate &a_stUpdate, const std::string &a_sTsRcvd, CMQTTPublishHandler &mqttPublisher,
+		bool a_bIsRealTime)
+{
+	std::string revdTopic{a_stUpdate.m_sDataTopic};
+	std::string mqttMsg;
+	CPolledUpdateCodec::toJson(a_stUpdate, mqttMsg);
+	if(false == CCommon::getInstance().appendJsonField(mqttMsg, "tsMsgRcvdForProcessing", a_sTsRcvd))
+	{
+		DO_LOG_ERROR("Polled update could not be converted to JSON for topic: " + revdTopic);
+		return false;
+	}
+	return mqttPublisher.createNPubMsg(mqttMsg, revdTopic, a_bIsRealTime);
+}
+
+/**
+ * Process batch of messages received from EII and publish each on MQTT
+ * @param msg	:[in] batch envelope, it is destroyed here
+ * @param mqttPublisher :[in] mqtt publisher instance from which to publish messages
+ * @param a_bIsRealTime :[in] RT or non-RT messages(true or false)
+ * returns true/false based on success/failure
+ */
+bool processBatchMsg(msg_envelope_t *msg, CMQTTPublishHandler &mqttPublisher, bool a_bIsRealTime)
+{
+	struct timespec tsMsgRcvd;
+	timespec_get(&tsMsgRcvd, TIME_UTC);
+	std::string strTsRcvd = std::to_string(CCommon::getInstance().get_micros(tsMsgRcvd));
+
+	CEmbBatchReader oReader;
+	bool bRetVal = oReader.open(msg);
+	stEmbBatchEntry stEntry;
+	thread_local stPolledUpdate stUpdate;
+	while(true == oReader.next(stEntry))
+	{
+		if(true == CPolledUpdateCodec::decode(stEntry.m_pMsg, stEntry.m_u32MsgLen, stUpdate))
+		{
+			// entry is binary polled update
+			if(false == publishPolledUpdate(stUpdate, strTsRcvd, mqttPublisher, a_bIsRealTime))
+			{
+				bRetVal = false;
+			}
+			continue;
+		}
+
+		// entry refers to received batch, it is copied only into MQTT payload
+		std::string revdTopic(stEntry.m_pTopic, stEntry.m_u16TopicLen);
+		std::string mqttMsg;
+		mqttMsg.reserve(stEntry.m_u32MsgLen + TS_FIELDS_RESERVE);
+		mqttMsg.append(stEntry.m_pMsg, stEntry.m_u32MsgLen);
+		if(true == CCommon::getInstance().appendJsonField(mqttMsg, "tsMsgRcvdForProcessing", strTsRcvd))
+		{
+			if(false == mqttPublisher.createNPubMsg(mqttMsg, revdTopic, a_bIsRealTime))
+			{
+				bRetVal = false;
+			}
+		}
+		else
+		{
+			DO_LOG_ERROR("Batch entry is not a JSON object for topic: " + revdTopic);
+			bRetVal = false;
+		}
+	}
+
+	msgbus_msg_envelope_destroy(msg);
+	return bRetVal;
+}
+
 /**
  * Process message received from EII and send for publishing on MQTT
  * @param msg	:[in] actual message
  * @param mqttPublisher :[in] mqtt publisher instance from which to publish this message
+ * @param a_bIsRealTime :[in] RT or non-RT message(true or false)
  * returns true/false based on success/failure
  */
-bool processMsg(msg_envelope_t *msg, CMQTTPublishHandler &mqttPublisher)
+bool processMsg(msg_envelope_t *msg, CMQTTPublishHandler &mqttPublisher, bool a_bIsRealTime = false)
 {
 	int num_parts = 0;
 	msg_envelope_serialized_part_t *parts = NULL;
@@ -72,9 +151,23 @@ bool processMsg(msg_envelope_t *msg, CMQTTPublishHandler &mqttPublisher)
 		return bRetVal;
 	}
 
+	if(true == CEmbBatchReader::isBatch(msg))
+	{
+		return processBatchMsg(msg, mqttPublisher, a_bIsRealTime);
+	}
+
 	struct timespec tsMsgRcvd;
 	timespec_get(&tsMsgRcvd, TIME_UTC);
 
+	thread_local stPolledUpdate stUpdate;
+	if(true == CPolledUpdateCodec::decode(msg, stUpdate))
+	{
+		bRetVal = publishPolledUpdate(stUpdate, std::to_string(CCommon::getInstance().get_micros(tsMsgRcvd)), mqttPublisher,
+				a_bIsRealTime);
+		msgbus_msg_envelope_destroy(msg);
+		return bRetVal;
+	}
+
 	std::string revdTopic;
 	msg_envelope_elem_body_t* data;
 	msgbus_ret_t msgRet = msgbus_msg_envelope_get(msg, "data_topic", &data);
@@ -87,10 +180,6 @@ bool processMsg(msg_envelope_t *msg, CMQTTPublishHandler &mqttPublisher)
 	{
 		revdTopic = data->body.string; // has the topic /flowmeter/PL0/D18/update
 
-		std::string strTsRcvd = std::to_string(CCommon::getInstance().get_micros(tsMsgRcvd));
-		msg_envelope_elem_body_t* tsMsgRcvdPut = msgbus_msg_envelope_new_string(strTsRcvd.c_str());
-		msgbus_msg_envelope_put(msg, "tsMsgRcvdForProcessing", tsMsgRcvdPut);
-
 		num_parts = msgbus_msg_envelope_serialize(msg, &parts);
 		if (num_parts <= 0)
 		{
@@ -100,10 +189,20 @@ bool processMsg(msg_envelope_t *msg, CMQTTPublishHandler &mqttPublisher)
 		{
 			if(NULL != parts[0].bytes)
 			{
-				std::string mqttMsg(parts[0].bytes);
-				mqttPublisher.createNPubMsg(mqttMsg, revdTopic);
-
-				bRetVal = true;
+				// Serialized message is copied only once, into the string which
+				// becomes MQTT payload. Time stamps are appended in the reserved room.
+				std::string mqttMsg;
+				mqttMsg.reserve(parts[0].len + TS_FIELDS_RESERVE);
+				mqttMsg.append(parts[0].bytes, strnlen(parts[0].bytes, parts[0].len));
+				std::string strTsRcvd = std::to_string(CCommon::getInstance().get_micros(tsMsgRcvd));
+				if(true == CCommon::getInstance().appendJsonField(mqttMsg, "tsMsgRcvdForProcessing", strTsRcvd))
+				{
+					bRetVal = mqttPublisher.createNPubMsg(mqttMsg, revdTopic, a_bIsRealTime);
+				}
+				else
+				{
+					DO_LOG_ERROR("Serialized message is not a JSON object");
+				}
 			}
 		}
 		else
@@ -196,10 +295,22 @@ void listenOnEII(std::string topicPrefix, zmq_handler::stZmqContext context, zmq
 	void *msgbus_ctx = context.m_pContext; // this is per subscriber
 	recv_ctx_t *sub_ctx = subContext.sub_ctx; // this is per SUB topic
 
-	//consider topic name as distinguishing factor for publisher
-	CMQTTPublishHandler mqttPublisher(EnvironmentInfo::getInstance().getDataFromEnvMap("MQTT_URL_FOR_EXPORT").c_str(),
-					topicPrefix, qos);
-	mqttPublisher.connect();
+	// connection is taken from shared publisher pool if pool is configured,
+	// otherwise topic name is distinguishing factor for publisher
+	std::unique_ptr<CMQTTPublishHandler> pOwnPublisher;
+	CMQTTPublisherPool &publisherPool = CMQTTPublisherPool::instance();
+	CMQTTPublishHandler *pPublisher = NULL;
+	if(0 != publisherPool.getPoolSize())
+	{
+		pPublisher = &(publisherPool.getPublisher(topicPrefix, qos));
+	}
+	else
+	{
+		pOwnPublisher.reset(publisherPool.createPublisher(EnvironmentInfo::getInstance().getDataFromEnvMap("MQTT_URL_FOR_EXPORT"),
+					topicPrefix, qos));
+		pOwnPublisher->connect();
+		pPublisher = pOwnPublisher.get();
+	}
 	
 	DO_LOG_INFO("ZMQ listening for topic : " + topicPrefix);
 
@@ -223,7 +334,7 @@ void listenOnEII(std::string topicPrefix, zmq_handler::stZmqContext context, zmq
 			}
 			
 			// process ZMQ message and publish to MQTT
-			processMsg(msg, mqttPublisher);
+			processMsg(msg, *pPublisher, operation.isRT());
 
 		}
 		catch (std::exception &ex)
@@ -238,130 +349,58 @@ void listenOnEII(std::string topicPrefix, zmq_handler::stZmqContext context, zmq
 /**
  * publish message to EII
  * @param a_oRcvdMsg  :[in] message to publish on EII
- * @param embTopic :[in] EII topic
+ * @param a_pPubHandle :[in] publisher handle of EII topic
  * @return true/false based on success/failure
  */
-bool publishEIIMsg(CMessageObject &a_oRcvdMsg, const std::string &embTopic)
+bool publishEIIMsg(CMessageObject &a_oRcvdMsg, zmq_handler::stZmqPubHandle *a_pPubHandle)
 {
-	bool retVal = false;
-
-	// Creating message to be published
-	msg_envelope_t *msg = NULL;
-	cJSON *root = NULL;
+	// Message is normally converted to envelope when it is received from MQTT
+	msg_envelope_t *msg = a_oRcvdMsg.getEnvelope();
+	msg_envelope_t *pLocalMsg = NULL;
 
 	try
 	{
-		msg = msgbus_msg_envelope_new(CT_JSON);
-		if(msg == NULL)
-		{
-			DO_LOG_ERROR("could not create new msg envelope");
-			return retVal;
-		}
-		std::string eiiMsg = a_oRcvdMsg.getStrMsg();
-		//TODO: Remove the realtime flag in JSON body before publishing to EMB.
-		//parse from root element
-		root = cJSON_Parse(eiiMsg.c_str());
-		if (NULL == root)
-		{
-			DO_LOG_ERROR("Could not parse value received from MQTT");
-
-			if(msg != NULL)
-			{
-				msgbus_msg_envelope_destroy(msg);
-			}
-
-			return retVal;
-		}
-
-		auto addField = [&msg](const std::string &a_sFieldName, const std::string &a_sValue) {
-			DO_LOG_DEBUG(a_sFieldName + " : " + a_sValue);
-			msg_envelope_elem_body_t *value = msgbus_msg_envelope_new_string(a_sValue.c_str());
-			if((NULL != value) && (NULL != msg))
-			{
-				msgbus_msg_envelope_put(msg, a_sFieldName.c_str(), value);
-			}
-		};
-
-		cJSON *device = root->child;
-		while (device)
+		if(NULL == msg)
 		{
-			if(cJSON_IsString(device))
-			{        
-				addField(device->string, device->valuestring);
-			}
-			else if (cJSON_IsBool(device))
-			{
-				bool val = false;
-				// Add bool in msg envelope
-				if (cJSON_IsTrue(device))
-				{
-					val = true;
-				}
-				msg_envelope_elem_body_t *value = msgbus_msg_envelope_new_bool(val);
-				if (NULL != msg && NULL != value)
-				{
-					msgbus_msg_envelope_put(msg, device->string, value);					
-				}
-			}
-			else if (cJSON_IsNumber(device))
-			{
-				// Add number in msg envelope
-				msg_envelope_elem_body_t *value = msgbus_msg_envelope_new_floating(device->valuedouble);
-				if (NULL != msg && NULL != value)
-				{
-					msgbus_msg_envelope_put(msg, device->string, value);
-				}
-			}
-			else
+			bool bIsRealtime = false;
+			pLocalMsg = CCommon::getInstance().convertToEnvelope(a_oRcvdMsg.getStrMsg(), bIsRealtime, false);
+			if(NULL == pLocalMsg)
 			{
-				throw std::string("Invalid JSON");
+				DO_LOG_ERROR("Could not parse value received from MQTT");
+				return false;
 			}
-			// get and print key
-			device = device->next;
+			CCommon::getInstance().addIngressFields(pLocalMsg, a_oRcvdMsg.getTopic(), a_oRcvdMsg.getTimestamp());
+			msg = pLocalMsg;
 		}
 
-		if (root)
-		{
-			cJSON_Delete(root);
-		}
-		root = NULL;
-
-		addField("tsMsgRcvdFromMQTT", (std::to_string(CCommon::getInstance().get_micros(a_oRcvdMsg.getTimestamp()))).c_str());
-		addField("sourcetopic", a_oRcvdMsg.getTopic());
-		
 		std::string strTsReceived{""};
 		bool bRet = true;
-		if(true == zmq_handler::publishJson(strTsReceived, msg, embTopic, "tsMsgPublishOnEII"))
+		if(true == zmq_handler::publishJson(strTsReceived, msg, a_pPubHandle, "tsMsgPublishOnEII"))
 		{
 			bRet = true;
 		}
 		else
 		{
-			DO_LOG_ERROR("Failed to publish write msg on EII: " + eiiMsg);
+			DO_LOG_ERROR("Failed to publish write msg on EII: " + a_oRcvdMsg.getStrMsg());
 			bRet = false;
 		}
 
-		msgbus_msg_envelope_destroy(msg);
-		msg = NULL;
+		if(NULL != pLocalMsg)
+		{
+			msgbus_msg_envelope_destroy(pLocalMsg);
+			pLocalMsg = NULL;
+		}
 
 		return bRet;
 	}
-	catch(std::string& strException)
-	{
-		DO_LOG_ERROR(strException);
-	}
 	catch(std::exception &ex)
 	{
 		DO_LOG_ERROR(ex.what());
 	}
 
-	if(msg != NULL)
-	{
-		msgbus_msg_envelope_destroy(msg);
-	}
-	if (root)
+	if(NULL != pLocalMsg)
 	{
-		cJSON_Delete(root);
+		msgbus_msg_envelope_destroy(pLocalMsg);
 	}
 
 	return false;
@@ -427,9 +466,6 @@ void processMsgToSendOnEII(CMessageObject &recvdMsg, const bool isRealtime)
 		// /flowmeter/PL0/D13/read to RT|NRT/read/flowmeter/PL0/D13
 		std::string embTopic = mapMqttToEMBTopic(rcvdTopic, isRealtime);
 
-		//Get the context for this EMB PUB topic
-		zmq_handler::prepareContext(true, (zmq_handler::getPubCtxCfg()).m_pub_msgbus_ctx, embTopic, (zmq_handler::getPubCtxCfg()).m_pub_config);
-
 		if (embTopic.empty())
 		{
 			DO_LOG_ERROR("EMB topic is not set to publish on EMB"+ rcvdTopic);
@@ -440,7 +476,15 @@ void processMsgToSendOnEII(CMessageObject &recvdMsg, const bool isRealtime)
 			//publish data to EII
 			DO_LOG_DEBUG("MQTT topic is Mapped to new EMB topic format : " + embTopic);
 
-			if(publishEIIMsg(recvdMsg, embTopic))
+			// publisher of EMB topic is resolved once per thread
+			static thread_local std::unordered_map<std::string, zmq_handler::stZmqPubHandle*> mapPubHandle;
+			zmq_handler::stZmqPubHandle *&pPubHandle = mapPubHandle[embTopic];
+			if(NULL == pPubHandle)
+			{
+				pPubHandle = zmq_handler::getPubHandle(embTopic);
+			}
+
+			if(publishEIIMsg(recvdMsg, pPubHandle))
 			{
 				DO_LOG_DEBUG("Published EII message : "	+ strMsg + " on topic :" + embTopic);
 			}
@@ -673,6 +717,9 @@ int main(int argc, char *argv[])
 		//read environment values from settings
 		CCommon::getInstance();
 
+		// MQTT publisher pool, in-flight window and spool settings
+		CMQTTPublisherPool::instance().initFromEnv();
+
 		//Prepare MQTT for publishing & subscribing
 		//subscribing to topics happens in callback of connect()
 		CMQTTHandler::instance();
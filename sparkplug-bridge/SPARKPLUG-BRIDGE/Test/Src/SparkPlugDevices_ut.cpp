@@ -80,6 +80,29 @@ TEST_F(SparkPlugDevices_ut, processRealDeviceUpdateMsg_MetricMapEmpty)
 
 }
 
+/**
+ * Test case to check processRealDeviceUpdateMsg() with binary update when metric map is empty
+ * @param :[in] None
+ * @param :[out] None
+ * @return None
+ */
+TEST_F(SparkPlugDevices_ut, processRealDeviceUpdateMsg_BinaryMetricMapEmpty)
+{
+	CSparkPlugDev CSparkPlugDev_obj{"Dev01", "Dev_Name", false};
+
+	stPolledUpdate stUpdate;
+	stUpdate.m_sDataTopic = "/Dev01/Dev_Name/UtData02/update";
+	stUpdate.m_sMetric = "UtData02";
+	stUpdate.m_bIsHexValue = true;
+	stUpdate.m_sHexValue = "0x00";
+	stUpdate.m_i64Usec = 1571887474111145;
+	std::string a_sPayLoad;
+	CPolledUpdateCodec::encode(stUpdate, a_sPayLoad);
+	std::vector<stRefForSparkPlugAction> a_stRefActionVec;
+	EXPECT_EQ( false, CSparkPlugDev_obj.processRealDeviceUpdateMsg(a_sPayLoad, a_stRefActionVec) );
+
+}
+
 /**
  * Test case to check processRealDeviceUpdateMsg() when device map is empty
  * @param :[in] None
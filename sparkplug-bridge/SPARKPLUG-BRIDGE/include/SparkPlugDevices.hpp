@@ -39,6 +39,7 @@
 #include "Metric.hpp"
 #include "NetworkInfo.hpp"
 #include "Common.hpp"
+#include "PolledUpdate.hpp"
 
 extern "C"
 {
@@ -91,6 +92,13 @@ class CSparkPlugDev
 	bool parseScaledValueRealDevices(const std::string &a_sPayLoad, std::string &a_sMetric,
 			 CValObj &a_rValobj);
 
+	bool parseRealDeviceUpdate(const std::string &a_sPayLoad, stPolledUpdate &a_stUpdate,
+		std::string &a_sMetric, std::string &a_sValue, std::string &a_sStatus,
+		uint64_t &a_usec, uint64_t &a_lastGoodUsec, uint32_t &a_error_code);
+
+	bool setScaledValueRealDevices(const stPolledUpdate &a_stUpdate, const std::string &a_sMetric,
+			 CValObj &a_rValobj);
+
 	bool validateRealDeviceUpdateData(
 		const std::string &a_sValue, std::string a_sStatus,
 		uint32_t a_error_code,
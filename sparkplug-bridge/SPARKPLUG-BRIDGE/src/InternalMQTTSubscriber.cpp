@@ -25,7 +25,9 @@
 #include "ConfigManager.hpp"
 #include "SparkPlugDevices.hpp"
 #include "SCADAHandler.hpp"
+#include "JsonEnvelope.hpp"
 #include <chrono>
+#include <unordered_map>
 #include <ctime>
 #include <errno.h>
 #define SUBSCRIBER_ID "SCADA_INT_MQTT_SUBSCRIBER"
@@ -411,50 +413,70 @@ std::string CIntMqttHandler::mapMqttToEMBRespTopic(std::string mqttTopic){
 // /flowmeter/PL0/D13/read to RT|NRT/read/flowmeter/PL0/D13
 bool CIntMqttHandler::publish_msg_to_emb(std::string embMsg,std::string mqttTopic)
 {
+	// converter reuses its buffers, hence one converter per thread
+	static thread_local CJsonToEnvelope oConverter;
+	// EMB publisher handle per MQTT topic, resolved on first message of
+	// the topic so that later messages skip topic mapping and the global
+	// publisher map lookup
+	static thread_local std::unordered_map<std::string, zmq_handler::stZmqPubHandle*> mapPubHandles;
+
 	bool retVal = false;
 	std::string delimeter = "/";
 	int size = mqttTopic.find(delimeter);
 	// To check if topic is of VA or Real Device
 	std::string VA_check = mqttTopic.substr(0,size);
-	std::string embTopic;	
 	msg_envelope_elem_body_t* obj = NULL;
 	msg_envelope_t *msg = NULL;
-	cJSON *root = NULL;
 	// In case of Vendor App
 	if(VA_check == "CMD"){
-		embTopic = mqttTopic;
 		// removing additional square braces from payload
 		delimeter = "]";
-		int length = embMsg.size();
 		size = embMsg.find(delimeter);
 		embMsg = embMsg.substr(0,size);
 		embMsg.replace(0,1,""); 
-		obj = msgbus_msg_envelope_new_object();
-	}else{// In case of Real Device
-		embTopic = CIntMqttHandler::mapMqttToEMBRespTopic(mqttTopic);
 	}
-	DO_LOG_DEBUG("Topic for publishing is"+ embTopic);
-	zmq_handler::prepareContext(true, (zmq_handler::getPubCtxCfg()).m_pub_msgbus_ctx, embTopic, (zmq_handler::getPubCtxCfg()).m_pub_config);
-	try
+	zmq_handler::stZmqPubHandle *pPubHandle = NULL;
+	auto itrHandle = mapPubHandles.find(mqttTopic);
+	if(mapPubHandles.end() != itrHandle)
 	{
-		msg = msgbus_msg_envelope_new(CT_JSON);
-		if(msg == NULL)
+		pPubHandle = itrHandle->second;
+	}
+	else
+	{
+		// In case of Vendor App, EMB topic is same as MQTT topic
+		std::string embTopic = (VA_check == "CMD") ? mqttTopic : CIntMqttHandler::mapMqttToEMBRespTopic(mqttTopic);
+		DO_LOG_DEBUG("Topic for publishing is"+ embTopic);
+		pPubHandle = zmq_handler::getPubHandle(embTopic);
+		if(NULL != pPubHandle)
 		{
-			DO_LOG_ERROR("could not create new msg envelope");
-			return retVal;
+			mapPubHandles.emplace(mqttTopic, pPubHandle);
+		}
+	}
+	try
+	{
+		if(VA_check=="CMD"){
+			// In case of Vendor App, payload is sent as "metrics" object
+			obj = oConverter.convertToObject(embMsg);
+			if(obj == NULL)
+			{
+				DO_LOG_ERROR("Could not parse value received from MQTT");
+				return retVal;
+			}
+			msg = msgbus_msg_envelope_new(CT_JSON);
+		}else{
+			// In case of Real Device, payload fields are sent as they are
+			msg = oConverter.convert(embMsg);
 		}
-		root = cJSON_Parse(embMsg.c_str());
-		if (NULL == root)
+		if(msg == NULL)
 		{
-			DO_LOG_ERROR("Could not parse value received from MQTT");
-
-			if(msg != NULL)
+			DO_LOG_ERROR("Could not create msg envelope for value received from MQTT");
+			if(obj != NULL)
 			{
-				msgbus_msg_envelope_destroy(msg);
+				msgbus_msg_envelope_elem_destroy(obj);
 			}
-
 			return retVal;
 		}
+
 		// In case of Real Device
 		auto addField = [&msg](const std::string &a_sFieldName, const std::string &a_sValue) {
 			DO_LOG_DEBUG(a_sFieldName + " : " + a_sValue);
@@ -474,73 +496,7 @@ bool CIntMqttHandler::publish_msg_to_emb(std::string embMsg,std::string mqttTopi
 				msgbus_msg_envelope_elem_object_put(obj, a_sFieldName.c_str() , value);	
 			}
 		};		
-		
-		cJSON *device = root->child;
-		while (device)
-		{
-			if(cJSON_IsString(device))
-			{        
-				
-				if(VA_check=="CMD"){
-					// In case of Vendor App
-					addField_VA(device->string, device->valuestring,VA_check,obj);
-
-				}else{
-					// In case of Real Device
-					addField(device->string, device->valuestring);
-				}
-			}
-			else if (cJSON_IsBool(device))
-			{
-				bool val = false;
-				// Add bool in msg envelope
-				if (cJSON_IsTrue(device))
-				{
-					val = true;
-				}
-				msg_envelope_elem_body_t *value = msgbus_msg_envelope_new_bool(val);
-				if (NULL != msg && NULL != value)
-				{
-					if(VA_check=="CMD"){
-						// In case of Vendor App
-						msgbus_msg_envelope_elem_object_put(obj, device->string , value);
-
-					}else{
-						// In case of Real Device
-						msgbus_msg_envelope_put(msg, device->string, value);
-					}					
-				}
-			}
-			else if (cJSON_IsNumber(device))
-			{
-				// Add number in msg envelope
-				msg_envelope_elem_body_t *value = msgbus_msg_envelope_new_floating(device->valuedouble);
-				if (NULL != msg && NULL != value)
-				{
-					
-					if(VA_check=="CMD"){
-						// In case of Vendor App
-						msgbus_msg_envelope_elem_object_put(obj, device->string , value);
 
-					}else{
-						// In case of Real Device
-						msgbus_msg_envelope_put(msg, device->string, value);
-					}					
-				}
-			}
-			else
-			{
-				throw std::string("Invalid JSON");
-			}
-			// get and print key
-			device = device->next;
-		}
-
-		if (root)
-		{
-			cJSON_Delete(root);
-		}
-		root = NULL;
 		std::string time_stamp_value = CCommon::getInstance().get_timestamp();
 		if(VA_check=="CMD"){
 			// In case of Vendor App
@@ -562,9 +518,11 @@ bool CIntMqttHandler::publish_msg_to_emb(std::string embMsg,std::string mqttTopi
 			msg_envelope_elem_body_t* ptUsec = msgbus_msg_envelope_new_string(a_sUsec.c_str());
 			msgbus_msg_envelope_elem_object_put(obj, "tsMsgPublishSPtoEMB" , ptUsec);
 			msgbus_msg_envelope_put(msg, "metrics", obj);
+			// object is owned by envelope now
+			obj = NULL;
 			
 			
-			if(true == zmq_handler::publishJson(strTsReceived, msg, embTopic, ""))
+			if(true == zmq_handler::publishJson(strTsReceived, msg, pPubHandle, ""))
 			{
 				bRet = true;
 			}
@@ -576,7 +534,7 @@ bool CIntMqttHandler::publish_msg_to_emb(std::string embMsg,std::string mqttTopi
 
 		}else{
 		// In case of Real Device
-		if(true == zmq_handler::publishJson(strTsReceived, msg, embTopic, "tsMsgPublishSPtoEMB"))
+		if(true == zmq_handler::publishJson(strTsReceived, msg, pPubHandle, "tsMsgPublishSPtoEMB"))
 		{
 			bRet = true;
 		}
@@ -600,9 +558,9 @@ bool CIntMqttHandler::publish_msg_to_emb(std::string embMsg,std::string mqttTopi
 	{
 		msgbus_msg_envelope_destroy(msg);
 	}
-	if (root)
+	if(obj != NULL)
 	{
-		cJSON_Delete(root);
+		msgbus_msg_envelope_elem_destroy(obj);
 	}
 
 	return false;
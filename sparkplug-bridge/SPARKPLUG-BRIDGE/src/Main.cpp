@@ -28,6 +28,7 @@
 #include "InternalMQTTSubscriber.hpp"
 #include "SparkPlugDevMgr.hpp"
 #include "ZmqHandler.hpp"
+#include "EmbBatch.hpp"
 #include <iostream>
 #ifdef UNIT_TEST
 #include <gtest/gtest.h>
@@ -145,6 +146,42 @@ bool processMsg(msg_envelope_t *msg,std::string eachTopic){
 	msg_envelope_serialized_part_t* parts = NULL;
 	std::string sRcvdTopic;
 	std::string check_topic;
+
+	CEmbBatchReader oReader;
+	if(true == oReader.open(msg))
+	{
+		// each entry of batch is a serialized message along with its data topic
+		stEmbBatchEntry stEntry;
+		while(true == oReader.next(stEntry))
+		{
+			CMessageObject oMsg{std::string(stEntry.m_pTopic, stEntry.m_u16TopicLen),
+				std::string(stEntry.m_pMsg, stEntry.m_u32MsgLen)};
+			QMgr::getDatapointsQ().pushMsg(oMsg);
+		}
+		return true;
+	}
+
+	// binary polled update is passed on as it is, along with its data topic
+	if(true == CPolledUpdateCodec::isPolledUpdate(msg))
+	{
+		msg_envelope_elem_body_t *pBlob = NULL;
+		if((MSG_SUCCESS != msgbus_msg_envelope_get(msg, NULL, &pBlob)) || (NULL == pBlob))
+		{
+			DO_LOG_ERROR("Binary update could not be read");
+			return false;
+		}
+		thread_local stPolledUpdate stUpdate;
+		if(false == CPolledUpdateCodec::decode(msg, stUpdate))
+		{
+			DO_LOG_ERROR("Binary update could not be decoded");
+			return false;
+		}
+		CMessageObject oMsg{stUpdate.m_sDataTopic,
+			std::string(pBlob->body.blob->data, pBlob->body.blob->len)};
+		QMgr::getDatapointsQ().pushMsg(oMsg);
+		return true;
+	}
+
 	msgbus_ret_t msgRet = msgbus_msg_envelope_get(msg, "data_topic", &data);
 	if(msgRet != MSG_SUCCESS)
 	{ 
@@ -870,7 +870,10 @@ void CSparkPlugDevManager::processUpdateMsg(std::string a_sDeviceName,
 			}
 
 			std::string sDevName(a_sDeviceName + SUBDEV_SEPARATOR_CHAR + a_sSubDev);
-			DO_LOG_DEBUG(sDevName + ":Device. Received message: " + a_sPayLoad);
+			if(false == CPolledUpdateCodec::isPolledUpdate(a_sPayLoad.data(), a_sPayLoad.size()))
+			{
+				DO_LOG_DEBUG(sDevName + ":Device. Received message: " + a_sPayLoad);
+			}
 
 			// Find the device in list
 			bool bIsFound = false;			
@@ -893,6 +893,144 @@ bool CSparkPlugDev::parseScaledValueRealDevices(const std::string &a_sPayLoad, s
 	return retVal;
 }
 
+/**
+ * Decodes binary update of real device and stores fields same as parseRealDeviceUpdateMsg
+ * @param a_sPayLoad :[in] binary update
+ * @param a_stUpdate :[out] decoded update
+ * @param a_sMetric :[out] metric of update
+ * @param a_sValue :[out] hex string value of update
+ * @param a_sStatus :[out] status of update
+ * @param a_usec :[out] publish time of update in milli-seconds
+ * @param a_lastGoodUsec :[out] time of last good value in milli-seconds, if any
+ * @param a_error_code :[out] error code of bad update
+ * @return true or false based on success
+ */
+bool CSparkPlugDev::parseRealDeviceUpdate(const std::string &a_sPayLoad, stPolledUpdate &a_stUpdate,
+		std::string &a_sMetric, std::string &a_sValue, std::string &a_sStatus,
+		uint64_t &a_usec, uint64_t &a_lastGoodUsec, uint32_t &a_error_code)
+{
+	if(false == CPolledUpdateCodec::decode(a_sPayLoad.data(), a_sPayLoad.size(), a_stUpdate))
+	{
+		DO_LOG_ERROR("Binary update could not be decoded");
+		return false;
+	}
+	if(false == a_stUpdate.m_bIsHexValue)
+	{
+		DO_LOG_ERROR("value key not found in message: " + a_stUpdate.m_sDataTopic);
+		return false;
+	}
+	a_sMetric = a_stUpdate.m_sMetric;
+	a_sValue = a_stUpdate.m_sHexValue;
+	a_sStatus = (enPOLLED_STATUS_BAD == a_stUpdate.m_eStatus) ? "Bad" : "Good";
+	a_usec = (0 < a_stUpdate.m_i64Usec) ? (uint64_t)(a_stUpdate.m_i64Usec / 1000) : get_current_timestamp();
+	a_lastGoodUsec = (0 < a_stUpdate.m_i64LastGoodUsec) ? (uint64_t)(a_stUpdate.m_i64LastGoodUsec / 1000) : 0;
+	a_error_code = a_stUpdate.m_u32ErrorCode;
+	return true;
+}
+
+/**
+ * Sets typed scaled value of binary update in CValObj as per datatype of metric.
+ * Conversions are same as the ones done by parseScaledValueRealDevices.
+ * @param a_stUpdate :[in] decoded update
+ * @param a_sMetric  :[in] metric of update
+ * @param a_rValobj  :[out] value object of metric
+ * @return true or false based on success
+ */
+bool CSparkPlugDev::setScaledValueRealDevices(const stPolledUpdate &a_stUpdate, const std::string &a_sMetric, CValObj &a_rValobj)
+{
+	auto iter = m_mapMetrics.find(a_sMetric);
+	if ((m_mapMetrics.end() == iter) || (nullptr == (iter->second)))
+	{
+		DO_LOG_ERROR("Metric Not found : " + a_sMetric);
+		return false;
+	}
+	uint32_t tempYmlDataType = (iter->second)->getValue().getDataType();
+
+	bool bIsNumber = (enPOLLED_VALUE_INT == a_stUpdate.m_eValueType) || (enPOLLED_VALUE_FLOAT == a_stUpdate.m_eValueType);
+	double dValue = (enPOLLED_VALUE_INT == a_stUpdate.m_eValueType) ? (double)a_stUpdate.m_i64Value : a_stUpdate.m_dValue;
+
+	if ((METRIC_DATA_TYPE_BOOLEAN == tempYmlDataType) && (enPOLLED_VALUE_BOOL == a_stUpdate.m_eValueType))
+	{
+		CValObj oValtemp(METRIC_DATA_TYPE_BOOLEAN, a_stUpdate.m_bValue);
+		a_rValobj.assignNewDataTypeValue(METRIC_DATA_TYPE_BOOLEAN, oValtemp);
+	}
+	else if (((METRIC_DATA_TYPE_UINT16 == tempYmlDataType) || (METRIC_DATA_TYPE_UINT32 == tempYmlDataType) ||
+			(METRIC_DATA_TYPE_UINT64 == tempYmlDataType)) && (true == bIsNumber))
+	{
+		if (dValue < 0.0)
+		{
+			DO_LOG_ERROR("Negative value received for unsigned datatype: " + std::to_string(tempYmlDataType));
+			return false;
+		}
+		if (METRIC_DATA_TYPE_UINT16 == tempYmlDataType)
+		{
+			CValObj oValtemp(METRIC_DATA_TYPE_UINT16, (uint16_t)dValue);
+			a_rValobj.assignNewDataTypeValue(METRIC_DATA_TYPE_UINT16, oValtemp);
+		}
+		else if (METRIC_DATA_TYPE_UINT32 == tempYmlDataType)
+		{
+			CValObj oValtemp(METRIC_DATA_TYPE_UINT32, (uint32_t)dValue);
+			a_rValobj.assignNewDataTypeValue(METRIC_DATA_TYPE_UINT32, oValtemp);
+		}
+		else
+		{
+			uint64_t u64 = (enPOLLED_VALUE_INT == a_stUpdate.m_eValueType) ? (uint64_t)a_stUpdate.m_i64Value : (uint64_t)dValue;
+			CValObj oValtemp(METRIC_DATA_TYPE_UINT64, u64);
+			a_rValobj.assignNewDataTypeValue(METRIC_DATA_TYPE_UINT64, oValtemp);
+		}
+	}
+	else if ((METRIC_DATA_TYPE_INT16 == tempYmlDataType) && (true == bIsNumber))
+	{
+		CValObj oValtemp(METRIC_DATA_TYPE_INT16, (int16_t)dValue);
+		a_rValobj.assignNewDataTypeValue(METRIC_DATA_TYPE_INT16, oValtemp);
+	}
+	else if ((METRIC_DATA_TYPE_INT32 == tempYmlDataType) && (true == bIsNumber))
+	{
+		CValObj oValtemp(METRIC_DATA_TYPE_INT32, (int32_t)dValue);
+		a_rValobj.assignNewDataTypeValue(METRIC_DATA_TYPE_INT32, oValtemp);
+	}
+	else if ((METRIC_DATA_TYPE_INT64 == tempYmlDataType) && (true == bIsNumber))
+	{
+		// integer is carried as it is, no rounding through double
+		int64_t i64 = a_stUpdate.m_i64Value;
+		if (enPOLLED_VALUE_FLOAT == a_stUpdate.m_eValueType)
+		{
+			i64 = static_cast<std::int64_t>(dValue);
+			// Handle corner scenario of max value
+			if((i64 < 0) && (dValue > 0.0))
+			{
+				i64 = std::numeric_limits<int64_t>::max();
+			}
+		}
+		CValObj oValtemp(METRIC_DATA_TYPE_INT64, i64);
+		a_rValobj.assignNewDataTypeValue(METRIC_DATA_TYPE_INT64, oValtemp);
+	}
+	else if ((METRIC_DATA_TYPE_STRING == tempYmlDataType) && (enPOLLED_VALUE_STRING == a_stUpdate.m_eValueType))
+	{
+		CValObj oValtemp(METRIC_DATA_TYPE_STRING, a_stUpdate.m_sValue);
+		a_rValobj.assignNewDataTypeValue(METRIC_DATA_TYPE_STRING, oValtemp);
+	}
+	else if ((METRIC_DATA_TYPE_FLOAT == tempYmlDataType) && (true == bIsNumber))
+	{
+		CValObj oValtemp(METRIC_DATA_TYPE_FLOAT, static_cast<float>(dValue));
+		a_rValobj.assignNewDataTypeValue(METRIC_DATA_TYPE_FLOAT, oValtemp);
+	}
+	else if ((METRIC_DATA_TYPE_DOUBLE == tempYmlDataType) && (true == bIsNumber))
+	{
+		CValObj oValtemp(METRIC_DATA_TYPE_DOUBLE, dValue);
+		a_rValobj.assignNewDataTypeValue(METRIC_DATA_TYPE_DOUBLE, oValtemp);
+	}
+	else
+	{
+		DO_LOG_ERROR(
+				"Invalid data type or mismatch found. Mentioned type in Yml file : "
+						+ std::to_string(tempYmlDataType) + ", Value datatype :"
+						+ std::to_string(a_stUpdate.m_eValueType));
+		return false;
+	}
+	return true;
+}
+
 /**
  * Validates data parsed from update message of a real device
  * @param a_sValue :[in] value of "value" key
@@ -972,7 +1110,8 @@ bool CSparkPlugDev::validateRealDeviceUpdateData(
 }
 
 /**
- * Parses real device update message and stores metrics and corresponding values
+ * Parses real device update message and stores metrics and corresponding values.
+ * Update is either JSON or binary polled update; binary update is used as it is.
  * @param a_sPayLoad :[in] payload containing metrics
  * @param a_stRefActionVec :[out] action vector
  * @return map containing metric and corresponding values
@@ -985,11 +1124,16 @@ bool CSparkPlugDev::processRealDeviceUpdateMsg(const std::string a_sPayLoad, std
 		uint64_t usec{0}, lastGoodUsec{0};
 		uint32_t error_code{0};
 		CValObj oValObj;
-		bool bRet = parseRealDeviceUpdateMsg(a_sPayLoad, 
-			sMetric, sValue, sStatus, usec, lastGoodUsec, error_code);
+		thread_local stPolledUpdate stUpdate;
+		bool bIsBinary = CPolledUpdateCodec::isPolledUpdate(a_sPayLoad.data(), a_sPayLoad.size());
+		bool bRet = (true == bIsBinary) ?
+			parseRealDeviceUpdate(a_sPayLoad, stUpdate, sMetric, sValue, sStatus, usec, lastGoodUsec, error_code) :
+			parseRealDeviceUpdateMsg(a_sPayLoad, sMetric, sValue, sStatus, usec, lastGoodUsec, error_code);
+		// binary update is identified by its data topic in logs
+		const std::string &sMsgDesc = (true == bIsBinary) ? stUpdate.m_sDataTopic : a_sPayLoad;
 		if(false == bRet)
 		{
-			DO_LOG_ERROR("Unable to parse message: " + a_sPayLoad);
+			DO_LOG_ERROR("Unable to parse message: " + sMsgDesc);
 			return false;
 		}
 
@@ -1001,7 +1145,7 @@ bool CSparkPlugDev::processRealDeviceUpdateMsg(const std::string a_sPayLoad, std
 		bRet = validateRealDeviceUpdateData(sValue, sStatus, error_code, bIsGood, bDeathErrorCode);
 		if(false == bRet)
 		{
-			DO_LOG_ERROR("Message validation failed: " + a_sPayLoad);
+			DO_LOG_ERROR("Message validation failed: " + sMsgDesc);
 			return false;
 		}
 		
@@ -1022,7 +1166,9 @@ bool CSparkPlugDev::processRealDeviceUpdateMsg(const std::string a_sPayLoad, std
 			return false;
 		}
 		CMetric &refMyMetric = *pOtherMetric;
-		if ( false == parseScaledValueRealDevices(a_sPayLoad, sMetric, oValObj))
+		bRet = (true == bIsBinary) ? setScaledValueRealDevices(stUpdate, sMetric, oValObj) :
+			parseScaledValueRealDevices(a_sPayLoad, sMetric, oValObj);
+		if ( false == bRet)
 		{
 			DO_LOG_ERROR("Error in parseScaledValueRealDevices. ");
 			return false;
@@ -23,9 +23,13 @@ CPP_SRCS += \
 ../Test/Src/CConfigManager_ut.cpp \
 ../Test/Src/CommonDataShare_ut.cpp \
 ../Test/Src/EnvironmentVarHandler_ut.cpp \
+../Test/Src/EmbBatch_ut.cpp \
+../Test/Src/JsonEnvelope_ut.cpp \
 ../Test/Src/Logger_ut.cpp \
 ../Test/Src/MQTTPubSubClient_ut.cpp \
 ../Test/Src/NetworkInfo_ut.cpp \
+../Test/Src/PolledUpdate_ut.cpp \
+../Test/Src/MqttSpool_ut.cpp \
 ../Test/Src/QueueHandler_ut.cpp \
 ../Test/Src/ZmqHandler_ut.cpp 
 
@@ -33,9 +37,13 @@ OBJS += \
 ./Test/Src/CConfigManager_ut.o \
 ./Test/Src/CommonDataShare_ut.o \
 ./Test/Src/EnvironmentVarHandler_ut.o \
+./Test/Src/EmbBatch_ut.o \
+./Test/Src/JsonEnvelope_ut.o \
 ./Test/Src/Logger_ut.o \
 ./Test/Src/MQTTPubSubClient_ut.o \
 ./Test/Src/NetworkInfo_ut.o \
+./Test/Src/PolledUpdate_ut.o \
+./Test/Src/MqttSpool_ut.o \
 ./Test/Src/QueueHandler_ut.o \
 ./Test/Src/ZmqHandler_ut.o 
 
@@ -43,9 +51,13 @@ CPP_DEPS += \
 ./Test/Src/CConfigManager_ut.d \
 ./Test/Src/CommonDataShare_ut.d \
 ./Test/Src/EnvironmentVarHandler_ut.d \
+./Test/Src/EmbBatch_ut.d \
+./Test/Src/JsonEnvelope_ut.d \
 ./Test/Src/Logger_ut.d \
 ./Test/Src/MQTTPubSubClient_ut.d \
 ./Test/Src/NetworkInfo_ut.d \
+./Test/Src/PolledUpdate_ut.d \
+./Test/Src/MqttSpool_ut.d \
 ./Test/Src/QueueHandler_ut.d \
 ./Test/Src/ZmqHandler_ut.d 
 
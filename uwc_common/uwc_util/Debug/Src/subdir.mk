@@ -23,10 +23,14 @@
 CPP_SRCS += \
 ../Src/CommonDataShare.cpp \
 ../Src/ConfigManager.cpp \
+../Src/EmbBatch.cpp \
 ../Src/EnvironmentVarHandler.cpp \
+../Src/JsonEnvelope.cpp \
 ../Src/Logger.cpp \
 ../Src/MQTTPubSubClient.cpp \
 ../Src/NetworkInfo.cpp \
+../Src/PolledUpdate.cpp \
+../Src/MqttSpool.cpp \
 ../Src/QueueHandler.cpp \
 ../Src/YamlUtil.cpp \
 ../Src/ZmqHandler.cpp 
@@ -34,10 +38,14 @@ CPP_SRCS += \
 OBJS += \
 ./Src/CommonDataShare.o \
 ./Src/ConfigManager.o \
+./Src/EmbBatch.o \
 ./Src/EnvironmentVarHandler.o \
+./Src/JsonEnvelope.o \
 ./Src/Logger.o \
 ./Src/MQTTPubSubClient.o \
 ./Src/NetworkInfo.o \
+./Src/PolledUpdate.o \
+./Src/MqttSpool.o \
 ./Src/QueueHandler.o \
 ./Src/YamlUtil.o \
 ./Src/ZmqHandler.o 
@@ -45,10 +53,14 @@ OBJS += \
 CPP_DEPS += \
 ./Src/CommonDataShare.d \
 ./Src/ConfigManager.d \
+./Src/EmbBatch.d \
 ./Src/EnvironmentVarHandler.d \
+./Src/JsonEnvelope.d \
 ./Src/Logger.d \
 ./Src/MQTTPubSubClient.d \
 ./Src/NetworkInfo.d \
+./Src/PolledUpdate.d \
+./Src/MqttSpool.d \
 ./Src/QueueHandler.d \
 ./Src/YamlUtil.d \
 ./Src/ZmqHandler.d 
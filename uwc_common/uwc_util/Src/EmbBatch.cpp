@@ -0,0 +1,510 @@
+/********************************************************************************
+* Copyright (c) 2021 Intel Corporation.
+
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*********************************************************************************/
+
+#include "EmbBatch.hpp"
+#include "Logger.hpp"
+#include <cstring>
+#include <vector>
+#include <algorithm>
+
+// Unnamed namespace to define helpers
+namespace
+{
+	/** writes integer at position in little endian order*/
+	void writeLE(char *a_pDst, uint64_t a_u64Val, size_t a_len)
+	{
+		for(size_t i = 0; i < a_len; ++i)
+		{
+			a_pDst[i] = (char)((a_u64Val >> (8 * i)) & 0xFF);
+		}
+	}
+
+	/** reads little endian integer from position*/
+	uint32_t readLE(const char *a_pSrc, size_t a_len)
+	{
+		uint32_t u32Val = 0;
+		for(size_t i = 0; i < a_len; ++i)
+		{
+			u32Val |= ((uint32_t)(uint8_t)a_pSrc[i]) << (8 * i);
+		}
+		return u32Val;
+	}
+}
+
+/**
+ * Constructor
+ * @param None
+ * @return None
+ */
+CEmbBatchPublisher::CEmbBatchPublisher() : m_stRTCfg{0, 0}, m_stNRTCfg{0, 0}, m_bIsStop{false}
+{
+}
+
+/**
+ * Destructor, publishes pending batches and stops flush thread
+ * @param None
+ * @return None
+ */
+CEmbBatchPublisher::~CEmbBatchPublisher()
+{
+	stop();
+}
+
+/**
+ * Maintain single instance of this class
+ * @param None
+ * @return Reference of this instance of this class
+ */
+CEmbBatchPublisher& CEmbBatchPublisher::instance()
+{
+	static CEmbBatchPublisher _self;
+	return _self;
+}
+
+/**
+ * Sets limits of RT and non-RT batches and starts flush thread if batching
+ * is enabled for any of these. To be called once before messages are added.
+ * @param a_stRTCfg :[in] limits of RT batches
+ * @param a_stNRTCfg :[in] limits of non-RT batches
+ * @return true/false based on success/failure
+ */
+bool CEmbBatchPublisher::init(const stEmbBatchCfg &a_stRTCfg, const stEmbBatchCfg &a_stNRTCfg)
+{
+	try
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutexBatch);
+			m_stRTCfg = a_stRTCfg;
+			m_stNRTCfg = a_stNRTCfg;
+		}
+		if(((true == isEnabled(true)) || (true == isEnabled(false))) &&
+				(false == m_threadFlush.joinable()))
+		{
+			m_bIsStop = false;
+			m_threadFlush = std::thread(&CEmbBatchPublisher::flushThread, this);
+		}
+		return true;
+	}
+	catch(std::exception &e)
+	{
+		DO_LOG_FATAL("Failed to start batch publisher: " + std::string(e.what()));
+	}
+	return false;
+}
+
+/**
+ * Stops flush thread. Pending batches are published before thread exits.
+ * @param None
+ * @return None
+ */
+void CEmbBatchPublisher::stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutexBatch);
+		m_bIsStop = true;
+	}
+	m_cvBatch.notify_all();
+	if(true == m_threadFlush.joinable())
+	{
+		m_threadFlush.join();
+	}
+}
+
+/**
+ * Moves batch payload to list of batches to be published by flush thread
+ * @param a_sBuf :[in/out] batch payload, having header filled
+ * @param a_pPubHandle :[in] publisher of topic
+ * @return None
+ */
+void CEmbBatchPublisher::takeBatch(std::string &a_sBuf, zmq_handler::stZmqPubHandle *a_pPubHandle)
+{
+	m_vToPublish.push_back(std::make_pair(a_pPubHandle, std::string()));
+	m_vToPublish.back().second.swap(a_sBuf);
+}
+
+/**
+ * Appends a message to batch payload
+ * @param a_sBuf :[in/out] batch payload
+ * @param a_sDataTopic :[in] data topic of message
+ * @param a_pMsg :[in] serialized JSON message
+ * @param a_len :[in] length of message
+ * @return None
+ */
+void CEmbBatchPublisher::appendEntry(std::string &a_sBuf, const std::string &a_sDataTopic, const char *a_pMsg, size_t a_len)
+{
+	char szHeader[EMB_BATCH_ENTRY_HEADER_LEN];
+	writeLE(szHeader, a_sDataTopic.size(), 2);
+	writeLE(szHeader + 2, a_len, 4);
+	a_sBuf.append(szHeader, EMB_BATCH_ENTRY_HEADER_LEN);
+	a_sBuf.append(a_sDataTopic);
+	a_sBuf.append(a_pMsg, a_len);
+}
+
+/**
+ * Fills header of batch payload. Payload starts with room for header.
+ * @param a_sBuf :[in/out] batch payload
+ * @param a_u32Count :[in] number of entries in payload
+ * @return None
+ */
+void CEmbBatchPublisher::fillHeader(std::string &a_sBuf, uint32_t a_u32Count)
+{
+	if(a_sBuf.size() < EMB_BATCH_HEADER_LEN)
+	{
+		a_sBuf.insert(0, EMB_BATCH_HEADER_LEN - a_sBuf.size(), '\0');
+	}
+	a_sBuf.replace(0, 4, EMB_BATCH_MAGIC, 4);
+	a_sBuf[4] = (char)EMB_BATCH_VERSION;
+	a_sBuf[5] = a_sBuf[6] = a_sBuf[7] = '\0';
+	writeLE(&a_sBuf[8], a_u32Count, 4);
+}
+
+/**
+ * Adds serialized message to batch of EII topic
+ * @param a_sBatchTopic :[in] EII topic on which batch is published
+ * @param a_bIsRT :[in] RT or non-RT message(true or false)
+ * @param a_sDataTopic :[in] data topic of message
+ * @param a_pMsg :[in] serialized JSON message
+ * @param a_len :[in] length of message
+ * @return true/false based on success/failure, message is to be published
+ * 			without batching on failure
+ */
+bool CEmbBatchPublisher::addMsg(const std::string &a_sBatchTopic, bool a_bIsRT,
+		const std::string &a_sDataTopic, const char *a_pMsg, size_t a_len)
+{
+	if((NULL == a_pMsg) || (0 == a_len) || (0xFFFF < a_sDataTopic.size()) ||
+			(false == isEnabled(a_bIsRT)) || (true == m_bIsStop.load()))
+	{
+		return false;
+	}
+
+	bool bIsNotify = false;
+	try
+	{
+		std::unique_lock<std::mutex> lock(m_mutexBatch);
+		auto itr = m_mapBatch.find(a_sBatchTopic);
+		if(m_mapBatch.end() == itr)
+		{
+			// publisher is resolved when first message of topic is added
+			stEmbBatch stBatch;
+			stBatch.m_u32Count = 0;
+			stBatch.m_bIsRT = a_bIsRT;
+			stBatch.m_pPubHandle = zmq_handler::getPubHandle(a_sBatchTopic);
+			if(NULL == stBatch.m_pPubHandle)
+			{
+				DO_LOG_ERROR("Batch publisher is not available for topic: " + a_sBatchTopic);
+				return false;
+			}
+			itr = m_mapBatch.insert(std::make_pair(a_sBatchTopic, stBatch)).first;
+		}
+
+		stEmbBatch &stBatch = itr->second;
+		if(0 == stBatch.m_u32Count)
+		{
+			// first message starts latency window of batch
+			stBatch.m_sBuf.assign(EMB_BATCH_HEADER_LEN, '\0');
+			stBatch.m_bIsRT = a_bIsRT;
+			stBatch.m_tpFlush = std::chrono::steady_clock::now() +
+					std::chrono::milliseconds(getCfg(a_bIsRT).m_u32MaxLatencyMs);
+			bIsNotify = true;
+		}
+		appendEntry(stBatch.m_sBuf, a_sDataTopic, a_pMsg, a_len);
+		++stBatch.m_u32Count;
+		if(stBatch.m_u32Count >= getCfg(stBatch.m_bIsRT).m_u32MaxCount)
+		{
+			// full batch is closed here, so that a batch never exceeds max count
+			fillHeader(stBatch.m_sBuf, stBatch.m_u32Count);
+			size_t uiSize = stBatch.m_sBuf.size();
+			stBatch.m_qFull.push_back(std::string());
+			stBatch.m_qFull.back().swap(stBatch.m_sBuf);
+			stBatch.m_sBuf.reserve(uiSize);
+			stBatch.m_u32Count = 0;
+			bIsNotify = true;
+		}
+	}
+	catch(std::exception &e)
+	{
+		DO_LOG_ERROR("Failed to add message to batch: " + std::string(e.what()));
+		return false;
+	}
+
+	if(true == bIsNotify)
+	{
+		m_cvBatch.notify_one();
+	}
+	return true;
+}
+
+/**
+ * Adds message envelope to batch of EII topic. Message is serialized at
+ * this point, hence envelope can be reused once this function returns.
+ * @param a_sUsec :[out] USEC timestamp value at which a message is added
+ * @param a_pMsg :[in] message to add, it must have data_topic field
+ * @param a_sBatchTopic :[in] EII topic on which batch is published
+ * @param a_bIsRT :[in] RT or non-RT message(true or false)
+ * @param a_sPubTimeField :[in] key for timestamp, empty if timestamp is not needed
+ * @return true/false based on success/failure, message is to be published
+ * 			without batching on failure
+ */
+bool CEmbBatchPublisher::addMsg(std::string &a_sUsec, msg_envelope_t *a_pMsg, const std::string &a_sBatchTopic,
+		bool a_bIsRT, const std::string &a_sPubTimeField)
+{
+	if((NULL == a_pMsg) || (false == isEnabled(a_bIsRT)))
+	{
+		return false;
+	}
+
+	msg_envelope_elem_body_t *pDataTopic = NULL;
+	if((MSG_SUCCESS != msgbus_msg_envelope_get(a_pMsg, "data_topic", &pDataTopic)) ||
+			(NULL == pDataTopic) || (MSG_ENV_DT_STRING != pDataTopic->type))
+	{
+		DO_LOG_ERROR("data_topic is not present in message to batch");
+		return false;
+	}
+
+	if(false == a_sPubTimeField.empty())
+	{
+		auto p1 = std::chrono::system_clock::now();
+		unsigned long uTime = (unsigned long)(std::chrono::duration_cast<std::chrono::microseconds>(p1.time_since_epoch()).count());
+		a_sUsec = std::to_string(uTime);
+		zmq_handler::setStringField(a_pMsg, a_sPubTimeField.c_str(), a_sUsec.c_str());
+	}
+
+	bool bRet = false;
+	msg_envelope_serialized_part_t *parts = NULL;
+	int num_parts = msgbus_msg_envelope_serialize(a_pMsg, &parts);
+	if((num_parts > 0) && (NULL != parts) && (NULL != parts[0].bytes))
+	{
+		bRet = addMsg(a_sBatchTopic, a_bIsRT, pDataTopic->body.string,
+				parts[0].bytes, strnlen(parts[0].bytes, parts[0].len));
+	}
+	else
+	{
+		DO_LOG_ERROR("Failed to serialize message to batch");
+	}
+	if(NULL != parts)
+	{
+		msgbus_msg_envelope_serialize_destroy(parts, num_parts);
+	}
+	// on failure, message is published without batching which sets timestamp again
+	return bRet;
+}
+
+/**
+ * Publishes all pending batches irrespective of their limits
+ * @param None
+ * @return None
+ */
+void CEmbBatchPublisher::flushAll()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutexBatch);
+		for(auto &itr : m_mapBatch)
+		{
+			if(0 != itr.second.m_u32Count)
+			{
+				itr.second.m_tpFlush = std::chrono::steady_clock::time_point::min();
+			}
+		}
+	}
+	m_cvBatch.notify_one();
+}
+
+/**
+ * Thread function publishing batches which are full or whose latency
+ * bound is reached. Batches are taken out of batch map under lock and
+ * are published after lock is released.
+ * @param None
+ * @return None
+ */
+void CEmbBatchPublisher::flushThread()
+{
+	std::unique_lock<std::mutex> lock(m_mutexBatch);
+	while(true)
+	{
+		try
+		{
+			auto tpNow = std::chrono::steady_clock::now();
+			auto tpNext = std::chrono::steady_clock::time_point::max();
+			bool bIsStop = m_bIsStop.load();
+			for(auto &itr : m_mapBatch)
+			{
+				stEmbBatch &stBatch = itr.second;
+				while(false == stBatch.m_qFull.empty())
+				{
+					takeBatch(stBatch.m_qFull.front(), stBatch.m_pPubHandle);
+					stBatch.m_qFull.pop_front();
+				}
+				if(0 == stBatch.m_u32Count)
+				{
+					continue;
+				}
+				if((false == bIsStop) && (stBatch.m_tpFlush > tpNow))
+				{
+					tpNext = std::min(tpNext, stBatch.m_tpFlush);
+					continue;
+				}
+				fillHeader(stBatch.m_sBuf, stBatch.m_u32Count);
+				size_t uiSize = stBatch.m_sBuf.size();
+				takeBatch(stBatch.m_sBuf, stBatch.m_pPubHandle);
+				stBatch.m_sBuf.reserve(uiSize);
+				stBatch.m_u32Count = 0;
+			}
+
+			if(true == m_vToPublish.empty())
+			{
+				if(true == bIsStop)
+				{
+					break;
+				}
+				if(std::chrono::steady_clock::time_point::max() == tpNext)
+				{
+					m_cvBatch.wait(lock);
+				}
+				else
+				{
+					m_cvBatch.wait_until(lock, tpNext);
+				}
+				continue;
+			}
+
+			lock.unlock();
+			for(auto &prBatch : m_vToPublish)
+			{
+				publishBatch(prBatch.first, prBatch.second);
+			}
+			m_vToPublish.clear();
+			lock.lock();
+		}
+		catch(std::exception &e)
+		{
+			DO_LOG_ERROR("Failed to publish batch: " + std::string(e.what()));
+			m_vToPublish.clear();
+			if(false == lock.owns_lock())
+			{
+				lock.lock();
+			}
+		}
+	}
+}
+
+/**
+ * Publishes batch payload as CT_BLOB envelope
+ * @param a_pPubHandle :[in] publisher of topic
+ * @param a_sBuf :[in] batch payload
+ * @return true/false based on success/failure
+ */
+bool CEmbBatchPublisher::publishBatch(zmq_handler::stZmqPubHandle *a_pPubHandle, const std::string &a_sBuf)
+{
+	return zmq_handler::publishBlob(a_pPubHandle, a_sBuf.data(), a_sBuf.size());
+}
+
+/**
+ * Constructor
+ * @param None
+ * @return None
+ */
+CEmbBatchReader::CEmbBatchReader() : m_pCur{NULL}, m_pEnd{NULL}, m_u32Count{0}, m_u32Remaining{0}
+{
+}
+
+/**
+ * Checks if received envelope is a batch
+ * @param a_pMsg :[in] received envelope
+ * @return true/false based on whether envelope is a batch
+ */
+bool CEmbBatchReader::isBatch(msg_envelope_t *a_pMsg)
+{
+	if((NULL == a_pMsg) || (CT_BLOB != a_pMsg->content_type))
+	{
+		return false;
+	}
+	CEmbBatchReader oReader;
+	return oReader.open(a_pMsg);
+}
+
+/**
+ * Starts reading batch from received envelope
+ * @param a_pMsg :[in] received envelope
+ * @return true/false based on whether envelope has valid batch header
+ */
+bool CEmbBatchReader::open(msg_envelope_t *a_pMsg)
+{
+	msg_envelope_elem_body_t *pBlob = NULL;
+	if((NULL == a_pMsg) || (CT_BLOB != a_pMsg->content_type) ||
+			(MSG_SUCCESS != msgbus_msg_envelope_get(a_pMsg, NULL, &pBlob)) ||
+			(NULL == pBlob) || (MSG_ENV_DT_BLOB != pBlob->type) || (NULL == pBlob->body.blob))
+	{
+		m_u32Count = m_u32Remaining = 0;
+		return false;
+	}
+	return open(pBlob->body.blob->data, pBlob->body.blob->len);
+}
+
+/**
+ * Starts reading batch from payload
+ * @param a_pData :[in] batch payload
+ * @param a_len :[in] length of payload
+ * @return true/false based on whether payload has valid batch header
+ */
+bool CEmbBatchReader::open(const char *a_pData, size_t a_len)
+{
+	m_u32Count = m_u32Remaining = 0;
+	if((NULL == a_pData) || (a_len < EMB_BATCH_HEADER_LEN) ||
+			(0 != memcmp(a_pData, EMB_BATCH_MAGIC, 4)) || (EMB_BATCH_VERSION != (uint8_t)a_pData[4]))
+	{
+		return false;
+	}
+	m_u32Count = m_u32Remaining = readLE(a_pData + 8, 4);
+	m_pCur = a_pData + EMB_BATCH_HEADER_LEN;
+	m_pEnd = a_pData + a_len;
+	return true;
+}
+
+/**
+ * Reads next entry of batch
+ * @param a_stEntry :[out] entry, it refers to batch payload
+ * @return true/false based on whether entry is read
+ */
+bool CEmbBatchReader::next(stEmbBatchEntry &a_stEntry)
+{
+	if((0 == m_u32Remaining) || ((size_t)(m_pEnd - m_pCur) < EMB_BATCH_ENTRY_HEADER_LEN))
+	{
+		m_u32Remaining = 0;
+		return false;
+	}
+	uint16_t u16TopicLen = (uint16_t)readLE(m_pCur, 2);
+	uint32_t u32MsgLen = readLE(m_pCur + 2, 4);
+	const char *pTopic = m_pCur + EMB_BATCH_ENTRY_HEADER_LEN;
+	if((size_t)(m_pEnd - pTopic) < ((size_t)u16TopicLen + u32MsgLen))
+	{
+		DO_LOG_ERROR("Batch entry is truncated");
+		m_u32Remaining = 0;
+		return false;
+	}
+	a_stEntry.m_pTopic = pTopic;
+	a_stEntry.m_u16TopicLen = u16TopicLen;
+	a_stEntry.m_pMsg = pTopic + u16TopicLen;
+	a_stEntry.m_u32MsgLen = u32MsgLen;
+	m_pCur = a_stEntry.m_pMsg + u32MsgLen;
+	--m_u32Remaining;
+	return true;
+}
@@ -0,0 +1,595 @@
+/********************************************************************************
+* Copyright (c) 2021 Intel Corporation.
+
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*********************************************************************************/
+
+#include "JsonEnvelope.hpp"
+#include "Logger.hpp"
+#include <cerrno>
+#include <cstdlib>
+
+/**
+ * Constructor
+ * @param None
+ * @return None
+ */
+CJsonToEnvelope::CJsonToEnvelope() : m_pCur{NULL}, m_pEnd{NULL},
+	m_vKeyBuf(JSON_ENVELOPE_MAX_DEPTH + 1), m_sValBuf{}
+{
+}
+
+/**
+ * Skips whitespace at current position
+ * @param None
+ * @return None
+ */
+void CJsonToEnvelope::skipWhitespace()
+{
+	while((m_pCur < m_pEnd) &&
+		((' ' == *m_pCur) || ('\t' == *m_pCur) || ('\n' == *m_pCur) || ('\r' == *m_pCur)))
+	{
+		++m_pCur;
+	}
+}
+
+/**
+ * Sets JSON text to convert and consumes opening brace of top level object
+ * @param a_pJson	:[in] JSON text
+ * @param a_len		:[in] length of JSON text
+ * @return 	true : if text starts with an object,
+ * 			false : otherwise
+ */
+bool CJsonToEnvelope::start(const char *a_pJson, size_t a_len)
+{
+	if(NULL == a_pJson)
+	{
+		return false;
+	}
+	m_pCur = a_pJson;
+	m_pEnd = a_pJson + a_len;
+	skipWhitespace();
+	if((m_pCur >= m_pEnd) || ('{' != *m_pCur))
+	{
+		return false;
+	}
+	++m_pCur;
+	return true;
+}
+
+/**
+ * Checks that nothing except whitespace follows top level object
+ * @param None
+ * @return 	true : if whole text is consumed,
+ * 			false : otherwise
+ */
+bool CJsonToEnvelope::isAtEnd()
+{
+	skipWhitespace();
+	// text may be NUL terminated within given length
+	return ((m_pCur >= m_pEnd) || ('\0' == *m_pCur));
+}
+
+/**
+ * Reads 4 hex digits of \u escape
+ * @param a_u32Code	:[out] code unit
+ * @return 	true : on success,
+ * 			false : on error
+ */
+bool CJsonToEnvelope::parseHex4(uint32_t &a_u32Code)
+{
+	if(m_pEnd - m_pCur < 4)
+	{
+		return false;
+	}
+	a_u32Code = 0;
+	for(int i = 0; i < 4; ++i, ++m_pCur)
+	{
+		char c = *m_pCur;
+		a_u32Code <<= 4;
+		if(c >= '0' && c <= '9')
+		{
+			a_u32Code |= (uint32_t)(c - '0');
+		}
+		else if(c >= 'a' && c <= 'f')
+		{
+			a_u32Code |= (uint32_t)(c - 'a' + 10);
+		}
+		else if(c >= 'A' && c <= 'F')
+		{
+			a_u32Code |= (uint32_t)(c - 'A' + 10);
+		}
+		else
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * Decodes JSON string at current position
+ * @param a_sOut	:[out] decoded string, its buffer is reused
+ * @return 	true : on success,
+ * 			false : on error
+ */
+bool CJsonToEnvelope::parseString(std::string &a_sOut)
+{
+	if((m_pCur >= m_pEnd) || ('"' != *m_pCur))
+	{
+		return false;
+	}
+	++m_pCur;
+	a_sOut.clear();
+
+	while(m_pCur < m_pEnd)
+	{
+		// copy run of plain characters at once
+		const char *pRun = m_pCur;
+		while((m_pCur < m_pEnd) && ('"' != *m_pCur) && ('\\' != *m_pCur) &&
+			((unsigned char)*m_pCur >= 0x20))
+		{
+			++m_pCur;
+		}
+		a_sOut.append(pRun, m_pCur - pRun);
+		if(m_pCur >= m_pEnd)
+		{
+			return false;
+		}
+
+		char c = *m_pCur++;
+		if('"' == c)
+		{
+			return true;
+		}
+		if('\\' != c || m_pCur >= m_pEnd)
+		{
+			// control character or unterminated escape
+			return false;
+		}
+
+		c = *m_pCur++;
+		switch(c)
+		{
+		case '"':
+		case '\\':
+		case '/':
+			a_sOut.push_back(c);
+			break;
+		case 'b':
+			a_sOut.push_back('\b');
+			break;
+		case 'f':
+			a_sOut.push_back('\f');
+			break;
+		case 'n':
+			a_sOut.push_back('\n');
+			break;
+		case 'r':
+			a_sOut.push_back('\r');
+			break;
+		case 't':
+			a_sOut.push_back('\t');
+			break;
+		case 'u':
+		{
+			uint32_t u32Code = 0;
+			if(false == parseHex4(u32Code))
+			{
+				return false;
+			}
+			if(u32Code >= 0xD800 && u32Code <= 0xDBFF)
+			{
+				// high surrogate must be followed by low surrogate
+				uint32_t u32Low = 0;
+				if((m_pEnd - m_pCur < 2) || ('\\' != m_pCur[0]) || ('u' != m_pCur[1]))
+				{
+					return false;
+				}
+				m_pCur += 2;
+				if((false == parseHex4(u32Low)) || (u32Low < 0xDC00) || (u32Low > 0xDFFF))
+				{
+					return false;
+				}
+				u32Code = 0x10000 + ((u32Code - 0xD800) << 10) + (u32Low - 0xDC00);
+			}
+			// encode as UTF-8
+			if(u32Code < 0x80)
+			{
+				a_sOut.push_back((char)u32Code);
+			}
+			else if(u32Code < 0x800)
+			{
+				a_sOut.push_back((char)(0xC0 | (u32Code >> 6)));
+				a_sOut.push_back((char)(0x80 | (u32Code & 0x3F)));
+			}
+			else if(u32Code < 0x10000)
+			{
+				a_sOut.push_back((char)(0xE0 | (u32Code >> 12)));
+				a_sOut.push_back((char)(0x80 | ((u32Code >> 6) & 0x3F)));
+				a_sOut.push_back((char)(0x80 | (u32Code & 0x3F)));
+			}
+			else
+			{
+				a_sOut.push_back((char)(0xF0 | (u32Code >> 18)));
+				a_sOut.push_back((char)(0x80 | ((u32Code >> 12) & 0x3F)));
+				a_sOut.push_back((char)(0x80 | ((u32Code >> 6) & 0x3F)));
+				a_sOut.push_back((char)(0x80 | (u32Code & 0x3F)));
+			}
+			break;
+		}
+		default:
+			return false;
+		}
+	}
+	return false;
+}
+
+/**
+ * Matches literal true, false or null at current position
+ * @param a_pszLiteral	:[in] literal to match
+ * @param a_len			:[in] length of literal
+ * @return 	true : if literal matches,
+ * 			false : otherwise
+ */
+bool CJsonToEnvelope::matchLiteral(const char *a_pszLiteral, size_t a_len)
+{
+	if((size_t)(m_pEnd - m_pCur) < a_len)
+	{
+		return false;
+	}
+	for(size_t i = 0; i < a_len; ++i)
+	{
+		if(m_pCur[i] != a_pszLiteral[i])
+		{
+			return false;
+		}
+	}
+	m_pCur += a_len;
+	return true;
+}
+
+/**
+ * Converts JSON number at current position
+ * @param None
+ * @return integer element if number has no fraction or exponent and fits in 64 bits,
+ * 			floating element otherwise; NULL on error
+ */
+msg_envelope_elem_body_t* CJsonToEnvelope::parseNumber()
+{
+	const char *pStart = m_pCur;
+	bool bIsInt = true;
+	auto isDigit = [this]() { return (m_pCur < m_pEnd) && (*m_pCur >= '0') && (*m_pCur <= '9'); };
+
+	if((m_pCur < m_pEnd) && ('-' == *m_pCur))
+	{
+		++m_pCur;
+	}
+	if(false == isDigit())
+	{
+		return NULL;
+	}
+	while(isDigit())
+	{
+		++m_pCur;
+	}
+	if((m_pCur < m_pEnd) && ('.' == *m_pCur))
+	{
+		bIsInt = false;
+		++m_pCur;
+		if(false == isDigit())
+		{
+			return NULL;
+		}
+		while(isDigit())
+		{
+			++m_pCur;
+		}
+	}
+	if((m_pCur < m_pEnd) && (('e' == *m_pCur) || ('E' == *m_pCur)))
+	{
+		bIsInt = false;
+		++m_pCur;
+		if((m_pCur < m_pEnd) && (('+' == *m_pCur) || ('-' == *m_pCur)))
+		{
+			++m_pCur;
+		}
+		if(false == isDigit())
+		{
+			return NULL;
+		}
+		while(isDigit())
+		{
+			++m_pCur;
+		}
+	}
+
+	// text need not be NUL terminated, hence number is copied before conversion
+	m_sValBuf.assign(pStart, m_pCur - pStart);
+	if(true == bIsInt)
+	{
+		errno = 0;
+		long long llVal = strtoll(m_sValBuf.c_str(), NULL, 10);
+		if(ERANGE != errno)
+		{
+			return msgbus_msg_envelope_new_integer((int64_t)llVal);
+		}
+	}
+	return msgbus_msg_envelope_new_floating(strtod(m_sValBuf.c_str(), NULL));
+}
+
+/**
+ * Converts JSON value at current position
+ * @param a_u32Depth	:[in] nesting level of value
+ * @return element on success; NULL on error
+ */
+msg_envelope_elem_body_t* CJsonToEnvelope::parseValue(uint32_t a_u32Depth)
+{
+	skipWhitespace();
+	if(m_pCur >= m_pEnd)
+	{
+		return NULL;
+	}
+
+	switch(*m_pCur)
+	{
+	case '"':
+		if(false == parseString(m_sValBuf))
+		{
+			return NULL;
+		}
+		return msgbus_msg_envelope_new_string(m_sValBuf.c_str());
+	case '{':
+	{
+		if(a_u32Depth >= JSON_ENVELOPE_MAX_DEPTH)
+		{
+			return NULL;
+		}
+		++m_pCur;
+		msg_envelope_elem_body_t *pObj = msgbus_msg_envelope_new_object();
+		if(NULL == pObj)
+		{
+			return NULL;
+		}
+		if(false == parseMembers(a_u32Depth + 1, NULL, pObj))
+		{
+			msgbus_msg_envelope_elem_destroy(pObj);
+			return NULL;
+		}
+		return pObj;
+	}
+	case '[':
+		if(a_u32Depth >= JSON_ENVELOPE_MAX_DEPTH)
+		{
+			return NULL;
+		}
+		++m_pCur;
+		return parseArray(a_u32Depth + 1);
+	case 't':
+		return matchLiteral("true", 4) ? msgbus_msg_envelope_new_bool(true) : NULL;
+	case 'f':
+		return matchLiteral("false", 5) ? msgbus_msg_envelope_new_bool(false) : NULL;
+	case 'n':
+		return matchLiteral("null", 4) ? msgbus_msg_envelope_new_none() : NULL;
+	default:
+		return parseNumber();
+	}
+}
+
+/**
+ * Converts JSON array after its opening bracket
+ * @param a_u32Depth	:[in] nesting level of array elements
+ * @return array element on success; NULL on error
+ */
+msg_envelope_elem_body_t* CJsonToEnvelope::parseArray(uint32_t a_u32Depth)
+{
+	msg_envelope_elem_body_t *pArr = msgbus_msg_envelope_new_array();
+	if(NULL == pArr)
+	{
+		return NULL;
+	}
+
+	skipWhitespace();
+	if((m_pCur < m_pEnd) && (']' == *m_pCur))
+	{
+		++m_pCur;
+		return pArr;
+	}
+
+	while(true)
+	{
+		msg_envelope_elem_body_t *pElem = parseValue(a_u32Depth);
+		if(NULL == pElem)
+		{
+			break;
+		}
+		if(MSG_SUCCESS != msgbus_msg_envelope_elem_array_add(pArr, pElem))
+		{
+			msgbus_msg_envelope_elem_destroy(pElem);
+			break;
+		}
+
+		skipWhitespace();
+		if(m_pCur >= m_pEnd)
+		{
+			break;
+		}
+		char c = *m_pCur++;
+		if(']' == c)
+		{
+			return pArr;
+		}
+		if(',' != c)
+		{
+			break;
+		}
+	}
+
+	msgbus_msg_envelope_elem_destroy(pArr);
+	return NULL;
+}
+
+/**
+ * Converts members of JSON object after its opening brace. Members are put
+ * either in envelope (top level object) or in object element (nested object).
+ * For duplicate key, first value is kept.
+ * @param a_u32Depth	:[in] nesting level of members
+ * @param a_pMsg		:[in] envelope in which to put members, NULL for nested object
+ * @param a_pObj		:[in] object element in which to put members, used if a_pMsg is NULL
+ * @return 	true : on success,
+ * 			false : on error
+ */
+bool CJsonToEnvelope::parseMembers(uint32_t a_u32Depth, msg_envelope_t *a_pMsg, msg_envelope_elem_body_t *a_pObj)
+{
+	skipWhitespace();
+	if((m_pCur < m_pEnd) && ('}' == *m_pCur))
+	{
+		++m_pCur;
+		return true;
+	}
+
+	// key buffer of this level is not touched by nested values
+	std::string &sKey = m_vKeyBuf[a_u32Depth];
+	while(true)
+	{
+		skipWhitespace();
+		if(false == parseString(sKey))
+		{
+			return false;
+		}
+		skipWhitespace();
+		if((m_pCur >= m_pEnd) || (':' != *m_pCur))
+		{
+			return false;
+		}
+		++m_pCur;
+
+		msg_envelope_elem_body_t *pElem = parseValue(a_u32Depth);
+		if(NULL == pElem)
+		{
+			return false;
+		}
+		msgbus_ret_t ret = (NULL != a_pMsg) ?
+				msgbus_msg_envelope_put(a_pMsg, sKey.c_str(), pElem) :
+				msgbus_msg_envelope_elem_object_put(a_pObj, sKey.c_str(), pElem);
+		if(MSG_SUCCESS != ret)
+		{
+			msgbus_msg_envelope_elem_destroy(pElem);
+		}
+
+		skipWhitespace();
+		if(m_pCur >= m_pEnd)
+		{
+			return false;
+		}
+		char c = *m_pCur++;
+		if('}' == c)
+		{
+			return true;
+		}
+		if(',' != c)
+		{
+			return false;
+		}
+	}
+}
+
+/**
+ * Converts JSON object text into new envelope. Members of object become
+ * elements of envelope.
+ * @param a_pJson	:[in] JSON text
+ * @param a_len		:[in] length of JSON text
+ * @return envelope on success, caller owns and destroys it;
+ * 			NULL on error
+ */
+msg_envelope_t* CJsonToEnvelope::convert(const char *a_pJson, size_t a_len)
+{
+	msg_envelope_t *pMsg = NULL;
+	try
+	{
+		if(false == start(a_pJson, a_len))
+		{
+			DO_LOG_ERROR("JSON text is not an object");
+			return NULL;
+		}
+		pMsg = msgbus_msg_envelope_new(CT_JSON);
+		if(NULL == pMsg)
+		{
+			DO_LOG_ERROR("could not create new msg envelope");
+			return NULL;
+		}
+		if((true == parseMembers(0, pMsg, NULL)) && (true == isAtEnd()))
+		{
+			return pMsg;
+		}
+		DO_LOG_ERROR("Invalid JSON at offset " + std::to_string(m_pCur - a_pJson));
+	}
+	catch(std::exception &ex)
+	{
+		DO_LOG_ERROR(ex.what());
+	}
+
+	if(NULL != pMsg)
+	{
+		msgbus_msg_envelope_destroy(pMsg);
+	}
+	return NULL;
+}
+
+/**
+ * Converts JSON object text into new object element, which can be put
+ * in another envelope
+ * @param a_pJson	:[in] JSON text
+ * @param a_len		:[in] length of JSON text
+ * @return object element on success, caller owns and destroys it;
+ * 			NULL on error
+ */
+msg_envelope_elem_body_t* CJsonToEnvelope::convertToObject(const char *a_pJson, size_t a_len)
+{
+	msg_envelope_elem_body_t *pObj = NULL;
+	try
+	{
+		if(false == start(a_pJson, a_len))
+		{
+			DO_LOG_ERROR("JSON text is not an object");
+			return NULL;
+		}
+		pObj = msgbus_msg_envelope_new_object();
+		if(NULL == pObj)
+		{
+			DO_LOG_ERROR("could not create new object element");
+			return NULL;
+		}
+		if((true == parseMembers(0, NULL, pObj)) && (true == isAtEnd()))
+		{
+			return pObj;
+		}
+		DO_LOG_ERROR("Invalid JSON at offset " + std::to_string(m_pCur - a_pJson));
+	}
+	catch(std::exception &ex)
+	{
+		DO_LOG_ERROR(ex.what());
+	}
+
+	if(NULL != pObj)
+	{
+		msgbus_msg_envelope_elem_destroy(pObj);
+	}
+	return NULL;
+}
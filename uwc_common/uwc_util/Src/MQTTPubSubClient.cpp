@@ -21,6 +21,7 @@
 *********************************************************************************/
 #include "MQTTPubSubClient.hpp"
 #include "Logger.hpp"
+#include <chrono>
 
 /**
  * This is a callback function to inform action failure related to mqtt
@@ -76,7 +77,8 @@ CMQTTPubSubClient::CMQTTPubSubClient(const std::string &a_sBrokerURL, std::strin
 	bool a_bIsTLS, std::string a_sCATrustStoreSecret, 
 	std::string a_sClientCertSecret, std::string a_sClientPvtKeySecret, 
 	std::string a_sListener)
-	: m_iQOS{a_iQOS}, m_sClientID{a_sClientID}, m_Client{a_sBrokerURL, a_sClientID}, m_Listener{a_sListener}
+	: m_iQOS{a_iQOS}, m_sClientID{a_sClientID}, m_Client{a_sBrokerURL, a_sClientID}, m_Listener{a_sListener},
+	m_u32Window{0}, m_u32MaxPending{1}, m_u64Dropped{0}
 {
 	try
 	{
@@ -177,24 +179,182 @@ void CMQTTPubSubClient::subscribe(const std::string &a_sTopic)
 }
 
 /**
- * This function publishes a message on MQTT broker
+ * This function publishes a message on MQTT broker. Message is not limited
+ * by publish window, publishMsgWindowed() is to be used for flow control.
  * @param a_pubMsg :[in] pointer to message to be published
  * @param a_bIsWaitForCompletion :[in] waits for completion
- * @return true/false status based on success/failure 
+ * @return true/false status based on success/failure, false if client is not connected
  */
 bool CMQTTPubSubClient::publishMsg(mqtt::message_ptr &a_pubMsg, bool a_bIsWaitForCompletion)
 {
 	try
 	{
-		if(true == m_Client.is_connected())
+		if(false == m_Client.is_connected())
+		{
+			DO_LOG_DEBUG(m_sClientID + ": Not connected. Message not published.");
+			return false;
+		}
+		a_pubMsg->set_qos(m_iQOS);
+		// failure of publish is logged in on_failure() of this class
+		mqtt::delivery_token_ptr pubtoken = m_Client.publish(a_pubMsg, nullptr, *this);
+		if(a_bIsWaitForCompletion && (nullptr != pubtoken))
+		{
+			pubtoken->wait();
+		}
+	}
+	catch (const std::exception &e)
+	{
+		DO_LOG_ERROR(e.what());
+		return false;
+	}
+	return true;
+}
+
+/**
+ * Releases token of acknowledged or failed message, publishes pending
+ * messages in freed window and wakes up waiting publishers. Token which
+ * is already released, e.g. by a late callback after connection is lost,
+ * is ignored.
+ * @param a_pToken :[in] token of message, NULL to release all, e.g. when connection is lost
+ * @return None
+ */
+void CMQTTPubSubClient::releaseInFlight(const mqtt::token *a_pToken)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutexInFlight);
+		if(NULL == a_pToken)
+		{
+			m_mapInFlight.clear();
+		}
+		else
+		{
+			m_mapInFlight.erase(a_pToken);
+		}
+		sendPending();
+	}
+	m_cvInFlight.notify_all();
+}
+
+/**
+ * Hands message to MQTT client and tracks its token in flight. Function is
+ * called with in-flight mutex locked, hence messages are handed over in order.
+ * @param a_pubMsg :[in] message to be published
+ * @return true/false status based on success/failure
+ */
+bool CMQTTPubSubClient::sendMsg(mqtt::message_ptr &a_pubMsg)
+{
+	a_pubMsg->set_qos(m_iQOS);
+	try
+	{
+		mqtt::delivery_token_ptr pubtoken = m_Client.publish(a_pubMsg, nullptr, *this);
+		if((0 != m_iQOS) && (nullptr != pubtoken))
+		{
+			m_mapInFlight[pubtoken.get()] = pubtoken;
+		}
+	}
+	catch (const std::exception &e)
+	{
+		DO_LOG_ERROR(e.what());
+		return false;
+	}
+	return true;
+}
+
+/**
+ * Checks if message can be handed to MQTT client now, i.e. client is
+ * connected and window has room. Function is called with in-flight mutex locked.
+ * @param None
+ * @return true/false based on whether window has room or not
+ */
+bool CMQTTPubSubClient::hasWindowRoom()
+{
+	return (true == m_Client.is_connected()) &&
+			((0 == m_u32Window) || (m_mapInFlight.size() < m_u32Window));
+}
+
+/**
+ * Publishes pending messages, oldest first, while window has room and
+ * client is connected. Function is called with in-flight mutex locked.
+ * @param None
+ * @return None
+ */
+void CMQTTPubSubClient::sendPending()
+{
+	while((false == m_dqPending.empty()) && (true == hasWindowRoom()))
+	{
+		if(false == sendMsg(m_dqPending.front()))
+		{
+			// message is kept to be tried again
+			break;
+		}
+		m_dqPending.pop_front();
+	}
+}
+
+/**
+ * Sets window of windowed publish, to be called before connect
+ * @param a_u32Window :[in] max messages in flight, 0 means no limit
+ * @param a_u32MaxPending :[in] max messages waiting for room in window, at least 1
+ * @return None
+ */
+void CMQTTPubSubClient::setPublishWindow(uint32_t a_u32Window, uint32_t a_u32MaxPending)
+{
+	std::lock_guard<std::mutex> lock(m_mutexInFlight);
+	m_u32Window = a_u32Window;
+	m_u32MaxPending = (0 == a_u32MaxPending) ? 1 : a_u32MaxPending;
+	if(0 != a_u32Window)
+	{
+		m_ConOptions.set_max_inflight((int)a_u32Window);
+	}
+}
+
+/**
+ * Publishes message without waiting for its acknowledgement, while keeping
+ * messages in flight within window. When window is full or client is not
+ * connected, message waits in pending queue and is published, in order, as
+ * soon as broker acknowledges earlier messages or client is connected.
+ * When pending queue is full, policy decides what happens.
+ * @param a_pubMsg :[in] message to be published
+ * @param a_ePolicy :[in] policy to be used when pending queue is full
+ * @param a_u32TimeoutMs :[in] max time to wait for room in pending queue, for block policy
+ * @return true : if message is published or queued,
+ * 			false : if message is not taken, for spool policy or when block policy times out
+ */
+bool CMQTTPubSubClient::publishMsgWindowed(mqtt::message_ptr &a_pubMsg, eMQTTPublishPolicy a_ePolicy, uint32_t a_u32TimeoutMs)
+{
+	try
+	{
+		std::unique_lock<std::mutex> lock(m_mutexInFlight);
+		// pending messages are published first, which keeps order of messages
+		if((true == m_dqPending.empty()) && (true == hasWindowRoom()))
 		{
-			a_pubMsg->set_qos(m_iQOS);
-			auto pubtoken = m_Client.publish(a_pubMsg, nullptr, m_Listener);
-			if(a_bIsWaitForCompletion)
+			return sendMsg(a_pubMsg);
+		}
+
+		switch(a_ePolicy)
+		{
+		case enPUBLISH_POLICY_SPOOL:
+			return false;
+
+		case enPUBLISH_POLICY_DROP_OLDEST:
+			if(m_dqPending.size() >= m_u32MaxPending)
 			{
-				pubtoken->wait();
+				m_dqPending.pop_front();
+				m_u64Dropped.fetch_add(1);
 			}
+			break;
+
+		default:
+			if(false == m_cvInFlight.wait_for(lock, std::chrono::milliseconds(a_u32TimeoutMs),
+					[this]() { return m_dqPending.size() < m_u32MaxPending; }))
+			{
+				return false;
+			}
+			break;
 		}
+		m_dqPending.push_back(a_pubMsg);
+		// window may have room after wait
+		sendPending();
 	}
 	catch (const std::exception &e)
 	{
@@ -204,6 +364,33 @@ bool CMQTTPubSubClient::publishMsg(mqtt::message_ptr &a_pubMsg, bool a_bIsWaitFo
 	return true;
 }
 
+/**
+ * Waits till windowed publish can hand a message to MQTT client without
+ * queuing it, i.e. no message is pending, client is connected and window has room
+ * @param a_u32TimeoutMs :[in] max time to wait in milliseconds
+ * @return true : if message can be published,
+ * 			false : if window is still full after timeout
+ */
+bool CMQTTPubSubClient::waitForPublishWindow(uint32_t a_u32TimeoutMs)
+{
+	std::unique_lock<std::mutex> lock(m_mutexInFlight);
+	return m_cvInFlight.wait_for(lock, std::chrono::milliseconds(a_u32TimeoutMs),
+			[this]() { return (true == m_dqPending.empty()) && (true == hasWindowRoom()); });
+}
+
+/**
+ * This is a callback function which gets called when broker acknowledges a published message
+ * @param token :[in] delivery token of message
+ * @return None
+ */
+void CMQTTPubSubClient::delivery_complete(mqtt::delivery_token_ptr token)
+{
+	if((0 != m_iQOS) && (nullptr != token))
+	{
+		releaseInFlight(token.get());
+	}
+}
+
 /**
  * This is a callback function which gets called when subscriber fails to send/receive/connect
  * @param tok :[in] failed message token
@@ -221,6 +408,16 @@ void CMQTTPubSubClient::on_failure(const mqtt::token& tok)
 				m_fcbDisconnected("CONNECT_FAILED");
 			}
 		}
+		else if(mqtt::token::Type::PUBLISH == tok.get_type())
+		{
+			auto top = tok.get_topics();
+			DO_LOG_ERROR(m_sClientID + ": Publish failed" + ((top && !top->empty()) ? (" for topic: " + (*top)[0]) : ""));
+			// delivery_complete() is not called for failed message
+			if(0 != m_iQOS)
+			{
+				releaseInFlight(&tok);
+			}
+		}
 	}
 	catch (const std::exception &e)
 	{
@@ -236,6 +433,11 @@ void CMQTTPubSubClient::on_failure(const mqtt::token& tok)
  */
 void CMQTTPubSubClient::on_success(const mqtt::token& tok)
 {
+	// publish uses this class as listener, its result is logged as by action listener
+	if(mqtt::token::Type::PUBLISH == tok.get_type())
+	{
+		static_cast<mqtt::iaction_listener&>(m_Listener).on_success(tok);
+	}
 }
 
 /**
@@ -248,6 +450,12 @@ void CMQTTPubSubClient::connected(const std::string& a_sCause)
 	try
 	{
 		DO_LOG_INFO(m_sClientID + " Connected: " + a_sCause);
+		// messages waiting for connection are published first
+		{
+			std::lock_guard<std::mutex> lock(m_mutexInFlight);
+			sendPending();
+		}
+		m_cvInFlight.notify_all();
 		if(m_bNotifyConnection)
 		{
 			m_fcbConnected(a_sCause);
@@ -269,6 +477,8 @@ void CMQTTPubSubClient::connection_lost(const std::string& a_sCause)
 	try
 	{
 		DO_LOG_ERROR(m_sClientID + ": Connection lost: " + a_sCause);
+		// messages in flight will not be acknowledged on this connection
+		releaseInFlight(NULL);
 
 		if(m_bNotifyDisConnection)
 		{
@@ -440,7 +650,44 @@ bool CMQTTBaseHandler::publishMsg(const std::string &a_sMsg, const std::string &
 			return false;
 		}
 		mqtt::message_ptr pubmsg = mqtt::make_message(a_sTopic, a_sMsg, m_QOS, false);
-		m_MQTTClient.publishMsg(pubmsg);
+		if(false == m_MQTTClient.publishMsg(pubmsg))
+		{
+			return false;
+		}
+
+		DO_LOG_DEBUG("Published message on Internal MQTT broker successfully with QOS:"+ std::to_string(m_QOS));
+
+		return true;
+	}
+	catch (const mqtt::exception &exc)
+	{
+		DO_LOG_ERROR(exc.what());
+	}
+	return false;
+}
+
+/**
+ * Publish message on MQTT broker, message buffer is moved into MQTT message
+ * instead of being copied
+ * @param a_sMsg :[in] message to publish, it is empty after the call
+ * @param a_sTopic :[in] topic on which to publish message
+ * @return true/false based on success/failure
+ */
+bool CMQTTBaseHandler::publishMsg(std::string &&a_sMsg, const std::string &a_sTopic)
+{
+	try
+	{
+		// Check if topic is blank
+		if (true == a_sTopic.empty())
+		{
+			DO_LOG_ERROR("Blank topic. Message not posted");
+			return false;
+		}
+		mqtt::message_ptr pubmsg = mqtt::make_message(a_sTopic, std::move(a_sMsg), m_QOS, false);
+		if(false == m_MQTTClient.publishMsg(pubmsg))
+		{
+			return false;
+		}
 
 		DO_LOG_DEBUG("Published message on Internal MQTT broker successfully with QOS:"+ std::to_string(m_QOS));
 
@@ -453,3 +700,39 @@ bool CMQTTBaseHandler::publishMsg(const std::string &a_sMsg, const std::string &
 	return false;
 }
 
+/**
+ * Publish message on MQTT broker through publish window of client. Message
+ * buffer is moved into MQTT message when message is taken, else it is
+ * given back to caller, e.g. to be spooled or to be tried again.
+ * @param a_sMsg :[in] message to publish
+ * @param a_sTopic :[in] topic on which to publish message
+ * @param a_ePolicy :[in] policy to be used when pending queue is full
+ * @param a_u32TimeoutMs :[in] max time to wait for room, for block policy
+ * @return true/false based on whether message is taken or not
+ */
+bool CMQTTBaseHandler::publishMsgWindowed(std::string &a_sMsg, const std::string &a_sTopic,
+		eMQTTPublishPolicy a_ePolicy, uint32_t a_u32TimeoutMs)
+{
+	try
+	{
+		// Check if topic is blank
+		if (true == a_sTopic.empty())
+		{
+			DO_LOG_ERROR("Blank topic. Message not posted");
+			return false;
+		}
+		mqtt::message_ptr pubmsg = mqtt::make_message(a_sTopic, std::move(a_sMsg), m_QOS, false);
+		if(false == m_MQTTClient.publishMsgWindowed(pubmsg, a_ePolicy, a_u32TimeoutMs))
+		{
+			a_sMsg = pubmsg->get_payload_str();
+			return false;
+		}
+		return true;
+	}
+	catch (const mqtt::exception &exc)
+	{
+		DO_LOG_ERROR(exc.what());
+	}
+	return false;
+}
+
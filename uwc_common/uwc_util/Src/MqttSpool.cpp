@@ -0,0 +1,453 @@
+/********************************************************************************
+* Copyright (c) 2021 Intel Corporation.
+
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*********************************************************************************/
+
+#include "MqttSpool.hpp"
+#include "Logger.hpp"
+#include <cstring>
+#include <cerrno>
+#include <vector>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+/** offsets of fields in segment header*/
+#define SEG_OFF_VERSION		4
+#define SEG_OFF_SEQ			8
+#define SEG_OFF_WRITE		16
+#define SEG_OFF_READ		20
+#define SEG_OFF_RECORDS		24
+
+// Unnamed namespace to define helpers
+namespace
+{
+	/** writes integer at position in little endian order*/
+	void writeLE(char *a_pDst, uint64_t a_u64Val, size_t a_len)
+	{
+		for(size_t i = 0; i < a_len; ++i)
+		{
+			a_pDst[i] = (char)((a_u64Val >> (8 * i)) & 0xFF);
+		}
+	}
+
+	/** reads little endian integer from position*/
+	uint64_t readLE(const char *a_pSrc, size_t a_len)
+	{
+		uint64_t u64Val = 0;
+		for(size_t i = 0; i < a_len; ++i)
+		{
+			u64Val |= ((uint64_t)(uint8_t)a_pSrc[i]) << (8 * i);
+		}
+		return u64Val;
+	}
+
+	/** creates directory along with its missing parents*/
+	bool makeDir(const std::string &a_sDir)
+	{
+		size_t pos = 0;
+		do
+		{
+			pos = a_sDir.find('/', pos + 1);
+			std::string sPart = a_sDir.substr(0, pos);
+			if((0 != mkdir(sPart.c_str(), 0750)) && (EEXIST != errno))
+			{
+				DO_LOG_ERROR("Spool directory could not be created: " + sPart + ", errno: " + std::to_string(errno));
+				return false;
+			}
+		} while(std::string::npos != pos);
+		return true;
+	}
+
+	/** maps segment file of given size, file is created if needed*/
+	char* mapFile(const std::string &a_sPath, uint32_t a_u32Size, bool a_bIsCreate)
+	{
+		int iFd = ::open(a_sPath.c_str(), (true == a_bIsCreate) ? (O_RDWR | O_CREAT | O_TRUNC) : O_RDWR, 0640);
+		if(0 > iFd)
+		{
+			DO_LOG_ERROR("Spool segment could not be opened: " + a_sPath + ", errno: " + std::to_string(errno));
+			return NULL;
+		}
+		struct stat stFile;
+		if((0 != fstat(iFd, &stFile)) ||
+				((stFile.st_size != (off_t)a_u32Size) && (0 != ftruncate(iFd, a_u32Size))))
+		{
+			DO_LOG_ERROR("Spool segment could not be sized: " + a_sPath + ", errno: " + std::to_string(errno));
+			::close(iFd);
+			return NULL;
+		}
+		void *pBase = mmap(NULL, a_u32Size, PROT_READ | PROT_WRITE, MAP_SHARED, iFd, 0);
+		// mapping stays valid after file descriptor is closed
+		::close(iFd);
+		if(MAP_FAILED == pBase)
+		{
+			DO_LOG_ERROR("Spool segment could not be mapped: " + a_sPath + ", errno: " + std::to_string(errno));
+			return NULL;
+		}
+		return (char*)pBase;
+	}
+}
+
+/**
+ * Constructor
+ * @param None
+ * @return None
+ */
+CMqttSpool::CMqttSpool() : m_u32SegmentSize{0}, m_u32MaxSegments{0},
+	m_u64Depth{0}, m_u64Bytes{0}, m_u64Appended{0}, m_u64Drained{0}, m_u64Dropped{0}
+{
+}
+
+/**
+ * Destructor, unmaps segments. Segment files are kept for next start.
+ * @param None
+ * @return None
+ */
+CMqttSpool::~CMqttSpool()
+{
+	close();
+}
+
+/**
+ * Opens spool and loads messages left in segment files by earlier run
+ * @param a_sDir :[in] directory of segment files, it is created if needed
+ * @param a_sName :[in] prefix of segment file names, spools sharing a directory need different names
+ * @param a_u32SegmentSize :[in] size of a segment file, largest message has to fit in it
+ * @param a_u32MaxSegments :[in] max segment files, spool is bounded to a_u32SegmentSize * a_u32MaxSegments
+ * @return true/false based on success/failure
+ */
+bool CMqttSpool::open(const std::string &a_sDir, const std::string &a_sName,
+		uint32_t a_u32SegmentSize, uint32_t a_u32MaxSegments)
+{
+	std::lock_guard<std::mutex> lock(m_mutexSpool);
+	if((true == a_sDir.empty()) || (true == a_sName.empty()) ||
+			(MQTT_SPOOL_SEG_HEADER_LEN + MQTT_SPOOL_RECORD_HEADER_LEN >= a_u32SegmentSize) || (0 == a_u32MaxSegments))
+	{
+		DO_LOG_ERROR("Invalid spool configuration");
+		return false;
+	}
+	if(false == m_sDir.empty())
+	{
+		DO_LOG_ERROR("Spool is already opened: " + m_sDir);
+		return false;
+	}
+	if(false == makeDir(a_sDir))
+	{
+		return false;
+	}
+
+	m_u32SegmentSize = a_u32SegmentSize;
+	m_u32MaxSegments = a_u32MaxSegments;
+	m_sName = a_sName;
+
+	// segment files are named <name>_<sequence>.seg
+	std::vector<std::pair<uint64_t, std::string>> vFiles;
+	DIR *pDir = opendir(a_sDir.c_str());
+	if(NULL == pDir)
+	{
+		DO_LOG_ERROR("Spool directory could not be read: " + a_sDir);
+		return false;
+	}
+	std::string sPrefix = a_sName + "_";
+	struct dirent *pEntry = NULL;
+	while(NULL != (pEntry = readdir(pDir)))
+	{
+		std::string sFile(pEntry->d_name);
+		std::string sExt(MQTT_SPOOL_SEG_EXT);
+		if((sFile.size() > sPrefix.size() + sExt.size()) && (0 == sFile.compare(0, sPrefix.size(), sPrefix)) &&
+				(0 == sFile.compare(sFile.size() - sExt.size(), sExt.size(), sExt)))
+		{
+			std::string sSeq = sFile.substr(sPrefix.size(), sFile.size() - sPrefix.size() - sExt.size());
+			if(std::string::npos == sSeq.find_first_not_of("0123456789"))
+			{
+				vFiles.push_back(std::make_pair(std::stoull(sSeq), a_sDir + "/" + sFile));
+			}
+		}
+	}
+	closedir(pDir);
+	std::sort(vFiles.begin(), vFiles.end());
+
+	m_sDir = a_sDir;
+	for(auto &itr : vFiles)
+	{
+		loadSegment(itr.second, itr.first);
+	}
+	// segments beyond the limit, e.g. after limit is reduced, are discarded oldest first
+	while(m_dqSegments.size() > m_u32MaxSegments)
+	{
+		removeFrontSegment();
+	}
+	if(0 != m_u64Depth.load())
+	{
+		DO_LOG_INFO("Spool " + m_sDir + "/" + m_sName + " loaded with " + std::to_string(m_u64Depth.load()) + " messages");
+	}
+	return true;
+}
+
+/**
+ * Unmaps segments. Segment files are kept, hence messages are loaded again
+ * when spool is opened next time.
+ * @param None
+ * @return None
+ */
+void CMqttSpool::close()
+{
+	std::lock_guard<std::mutex> lock(m_mutexSpool);
+	for(auto &itr : m_dqSegments)
+	{
+		munmap(itr.m_pBase, m_u32SegmentSize);
+	}
+	m_dqSegments.clear();
+	m_sDir.clear();
+	m_u64Depth.store(0);
+	m_u64Bytes.store(0);
+}
+
+/**
+ * Loads segment file left by earlier run. Invalid segment file is deleted.
+ * Function is called with spool mutex locked.
+ * @param a_sPath :[in] path of segment file
+ * @param a_u64Seq :[in] sequence of segment
+ * @return true/false based on success/failure
+ */
+bool CMqttSpool::loadSegment(const std::string &a_sPath, uint64_t a_u64Seq)
+{
+	struct stat stFile;
+	char *pBase = NULL;
+	if((0 == stat(a_sPath.c_str(), &stFile)) && (stFile.st_size == (off_t)m_u32SegmentSize))
+	{
+		pBase = mapFile(a_sPath, m_u32SegmentSize, false);
+	}
+	if(NULL != pBase)
+	{
+		uint32_t u32Write = (uint32_t)readLE(pBase + SEG_OFF_WRITE, 4);
+		uint32_t u32Read = (uint32_t)readLE(pBase + SEG_OFF_READ, 4);
+		if((0 == memcmp(pBase, MQTT_SPOOL_MAGIC, 4)) &&
+				(MQTT_SPOOL_VERSION == readLE(pBase + SEG_OFF_VERSION, 4)) &&
+				(a_u64Seq == readLE(pBase + SEG_OFF_SEQ, 8)) &&
+				(MQTT_SPOOL_SEG_HEADER_LEN <= u32Read) && (u32Read <= u32Write) && (u32Write <= m_u32SegmentSize))
+		{
+			m_dqSegments.push_back(stSpoolSegment{a_u64Seq, a_sPath, pBase});
+			m_u64Depth.fetch_add(readLE(pBase + SEG_OFF_RECORDS, 4));
+			m_u64Bytes.fetch_add(u32Write - u32Read);
+			return true;
+		}
+		munmap(pBase, m_u32SegmentSize);
+	}
+	DO_LOG_ERROR("Invalid spool segment is discarded: " + a_sPath);
+	unlink(a_sPath.c_str());
+	return false;
+}
+
+/**
+ * Creates new segment to be written. Function is called with spool mutex locked.
+ * @param a_u64Seq :[in] sequence of segment
+ * @return true/false based on success/failure
+ */
+bool CMqttSpool::addSegment(uint64_t a_u64Seq)
+{
+	std::string sPath = m_sDir + "/" + m_sName + "_" + std::to_string(a_u64Seq) + MQTT_SPOOL_SEG_EXT;
+	char *pBase = mapFile(sPath, m_u32SegmentSize, true);
+	if(NULL == pBase)
+	{
+		return false;
+	}
+	memcpy(pBase, MQTT_SPOOL_MAGIC, 4);
+	writeLE(pBase + SEG_OFF_VERSION, MQTT_SPOOL_VERSION, 4);
+	writeLE(pBase + SEG_OFF_SEQ, a_u64Seq, 8);
+	writeLE(pBase + SEG_OFF_WRITE, MQTT_SPOOL_SEG_HEADER_LEN, 4);
+	writeLE(pBase + SEG_OFF_READ, MQTT_SPOOL_SEG_HEADER_LEN, 4);
+	writeLE(pBase + SEG_OFF_RECORDS, 0, 4);
+	m_dqSegments.push_back(stSpoolSegment{a_u64Seq, sPath, pBase});
+	return true;
+}
+
+/**
+ * Removes oldest segment along with its file. Unread messages of segment are
+ * counted as dropped. Function is called with spool mutex locked.
+ * @param None
+ * @return None
+ */
+void CMqttSpool::removeFrontSegment()
+{
+	if(true == m_dqSegments.empty())
+	{
+		return;
+	}
+	stSpoolSegment &stSeg = m_dqSegments.front();
+	uint32_t u32Records = (uint32_t)readLE(stSeg.m_pBase + SEG_OFF_RECORDS, 4);
+	uint32_t u32Unread = (uint32_t)(readLE(stSeg.m_pBase + SEG_OFF_WRITE, 4) - readLE(stSeg.m_pBase + SEG_OFF_READ, 4));
+	if(0 != u32Records)
+	{
+		DO_LOG_WARN("Spool is full, " + std::to_string(u32Records) + " oldest messages are discarded from " + stSeg.m_sPath);
+	}
+	m_u64Dropped.fetch_add(u32Records);
+	m_u64Depth.fetch_sub(std::min<uint64_t>(u32Records, m_u64Depth.load()));
+	m_u64Bytes.fetch_sub(std::min<uint64_t>(u32Unread, m_u64Bytes.load()));
+	munmap(stSeg.m_pBase, m_u32SegmentSize);
+	unlink(stSeg.m_sPath.c_str());
+	m_dqSegments.pop_front();
+}
+
+/**
+ * Appends message at end of spool. When spool is full, oldest segment is
+ * discarded to make room for message.
+ * @param a_sTopic :[in] MQTT topic of message
+ * @param a_sMsg :[in] message
+ * @return true/false based on success/failure
+ */
+bool CMqttSpool::append(const std::string &a_sTopic, const std::string &a_sMsg)
+{
+	std::lock_guard<std::mutex> lock(m_mutexSpool);
+	uint64_t u64RecordLen = MQTT_SPOOL_RECORD_HEADER_LEN + a_sTopic.size() + a_sMsg.size();
+	if((true == m_sDir.empty()) || (UINT16_MAX < a_sTopic.size()) ||
+			(u64RecordLen > m_u32SegmentSize - MQTT_SPOOL_SEG_HEADER_LEN))
+	{
+		DO_LOG_ERROR("Message could not be spooled for topic: " + a_sTopic);
+		m_u64Dropped.fetch_add(1);
+		return false;
+	}
+
+	if((true == m_dqSegments.empty()) ||
+			(readLE(m_dqSegments.back().m_pBase + SEG_OFF_WRITE, 4) + u64RecordLen > m_u32SegmentSize))
+	{
+		uint64_t u64Seq = (true == m_dqSegments.empty()) ? 0 : (m_dqSegments.back().m_u64Seq + 1);
+		while(m_dqSegments.size() >= m_u32MaxSegments)
+		{
+			removeFrontSegment();
+		}
+		if(false == addSegment(u64Seq))
+		{
+			m_u64Dropped.fetch_add(1);
+			return false;
+		}
+	}
+
+	char *pBase = m_dqSegments.back().m_pBase;
+	uint32_t u32Write = (uint32_t)readLE(pBase + SEG_OFF_WRITE, 4);
+	char *pRecord = pBase + u32Write;
+	writeLE(pRecord, a_sMsg.size(), 4);
+	writeLE(pRecord + 4, a_sTopic.size(), 2);
+	writeLE(pRecord + 6, 0, 2);
+	memcpy(pRecord + MQTT_SPOOL_RECORD_HEADER_LEN, a_sTopic.data(), a_sTopic.size());
+	memcpy(pRecord + MQTT_SPOOL_RECORD_HEADER_LEN + a_sTopic.size(), a_sMsg.data(), a_sMsg.size());
+	// record is visible to next run only after write offset is moved
+	writeLE(pBase + SEG_OFF_RECORDS, readLE(pBase + SEG_OFF_RECORDS, 4) + 1, 4);
+	writeLE(pBase + SEG_OFF_WRITE, u32Write + u64RecordLen, 4);
+
+	m_u64Depth.fetch_add(1);
+	m_u64Bytes.fetch_add(u64RecordLen);
+	m_u64Appended.fetch_add(1);
+	return true;
+}
+
+/**
+ * Gets oldest unread record. Segments which are completely read are removed.
+ * Function is called with spool mutex locked.
+ * @param a_pRecord :[out] start of record
+ * @param a_u32MsgLen :[out] length of message
+ * @param a_u16TopicLen :[out] length of topic
+ * @return true/false based on whether record is present
+ */
+bool CMqttSpool::getFrontRecord(char *&a_pRecord, uint32_t &a_u32MsgLen, uint16_t &a_u16TopicLen)
+{
+	while(false == m_dqSegments.empty())
+	{
+		char *pBase = m_dqSegments.front().m_pBase;
+		uint32_t u32Read = (uint32_t)readLE(pBase + SEG_OFF_READ, 4);
+		uint32_t u32Write = (uint32_t)readLE(pBase + SEG_OFF_WRITE, 4);
+		if(u32Read + MQTT_SPOOL_RECORD_HEADER_LEN <= u32Write)
+		{
+			a_pRecord = pBase + u32Read;
+			a_u32MsgLen = (uint32_t)readLE(a_pRecord, 4);
+			a_u16TopicLen = (uint16_t)readLE(a_pRecord + 4, 2);
+			if((uint64_t)u32Read + MQTT_SPOOL_RECORD_HEADER_LEN + a_u16TopicLen + a_u32MsgLen <= u32Write)
+			{
+				return true;
+			}
+			DO_LOG_ERROR("Invalid record in spool segment: " + m_dqSegments.front().m_sPath);
+		}
+		if(1 == m_dqSegments.size())
+		{
+			// segment being written is reused from start once it is read
+			writeLE(pBase + SEG_OFF_READ, MQTT_SPOOL_SEG_HEADER_LEN, 4);
+			writeLE(pBase + SEG_OFF_RECORDS, 0, 4);
+			writeLE(pBase + SEG_OFF_WRITE, MQTT_SPOOL_SEG_HEADER_LEN, 4);
+			m_u64Depth.store(0);
+			m_u64Bytes.store(0);
+			return false;
+		}
+		removeFrontSegment();
+	}
+	return false;
+}
+
+/**
+ * Reads oldest message of spool. Message stays in spool till pop() is called,
+ * hence it is not lost if it cannot be published.
+ * @param a_sTopic :[out] MQTT topic of message
+ * @param a_sMsg :[out] message
+ * @return true/false based on whether message is present
+ */
+bool CMqttSpool::front(std::string &a_sTopic, std::string &a_sMsg)
+{
+	std::lock_guard<std::mutex> lock(m_mutexSpool);
+	char *pRecord = NULL;
+	uint32_t u32MsgLen = 0;
+	uint16_t u16TopicLen = 0;
+	if(false == getFrontRecord(pRecord, u32MsgLen, u16TopicLen))
+	{
+		return false;
+	}
+	a_sTopic.assign(pRecord + MQTT_SPOOL_RECORD_HEADER_LEN, u16TopicLen);
+	a_sMsg.assign(pRecord + MQTT_SPOOL_RECORD_HEADER_LEN + u16TopicLen, u32MsgLen);
+	return true;
+}
+
+/**
+ * Removes oldest message of spool
+ * @param None
+ * @return true/false based on whether message is removed
+ */
+bool CMqttSpool::pop()
+{
+	std::lock_guard<std::mutex> lock(m_mutexSpool);
+	char *pRecord = NULL;
+	uint32_t u32MsgLen = 0;
+	uint16_t u16TopicLen = 0;
+	if(false == getFrontRecord(pRecord, u32MsgLen, u16TopicLen))
+	{
+		return false;
+	}
+	char *pBase = m_dqSegments.front().m_pBase;
+	uint32_t u32RecordLen = MQTT_SPOOL_RECORD_HEADER_LEN + u16TopicLen + u32MsgLen;
+	uint32_t u32Records = (uint32_t)readLE(pBase + SEG_OFF_RECORDS, 4);
+	writeLE(pBase + SEG_OFF_RECORDS, (0 == u32Records) ? 0 : (u32Records - 1), 4);
+	writeLE(pBase + SEG_OFF_READ, readLE(pBase + SEG_OFF_READ, 4) + u32RecordLen, 4);
+
+	m_u64Depth.fetch_sub(std::min<uint64_t>(1, m_u64Depth.load()));
+	m_u64Bytes.fetch_sub(std::min<uint64_t>(u32RecordLen, m_u64Bytes.load()));
+	m_u64Drained.fetch_add(1);
+	return true;
+}
@@ -24,6 +24,7 @@
 #include <atomic>
 #include <map>
 #include <algorithm>
+#include <cmath>
 #include <arpa/inet.h>
 #include "NetworkInfo.hpp"
 #include "yaml-cpp/eventhandler.h"
@@ -48,7 +49,7 @@ std::map<std::string, CUniqueDataDevice> g_mapUniqueDataDevice;
 std::map<std::string, CDeviceInfo> g_mapDeviceInfo;
 std::map<std::string, CDataPointsYML> g_mapDataPointsYML;
 std::vector<std::string> g_sErrorYMLs;
-unsigned short g_usTotalCnt{0};
+uint32_t g_u32TotalCnt{0};
 
 /**
  * Populate unique point data
@@ -881,6 +882,33 @@ void network_info::CDataPoint::build(const YAML::Node& a_oData, CDataPoint &a_oC
 			a_oCDataPoint.m_stAddress.m_dScaleFactor = globalConfig::CGlobalConfig::getInstance().getDefaultScaleFactor();
 			DO_LOG_WARN(" Scale factor key is not present. Set to default." + std::string(e.what()));			
 		}
+
+		// Report-by-exception parameters. All are optional and disabled by default.
+		a_oCDataPoint.m_stAddress.m_dDeadband = 0;
+		a_oCDataPoint.m_stAddress.m_dDeadbandPercent = 0;
+		a_oCDataPoint.m_stAddress.m_uiHeartbeatMs = 0;
+		try
+		{
+			if (a_oData["attributes"]["deadband"])
+			{
+				a_oCDataPoint.m_stAddress.m_dDeadband = std::fabs(a_oData["attributes"]["deadband"].as<double>());
+			}
+			if (a_oData["attributes"]["deadbandpercent"])
+			{
+				a_oCDataPoint.m_stAddress.m_dDeadbandPercent = std::fabs(a_oData["attributes"]["deadbandpercent"].as<double>());
+			}
+			if (a_oData["attributes"]["heartbeat"])
+			{
+				a_oCDataPoint.m_stAddress.m_uiHeartbeatMs = a_oData["attributes"]["heartbeat"].as<std::uint32_t>();
+			}
+		}
+		catch(YAML::Exception &e)
+		{
+			a_oCDataPoint.m_stAddress.m_dDeadband = 0;
+			a_oCDataPoint.m_stAddress.m_dDeadbandPercent = 0;
+			a_oCDataPoint.m_stAddress.m_uiHeartbeatMs = 0;
+			DO_LOG_WARN("Deadband or heartbeat value is incorrect. Every value will be reported." + std::string(e.what()));
+		}
 		
 	}
 	catch(YAML::Exception &e)
@@ -1025,21 +1053,27 @@ void network_info::buildNetworkInfo(string a_strNetworkType, string a_strSiteLis
 	if(!a_strAppId.empty())
 	{
 		DO_LOG_INFO(": MY_APP_ID value = " + a_strAppId);
-		auto a = (unsigned short) atoi(a_strAppId.c_str());
-		a = a & 0x000F;
-		g_usTotalCnt = (a << 12);
+		uint32_t a = (uint32_t) atoi(a_strAppId.c_str());
+		a = a & ((1u << ROLL_ID_APP_BITS) - 1);
+		g_u32TotalCnt = (a << ROLL_ID_POINT_BITS);
 	}
 	else
 	{
 		DO_LOG_INFO("MY_APP_ID value is not set. Expected values 0 to 16");
 		DO_LOG_INFO("Assuming value as 0");
-		g_usTotalCnt = 0;
+		g_u32TotalCnt = 0;
 	}
-	DO_LOG_INFO(": Count start from = " + std::to_string(g_usTotalCnt));
+	const uint32_t u32StartCnt = g_u32TotalCnt;
+	DO_LOG_INFO(": Count start from = " + std::to_string(g_u32TotalCnt));
 	for(auto &a: g_mapYMLWellSite)
 	{
 		populateUniquePointData(g_mapYMLWellSite.at(a.first));
 	}
+	if((g_u32TotalCnt - u32StartCnt) > ROLL_ID_MAX_POINTS)
+	{
+		DO_LOG_ERROR("Number of points " + std::to_string(g_u32TotalCnt - u32StartCnt) +
+				" exceeds " + std::to_string(ROLL_ID_MAX_POINTS) + ", roll IDs of points are not unique");
+	}
 
 	for(auto &a: oWellSiteList)
 	{
@@ -1059,10 +1093,10 @@ void network_info::buildNetworkInfo(string a_strNetworkType, string a_strSiteLis
  */
 CUniqueDataPoint::CUniqueDataPoint(std::string a_sId, const CWellSiteInfo &a_rWellSite,
 		const CWellSiteDevInfo &a_rWellSiteDev, const CDataPoint &a_rPoint) :
-									m_uiMyRollID{((unsigned int)g_usTotalCnt)+1}, m_sId{a_sId},
+									m_u32MyRollID{g_u32TotalCnt+1}, m_sId{a_sId},
 									m_rWellSite{a_rWellSite}, m_rWellSiteDev{a_rWellSiteDev}, m_rPoint{a_rPoint}, m_bIsAwaitResp{false}, m_bIsRT{a_rPoint.getPollingConfig().m_bIsRealTime}
 									{
-										++g_usTotalCnt;
+										++g_u32TotalCnt;
 									}
 
 									/**
@@ -1070,7 +1104,7 @@ CUniqueDataPoint::CUniqueDataPoint(std::string a_sId, const CWellSiteInfo &a_rWe
 									 * @param a_objPt 		:[in] reference CUniqueDataPoint object for copy constructor
 									 */
 									CUniqueDataPoint::CUniqueDataPoint(const CUniqueDataPoint &a_objPt) :
-									m_uiMyRollID{a_objPt.m_uiMyRollID}, m_sId{a_objPt.m_sId},
+									m_u32MyRollID{a_objPt.m_u32MyRollID}, m_sId{a_objPt.m_sId},
 									m_rWellSite{a_objPt.m_rWellSite}, m_rWellSiteDev{a_objPt.m_rWellSiteDev}, m_rPoint{a_objPt.m_rPoint}, m_bIsAwaitResp{false}
 									{
 										m_bIsRT.store(a_objPt.m_bIsRT);
@@ -0,0 +1,487 @@
+/********************************************************************************
+* Copyright (c) 2021 Intel Corporation.
+
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*********************************************************************************/
+
+#include "PolledUpdate.hpp"
+#include "Logger.hpp"
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <climits>
+#include <ctime>
+
+// Unnamed namespace to define helpers
+namespace
+{
+	/** offsets of fields in fixed part of binary polled update*/
+	enum
+	{
+		OFF_VERSION = 4,
+		OFF_FLAGS = 5,
+		OFF_STATUS = 6,
+		OFF_VALUE_TYPE = 7,
+		OFF_POINT_ID = 8,
+		OFF_ERROR_CODE = 12,
+		OFF_DRIVER_SEQ = 16,
+		OFF_VALUE = 24,
+		OFF_TIMESTAMPS = 32
+	};
+
+	/** number of int64 timestamps in fixed part, in order tsPollingTime, reqRcvdInStack,
+	 * reqSentByStack, respRcvdByStack, respPostedByStack, timestamp, usec, lastGoodUsec*/
+	const size_t TIMESTAMP_COUNT = 8;
+
+	/** writes integer at position in little endian order*/
+	void writeLE(char *a_pDst, uint64_t a_u64Val, size_t a_len)
+	{
+		for(size_t i = 0; i < a_len; ++i)
+		{
+			a_pDst[i] = (char)((a_u64Val >> (8 * i)) & 0xFF);
+		}
+	}
+
+	/** reads little endian integer from position*/
+	uint64_t readLE(const char *a_pSrc, size_t a_len)
+	{
+		uint64_t u64Val = 0;
+		for(size_t i = 0; i < a_len; ++i)
+		{
+			u64Val |= ((uint64_t)(uint8_t)a_pSrc[i]) << (8 * i);
+		}
+		return u64Val;
+	}
+
+	/** appends u16 length and bytes of string*/
+	void appendString(std::string &a_sBuf, const std::string &a_sVal)
+	{
+		size_t len = (a_sVal.size() > UINT16_MAX) ? UINT16_MAX : a_sVal.size();
+		char arrLen[2];
+		writeLE(arrLen, len, sizeof(arrLen));
+		a_sBuf.append(arrLen, sizeof(arrLen));
+		a_sBuf.append(a_sVal.data(), len);
+	}
+
+	/** reads u16 length and bytes of string, advances position*/
+	bool readString(const char *&a_pCur, const char *a_pEnd, std::string &a_sVal)
+	{
+		if((a_pEnd - a_pCur) < 2)
+		{
+			return false;
+		}
+		size_t len = (size_t)readLE(a_pCur, 2);
+		a_pCur += 2;
+		if((size_t)(a_pEnd - a_pCur) < len)
+		{
+			return false;
+		}
+		a_sVal.assign(a_pCur, len);
+		a_pCur += len;
+		return true;
+	}
+
+	/** appends string as JSON string, special characters are escaped*/
+	void appendJsonString(std::string &a_sJson, const std::string &a_sVal)
+	{
+		a_sJson.push_back('"');
+		for(unsigned char c : a_sVal)
+		{
+			if(('"' == c) || ('\\' == c))
+			{
+				a_sJson.push_back('\\');
+				a_sJson.push_back((char)c);
+			}
+			else if(c < 0x20)
+			{
+				char arrEsc[8];
+				snprintf(arrEsc, sizeof(arrEsc), "\\u%04x", c);
+				a_sJson.append(arrEsc);
+			}
+			else
+			{
+				a_sJson.push_back((char)c);
+			}
+		}
+		a_sJson.push_back('"');
+	}
+
+	/** appends "key": to JSON object being built*/
+	void appendJsonKey(std::string &a_sJson, const char *a_pszKey)
+	{
+		if('{' != a_sJson.back())
+		{
+			a_sJson.push_back(',');
+		}
+		a_sJson.push_back('"');
+		a_sJson.append(a_pszKey);
+		a_sJson.append("\":");
+	}
+
+	/** formats timestamp in "YYYY-mm-dd HH:MM:SS" form, as it is in JSON polled update*/
+	std::string formatTimestamp(int64_t a_i64Usec)
+	{
+		std::time_t rawtime = (std::time_t)(a_i64Usec / 1000000);
+		struct tm stTm;
+		char buffer[80] = {0};
+		if(NULL != gmtime_r(&rawtime, &stTm))
+		{
+			std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &stTm);
+		}
+		return buffer;
+	}
+
+	/** formats floating value same as JSON serializer of envelope*/
+	void appendJsonDouble(std::string &a_sJson, double a_dValue)
+	{
+		char arrNum[32];
+		if((true == std::isnan(a_dValue)) || (true == std::isinf(a_dValue)))
+		{
+			a_sJson.append("null");
+			return;
+		}
+		if((std::fabs(a_dValue) <= INT_MAX) && (a_dValue == (double)(int)a_dValue))
+		{
+			snprintf(arrNum, sizeof(arrNum), "%d", (int)a_dValue);
+		}
+		else
+		{
+			// use shortest form which reads back as same value
+			snprintf(arrNum, sizeof(arrNum), "%1.15g", a_dValue);
+			if(strtod(arrNum, NULL) != a_dValue)
+			{
+				snprintf(arrNum, sizeof(arrNum), "%1.17g", a_dValue);
+			}
+		}
+		a_sJson.append(arrNum);
+	}
+}
+
+/**
+ * Constructor
+ * @param None
+ * @return None
+ */
+stPolledUpdate::stPolledUpdate() : m_u32PointId{0}, m_bIsRealTime{false}, m_bIsDataPersist{false},
+		m_eStatus{enPOLLED_STATUS_GOOD}, m_u32ErrorCode{0}, m_bIsHexValue{false},
+		m_eValueType{enPOLLED_VALUE_NONE}, m_i64Value{0}, m_dValue{0}, m_bValue{false},
+		m_u64DriverSeq{0}, m_i64TsPolling{0}, m_i64ReqRcvdInStack{0}, m_i64ReqSentByStack{0},
+		m_i64RespRcvdByStack{0}, m_i64RespPostedByStack{0}, m_i64Timestamp{0}, m_i64Usec{0},
+		m_i64LastGoodUsec{0}
+{
+}
+
+/**
+ * Sets scaled value of update from envelope element
+ * @param a_stUpdate :[out] update in which to set value
+ * @param a_pScaledValue :[in] scaled value element, NULL means no value
+ * @return true/false based on whether element type is supported
+ */
+bool CPolledUpdateCodec::setScaledValue(stPolledUpdate &a_stUpdate, const msg_envelope_elem_body_t *a_pScaledValue)
+{
+	a_stUpdate.m_eValueType = enPOLLED_VALUE_NONE;
+	a_stUpdate.m_sValue.clear();
+	if(NULL == a_pScaledValue)
+	{
+		return true;
+	}
+	switch(a_pScaledValue->type)
+	{
+	case MSG_ENV_DT_INT:
+		a_stUpdate.m_eValueType = enPOLLED_VALUE_INT;
+		a_stUpdate.m_i64Value = a_pScaledValue->body.integer;
+		break;
+	case MSG_ENV_DT_FLOATING:
+		a_stUpdate.m_eValueType = enPOLLED_VALUE_FLOAT;
+		a_stUpdate.m_dValue = a_pScaledValue->body.floating;
+		break;
+	case MSG_ENV_DT_BOOLEAN:
+		a_stUpdate.m_eValueType = enPOLLED_VALUE_BOOL;
+		a_stUpdate.m_bValue = a_pScaledValue->body.boolean;
+		break;
+	case MSG_ENV_DT_STRING:
+		a_stUpdate.m_eValueType = enPOLLED_VALUE_STRING;
+		if(NULL != a_pScaledValue->body.string)
+		{
+			a_stUpdate.m_sValue.assign(a_pScaledValue->body.string);
+		}
+		break;
+	default:
+		DO_LOG_ERROR("Unsupported type of scaled value: " + std::to_string(a_pScaledValue->type));
+		return false;
+	}
+	return true;
+}
+
+/**
+ * Encodes update in binary form. Buffer is overwritten, its capacity is
+ * reused, hence same buffer can be used for every update of a point.
+ * @param a_stUpdate :[in] update to encode
+ * @param a_sBuf :[out] binary update
+ * @return None
+ */
+void CPolledUpdateCodec::encode(const stPolledUpdate &a_stUpdate, std::string &a_sBuf)
+{
+	a_sBuf.resize(POLLED_UPDATE_FIXED_LEN);
+	char *pBuf = &a_sBuf[0];
+
+	memcpy(pBuf, POLLED_UPDATE_MAGIC, 4);
+	uint8_t u8Flags = 0;
+	u8Flags |= (true == a_stUpdate.m_bIsRealTime) ? POLLED_UPDATE_FLAG_RT : 0;
+	u8Flags |= (true == a_stUpdate.m_bIsDataPersist) ? POLLED_UPDATE_FLAG_PERSIST : 0;
+	u8Flags |= (true == a_stUpdate.m_bIsHexValue) ? POLLED_UPDATE_FLAG_HEX_VALUE : 0;
+	pBuf[OFF_VERSION] = (char)POLLED_UPDATE_VERSION;
+	pBuf[OFF_FLAGS] = (char)u8Flags;
+	pBuf[OFF_STATUS] = (char)a_stUpdate.m_eStatus;
+	pBuf[OFF_VALUE_TYPE] = (char)a_stUpdate.m_eValueType;
+	writeLE(pBuf + OFF_POINT_ID, a_stUpdate.m_u32PointId, 4);
+	writeLE(pBuf + OFF_ERROR_CODE, a_stUpdate.m_u32ErrorCode, 4);
+	writeLE(pBuf + OFF_DRIVER_SEQ, a_stUpdate.m_u64DriverSeq, 8);
+
+	uint64_t u64Value = 0;
+	switch(a_stUpdate.m_eValueType)
+	{
+	case enPOLLED_VALUE_INT:
+		u64Value = (uint64_t)a_stUpdate.m_i64Value;
+		break;
+	case enPOLLED_VALUE_FLOAT:
+		memcpy(&u64Value, &a_stUpdate.m_dValue, sizeof(u64Value));
+		break;
+	case enPOLLED_VALUE_BOOL:
+		u64Value = (true == a_stUpdate.m_bValue) ? 1 : 0;
+		break;
+	default:
+		break;
+	}
+	writeLE(pBuf + OFF_VALUE, u64Value, 8);
+
+	const int64_t arrTs[TIMESTAMP_COUNT] = {a_stUpdate.m_i64TsPolling, a_stUpdate.m_i64ReqRcvdInStack,
+			a_stUpdate.m_i64ReqSentByStack, a_stUpdate.m_i64RespRcvdByStack, a_stUpdate.m_i64RespPostedByStack,
+			a_stUpdate.m_i64Timestamp, a_stUpdate.m_i64Usec, a_stUpdate.m_i64LastGoodUsec};
+	for(size_t i = 0; i < TIMESTAMP_COUNT; ++i)
+	{
+		writeLE(pBuf + OFF_TIMESTAMPS + (8 * i), (uint64_t)arrTs[i], 8);
+	}
+
+	appendString(a_sBuf, a_stUpdate.m_sDataTopic);
+	appendString(a_sBuf, a_stUpdate.m_sWellhead);
+	appendString(a_sBuf, a_stUpdate.m_sMetric);
+	appendString(a_sBuf, a_stUpdate.m_sDataType);
+	appendString(a_sBuf, a_stUpdate.m_sHexValue);
+	appendString(a_sBuf, a_stUpdate.m_sValue);
+}
+
+/**
+ * Checks if payload is binary polled update of supported version
+ * @param a_pData :[in] payload
+ * @param a_len :[in] length of payload
+ * @return true/false based on whether payload is binary polled update
+ */
+bool CPolledUpdateCodec::isPolledUpdate(const char *a_pData, size_t a_len)
+{
+	return (NULL != a_pData) && (a_len >= POLLED_UPDATE_FIXED_LEN) &&
+			(0 == memcmp(a_pData, POLLED_UPDATE_MAGIC, 4)) &&
+			(POLLED_UPDATE_VERSION == (uint8_t)a_pData[OFF_VERSION]);
+}
+
+/**
+ * Checks if received envelope is binary polled update
+ * @param a_pMsg :[in] received envelope
+ * @return true/false based on whether envelope is binary polled update
+ */
+bool CPolledUpdateCodec::isPolledUpdate(msg_envelope_t *a_pMsg)
+{
+	msg_envelope_elem_body_t *pBlob = NULL;
+	if((NULL == a_pMsg) || (CT_BLOB != a_pMsg->content_type) ||
+			(MSG_SUCCESS != msgbus_msg_envelope_get(a_pMsg, NULL, &pBlob)) ||
+			(NULL == pBlob) || (MSG_ENV_DT_BLOB != pBlob->type) || (NULL == pBlob->body.blob))
+	{
+		return false;
+	}
+	return isPolledUpdate(pBlob->body.blob->data, pBlob->body.blob->len);
+}
+
+/**
+ * Decodes binary polled update. Strings of update are reused, hence same
+ * update can be used to decode many payloads.
+ * @param a_pData :[in] payload
+ * @param a_len :[in] length of payload
+ * @param a_stUpdate :[out] decoded update
+ * @return true/false based on success/failure
+ */
+bool CPolledUpdateCodec::decode(const char *a_pData, size_t a_len, stPolledUpdate &a_stUpdate)
+{
+	if(false == isPolledUpdate(a_pData, a_len))
+	{
+		return false;
+	}
+
+	uint8_t u8Flags = (uint8_t)a_pData[OFF_FLAGS];
+	uint8_t u8Status = (uint8_t)a_pData[OFF_STATUS];
+	uint8_t u8ValueType = (uint8_t)a_pData[OFF_VALUE_TYPE];
+	if((u8Status > enPOLLED_STATUS_BAD) || (u8ValueType > enPOLLED_VALUE_STRING))
+	{
+		DO_LOG_ERROR("Invalid status or value type in polled update");
+		return false;
+	}
+	a_stUpdate.m_bIsRealTime = (0 != (u8Flags & POLLED_UPDATE_FLAG_RT));
+	a_stUpdate.m_bIsDataPersist = (0 != (u8Flags & POLLED_UPDATE_FLAG_PERSIST));
+	a_stUpdate.m_bIsHexValue = (0 != (u8Flags & POLLED_UPDATE_FLAG_HEX_VALUE));
+	a_stUpdate.m_eStatus = (ePolledUpdateStatus)u8Status;
+	a_stUpdate.m_eValueType = (ePolledValueType)u8ValueType;
+	a_stUpdate.m_u32PointId = (uint32_t)readLE(a_pData + OFF_POINT_ID, 4);
+	a_stUpdate.m_u32ErrorCode = (uint32_t)readLE(a_pData + OFF_ERROR_CODE, 4);
+	a_stUpdate.m_u64DriverSeq = readLE(a_pData + OFF_DRIVER_SEQ, 8);
+
+	uint64_t u64Value = readLE(a_pData + OFF_VALUE, 8);
+	a_stUpdate.m_i64Value = (int64_t)u64Value;
+	memcpy(&a_stUpdate.m_dValue, &u64Value, sizeof(u64Value));
+	a_stUpdate.m_bValue = (0 != u64Value);
+
+	int64_t* arrTs[TIMESTAMP_COUNT] = {&a_stUpdate.m_i64TsPolling, &a_stUpdate.m_i64ReqRcvdInStack,
+			&a_stUpdate.m_i64ReqSentByStack, &a_stUpdate.m_i64RespRcvdByStack, &a_stUpdate.m_i64RespPostedByStack,
+			&a_stUpdate.m_i64Timestamp, &a_stUpdate.m_i64Usec, &a_stUpdate.m_i64LastGoodUsec};
+	for(size_t i = 0; i < TIMESTAMP_COUNT; ++i)
+	{
+		*arrTs[i] = (int64_t)readLE(a_pData + OFF_TIMESTAMPS + (8 * i), 8);
+	}
+
+	const char *pCur = a_pData + POLLED_UPDATE_FIXED_LEN;
+	const char *pEnd = a_pData + a_len;
+	if((false == readString(pCur, pEnd, a_stUpdate.m_sDataTopic)) ||
+			(false == readString(pCur, pEnd, a_stUpdate.m_sWellhead)) ||
+			(false == readString(pCur, pEnd, a_stUpdate.m_sMetric)) ||
+			(false == readString(pCur, pEnd, a_stUpdate.m_sDataType)) ||
+			(false == readString(pCur, pEnd, a_stUpdate.m_sHexValue)) ||
+			(false == readString(pCur, pEnd, a_stUpdate.m_sValue)))
+	{
+		DO_LOG_ERROR("Polled update is truncated");
+		return false;
+	}
+	return true;
+}
+
+/**
+ * Decodes binary polled update from received envelope
+ * @param a_pMsg :[in] received envelope
+ * @param a_stUpdate :[out] decoded update
+ * @return true/false based on success/failure
+ */
+bool CPolledUpdateCodec::decode(msg_envelope_t *a_pMsg, stPolledUpdate &a_stUpdate)
+{
+	msg_envelope_elem_body_t *pBlob = NULL;
+	if((NULL == a_pMsg) || (CT_BLOB != a_pMsg->content_type) ||
+			(MSG_SUCCESS != msgbus_msg_envelope_get(a_pMsg, NULL, &pBlob)) ||
+			(NULL == pBlob) || (MSG_ENV_DT_BLOB != pBlob->type) || (NULL == pBlob->body.blob))
+	{
+		return false;
+	}
+	return decode(pBlob->body.blob->data, pBlob->body.blob->len, a_stUpdate);
+}
+
+/**
+ * Gets field of update as it is in JSON polled update. Only string fields
+ * of JSON form can be read here; scaledValue and dataPersist are not strings.
+ * @param a_stUpdate :[in] decoded update
+ * @param a_sKey :[in] key of field in JSON form
+ * @param a_sValue :[out] value of field
+ * @return true/false based on whether field is present in update
+ */
+bool CPolledUpdateCodec::getField(const stPolledUpdate &a_stUpdate, const std::string &a_sKey, std::string &a_sValue)
+{
+	bool bIsBad = (enPOLLED_STATUS_BAD == a_stUpdate.m_eStatus);
+	if("driver_seq" == a_sKey) { a_sValue = std::to_string(a_stUpdate.m_u64DriverSeq); }
+	else if("status" == a_sKey) { a_sValue = (true == bIsBad) ? "Bad" : "Good"; }
+	else if("data_topic" == a_sKey) { a_sValue = a_stUpdate.m_sDataTopic; }
+	else if("wellhead" == a_sKey) { a_sValue = a_stUpdate.m_sWellhead; }
+	else if("metric" == a_sKey) { a_sValue = a_stUpdate.m_sMetric; }
+	else if("realtime" == a_sKey) { a_sValue = (true == a_stUpdate.m_bIsRealTime) ? "1" : "0"; }
+	else if("version" == a_sKey) { a_sValue = POLLED_UPDATE_JSON_VERSION; }
+	else if(("datatype" == a_sKey) && (false == a_stUpdate.m_sDataType.empty())) { a_sValue = a_stUpdate.m_sDataType; }
+	else if(("value" == a_sKey) && (true == a_stUpdate.m_bIsHexValue)) { a_sValue = a_stUpdate.m_sHexValue; }
+	else if(("error_code" == a_sKey) && (true == bIsBad)) { a_sValue = std::to_string(a_stUpdate.m_u32ErrorCode); }
+	else if(("lastGoodUsec" == a_sKey) && (true == bIsBad))
+	{
+		a_sValue = (0 == a_stUpdate.m_i64LastGoodUsec) ? "" : std::to_string(a_stUpdate.m_i64LastGoodUsec);
+	}
+	else if("tsPollingTime" == a_sKey) { a_sValue = std::to_string(a_stUpdate.m_i64TsPolling); }
+	else if("reqRcvdInStack" == a_sKey) { a_sValue = std::to_string(a_stUpdate.m_i64ReqRcvdInStack); }
+	else if("reqSentByStack" == a_sKey) { a_sValue = std::to_string(a_stUpdate.m_i64ReqSentByStack); }
+	else if("respRcvdByStack" == a_sKey) { a_sValue = std::to_string(a_stUpdate.m_i64RespRcvdByStack); }
+	else if("respPostedByStack" == a_sKey) { a_sValue = std::to_string(a_stUpdate.m_i64RespPostedByStack); }
+	else if("timestamp" == a_sKey) { a_sValue = formatTimestamp(a_stUpdate.m_i64Timestamp); }
+	else if("usec" == a_sKey) { a_sValue = std::to_string(a_stUpdate.m_i64Usec); }
+	else
+	{
+		a_sValue.clear();
+		return false;
+	}
+	return true;
+}
+
+/**
+ * Converts update in JSON polled update, fields and their types are same
+ * as JSON polled update published on EII
+ * @param a_stUpdate :[in] decoded update
+ * @param a_sJson :[out] JSON text, capacity of string is reused
+ * @return None
+ */
+void CPolledUpdateCodec::toJson(const stPolledUpdate &a_stUpdate, std::string &a_sJson)
+{
+	static const char* arrStringFields[] = {"version", "data_topic", "wellhead", "metric", "realtime", "datatype",
+			"tsPollingTime", "reqRcvdInStack", "reqSentByStack", "respRcvdByStack", "respPostedByStack",
+			"value", "status", "error_code", "lastGoodUsec", "driver_seq", "timestamp", "usec"};
+
+	a_sJson.clear();
+	a_sJson.push_back('{');
+	std::string sValue;
+	for(const char *pszKey : arrStringFields)
+	{
+		if(true == getField(a_stUpdate, pszKey, sValue))
+		{
+			appendJsonKey(a_sJson, pszKey);
+			appendJsonString(a_sJson, sValue);
+		}
+	}
+
+	appendJsonKey(a_sJson, "dataPersist");
+	a_sJson.append((true == a_stUpdate.m_bIsDataPersist) ? "true" : "false");
+
+	if(enPOLLED_VALUE_NONE != a_stUpdate.m_eValueType)
+	{
+		appendJsonKey(a_sJson, "scaledValue");
+		switch(a_stUpdate.m_eValueType)
+		{
+		case enPOLLED_VALUE_INT:
+			a_sJson.append(std::to_string(a_stUpdate.m_i64Value));
+			break;
+		case enPOLLED_VALUE_FLOAT:
+			appendJsonDouble(a_sJson, a_stUpdate.m_dValue);
+			break;
+		case enPOLLED_VALUE_BOOL:
+			a_sJson.append((true == a_stUpdate.m_bValue) ? "true" : "false");
+			break;
+		default:
+			appendJsonString(a_sJson, a_stUpdate.m_sValue);
+			break;
+		}
+	}
+	a_sJson.push_back('}');
+}
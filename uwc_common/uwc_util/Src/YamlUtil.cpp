@@ -22,6 +22,8 @@
 
 #include "YamlUtil.hpp"
 #include<iostream>
+#include <cerrno>
+#include <cstdlib>
 #include "Logger.hpp"
 
 namespace CommonUtils {
@@ -131,4 +133,35 @@ bool readEnvVariable(const char *pEnvVarName, std::string &storeVal)
 	return bRetVal;
 }
 
+/**
+ * Reads environment variable having unsigned integer value within given range.
+ * Value is not changed if variable is not set or if it is not valid, hence
+ * caller sets default value before calling this function.
+ * @param pEnvVarName:[in] Environment variable name
+ * @param a_u32Min:[in] min allowed value
+ * @param a_u32Max:[in] max allowed value
+ * @param a_u32Val:[in,out] value of environment variable, default value if variable is not used
+ * @return true if valid value is read, false otherwise
+ */
+bool readEnvVariable(const char *pEnvVarName, uint32_t a_u32Min, uint32_t a_u32Max, uint32_t &a_u32Val)
+{
+	std::string sValue;
+	if(false == readEnvVariable(pEnvVarName, sValue))
+	{
+		return false;
+	}
+	char *pEnd = NULL;
+	errno = 0;
+	unsigned long ulValue = strtoul(sValue.c_str(), &pEnd, 10);
+	if((true == sValue.empty()) || ('-' == sValue[0]) || (NULL == pEnd) || ('\0' != *pEnd) || (0 != errno) ||
+			(ulValue < a_u32Min) || (ulValue > a_u32Max))
+	{
+		DO_LOG_ERROR(std::string(pEnvVarName) + " is not a number in range " + std::to_string(a_u32Min) + " to " +
+				std::to_string(a_u32Max) + ": " + sValue + ". Default value " + std::to_string(a_u32Val) + " is used.");
+		return false;
+	}
+	a_u32Val = (uint32_t)ulValue;
+	return true;
+}
+
 } /* namespace CommonUtils */
@@ -43,6 +43,7 @@ std::mutex __SubctxMapLock;
 std::mutex __PubctxMapLock;
 std::mutex __mtxUniqueTracker;
 std::mutex __mtxMakePubThSafe;
+std::mutex __PubHandleMapLock;
 
 // Unnamed namespace to define globals
 namespace
@@ -50,6 +51,7 @@ namespace
 	std::map<std::string, stZmqContext> g_mapContextMap;
 	std::map<std::string, stZmqSubContext> g_mapSubContextMap;
 	std::map<std::string, stZmqPubContext> g_mapPubContextMap;
+	std::map<std::string, std::unique_ptr<stZmqPubHandle>> g_mapPubHandleMap;
 	std::map<std::string,int> g_mapUniqueTopicTracker;
 	stPubCtxCfg g_pubCtxCfg;
 	// Check if EMB or Mqtt is specified in config
@@ -479,11 +481,56 @@ void zmq_handler::removePubCTX(std::string a_sTopic)
 	DO_LOG_DEBUG("End: ");
 }
 
+/**
+ * Get publisher handle of topic. Publisher context is created if it is not
+ * yet created. Handle is created once per topic and is valid till process ends.
+ * @param a_sTopic	:[in] topic for which to get publisher handle
+ * @return 	pointer to handle : on success,
+ * 			NULL : on error
+ */
+stZmqPubHandle* zmq_handler::getPubHandle(const std::string &a_sTopic)
+{
+	DO_LOG_DEBUG("Start: " + a_sTopic);
+	try
+	{
+		std::lock_guard<std::mutex> lck(__PubHandleMapLock);
+		auto itr = g_mapPubHandleMap.find(a_sTopic);
+		if(g_mapPubHandleMap.end() != itr)
+		{
+			return itr->second.get();
+		}
+
+		// create publisher if it is not yet created
+		if(false == isPubTopicPresentInMap(a_sTopic))
+		{
+			prepareContext(true, g_pubCtxCfg.m_pub_msgbus_ctx, a_sTopic, g_pubCtxCfg.m_pub_config);
+		}
+		void *pMsgbusCtx = getCTX(a_sTopic).m_pContext;
+		publisher_ctx_t *pPubCtx = (publisher_ctx_t*)getPubCTX(a_sTopic).m_pContext;
+		if((NULL == pMsgbusCtx) || (NULL == pPubCtx))
+		{
+			DO_LOG_ERROR("Context is NULL for topic: " + a_sTopic);
+			return NULL;
+		}
+
+		stZmqPubHandle *pPubHandle = new stZmqPubHandle(pMsgbusCtx, pPubCtx, a_sTopic);
+		g_mapPubHandleMap[a_sTopic].reset(pPubHandle);
+		DO_LOG_DEBUG("End: ");
+		return pPubHandle;
+	}
+	catch (std::exception &e)
+	{
+		DO_LOG_ERROR("Failed to get publisher for topic: " + a_sTopic + ", " + e.what());
+	}
+	return NULL;
+}
+
 /**
  * Publish json
  * @param a_sUsec		:[out] USEC timestamp value at which a message is published
  * @param msg			:[in] message to publish
  * @param a_sTopic		:[in] topic on which to publish
+ * @param a_sPubTimeField	:[in] key for publish timestamp, empty if timestamp is not needed
  * @return 	true : on success,
  * 			false : on error
  */
@@ -495,31 +542,45 @@ bool zmq_handler::publishJson(std::string &a_sUsec, msg_envelope_t* msg, const s
 		return false;
 	}
 	DO_LOG_DEBUG("msg to publish :: Topic :: " + a_sTopic);
-	zmq_handler::stZmqContext& msgbus_ctx = zmq_handler::getCTX(a_sTopic);
-	void* pub_ctx = zmq_handler::getPubCTX(a_sTopic).m_pContext;
-	if((NULL == msgbus_ctx.m_pContext) || (NULL == pub_ctx))
+	return publishJson(a_sUsec, msg, getPubHandle(a_sTopic), a_sPubTimeField);
+}
+
+/**
+ * Publish json using publisher handle. Only publisher socket of handle is
+ * locked, publishers of other topics on same msgbus context are not blocked.
+ * @param a_sUsec		:[out] USEC timestamp value at which a message is published
+ * @param msg			:[in] message to publish
+ * @param a_pPubHandle	:[in] publisher handle returned by getPubHandle
+ * @param a_sPubTimeField	:[in] key for publish timestamp, empty if timestamp is not needed
+ * @return 	true : on success,
+ * 			false : on error
+ */
+bool zmq_handler::publishJson(std::string &a_sUsec, msg_envelope_t* msg, stZmqPubHandle *a_pPubHandle, const std::string &a_sPubTimeField)
+{
+	if(NULL == msg)
+	{
+		DO_LOG_ERROR(": Failed to publish message - Input message is NULL");
+		return false;
+	}
+	if(NULL == a_pPubHandle)
 	{
-		DO_LOG_ERROR(": Failed to publish message - context is NULL: " + a_sTopic);
+		DO_LOG_ERROR(": Failed to publish message - publisher handle is NULL");
 		return false;
 	}
 	msgbus_ret_t ret;
 
 	{
-		std::lock_guard<std::mutex> lock(msgbus_ctx.m_mutex);
+		std::lock_guard<std::mutex> lock(a_pPubHandle->m_mutex);
 		if(a_sPubTimeField.empty() == false)
 		{
 			auto p1 = std::chrono::system_clock::now();
 			unsigned long uTime = (unsigned long)(std::chrono::duration_cast<std::chrono::microseconds>(p1.time_since_epoch()).count());
 			a_sUsec = std::to_string(uTime);
-			msg_envelope_elem_body_t* ptUsec = msgbus_msg_envelope_new_string(a_sUsec.c_str());
-			if(NULL != ptUsec)
-			{
-				msgbus_msg_envelope_put(msg, a_sPubTimeField.c_str(), ptUsec);
-			}
+			setStringField(msg, a_sPubTimeField.c_str(), a_sUsec.c_str());
 		}
-		ret = msgbus_publisher_publish(msgbus_ctx.m_pContext, (publisher_ctx_t*)pub_ctx, msg);
+		ret = msgbus_publisher_publish(a_pPubHandle->m_pMsgbusCtx, a_pPubHandle->m_pPubCtx, msg);
 		if(ret == MSG_SUCCESS) {
-			DO_LOG_DEBUG("Successfully published the message on the topic " + a_sTopic);
+			DO_LOG_DEBUG("Successfully published the message on the topic " + a_pPubHandle->m_sTopic);
 		}
 	}
 
@@ -532,6 +593,100 @@ bool zmq_handler::publishJson(std::string &a_sUsec, msg_envelope_t* msg, const s
 	return true;
 }
 
+/**
+ * Set string field of envelope. When field is already present as a string which is
+ * not shorter than new value, its buffer is overwritten and nothing is allocated.
+ * Otherwise field is replaced by new element.
+ * @param msg		:[in] envelope
+ * @param a_pcKey	:[in] field name
+ * @param a_pcValue	:[in] value to set
+ * @return 	true : on success,
+ * 			false : on error
+ */
+bool zmq_handler::setStringField(msg_envelope_t* msg, const char *a_pcKey, const char *a_pcValue)
+{
+	if((NULL == msg) || (NULL == a_pcKey) || (NULL == a_pcValue))
+	{
+		return false;
+	}
+	size_t szLen = strlen(a_pcValue);
+	msg_envelope_elem_body_t* pElem = NULL;
+	if((MSG_SUCCESS == msgbus_msg_envelope_get(msg, a_pcKey, &pElem)) && (NULL != pElem))
+	{
+		if((MSG_ENV_DT_STRING == pElem->type) && (NULL != pElem->body.string) &&
+				(szLen <= strlen(pElem->body.string)))
+		{
+			memcpy(pElem->body.string, a_pcValue, szLen + 1);
+			return true;
+		}
+		msgbus_msg_envelope_remove(msg, a_pcKey);
+	}
+
+	pElem = msgbus_msg_envelope_new_string(a_pcValue);
+	if(NULL == pElem)
+	{
+		DO_LOG_ERROR("Error: memory not allocated");
+		return false;
+	}
+	if(MSG_SUCCESS != msgbus_msg_envelope_put(msg, a_pcKey, pElem))
+	{
+		DO_LOG_ERROR(std::string("Could not add field: ") + a_pcKey);
+		msgbus_msg_envelope_elem_destroy(pElem);
+		return false;
+	}
+	return true;
+}
+
+/**
+ * Publish binary payload as CT_BLOB envelope using publisher handle.
+ * Payload is copied once, into the blob owned by envelope.
+ * @param a_pPubHandle	:[in] publisher handle returned by getPubHandle
+ * @param a_pData		:[in] payload
+ * @param a_len			:[in] length of payload
+ * @return 	true : on success,
+ * 			false : on error
+ */
+bool zmq_handler::publishBlob(stZmqPubHandle *a_pPubHandle, const char *a_pData, size_t a_len)
+{
+	if((NULL == a_pData) || (0 == a_len))
+	{
+		DO_LOG_ERROR(": Failed to publish message - Input payload is empty");
+		return false;
+	}
+	// blob element takes ownership of malloc-ed payload
+	char *pData = (char*)malloc(a_len);
+	if(NULL == pData)
+	{
+		DO_LOG_ERROR("Memory not allocated, payload is dropped");
+		return false;
+	}
+	memcpy(pData, a_pData, a_len);
+
+	bool bRet = false;
+	msg_envelope_t *pMsg = msgbus_msg_envelope_new(CT_BLOB);
+	msg_envelope_elem_body_t *pBlob = (NULL == pMsg) ? NULL : msgbus_msg_envelope_new_blob(pData, a_len);
+	if(NULL == pBlob)
+	{
+		DO_LOG_ERROR("Failed to create blob envelope");
+		free(pData);
+	}
+	else if(MSG_SUCCESS != msgbus_msg_envelope_put(pMsg, NULL, pBlob))
+	{
+		DO_LOG_ERROR("Failed to put blob in envelope");
+		msgbus_msg_envelope_elem_destroy(pBlob);
+	}
+	else
+	{
+		std::string sUsec{""};
+		bRet = publishJson(sUsec, pMsg, a_pPubHandle, "");
+	}
+	if(NULL != pMsg)
+	{
+		msgbus_msg_envelope_destroy(pMsg);
+	}
+	return bRet;
+}
+
 bool zmq_handler::returnAllTopics(std::string topicType, std::vector<std::string>& vecTopics) {
 	int numPubsOrSubs;
 	if(topicType == "pub") {
@@ -0,0 +1,87 @@
+/********************************************************************************
+* Copyright (c) 2021 Intel Corporation.
+
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*********************************************************************************/
+
+#include "../include/EmbBatch_ut.hpp"
+
+void EmbBatch_ut::SetUp()
+{
+	// Setup code
+}
+
+void EmbBatch_ut::TearDown()
+{
+	// TearDown code
+}
+
+/** Test for CEmbBatchReader to read entries written by CEmbBatchPublisher**/
+TEST_F(EmbBatch_ut, reader_ReadsEntries)
+{
+	std::string sMsg1 = "{\"data_topic\": \"/flowmeter/PL0/Flow/update\",\"value\": \"0x00\"}";
+	std::string sMsg2 = "{\"data_topic\": \"/flowmeter/PL0/Temp/update\",\"value\": \"0x01\"}";
+	std::string sBuf(EMB_BATCH_HEADER_LEN, '\0');
+	CEmbBatchPublisher::appendEntry(sBuf, "/flowmeter/PL0/Flow/update", sMsg1.c_str(), sMsg1.size());
+	CEmbBatchPublisher::appendEntry(sBuf, "/flowmeter/PL0/Temp/update", sMsg2.c_str(), sMsg2.size());
+	CEmbBatchPublisher::fillHeader(sBuf, 2);
+
+	ASSERT_EQ(true, m_oReader.open(sBuf.data(), sBuf.size()));
+	EXPECT_EQ((uint32_t)2, m_oReader.getCount());
+
+	stEmbBatchEntry stEntry;
+	ASSERT_EQ(true, m_oReader.next(stEntry));
+	EXPECT_EQ(std::string("/flowmeter/PL0/Flow/update"), std::string(stEntry.m_pTopic, stEntry.m_u16TopicLen));
+	EXPECT_EQ(sMsg1, std::string(stEntry.m_pMsg, stEntry.m_u32MsgLen));
+	// entry refers to batch payload, it is not copied
+	EXPECT_TRUE((stEntry.m_pMsg > sBuf.data()) && (stEntry.m_pMsg < sBuf.data() + sBuf.size()));
+
+	ASSERT_EQ(true, m_oReader.next(stEntry));
+	EXPECT_EQ(std::string("/flowmeter/PL0/Temp/update"), std::string(stEntry.m_pTopic, stEntry.m_u16TopicLen));
+	EXPECT_EQ(sMsg2, std::string(stEntry.m_pMsg, stEntry.m_u32MsgLen));
+
+	EXPECT_EQ(false, m_oReader.next(stEntry));
+}
+
+/** Test for CEmbBatchReader with invalid and truncated payload**/
+TEST_F(EmbBatch_ut, reader_InvalidPayload)
+{
+	std::string sMsg = "{\"value\": \"0x00\"}";
+	std::string sBuf(EMB_BATCH_HEADER_LEN, '\0');
+	CEmbBatchPublisher::appendEntry(sBuf, "/flowmeter/PL0/Flow/update", sMsg.c_str(), sMsg.size());
+	CEmbBatchPublisher::fillHeader(sBuf, 1);
+
+	// not a batch
+	std::string sJson = "{\"value\": \"0x00\", \"data_topic\": \"/a\"}";
+	EXPECT_EQ(false, m_oReader.open(sJson.data(), sJson.size()));
+
+	// truncated entry is not read
+	ASSERT_EQ(true, m_oReader.open(sBuf.data(), sBuf.size() - 1));
+	stEmbBatchEntry stEntry;
+	EXPECT_EQ(false, m_oReader.next(stEntry));
+}
+
+/** Test for CEmbBatchPublisher::addMsg() when batching is not enabled**/
+TEST_F(EmbBatch_ut, addMsg_Disabled)
+{
+	std::string sMsg = "{\"value\": \"0x00\"}";
+	EXPECT_EQ(false, CEmbBatchPublisher::instance().isEnabled(true));
+	EXPECT_EQ(false, CEmbBatchPublisher::instance().addMsg("TCP/RT/update", true,
+			"/flowmeter/PL0/Flow/update", sMsg.c_str(), sMsg.size()));
+}
@@ -0,0 +1,182 @@
+/********************************************************************************
+* Copyright (c) 2021 Intel Corporation.
+
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*********************************************************************************/
+
+#include "../include/JsonEnvelope_ut.hpp"
+#include "cjson/cJSON.h"
+#include <chrono>
+#include <iostream>
+
+/** message shapes exchanged on MQTT and EII*/
+static const std::string g_sReadReq = "{\"wellhead\": \"PL0\",\"command\": \"Flow\",\"timestamp\": \"2019-09-20 12:34:56\","
+		"\"usec\": \"1571887474111145\",\"version\": \"2.0\",\"app_seq\": \"1234\",\"realtime\": \"0\"}";
+static const std::string g_sWriteReq = "{\"wellhead\": \"PL0\",\"command\": \"Flow\",\"value\": \"0x00\",\"timestamp\": \"2019-09-20 12:34:56\","
+		"\"usec\": \"1571887474111145\",\"version\": \"2.0\",\"app_seq\": \"1234\",\"realtime\": \"1\",\"scaledValue\": 12.5}";
+static const std::string g_sUpdateMsg = "{\"driver_seq\": \"1171\",\"data_topic\": \"/flowmeter/PL0/Flow/update\",\"metric\": \"Flow\","
+		"\"wellhead\": \"PL0\",\"timestamp\": \"2019-09-20 12:34:56\",\"usec\": \"1571887474111145\",\"version\": \"2.0\","
+		"\"status\": \"Good\",\"value\": \"0x00\",\"scaledValue\": 0,\"lastGoodValue\": \"0x00\",\"dataPersist\": true,"
+		"\"tsPollingTime\": \"1571887474111145\",\"tsMsgRcvdFromMQTT\": \"1571887474111145\"}";
+
+void JsonEnvelope_ut::SetUp()
+{
+	// Setup code
+}
+
+void JsonEnvelope_ut::TearDown()
+{
+	// TearDown code
+}
+
+/** Test for CJsonToEnvelope::convert() to check value types and nested elements**/
+TEST_F(JsonEnvelope_ut, convert_TypedValues)
+{
+	msg_envelope_t *pMsg = m_oConverter.convert("{\"s\": \"a\\\"b\\u00e9\", \"i\": -12, \"f\": 1.5e1, \"b\": true,"
+			" \"n\": null, \"o\": {\"k\": \"v\", \"arr\": [1, \"x\", {}]}}");
+	ASSERT_NE((msg_envelope_t*)NULL, pMsg);
+
+	msg_envelope_elem_body_t *pData = NULL;
+	ASSERT_EQ(MSG_SUCCESS, msgbus_msg_envelope_get(pMsg, "s", &pData));
+	ASSERT_EQ(MSG_ENV_DT_STRING, pData->type);
+	EXPECT_EQ(std::string("a\"b\xC3\xA9"), std::string(pData->body.string));
+
+	ASSERT_EQ(MSG_SUCCESS, msgbus_msg_envelope_get(pMsg, "i", &pData));
+	ASSERT_EQ(MSG_ENV_DT_INT, pData->type);
+	EXPECT_EQ(-12, pData->body.integer);
+
+	ASSERT_EQ(MSG_SUCCESS, msgbus_msg_envelope_get(pMsg, "f", &pData));
+	ASSERT_EQ(MSG_ENV_DT_FLOATING, pData->type);
+	EXPECT_DOUBLE_EQ(15.0, pData->body.floating);
+
+	ASSERT_EQ(MSG_SUCCESS, msgbus_msg_envelope_get(pMsg, "b", &pData));
+	ASSERT_EQ(MSG_ENV_DT_BOOLEAN, pData->type);
+	EXPECT_EQ(true, pData->body.boolean);
+
+	ASSERT_EQ(MSG_SUCCESS, msgbus_msg_envelope_get(pMsg, "n", &pData));
+	EXPECT_EQ(MSG_ENV_DT_NONE, pData->type);
+
+	ASSERT_EQ(MSG_SUCCESS, msgbus_msg_envelope_get(pMsg, "o", &pData));
+	ASSERT_EQ(MSG_ENV_DT_OBJECT, pData->type);
+	msg_envelope_elem_body_t *pArr = msgbus_msg_envelope_elem_object_get(pData, "arr");
+	ASSERT_NE((msg_envelope_elem_body_t*)NULL, pArr);
+	ASSERT_EQ(MSG_ENV_DT_ARRAY, pArr->type);
+	msg_envelope_elem_body_t *pElem = msgbus_msg_envelope_elem_array_get_at(pArr, 1);
+	ASSERT_NE((msg_envelope_elem_body_t*)NULL, pElem);
+	EXPECT_EQ(std::string("x"), std::string(pElem->body.string));
+	pElem = msgbus_msg_envelope_elem_object_get(pData, "k");
+	ASSERT_NE((msg_envelope_elem_body_t*)NULL, pElem);
+	EXPECT_EQ(std::string("v"), std::string(pElem->body.string));
+
+	msgbus_msg_envelope_destroy(pMsg);
+}
+
+/** Test for CJsonToEnvelope::convert() to check that malformed text is rejected**/
+TEST_F(JsonEnvelope_ut, convert_InvalidJson)
+{
+	const char *arrInvalid[] = {"", "InvMsg", "[1, 2]", "{\"a\": }", "{\"a\": 1", "{\"a\": 1} x",
+			"{\"a\": tru}", "{\"a\": \"b}", "{\"a\": 01.}", "{a: 1}", "{\"a\": \"\\ud800\"}"};
+	for(const char *pszJson : arrInvalid)
+	{
+		EXPECT_EQ((msg_envelope_t*)NULL, m_oConverter.convert(pszJson)) << pszJson;
+	}
+
+	// converter is usable after an error
+	msg_envelope_t *pMsg = m_oConverter.convert(g_sWriteReq);
+	ASSERT_NE((msg_envelope_t*)NULL, pMsg);
+	msgbus_msg_envelope_destroy(pMsg);
+}
+
+/** Test for CJsonToEnvelope::convertToObject()**/
+TEST_F(JsonEnvelope_ut, convertToObject_Members)
+{
+	msg_envelope_elem_body_t *pObj = m_oConverter.convertToObject(g_sReadReq);
+	ASSERT_NE((msg_envelope_elem_body_t*)NULL, pObj);
+	msg_envelope_elem_body_t *pElem = msgbus_msg_envelope_elem_object_get(pObj, "app_seq");
+	ASSERT_NE((msg_envelope_elem_body_t*)NULL, pElem);
+	EXPECT_EQ(std::string("1234"), std::string(pElem->body.string));
+	msgbus_msg_envelope_elem_destroy(pObj);
+}
+
+/**
+ * Microbenchmark of CJsonToEnvelope against cJSON document walk used earlier by
+ * publishers. Run with --gtest_also_run_disabled_tests.
+ */
+TEST_F(JsonEnvelope_ut, DISABLED_benchmark_VsCJSON)
+{
+	const int iIterations = 100000;
+	auto convertWithCJSON = [](const std::string &a_sJson) -> msg_envelope_t*
+	{
+		cJSON *root = cJSON_Parse(a_sJson.c_str());
+		if(NULL == root)
+		{
+			return NULL;
+		}
+		msg_envelope_t *msg = msgbus_msg_envelope_new(CT_JSON);
+		for(cJSON *device = root->child; NULL != device; device = device->next)
+		{
+			msg_envelope_elem_body_t *value = NULL;
+			if(cJSON_IsString(device))
+			{
+				value = msgbus_msg_envelope_new_string(device->valuestring);
+			}
+			else if(cJSON_IsBool(device))
+			{
+				value = msgbus_msg_envelope_new_bool(cJSON_IsTrue(device) ? true : false);
+			}
+			else if(cJSON_IsNumber(device))
+			{
+				value = msgbus_msg_envelope_new_floating(device->valuedouble);
+			}
+			if(NULL != value)
+			{
+				msgbus_msg_envelope_put(msg, device->string, value);
+			}
+		}
+		cJSON_Delete(root);
+		return msg;
+	};
+
+	const std::string *arrShapes[] = {&g_sReadReq, &g_sWriteReq, &g_sUpdateMsg};
+	const char *arrNames[] = {"on-demand read", "on-demand write", "update"};
+	for(int i = 0; i < 3; ++i)
+	{
+		auto tStart = std::chrono::steady_clock::now();
+		for(int iter = 0; iter < iIterations; ++iter)
+		{
+			msg_envelope_t *pMsg = convertWithCJSON(*arrShapes[i]);
+			ASSERT_NE((msg_envelope_t*)NULL, pMsg);
+			msgbus_msg_envelope_destroy(pMsg);
+		}
+		auto tMid = std::chrono::steady_clock::now();
+		for(int iter = 0; iter < iIterations; ++iter)
+		{
+			msg_envelope_t *pMsg = m_oConverter.convert(*arrShapes[i]);
+			ASSERT_NE((msg_envelope_t*)NULL, pMsg);
+			msgbus_msg_envelope_destroy(pMsg);
+		}
+		auto tEnd = std::chrono::steady_clock::now();
+
+		std::cout << arrNames[i] << " : cJSON "
+				<< std::chrono::duration_cast<std::chrono::nanoseconds>(tMid - tStart).count() / iIterations
+				<< " ns/msg, streaming "
+				<< std::chrono::duration_cast<std::chrono::nanoseconds>(tEnd - tMid).count() / iIterations
+				<< " ns/msg" << std::endl;
+	}
+}
@@ -33,7 +33,7 @@ void MQTTPubSubClient_ut::TearDown()
 	// TearDown code
 }
 
-/**Test for CMQTTPubSubClient::publishMsg()**/
+/**Test for CMQTTPubSubClient::publishMsg() when client is not connected**/
 TEST_F(MQTTPubSubClient_ut, Pubmsg)
 {
 	std::string Topic = "TCP_WrReq";
@@ -42,7 +42,7 @@ TEST_F(MQTTPubSubClient_ut, Pubmsg)
 	mqtt::message_ptr pubmsg = mqtt::make_message(Topic, Msg, QOS, false);
 
 	bool RetVal = CMQTTPubSubClient_obj.publishMsg(pubmsg);
-	EXPECT_EQ(true, RetVal);
+	EXPECT_EQ(false, RetVal);
 }
 
 /**Test for CMQTTPubSubClient::connect() *
@@ -105,12 +105,52 @@ TEST_F(MQTTPubSubClient_ut, Disconnect)
 	//EXPECT_EQ(false, RetVal);
 }
 
-/**Test for MQTTBaseHandler::publishMsg() **/
+/**Test for MQTTBaseHandler::publishMsg() when client is not connected **/
 TEST_F(MQTTPubSubClient_ut, PublishMsg)
 {
 	std::string strMsg = "{ 	\"value\": \"0xFF00\", 	\"command\": \"Pointname\", 	\"app_seq\": \"1234\" }";
 	std::string Topic = "TCP_WrReq";
 	bool RetVal = CMQTTBaseHandler_obj.publishMsg(strMsg, Topic);
-	EXPECT_EQ(true, RetVal);
+	EXPECT_EQ(false, RetVal);
+	RetVal = CMQTTBaseHandler_obj.publishMsg(std::move(strMsg), Topic);
+	EXPECT_EQ(false, RetVal);
 }
 
+
+/**Test for CMQTTPubSubClient::publishMsgWindowed() with drop oldest policy when client is not connected **/
+TEST_F(MQTTPubSubClient_ut, PublishWindowed_DropOldest)
+{
+	std::string Topic = "TCP_WrReq";
+	CMQTTPubSubClient_obj.setPublishWindow(1, 2);
+	for(int i = 0; i < 3; ++i)
+	{
+		mqtt::message_ptr pubmsg = mqtt::make_message(Topic, std::to_string(i), iQOS, false);
+		EXPECT_EQ(true, CMQTTPubSubClient_obj.publishMsgWindowed(pubmsg, enPUBLISH_POLICY_DROP_OLDEST, 0));
+	}
+	EXPECT_EQ((size_t)2, CMQTTPubSubClient_obj.getPendingCount());
+	EXPECT_EQ((uint64_t)1, CMQTTPubSubClient_obj.getDroppedCount());
+}
+
+/**Test for CMQTTPubSubClient::publishMsgWindowed() with spool policy when client is not connected **/
+TEST_F(MQTTPubSubClient_ut, PublishWindowed_Spool)
+{
+	std::string Topic = "TCP_WrReq";
+	CMQTTPubSubClient_obj.setPublishWindow(1, 2);
+	mqtt::message_ptr pubmsg = mqtt::make_message(Topic, "msg", iQOS, false);
+	EXPECT_EQ(false, CMQTTPubSubClient_obj.publishMsgWindowed(pubmsg, enPUBLISH_POLICY_SPOOL, 0));
+	EXPECT_EQ((size_t)0, CMQTTPubSubClient_obj.getPendingCount());
+}
+
+/**Test for MQTTBaseHandler::publishMsgWindowed() with block policy when pending messages are at max **/
+TEST_F(MQTTPubSubClient_ut, PublishWindowed_BlockTimeout)
+{
+	std::string strMsg = "{\"value\": \"0xFF00\"}";
+	std::string Topic = "TCP_WrReq";
+	CMQTTBaseHandler_obj.setPublishWindow(1, 1);
+	std::string sMsg1{strMsg}, sMsg2{strMsg};
+	EXPECT_EQ(true, CMQTTBaseHandler_obj.publishMsgWindowed(sMsg1, Topic, enPUBLISH_POLICY_BLOCK, 10));
+	EXPECT_EQ(false, CMQTTBaseHandler_obj.publishMsgWindowed(sMsg2, Topic, enPUBLISH_POLICY_BLOCK, 10));
+	// message which is not taken is given back
+	EXPECT_EQ(strMsg, sMsg2);
+	EXPECT_EQ((size_t)1, CMQTTBaseHandler_obj.getPendingCount());
+}
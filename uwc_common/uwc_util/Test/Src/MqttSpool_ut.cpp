@@ -0,0 +1,117 @@
+/********************************************************************************
+* Copyright (c) 2021 Intel Corporation.
+
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*********************************************************************************/
+
+#include "../include/MqttSpool_ut.hpp"
+#include <cstdlib>
+#include <unistd.h>
+
+void MqttSpool_ut::SetUp()
+{
+	char arrDir[] = "/tmp/mqtt_spool_ut_XXXXXX";
+	m_sDir = (NULL == mkdtemp(arrDir)) ? "/tmp/mqtt_spool_ut" : arrDir;
+}
+
+void MqttSpool_ut::TearDown()
+{
+	std::string sCmd = "rm -rf " + m_sDir;
+	(void)system(sCmd.c_str());
+}
+
+/** Test for CMqttSpool to read messages in the order of append**/
+TEST_F(MqttSpool_ut, appendFrontPop_InOrder)
+{
+	CMqttSpool oSpool;
+	ASSERT_EQ(true, oSpool.open(m_sDir, "NRT", 256, 4));
+	EXPECT_EQ(true, oSpool.append("/flowmeter/PL0/Flow/update", "{\"value\": \"0x00\"}"));
+	EXPECT_EQ(true, oSpool.append("/flowmeter/PL0/Temp/update", "{\"value\": \"0x01\"}"));
+	EXPECT_EQ((uint64_t)2, oSpool.getDepth());
+
+	ASSERT_EQ(true, oSpool.front(m_sTopic, m_sMsg));
+	EXPECT_EQ("/flowmeter/PL0/Flow/update", m_sTopic);
+	EXPECT_EQ("{\"value\": \"0x00\"}", m_sMsg);
+	// message stays in spool till it is popped
+	ASSERT_EQ(true, oSpool.front(m_sTopic, m_sMsg));
+	EXPECT_EQ("/flowmeter/PL0/Flow/update", m_sTopic);
+	EXPECT_EQ(true, oSpool.pop());
+
+	ASSERT_EQ(true, oSpool.front(m_sTopic, m_sMsg));
+	EXPECT_EQ("/flowmeter/PL0/Temp/update", m_sTopic);
+	EXPECT_EQ(true, oSpool.pop());
+
+	EXPECT_EQ(false, oSpool.front(m_sTopic, m_sMsg));
+	EXPECT_EQ((uint64_t)0, oSpool.getDepth());
+	EXPECT_EQ((uint64_t)2, oSpool.getDrainedCount());
+}
+
+/** Test for CMqttSpool to load messages left by earlier run**/
+TEST_F(MqttSpool_ut, open_LoadsSpooledMessages)
+{
+	{
+		CMqttSpool oSpool;
+		ASSERT_EQ(true, oSpool.open(m_sDir, "RT", 128, 8));
+		for(int i = 0; i < 6; ++i)
+		{
+			EXPECT_EQ(true, oSpool.append("/a/b/c/update", "msg" + std::to_string(i)));
+		}
+		EXPECT_EQ(true, oSpool.pop());
+	}
+
+	CMqttSpool oSpool;
+	ASSERT_EQ(true, oSpool.open(m_sDir, "RT", 128, 8));
+	EXPECT_EQ((uint64_t)5, oSpool.getDepth());
+	for(int i = 1; i < 6; ++i)
+	{
+		ASSERT_EQ(true, oSpool.front(m_sTopic, m_sMsg));
+		EXPECT_EQ("msg" + std::to_string(i), m_sMsg);
+		EXPECT_EQ(true, oSpool.pop());
+	}
+	EXPECT_EQ(false, oSpool.front(m_sTopic, m_sMsg));
+}
+
+/** Test for CMqttSpool to discard oldest segment when spool is full**/
+TEST_F(MqttSpool_ut, append_FullSpoolDropsOldest)
+{
+	CMqttSpool oSpool;
+	// each segment holds 2 records of 8 + 13 + 4 bytes
+	ASSERT_EQ(true, oSpool.open(m_sDir, "NRT", 64 + 50, 2));
+	for(int i = 0; i < 6; ++i)
+	{
+		EXPECT_EQ(true, oSpool.append("/a/b/c/update", "m" + std::to_string(i) + "__"));
+	}
+	EXPECT_EQ((uint64_t)4, oSpool.getDepth());
+	EXPECT_EQ((uint64_t)2, oSpool.getDroppedCount());
+	ASSERT_EQ(true, oSpool.front(m_sTopic, m_sMsg));
+	EXPECT_EQ("m2__", m_sMsg);
+
+	// message larger than a segment is not spooled
+	EXPECT_EQ(false, oSpool.append("/a/b/c/update", std::string(100, 'x')));
+}
+
+/** Test for CMqttSpool with invalid configuration**/
+TEST_F(MqttSpool_ut, open_InvalidConfig)
+{
+	CMqttSpool oSpool;
+	EXPECT_EQ(false, oSpool.open("", "NRT", 4096, 4));
+	EXPECT_EQ(false, oSpool.open(m_sDir, "NRT", 16, 4));
+	EXPECT_EQ(false, oSpool.open(m_sDir, "NRT", 4096, 0));
+	EXPECT_EQ(false, oSpool.append("/a/b/c/update", "msg"));
+}
@@ -0,0 +1,186 @@
+/********************************************************************************
+* Copyright (c) 2021 Intel Corporation.
+
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*********************************************************************************/
+
+#include "../include/PolledUpdate_ut.hpp"
+#include "cjson/cJSON.h"
+#include <chrono>
+#include <iostream>
+
+void PolledUpdate_ut::SetUp()
+{
+	// update as published for a good response of a float point
+	m_stUpdate.m_sDataTopic = "/flowmeter/PL0/Flow/update";
+	m_stUpdate.m_u32PointId = 1048577;
+	m_stUpdate.m_sWellhead = "PL0";
+	m_stUpdate.m_sMetric = "Flow";
+	m_stUpdate.m_sDataType = "float";
+	m_stUpdate.m_bIsRealTime = true;
+	m_stUpdate.m_bIsDataPersist = true;
+	m_stUpdate.m_bIsHexValue = true;
+	m_stUpdate.m_sHexValue = "0x41480000";
+	m_stUpdate.m_eValueType = enPOLLED_VALUE_FLOAT;
+	m_stUpdate.m_dValue = 12.5;
+	m_stUpdate.m_u64DriverSeq = 281474976711825ULL;
+	m_stUpdate.m_i64TsPolling = 1571887474111145;
+	m_stUpdate.m_i64ReqRcvdInStack = 1571887474111150;
+	m_stUpdate.m_i64ReqSentByStack = 1571887474111160;
+	m_stUpdate.m_i64RespRcvdByStack = 1571887474112000;
+	m_stUpdate.m_i64RespPostedByStack = 1571887474112010;
+	m_stUpdate.m_i64Timestamp = 1571887474112100;
+	m_stUpdate.m_i64Usec = 1571887474112200;
+}
+
+void PolledUpdate_ut::TearDown()
+{
+	// TearDown code
+}
+
+/** Test for CPolledUpdateCodec::encode() and decode() to check all fields are carried**/
+TEST_F(PolledUpdate_ut, encodeDecode_RoundTrip)
+{
+	CPolledUpdateCodec::encode(m_stUpdate, m_sBuf);
+	ASSERT_EQ(true, CPolledUpdateCodec::isPolledUpdate(m_sBuf.data(), m_sBuf.size()));
+	ASSERT_EQ(true, CPolledUpdateCodec::decode(m_sBuf.data(), m_sBuf.size(), m_stDecoded));
+
+	EXPECT_EQ(m_stUpdate.m_u32PointId, m_stDecoded.m_u32PointId);
+	EXPECT_EQ(m_stUpdate.m_sDataTopic, m_stDecoded.m_sDataTopic);
+	EXPECT_EQ(m_stUpdate.m_sWellhead, m_stDecoded.m_sWellhead);
+	EXPECT_EQ(m_stUpdate.m_sMetric, m_stDecoded.m_sMetric);
+	EXPECT_EQ(m_stUpdate.m_sDataType, m_stDecoded.m_sDataType);
+	EXPECT_EQ(true, m_stDecoded.m_bIsRealTime);
+	EXPECT_EQ(true, m_stDecoded.m_bIsDataPersist);
+	EXPECT_EQ(enPOLLED_STATUS_GOOD, m_stDecoded.m_eStatus);
+	EXPECT_EQ(true, m_stDecoded.m_bIsHexValue);
+	EXPECT_EQ(m_stUpdate.m_sHexValue, m_stDecoded.m_sHexValue);
+	EXPECT_EQ(enPOLLED_VALUE_FLOAT, m_stDecoded.m_eValueType);
+	EXPECT_EQ(12.5, m_stDecoded.m_dValue);
+	EXPECT_EQ(m_stUpdate.m_u64DriverSeq, m_stDecoded.m_u64DriverSeq);
+	EXPECT_EQ(m_stUpdate.m_i64TsPolling, m_stDecoded.m_i64TsPolling);
+	EXPECT_EQ(m_stUpdate.m_i64RespPostedByStack, m_stDecoded.m_i64RespPostedByStack);
+	EXPECT_EQ(m_stUpdate.m_i64Usec, m_stDecoded.m_i64Usec);
+
+	// negative integer survives encoding
+	m_stUpdate.m_eValueType = enPOLLED_VALUE_INT;
+	m_stUpdate.m_i64Value = -42;
+	CPolledUpdateCodec::encode(m_stUpdate, m_sBuf);
+	ASSERT_EQ(true, CPolledUpdateCodec::decode(m_sBuf.data(), m_sBuf.size(), m_stDecoded));
+	EXPECT_EQ(enPOLLED_VALUE_INT, m_stDecoded.m_eValueType);
+	EXPECT_EQ(-42, m_stDecoded.m_i64Value);
+}
+
+/** Test for CPolledUpdateCodec::decode() with invalid and truncated payload**/
+TEST_F(PolledUpdate_ut, decode_InvalidPayload)
+{
+	std::string sJson = "{\"data_topic\": \"/flowmeter/PL0/Flow/update\",\"value\": \"0x00\"}";
+	EXPECT_EQ(false, CPolledUpdateCodec::decode(sJson.data(), sJson.size(), m_stDecoded));
+
+	CPolledUpdateCodec::encode(m_stUpdate, m_sBuf);
+	EXPECT_EQ(false, CPolledUpdateCodec::decode(m_sBuf.data(), m_sBuf.size() - 1, m_stDecoded));
+
+	// other layout version is not decoded
+	m_sBuf[4] = (char)(POLLED_UPDATE_VERSION + 1);
+	EXPECT_EQ(false, CPolledUpdateCodec::isPolledUpdate(m_sBuf.data(), m_sBuf.size()));
+}
+
+/** Test for CPolledUpdateCodec::toJson() to check fields of bad response**/
+TEST_F(PolledUpdate_ut, toJson_BadResponse)
+{
+	m_stUpdate.m_eStatus = enPOLLED_STATUS_BAD;
+	m_stUpdate.m_u32ErrorCode = 2002;
+	m_stUpdate.m_i64LastGoodUsec = 1571887474000000;
+	m_stUpdate.m_bIsHexValue = false;
+	m_stUpdate.m_eValueType = enPOLLED_VALUE_BOOL;
+	m_stUpdate.m_bValue = true;
+
+	std::string sJson;
+	CPolledUpdateCodec::toJson(m_stUpdate, sJson);
+	cJSON *pRoot = cJSON_Parse(sJson.c_str());
+	ASSERT_NE((cJSON*)NULL, pRoot);
+
+	EXPECT_EQ(std::string("Bad"), std::string(cJSON_GetObjectItem(pRoot, "status")->valuestring));
+	EXPECT_EQ(std::string("2002"), std::string(cJSON_GetObjectItem(pRoot, "error_code")->valuestring));
+	EXPECT_EQ(std::string("1571887474000000"), std::string(cJSON_GetObjectItem(pRoot, "lastGoodUsec")->valuestring));
+	EXPECT_EQ(std::string("281474976711825"), std::string(cJSON_GetObjectItem(pRoot, "driver_seq")->valuestring));
+	EXPECT_EQ(std::string("1"), std::string(cJSON_GetObjectItem(pRoot, "realtime")->valuestring));
+	EXPECT_EQ(std::string("2019-10-24 03:24:34"), std::string(cJSON_GetObjectItem(pRoot, "timestamp")->valuestring));
+	EXPECT_TRUE(cJSON_IsTrue(cJSON_GetObjectItem(pRoot, "scaledValue")));
+	EXPECT_TRUE(cJSON_IsTrue(cJSON_GetObjectItem(pRoot, "dataPersist")));
+	EXPECT_EQ(false, cJSON_HasObjectItem(pRoot, "value"));
+	cJSON_Delete(pRoot);
+}
+
+/** Benchmark of binary polled update against JSON envelope, run with --gtest_also_run_disabled_tests**/
+TEST_F(PolledUpdate_ut, DISABLED_benchmark_VsJSON)
+{
+	const int iIterations = 100000;
+	auto buildEnvelope = [this]() -> msg_envelope_t*
+	{
+		msg_envelope_t *pMsg = msgbus_msg_envelope_new(CT_JSON);
+		std::string sValue;
+		const char *arrFields[] = {"version", "data_topic", "wellhead", "metric", "realtime", "datatype",
+				"tsPollingTime", "reqRcvdInStack", "reqSentByStack", "respRcvdByStack", "respPostedByStack",
+				"value", "status", "driver_seq", "timestamp", "usec"};
+		for(const char *pszKey : arrFields)
+		{
+			CPolledUpdateCodec::getField(m_stUpdate, pszKey, sValue);
+			msgbus_msg_envelope_put(pMsg, pszKey, msgbus_msg_envelope_new_string(sValue.c_str()));
+		}
+		msgbus_msg_envelope_put(pMsg, "dataPersist", msgbus_msg_envelope_new_bool(true));
+		msgbus_msg_envelope_put(pMsg, "scaledValue", msgbus_msg_envelope_new_floating(m_stUpdate.m_dValue));
+		return pMsg;
+	};
+
+	// JSON: producer fills envelope and serializes it, consumer parses JSON and reads value
+	size_t jsonBytes = 0;
+	auto tStart = std::chrono::steady_clock::now();
+	for(int iter = 0; iter < iIterations; ++iter)
+	{
+		msg_envelope_t *pMsg = buildEnvelope();
+		msg_envelope_serialized_part_t *parts = NULL;
+		int num_parts = msgbus_msg_envelope_serialize(pMsg, &parts);
+		ASSERT_GT(num_parts, 0);
+		jsonBytes = parts[0].len;
+		cJSON *pRoot = cJSON_Parse(parts[0].bytes);
+		ASSERT_NE((cJSON*)NULL, pRoot);
+		ASSERT_EQ(12.5, cJSON_GetObjectItem(pRoot, "scaledValue")->valuedouble);
+		cJSON_Delete(pRoot);
+		msgbus_msg_envelope_serialize_destroy(parts, num_parts);
+		msgbus_msg_envelope_destroy(pMsg);
+	}
+	auto tMid = std::chrono::steady_clock::now();
+
+	// binary: producer encodes in reused buffer, consumer decodes in reused update
+	for(int iter = 0; iter < iIterations; ++iter)
+	{
+		CPolledUpdateCodec::encode(m_stUpdate, m_sBuf);
+		ASSERT_EQ(true, CPolledUpdateCodec::decode(m_sBuf.data(), m_sBuf.size(), m_stDecoded));
+		ASSERT_EQ(12.5, m_stDecoded.m_dValue);
+	}
+	auto tEnd = std::chrono::steady_clock::now();
+
+	std::cout << "update : JSON " << jsonBytes << " bytes, "
+			<< std::chrono::duration_cast<std::chrono::nanoseconds>(tMid - tStart).count() / iIterations
+			<< " ns/msg, binary " << m_sBuf.size() << " bytes, "
+			<< std::chrono::duration_cast<std::chrono::nanoseconds>(tEnd - tMid).count() / iIterations
+			<< " ns/msg" << std::endl;
+	EXPECT_LT(m_sBuf.size(), jsonBytes);
+}
@@ -271,3 +271,41 @@ TEST_F(ZmqHandler_ut, prepareContext_NULLArg_msgbus_ctx)
 	EXPECT_EQ(false, Res);
 }
 
+
+/**Test for getPubHandle(), same handle is returned for a topic**/
+TEST_F(ZmqHandler_ut, getPubHandle_SameHandle)
+{
+	int iMsgbusCtx = 0;
+	int iPubCtx = 0;
+	std::string topic = "Modbus-TCP-Master_PubHandle";
+	zmq_handler::stZmqContext objTempCtx{&iMsgbusCtx};
+	zmq_handler::stZmqPubContext objTempPubCtx;
+	objTempPubCtx.m_pContext = &iPubCtx;
+	zmq_handler::insertCTX(topic, objTempCtx);
+	zmq_handler::insertPubCTX(topic, objTempPubCtx);
+
+	zmq_handler::stZmqPubHandle *pPubHandle = zmq_handler::getPubHandle(topic);
+	ASSERT_NE((zmq_handler::stZmqPubHandle*)NULL, pPubHandle);
+	EXPECT_EQ(pPubHandle, zmq_handler::getPubHandle(topic));
+	EXPECT_EQ((void*)&iMsgbusCtx, pPubHandle->m_pMsgbusCtx);
+	EXPECT_EQ((void*)&iPubCtx, (void*)pPubHandle->m_pPubCtx);
+}
+
+/**Test for publishJson() with NULL publisher handle**/
+TEST_F(ZmqHandler_ut, publishJson_NULLPubHandle)
+{
+	std::string sUsec;
+	msg_envelope_t *msg = msgbus_msg_envelope_new(CT_JSON);
+	zmq_handler::stZmqPubHandle *pPubHandle = NULL;
+
+	EXPECT_EQ(false, zmq_handler::publishJson(sUsec, msg, pPubHandle, "usec"));
+	msgbus_msg_envelope_destroy(msg);
+}
+
+/**Test for publishBlob() with empty payload and NULL publisher handle**/
+TEST_F(ZmqHandler_ut, publishBlob_InvalidInput)
+{
+	std::string sPayload = "UWCP";
+	EXPECT_EQ(false, zmq_handler::publishBlob(NULL, NULL, 0));
+	EXPECT_EQ(false, zmq_handler::publishBlob(NULL, sPayload.data(), sPayload.size()));
+}
@@ -0,0 +1,157 @@
+/********************************************************************************
+* Copyright (c) 2021 Intel Corporation.
+
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*********************************************************************************/
+/*** EmbBatch.hpp is used to publish and receive many EII messages in one batch envelope*/
+
+#ifndef EMBBATCH_HPP_
+#define EMBBATCH_HPP_
+
+#include <string>
+#include <map>
+#include <deque>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <eii/msgbus/msgbus.h>
+#include "ZmqHandler.hpp"
+
+/** identifies batch payload, followed by version, reserved bytes and entry count*/
+#define EMB_BATCH_MAGIC "UWCB"
+/** version of batch payload layout*/
+#define EMB_BATCH_VERSION 1
+/** length of batch header: magic(4), version(1), reserved(3), entry count(4)*/
+#define EMB_BATCH_HEADER_LEN 12
+/** length of entry header: topic length(2), message length(4)*/
+#define EMB_BATCH_ENTRY_HEADER_LEN 6
+
+/** Limits of a batch, batch is published when either limit is reached */
+struct stEmbBatchCfg
+{
+	uint32_t m_u32MaxCount; /** max messages in a batch, 0 or 1 means batching is disabled*/
+	uint32_t m_u32MaxLatencyMs; /** max time for which first message of batch waits*/
+};
+
+/** Entry of received batch. Pointers refer to received envelope and
+ * are valid till envelope is destroyed */
+struct stEmbBatchEntry
+{
+	const char *m_pTopic; /** data topic of message, not null terminated*/
+	uint16_t m_u16TopicLen; /** length of data topic*/
+	const char *m_pMsg; /** serialized JSON message, not null terminated*/
+	uint32_t m_u32MsgLen; /** length of message*/
+};
+
+/**
+ * Batch payload layout is:
+ * header : "UWCB", version, 3 reserved bytes, u32 entry count
+ * entry  : u16 topic length, u32 message length, topic, JSON message
+ * Integers are little endian. Payload is sent as CT_BLOB envelope.
+ */
+
+/**
+ * CEmbBatchPublisher class collects messages per EII topic and publishes
+ * them as one batch envelope when batch is full or its latency bound is
+ * reached. Batches are published by one flush thread, hence batches of a
+ * topic are published in order.
+ */
+class CEmbBatchPublisher
+{
+	/** messages collected for a topic*/
+	struct stEmbBatch
+	{
+		std::string m_sBuf; /** batch payload, header is filled when batch is full or is published*/
+		uint32_t m_u32Count; /** messages in batch*/
+		std::deque<std::string> m_qFull; /** full batches waiting for flush thread*/
+		bool m_bIsRT; /** RT or non-RT batch(true or false)*/
+		std::chrono::steady_clock::time_point m_tpFlush; /** time when batch is to be published*/
+		zmq_handler::stZmqPubHandle *m_pPubHandle; /** publisher of topic*/
+	};
+
+	std::map<std::string, stEmbBatch> m_mapBatch; /** batches per EII topic*/
+	std::mutex m_mutexBatch; /** mutex for batches*/
+	std::condition_variable m_cvBatch; /** signals flush thread about batch to publish*/
+	stEmbBatchCfg m_stRTCfg; /** limits of RT batches*/
+	stEmbBatchCfg m_stNRTCfg; /** limits of non-RT batches*/
+	std::atomic<bool> m_bIsStop; /** flush thread is to stop(true or false)*/
+	std::thread m_threadFlush; /** thread publishing batches*/
+	std::vector<std::pair<zmq_handler::stZmqPubHandle*, std::string>> m_vToPublish; /** batches taken by flush thread*/
+
+	CEmbBatchPublisher();
+	~CEmbBatchPublisher();
+	// delete copy and move constructors and assign operators
+	CEmbBatchPublisher(const CEmbBatchPublisher&) = delete;	 			// Copy construct
+	CEmbBatchPublisher& operator=(const CEmbBatchPublisher&) = delete;	// Copy assign
+
+	const stEmbBatchCfg& getCfg(bool a_bIsRT) {return (true == a_bIsRT) ? m_stRTCfg : m_stNRTCfg;}
+	void takeBatch(std::string &a_sBuf, zmq_handler::stZmqPubHandle *a_pPubHandle);
+	void flushThread();
+	bool publishBatch(zmq_handler::stZmqPubHandle *a_pPubHandle, const std::string &a_sBuf);
+
+public:
+	static CEmbBatchPublisher& instance();
+
+	bool init(const stEmbBatchCfg &a_stRTCfg, const stEmbBatchCfg &a_stNRTCfg);
+	void stop();
+
+	/** checks if messages of RT or non-RT class are batched*/
+	bool isEnabled(bool a_bIsRT) {return (1 < getCfg(a_bIsRT).m_u32MaxCount);}
+
+	bool addMsg(const std::string &a_sBatchTopic, bool a_bIsRT,
+			const std::string &a_sDataTopic, const char *a_pMsg, size_t a_len);
+
+	bool addMsg(std::string &a_sUsec, msg_envelope_t *a_pMsg, const std::string &a_sBatchTopic,
+			bool a_bIsRT, const std::string &a_sPubTimeField);
+
+	void flushAll();
+
+	static void appendEntry(std::string &a_sBuf, const std::string &a_sDataTopic, const char *a_pMsg, size_t a_len);
+
+	static void fillHeader(std::string &a_sBuf, uint32_t a_u32Count);
+};
+
+/**
+ * CEmbBatchReader class iterates entries of received batch envelope without
+ * copying them
+ */
+class CEmbBatchReader
+{
+	const char *m_pCur; /** current position in batch payload*/
+	const char *m_pEnd; /** end of batch payload*/
+	uint32_t m_u32Count; /** entries in batch*/
+	uint32_t m_u32Remaining; /** entries not yet read*/
+
+public:
+	CEmbBatchReader();
+
+	static bool isBatch(msg_envelope_t *a_pMsg);
+
+	bool open(msg_envelope_t *a_pMsg);
+	bool open(const char *a_pData, size_t a_len);
+	bool next(stEmbBatchEntry &a_stEntry);
+
+	/** returns number of entries in batch*/
+	uint32_t getCount() {return m_u32Count;}
+};
+#endif
@@ -0,0 +1,78 @@
+/********************************************************************************
+* Copyright (c) 2021 Intel Corporation.
+
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*********************************************************************************/
+/*** JsonEnvelope.hpp is used to convert JSON text into EII message envelope*/
+
+#ifndef JSONENVELOPE_HPP_
+#define JSONENVELOPE_HPP_
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <eii/msgbus/msgbus.h>
+
+/** max nesting of objects and arrays accepted in JSON text*/
+#define JSON_ENVELOPE_MAX_DEPTH 16
+
+	/**
+	 * Streaming converter of JSON text into EII message envelope. Text is
+	 * tokenized in one pass and every value is put in envelope as soon as it
+	 * is read, no JSON document is built. Numbers without fraction and
+	 * exponent become integers, others become floating; objects and arrays
+	 * become nested envelope elements.
+	 * Decoded keys and strings are kept in buffers owned by converter, these
+	 * are reused for next conversion. Hence one converter is to be used by
+	 * one thread at a time.
+	 */
+	class CJsonToEnvelope
+	{
+		const char *m_pCur; /** current position in JSON text*/
+		const char *m_pEnd; /** end of JSON text*/
+		std::vector<std::string> m_vKeyBuf; /** decoded key per nesting level*/
+		std::string m_sValBuf; /** decoded string or number value*/
+
+		// delete copy and move constructors and assign operators
+		CJsonToEnvelope& operator=(const CJsonToEnvelope&)=delete;	// Copy assign
+		CJsonToEnvelope(const CJsonToEnvelope&)=delete;	 			// Copy construct
+
+		void skipWhitespace();
+		bool start(const char *a_pJson, size_t a_len);
+		bool isAtEnd();
+		bool parseString(std::string &a_sOut);
+		bool parseHex4(uint32_t &a_u32Code);
+		bool matchLiteral(const char *a_pszLiteral, size_t a_len);
+		msg_envelope_elem_body_t* parseNumber();
+		msg_envelope_elem_body_t* parseValue(uint32_t a_u32Depth);
+		msg_envelope_elem_body_t* parseArray(uint32_t a_u32Depth);
+		bool parseMembers(uint32_t a_u32Depth, msg_envelope_t *a_pMsg, msg_envelope_elem_body_t *a_pObj);
+
+	public:
+		CJsonToEnvelope();
+
+		msg_envelope_t* convert(const char *a_pJson, size_t a_len);
+		/** converts JSON object text into new envelope*/
+		msg_envelope_t* convert(const std::string &a_sJson) {return convert(a_sJson.c_str(), a_sJson.size());}
+
+		msg_envelope_elem_body_t* convertToObject(const char *a_pJson, size_t a_len);
+		/** converts JSON object text into new object element*/
+		msg_envelope_elem_body_t* convertToObject(const std::string &a_sJson) {return convertToObject(a_sJson.c_str(), a_sJson.size());}
+	};
+#endif
@@ -28,6 +28,18 @@
 #include "mqtt/async_client.h"
 #include "mqtt/will_options.h"
 #include <mutex>
+#include <atomic>
+#include <deque>
+#include <unordered_map>
+#include <condition_variable>
+
+/** What a windowed publish does when in-flight window and pending queue are full*/
+enum eMQTTPublishPolicy
+{
+	enPUBLISH_POLICY_BLOCK = 0, /** caller waits till there is room in pending queue*/
+	enPUBLISH_POLICY_DROP_OLDEST, /** oldest pending message is dropped*/
+	enPUBLISH_POLICY_SPOOL /** message is not taken, caller stores it elsewhere*/
+};
 
 /** class is for action failure or success related to mqtt*/
 class action_listener : public virtual mqtt::iaction_listener
@@ -63,6 +75,20 @@ class CMQTTPubSubClient : public virtual mqtt::callback,
 	bool m_bNotifyMsgRcvd = false;
 	mqtt::async_client::message_handler m_fcbMsgRcvd;
 
+	std::unordered_map<const mqtt::token*, mqtt::delivery_token_ptr> m_mapInFlight; /** tokens of QoS 1 and 2 messages published through window but not yet acknowledged*/
+	std::mutex m_mutexInFlight; /** mutex for in-flight tokens and pending messages*/
+	std::condition_variable m_cvInFlight; /** signals acknowledgement of in-flight message*/
+
+	uint32_t m_u32Window; /** max messages in flight for windowed publish, 0 means no limit*/
+	uint32_t m_u32MaxPending; /** max messages waiting for room in window*/
+	std::deque<mqtt::message_ptr> m_dqPending; /** messages waiting for room in window, in order of publish*/
+	std::atomic<uint64_t> m_u64Dropped; /** pending messages dropped since start*/
+
+	void releaseInFlight(const mqtt::token *a_pToken);
+	bool hasWindowRoom();
+	bool sendMsg(mqtt::message_ptr &a_pubMsg);
+	void sendPending();
+
 	/** Re-connection failure */
 	void on_failure(const mqtt::token& tok) override;
 
@@ -80,7 +106,7 @@ class CMQTTPubSubClient : public virtual mqtt::callback,
 	/** Callback for when a message arrives. */
 	void message_arrived(mqtt::const_message_ptr msg) override;
 
-	void delivery_complete(mqtt::delivery_token_ptr token) override {}
+	void delivery_complete(mqtt::delivery_token_ptr token) override;
 
 public:
 	/** constructor*/
@@ -107,6 +133,38 @@ public:
 		return m_Client.is_connected();
 	}
 
+	/** Function to set max in-flight messages, to be called before connect*/
+	void setMaxInFlight(int a_iMaxInFlight)
+	{
+		m_ConOptions.set_max_inflight(a_iMaxInFlight);
+	}
+
+	/** Function to get count of messages waiting for acknowledgement*/
+	uint32_t getInFlightCount()
+	{
+		std::lock_guard<std::mutex> lock(m_mutexInFlight);
+		return (uint32_t)m_mapInFlight.size();
+	}
+
+	bool waitForPublishWindow(uint32_t a_u32TimeoutMs);
+
+	void setPublishWindow(uint32_t a_u32Window, uint32_t a_u32MaxPending);
+
+	bool publishMsgWindowed(mqtt::message_ptr &a_pubMsg, eMQTTPublishPolicy a_ePolicy, uint32_t a_u32TimeoutMs);
+
+	/** Function to get count of messages waiting for room in window*/
+	size_t getPendingCount()
+	{
+		std::lock_guard<std::mutex> lock(m_mutexInFlight);
+		return m_dqPending.size();
+	}
+
+	/** Function to get count of pending messages dropped since start*/
+	uint64_t getDroppedCount()
+	{
+		return m_u64Dropped.load();
+	}
+
 	void subscribe(const std::string &a_sTopic);
 
 	/** Function to set notification for connection*/
@@ -156,6 +214,34 @@ public:
 	void disconnect();
 
 	bool publishMsg(const std::string &a_sMsg, const std::string &a_sTopic);
+	bool publishMsg(std::string &&a_sMsg, const std::string &a_sTopic);
+
+	/** Function to wait till windowed publish can hand a message to client*/
+	bool waitForPublishWindow(uint32_t a_u32TimeoutMs)
+	{
+		return m_MQTTClient.waitForPublishWindow(a_u32TimeoutMs);
+	}
+
+	/** Function to set window of windowed publish, to be called before connect*/
+	void setPublishWindow(uint32_t a_u32Window, uint32_t a_u32MaxPending)
+	{
+		m_MQTTClient.setPublishWindow(a_u32Window, a_u32MaxPending);
+	}
+
+	bool publishMsgWindowed(std::string &a_sMsg, const std::string &a_sTopic,
+			eMQTTPublishPolicy a_ePolicy, uint32_t a_u32TimeoutMs);
+
+	/** Function to get count of messages waiting for room in publish window*/
+	size_t getPendingCount()
+	{
+		return m_MQTTClient.getPendingCount();
+	}
+
+	/** Function to get count of pending messages dropped since start*/
+	uint64_t getDroppedCount()
+	{
+		return m_MQTTClient.getDroppedCount();
+	}
 };
 
 #endif
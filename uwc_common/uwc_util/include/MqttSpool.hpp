@@ -0,0 +1,117 @@
+/********************************************************************************
+* Copyright (c) 2021 Intel Corporation.
+
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*********************************************************************************/
+/*** MqttSpool.hpp is used to store MQTT messages on disk while they cannot be published*/
+
+#ifndef MQTTSPOOL_HPP_
+#define MQTTSPOOL_HPP_
+
+#include <string>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+
+/** identifies spool segment file, followed by layout version*/
+#define MQTT_SPOOL_MAGIC "UWCS"
+/** version of spool segment layout*/
+#define MQTT_SPOOL_VERSION 1
+/** length of segment header, records start after it*/
+#define MQTT_SPOOL_SEG_HEADER_LEN 64
+/** length of record header: message length(4), topic length(2), reserved(2)*/
+#define MQTT_SPOOL_RECORD_HEADER_LEN 8
+/** extension of segment files*/
+#define MQTT_SPOOL_SEG_EXT ".seg"
+
+/**
+ * Segment file layout is (integers are little endian):
+ * 0  : "UWCS", u32 version, u64 segment sequence, u32 write offset,
+ *      u32 read offset, u32 unread records
+ * 64 : records, each is u32 message length, u16 topic length, 2 reserved
+ *      bytes, topic and message
+ * Record is written before write offset is moved, hence a record which was
+ * being written when process stopped is not read back.
+ */
+
+/**
+ * CMqttSpool class is a bounded FIFO of MQTT messages kept in a ring of
+ * memory mapped segment files. Messages are read back in the order in which
+ * they are appended, also after restart of process. When ring is full, the
+ * oldest segment is discarded to make room for new messages.
+ */
+class CMqttSpool
+{
+	/** memory mapped segment file*/
+	struct stSpoolSegment
+	{
+		uint64_t m_u64Seq; /** sequence of segment, older segments have lower sequence*/
+		std::string m_sPath; /** path of segment file*/
+		char *m_pBase; /** start of mapped segment*/
+	};
+
+	std::string m_sDir; /** directory of segment files*/
+	std::string m_sName; /** prefix of segment file names*/
+	uint32_t m_u32SegmentSize; /** size of segment file*/
+	uint32_t m_u32MaxSegments; /** max segment files*/
+	std::deque<stSpoolSegment> m_dqSegments; /** segments, oldest first; last one is being written*/
+	std::mutex m_mutexSpool; /** mutex for segments*/
+	std::atomic<uint64_t> m_u64Depth; /** messages in spool*/
+	std::atomic<uint64_t> m_u64Bytes; /** bytes of messages in spool*/
+	std::atomic<uint64_t> m_u64Appended; /** messages appended since start*/
+	std::atomic<uint64_t> m_u64Drained; /** messages removed after reading since start*/
+	std::atomic<uint64_t> m_u64Dropped; /** messages discarded since start*/
+
+	// delete copy and move constructors and assign operators
+	CMqttSpool(const CMqttSpool&) = delete;	 			// Copy construct
+	CMqttSpool& operator=(const CMqttSpool&) = delete;	// Copy assign
+
+	bool addSegment(uint64_t a_u64Seq);
+	bool loadSegment(const std::string &a_sPath, uint64_t a_u64Seq);
+	void removeFrontSegment();
+	bool getFrontRecord(char *&a_pRecord, uint32_t &a_u32MsgLen, uint16_t &a_u16TopicLen);
+
+public:
+	CMqttSpool();
+	~CMqttSpool();
+
+	bool open(const std::string &a_sDir, const std::string &a_sName,
+			uint32_t a_u32SegmentSize, uint32_t a_u32MaxSegments);
+	void close();
+
+	/** checks if spool is opened*/
+	bool isOpen() {return (false == m_sDir.empty());}
+
+	bool append(const std::string &a_sTopic, const std::string &a_sMsg);
+	bool front(std::string &a_sTopic, std::string &a_sMsg);
+	bool pop();
+
+	/** returns number of messages in spool*/
+	uint64_t getDepth() {return m_u64Depth.load();}
+	/** returns bytes of messages in spool*/
+	uint64_t getBytes() {return m_u64Bytes.load();}
+	/** returns number of messages appended since start*/
+	uint64_t getAppendedCount() {return m_u64Appended.load();}
+	/** returns number of messages read and removed since start*/
+	uint64_t getDrainedCount() {return m_u64Drained.load();}
+	/** returns number of messages discarded since start, as spool was full*/
+	uint64_t getDroppedCount() {return m_u64Dropped.load();}
+};
+#endif
@@ -34,6 +34,13 @@
 #define SEPARATOR_CHAR "/"
 #define PERIODIC_GENERIC_TOPIC "update"
 
+/** roll ID of point is MY_APP_ID in upper bits followed by index of point in application*/
+#define ROLL_ID_APP_BITS 4
+/** number of bits of roll ID used for index of point in application*/
+#define ROLL_ID_POINT_BITS 20
+/** maximum number of points an application can have with unique roll ID*/
+#define ROLL_ID_MAX_POINTS ((1u << ROLL_ID_POINT_BITS) - 1)
+
 using std::string;
 using std::vector;
 
@@ -69,6 +76,9 @@ namespace network_info
 		bool m_bIsWordSwap; /** word swap or not(true or false)*/
 		std::string m_sDataType; /** data type*/
 		double m_dScaleFactor;
+		double m_dDeadband; /** absolute change of scaled value to be reported, 0 disables it*/
+		double m_dDeadbandPercent; /** change of scaled value, in percent of last reported value, to be reported, 0 disables it*/
+		unsigned int m_uiHeartbeatMs; /** max time in ms without report of unchanged value, 0 disables it*/
 	};
 
 	/** structure for polling data information*/
@@ -300,7 +310,7 @@ namespace network_info
 	/** class for maintaining Unique data point*/
 	class CUniqueDataPoint
 	{
-		const unsigned int m_uiMyRollID; /** ID value*/
+		const uint32_t m_u32MyRollID; /** ID value, MY_APP_ID and index of point*/
 		const std::string m_sId; /** site ID value*/
 		const CWellSiteInfo &m_rWellSite; /** reference of wellsite*/
 		const CWellSiteDevInfo &m_rWellSiteDev; /** reference of wellsite device*/
@@ -322,7 +332,7 @@ namespace network_info
 		const CWellSiteDevInfo& getWellSiteDev() const {return m_rWellSiteDev;}
 		const CDataPoint& getDataPoint() const {return m_rPoint;}
 
-		unsigned int getMyRollID() const {return m_uiMyRollID;}
+		uint32_t getMyRollID() const {return m_u32MyRollID;}
 
 		bool isIsAwaitResp() const;
 
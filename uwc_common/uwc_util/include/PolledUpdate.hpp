@@ -0,0 +1,131 @@
+/********************************************************************************
+* Copyright (c) 2021 Intel Corporation.
+
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*********************************************************************************/
+/*** PolledUpdate.hpp is used to encode and decode polled update in binary form*/
+
+#ifndef POLLEDUPDATE_HPP_
+#define POLLEDUPDATE_HPP_
+
+#include <string>
+#include <cstdint>
+#include <eii/msgbus/msgbus.h>
+
+/** identifies binary polled update, followed by layout version*/
+#define POLLED_UPDATE_MAGIC "UWCP"
+/** version of binary polled update layout, changed only when layout changes*/
+#define POLLED_UPDATE_VERSION 1
+/** length of fixed part of binary polled update*/
+#define POLLED_UPDATE_FIXED_LEN 96
+/** value of "version" field of JSON polled update*/
+#define POLLED_UPDATE_JSON_VERSION "2.0"
+
+/** flags of binary polled update*/
+#define POLLED_UPDATE_FLAG_RT			0x01
+#define POLLED_UPDATE_FLAG_PERSIST		0x02
+#define POLLED_UPDATE_FLAG_HEX_VALUE	0x04
+
+/** status of polled update*/
+enum ePolledUpdateStatus
+{
+	enPOLLED_STATUS_GOOD = 0,
+	enPOLLED_STATUS_BAD = 1
+};
+
+/** type of scaled value of polled update, same as envelope element types*/
+enum ePolledValueType
+{
+	enPOLLED_VALUE_NONE = 0,
+	enPOLLED_VALUE_INT = 1,
+	enPOLLED_VALUE_FLOAT = 2,
+	enPOLLED_VALUE_BOOL = 3,
+	enPOLLED_VALUE_STRING = 4
+};
+
+/** Polled update of a point. Timestamps are in micro-seconds since epoch */
+struct stPolledUpdate
+{
+	uint32_t m_u32PointId; /** roll ID of point, unique across points of all applications*/
+	std::string m_sDataTopic; /** data topic, e.g. /flowmeter/PL0/D1/update*/
+	std::string m_sWellhead; /** wellhead of point*/
+	std::string m_sMetric; /** metric of point*/
+	std::string m_sDataType; /** datatype of point, empty if not configured*/
+	bool m_bIsRealTime; /** RT or non-RT point(true or false)*/
+	bool m_bIsDataPersist; /** data persist flag*/
+	ePolledUpdateStatus m_eStatus; /** good or bad response*/
+	uint32_t m_u32ErrorCode; /** error code of bad response*/
+	bool m_bIsHexValue; /** hex string value is present(true or false)*/
+	std::string m_sHexValue; /** value as hex string*/
+	ePolledValueType m_eValueType; /** type of scaled value*/
+	int64_t m_i64Value; /** scaled value of INT type*/
+	double m_dValue; /** scaled value of FLOAT type*/
+	bool m_bValue; /** scaled value of BOOL type*/
+	std::string m_sValue; /** scaled value of STRING type*/
+	uint64_t m_u64DriverSeq; /** driver sequence number*/
+	int64_t m_i64TsPolling; /** polling time*/
+	int64_t m_i64ReqRcvdInStack; /** request received in stack*/
+	int64_t m_i64ReqSentByStack; /** request sent by stack*/
+	int64_t m_i64RespRcvdByStack; /** response received by stack*/
+	int64_t m_i64RespPostedByStack; /** response posted by stack*/
+	int64_t m_i64Timestamp; /** time at which update is prepared*/
+	int64_t m_i64Usec; /** time at which update is published*/
+	int64_t m_i64LastGoodUsec; /** time of last good value for bad response, 0 if not known*/
+
+	stPolledUpdate();
+};
+
+/**
+ * Binary polled update layout is (integers are little endian):
+ * 0  : "UWCP", version, flags, status, scaled value type
+ * 8  : u32 point ID, u32 error code, u64 driver sequence
+ * 24 : 8 bytes scaled value: int64, IEEE-754 double or 0/1 for bool
+ * 32 : int64 tsPollingTime, reqRcvdInStack, reqSentByStack, respRcvdByStack,
+ *      respPostedByStack, timestamp, usec, lastGoodUsec
+ * 96 : u16 length and bytes of data topic, wellhead, metric, datatype,
+ *      hex value and string scaled value
+ * Payload is sent as CT_BLOB envelope or as entry of EII batch.
+ */
+
+/**
+ * CPolledUpdateCodec class converts polled update to and from binary
+ * form. JSON form is produced only where update leaves EII, e.g. on MQTT.
+ */
+class CPolledUpdateCodec
+{
+	CPolledUpdateCodec() = delete;
+
+public:
+	static bool setScaledValue(stPolledUpdate &a_stUpdate, const msg_envelope_elem_body_t *a_pScaledValue);
+
+	static void encode(const stPolledUpdate &a_stUpdate, std::string &a_sBuf);
+
+	static bool isPolledUpdate(const char *a_pData, size_t a_len);
+
+	static bool isPolledUpdate(msg_envelope_t *a_pMsg);
+
+	static bool decode(const char *a_pData, size_t a_len, stPolledUpdate &a_stUpdate);
+
+	static bool decode(msg_envelope_t *a_pMsg, stPolledUpdate &a_stUpdate);
+
+	static bool getField(const stPolledUpdate &a_stUpdate, const std::string &a_sKey, std::string &a_sValue);
+
+	static void toJson(const stPolledUpdate &a_stUpdate, std::string &a_sJson);
+};
+#endif
@@ -30,6 +30,8 @@
 #include "mqtt/async_client.h"
 #include <queue>
 #include <string>
+#include <memory>
+#include "eii/msgbus/msgbus.h"
 
 	/**
 	 * Message Object class which handles mqtt message, time & topic related operations
@@ -38,6 +40,7 @@
 	{
 		mqtt::const_message_ptr m_mqttMsg; /** mqtt-export message*/
 		struct timespec m_stTs; /** timestamp when this object is created*/
+		std::shared_ptr<msg_envelope_t> m_pEnvelope; /** message already converted to EII envelope, if any*/
 
 		public:
 		CMessageObject() : m_mqttMsg{}, m_stTs{}
@@ -58,15 +61,30 @@
 			timespec_get(&m_stTs, TIME_UTC);
 		}
 
+		/** takes ownership of envelope converted from mqtt message, envelope
+		 * is destroyed with last copy of this object */
+		CMessageObject(mqtt::const_message_ptr a_mqttMsg, msg_envelope_t *a_pEnvelope)
+			: m_mqttMsg{a_mqttMsg}, m_stTs{}, m_pEnvelope{a_pEnvelope, [](msg_envelope_t *a_pMsg)
+			{
+				if(NULL != a_pMsg)
+				{
+					msgbus_msg_envelope_destroy(a_pMsg);
+				}
+			}}
+		{
+			timespec_get(&m_stTs, TIME_UTC);
+		}
+
 		
 		CMessageObject(const CMessageObject& a_obj)
-		: m_mqttMsg{a_obj.m_mqttMsg}, m_stTs{a_obj.m_stTs}
+		: m_mqttMsg{a_obj.m_mqttMsg}, m_stTs{a_obj.m_stTs}, m_pEnvelope{a_obj.m_pEnvelope}
 		{}
 
 		CMessageObject& operator=(const CMessageObject &a_obj)
 	    { 
 	    	m_mqttMsg = a_obj.m_mqttMsg;
 	    	m_stTs = a_obj.m_stTs;
+	    	m_pEnvelope = a_obj.m_pEnvelope;
 	        return *this; 
 	    }
 
@@ -89,6 +107,8 @@
 			return m_mqttMsg->get_payload();
 		}
 		mqtt::const_message_ptr& getMqttMsg() {return m_mqttMsg;}
+		/** function to get envelope, NULL if message is not converted*/
+		msg_envelope_t* getEnvelope() {return m_pEnvelope.get();}
 		struct timespec getTimestamp() {return m_stTs;}
 	};
 	/**
@@ -25,6 +25,7 @@
 #ifndef YAMLUTIL_H_
 #define YAMLUTIL_H_
 #include "yaml-cpp/yaml.h"  // IWYU pragma: keep
+#include <cstdint>
 
 #define BASE_PATH_YAML_FILE "/opt/intel/eii/uwc_data/"
 
@@ -40,6 +41,8 @@ void ConvertIPStringToCharArray(std::string srcString, unsigned char *ptrIpAddr)
 
 bool readEnvVariable(const char *pEnvVarName, std::string &storeVal);
 
+bool readEnvVariable(const char *pEnvVarName, uint32_t a_u32Min, uint32_t a_u32Max, uint32_t &a_u32Val);
+
 /** This function is used to read common environment variables
  *
  * @return: true/false based on success or error
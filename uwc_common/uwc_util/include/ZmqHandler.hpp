@@ -27,6 +27,7 @@
 
 #include <string>
 #include <map>
+#include <memory>
 #include <functional>
 #include <mutex>
 #include "cjson/cJSON.h"
@@ -70,6 +71,21 @@ namespace zmq_handler
 	{
 		void *m_pContext; /**msg bus context*/
 	};
+	/** structure maintaining publisher of a topic resolved once. Handle is
+	 * used to publish without context map lookups, it lives till process ends*/
+	struct stZmqPubHandle
+	{
+		void *m_pMsgbusCtx; /**msg bus context*/
+		publisher_ctx_t *m_pPubCtx; /** publisher context of topic*/
+		std::string m_sTopic; /** topic of publisher*/
+		std::mutex m_mutex; /** mutex for publisher socket*/
+
+		stZmqPubHandle(void *a_pMsgbusCtx, publisher_ctx_t *a_pPubCtx, const std::string &a_sTopic):
+			m_pMsgbusCtx{a_pMsgbusCtx}, m_pPubCtx{a_pPubCtx}, m_sTopic{a_sTopic}, m_mutex{} {;};
+		stZmqPubHandle(const stZmqPubHandle&)=delete;
+		stZmqPubHandle& operator=(const stZmqPubHandle&)=delete;
+	};
+
 	/** structure maintaining zmq subscribe context*/
 	struct stZmqSubContext
 	{
@@ -132,6 +148,18 @@ namespace zmq_handler
 	/** function to publish json data on ZMQ*/
 	bool publishJson(std::string &a_sUsec, msg_envelope_t* msg, const std::string &a_sTopic, std::string a_sPubTimeField);
 
+	/** function to get publisher handle of topic, publisher is created if needed*/
+	stZmqPubHandle* getPubHandle(const std::string &a_sTopic);
+
+	/** function to publish json data on ZMQ using publisher handle*/
+	bool publishJson(std::string &a_sUsec, msg_envelope_t* msg, stZmqPubHandle *a_pPubHandle, const std::string &a_sPubTimeField);
+
+	/** function to publish binary payload on ZMQ as CT_BLOB envelope using publisher handle*/
+	bool publishBlob(stZmqPubHandle *a_pPubHandle, const char *a_pData, size_t a_len);
+
+	/** function to set string field of envelope, buffer of present field is reused if value fits in it*/
+	bool setStringField(msg_envelope_t* msg, const char *a_pcKey, const char *a_pcValue);
+
 	/**
 	 *  function to return all pub/sub topics
 	 *  @param topicType     : [in] pub or sub